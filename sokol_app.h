@@ -115,6 +115,7 @@
     swap interval       | YES     | YES   | YES   | YES   | TODO    | TODO  | YES
     high-dpi            | YES     | YES   | TODO  | YES   | YES     | TODO  | YES
     clipboard           | YES     | YES   | TODO  | ---   | ---     | ---   | YES
+    headless            | ---     | ---   | YES   | ---   | ---     | ---   | ---
 
     TODO
     ====
@@ -514,6 +515,42 @@
     might still be used for the non-fullscreen window, in case the user can
     switch back from fullscreen- to windowed-mode).
 
+    HEADLESS MODE
+    =============
+    On Linux, sokol-app can run without a window system, for instance to
+    render images or run GPU tests on a build server without an X11 display.
+    Set sapp_desc.headless to true to enable this mode:
+
+        sapp_desc sokol_main(int argc, char* argv[]) {
+            return (sapp_desc){
+                .width = 1024,
+                .height = 768,
+                .headless = true,
+                .headless_frame_count = 16,
+                ...
+            };
+        }
+
+    In headless mode, sokol-app doesn't talk to X11 at all, instead libEGL is
+    loaded at runtime and a GL 3.3 core profile context is created, preferably
+    on Mesa's surfaceless platform. The default framebuffer is either an EGL
+    pbuffer, or, if the EGL implementation has no pbuffer configs, an
+    offscreen framebuffer object with an RGBA8 color- and a depth-stencil
+    renderbuffer (in this case, sapp_desc.sample_count is ignored and
+    sapp_sample_count() returns 1). In both cases the framebuffer size is fixed to
+    sapp_desc.width/height (default 640x480), the DPI scale is 1.0 and
+    sapp_desc.high_dpi and sapp_desc.swap_interval are ignored.
+
+    The init-, frame- and cleanup-callbacks are called just as in windowed
+    mode, frames are rendered back-to-back without any vsync throttling, and
+    no input- or window-events are sent. The application quits after
+    sapp_desc.headless_frame_count frames (or when sapp_request_quit()
+    is called if the frame count is zero), the usual
+    SAPP_EVENTTYPE_QUIT_REQUESTED event is sent before quitting.
+
+    To get the rendered pixels back to the CPU, use sokol_gfx's
+    sg_read_pixels_async() on the default pass.
+
     ONSCREEN KEYBOARD
     =================
     On some platforms which don't provide a physical keyboard, sokol-app
@@ -855,6 +892,8 @@ typedef struct sapp_desc {
     bool html5_ask_leave_site;          /* initial state of the internal html5_ask_leave_site flag (see sapp_html5_ask_leave_site()) */
     bool ios_keyboard_resizes_canvas;   /* if true, showing the iOS keyboard shrinks the canvas */
     bool gl_force_gles2;                /* if true, setup GLES2/WebGL even if GLES3/WebGL2 is available */
+    bool headless;                      /* Linux only: no window, render into an EGL pbuffer or surfaceless context of size width/height */
+    int headless_frame_count;           /* headless mode only: quit after this many frames (default: 0, run until sapp_request_quit()) */
 } sapp_desc;
 
 /* user-provided functions */
@@ -6648,6 +6687,81 @@ static bool _sapp_glx_EXT_framebuffer_sRGB;
 static bool _sapp_glx_ARB_create_context;
 static bool _sapp_glx_ARB_create_context_profile;
 
+/* EGL types and constants for the headless mode (libEGL is loaded at runtime) */
+#define EGL_FALSE 0
+#define EGL_TRUE 1
+#define EGL_NONE 0x3038
+#define EGL_ALPHA_SIZE 0x3021
+#define EGL_BLUE_SIZE 0x3022
+#define EGL_GREEN_SIZE 0x3023
+#define EGL_RED_SIZE 0x3024
+#define EGL_DEPTH_SIZE 0x3025
+#define EGL_STENCIL_SIZE 0x3026
+#define EGL_SAMPLES 0x3031
+#define EGL_SAMPLE_BUFFERS 0x3032
+#define EGL_SURFACE_TYPE 0x3033
+#define EGL_RENDERABLE_TYPE 0x3040
+#define EGL_EXTENSIONS 0x3055
+#define EGL_HEIGHT 0x3056
+#define EGL_WIDTH 0x3057
+#define EGL_PBUFFER_BIT 0x0001
+#define EGL_OPENGL_BIT 0x0008
+#define EGL_OPENGL_API 0x30A2
+#define EGL_CONTEXT_MAJOR_VERSION 0x3098
+#define EGL_CONTEXT_MINOR_VERSION 0x30FB
+#define EGL_CONTEXT_OPENGL_PROFILE_MASK 0x30FD
+#define EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT 0x0001
+#define EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE 0x31B1
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#define EGL_DEFAULT_DISPLAY ((void*)0)
+#define EGL_NO_DISPLAY ((EGLDisplay)0)
+#define EGL_NO_CONTEXT ((EGLContext)0)
+#define EGL_NO_SURFACE ((EGLSurface)0)
+
+typedef void* EGLDisplay;
+typedef void* EGLConfig;
+typedef void* EGLContext;
+typedef void* EGLSurface;
+typedef int32_t EGLint;
+typedef unsigned int EGLBoolean;
+typedef unsigned int EGLenum;
+typedef void (*__EGLextproc)(void);
+
+typedef __EGLextproc (*PFNEGLGETPROCADDRESSPROC)(const char*);
+typedef EGLDisplay (*PFNEGLGETDISPLAYPROC)(void*);
+typedef EGLDisplay (*PFNEGLGETPLATFORMDISPLAYEXTPROC)(EGLenum,void*,const EGLint*);
+typedef EGLBoolean (*PFNEGLINITIALIZEPROC)(EGLDisplay,EGLint*,EGLint*);
+typedef EGLBoolean (*PFNEGLTERMINATEPROC)(EGLDisplay);
+typedef const char* (*PFNEGLQUERYSTRINGPROC)(EGLDisplay,EGLint);
+typedef EGLBoolean (*PFNEGLBINDAPIPROC)(EGLenum);
+typedef EGLBoolean (*PFNEGLCHOOSECONFIGPROC)(EGLDisplay,const EGLint*,EGLConfig*,EGLint,EGLint*);
+typedef EGLSurface (*PFNEGLCREATEPBUFFERSURFACEPROC)(EGLDisplay,EGLConfig,const EGLint*);
+typedef EGLBoolean (*PFNEGLDESTROYSURFACEPROC)(EGLDisplay,EGLSurface);
+typedef EGLContext (*PFNEGLCREATECONTEXTPROC)(EGLDisplay,EGLConfig,EGLContext,const EGLint*);
+typedef EGLBoolean (*PFNEGLDESTROYCONTEXTPROC)(EGLDisplay,EGLContext);
+typedef EGLBoolean (*PFNEGLMAKECURRENTPROC)(EGLDisplay,EGLSurface,EGLSurface,EGLContext);
+
+static void* _sapp_egl_libegl;
+static EGLDisplay _sapp_egl_display;
+static EGLContext _sapp_egl_ctx;
+static EGLSurface _sapp_egl_surface;
+static GLuint _sapp_egl_fb;
+static GLuint _sapp_egl_color_rb;
+static GLuint _sapp_egl_depth_stencil_rb;
+static PFNEGLGETPROCADDRESSPROC            _sapp_egl_GetProcAddress;
+static PFNEGLGETDISPLAYPROC                _sapp_egl_GetDisplay;
+static PFNEGLGETPLATFORMDISPLAYEXTPROC     _sapp_egl_GetPlatformDisplayEXT;
+static PFNEGLINITIALIZEPROC                _sapp_egl_Initialize;
+static PFNEGLTERMINATEPROC                 _sapp_egl_Terminate;
+static PFNEGLQUERYSTRINGPROC               _sapp_egl_QueryString;
+static PFNEGLBINDAPIPROC                   _sapp_egl_BindAPI;
+static PFNEGLCHOOSECONFIGPROC              _sapp_egl_ChooseConfig;
+static PFNEGLCREATEPBUFFERSURFACEPROC      _sapp_egl_CreatePbufferSurface;
+static PFNEGLDESTROYSURFACEPROC            _sapp_egl_DestroySurface;
+static PFNEGLCREATECONTEXTPROC             _sapp_egl_CreateContext;
+static PFNEGLDESTROYCONTEXTPROC            _sapp_egl_DestroyContext;
+static PFNEGLMAKECURRENTPROC               _sapp_egl_MakeCurrent;
+
 /* see GLFW's xkb_unicode.c */
 static const struct _sapp_x11_codepair {
   uint16_t keysym;
@@ -8304,8 +8418,210 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
     }
 }
 
+_SOKOL_PRIVATE void _sapp_egl_init(void) {
+    const char* sonames[] = { "libEGL.so.1", "libEGL.so", 0 };
+    for (int i = 0; sonames[i]; i++) {
+        _sapp_egl_libegl = dlopen(sonames[i], RTLD_LAZY|RTLD_GLOBAL);
+        if (_sapp_egl_libegl) {
+            break;
+        }
+    }
+    if (!_sapp_egl_libegl) {
+        _sapp_fail("EGL: failed to load libEGL");
+    }
+    _sapp_egl_GetProcAddress        = (PFNEGLGETPROCADDRESSPROC)        dlsym(_sapp_egl_libegl, "eglGetProcAddress");
+    _sapp_egl_GetDisplay            = (PFNEGLGETDISPLAYPROC)            dlsym(_sapp_egl_libegl, "eglGetDisplay");
+    _sapp_egl_Initialize            = (PFNEGLINITIALIZEPROC)            dlsym(_sapp_egl_libegl, "eglInitialize");
+    _sapp_egl_Terminate             = (PFNEGLTERMINATEPROC)             dlsym(_sapp_egl_libegl, "eglTerminate");
+    _sapp_egl_QueryString           = (PFNEGLQUERYSTRINGPROC)           dlsym(_sapp_egl_libegl, "eglQueryString");
+    _sapp_egl_BindAPI               = (PFNEGLBINDAPIPROC)               dlsym(_sapp_egl_libegl, "eglBindAPI");
+    _sapp_egl_ChooseConfig          = (PFNEGLCHOOSECONFIGPROC)          dlsym(_sapp_egl_libegl, "eglChooseConfig");
+    _sapp_egl_CreatePbufferSurface  = (PFNEGLCREATEPBUFFERSURFACEPROC)  dlsym(_sapp_egl_libegl, "eglCreatePbufferSurface");
+    _sapp_egl_DestroySurface        = (PFNEGLDESTROYSURFACEPROC)        dlsym(_sapp_egl_libegl, "eglDestroySurface");
+    _sapp_egl_CreateContext         = (PFNEGLCREATECONTEXTPROC)         dlsym(_sapp_egl_libegl, "eglCreateContext");
+    _sapp_egl_DestroyContext        = (PFNEGLDESTROYCONTEXTPROC)        dlsym(_sapp_egl_libegl, "eglDestroyContext");
+    _sapp_egl_MakeCurrent           = (PFNEGLMAKECURRENTPROC)           dlsym(_sapp_egl_libegl, "eglMakeCurrent");
+    if (!_sapp_egl_GetProcAddress ||
+        !_sapp_egl_GetDisplay ||
+        !_sapp_egl_Initialize ||
+        !_sapp_egl_Terminate ||
+        !_sapp_egl_QueryString ||
+        !_sapp_egl_BindAPI ||
+        !_sapp_egl_ChooseConfig ||
+        !_sapp_egl_CreatePbufferSurface ||
+        !_sapp_egl_DestroySurface ||
+        !_sapp_egl_CreateContext ||
+        !_sapp_egl_DestroyContext ||
+        !_sapp_egl_MakeCurrent)
+    {
+        _sapp_fail("EGL: failed to load required entry points");
+    }
+
+    /* prefer Mesa's surfaceless platform, this doesn't touch X11 or Wayland at all */
+    const char* client_exts = _sapp_egl_QueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (_sapp_glx_extsupported("EGL_MESA_platform_surfaceless", client_exts)) {
+        _sapp_egl_GetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC) _sapp_egl_GetProcAddress("eglGetPlatformDisplayEXT");
+        if (_sapp_egl_GetPlatformDisplayEXT) {
+            _sapp_egl_display = _sapp_egl_GetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, 0);
+        }
+    }
+    if (EGL_NO_DISPLAY == _sapp_egl_display) {
+        _sapp_egl_display = _sapp_egl_GetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    if (EGL_NO_DISPLAY == _sapp_egl_display) {
+        _sapp_fail("EGL: failed to get display");
+    }
+    EGLint major, minor;
+    if (!_sapp_egl_Initialize(_sapp_egl_display, &major, &minor)) {
+        _sapp_fail("EGL: failed to initialize display");
+    }
+    if (!_sapp_egl_BindAPI(EGL_OPENGL_API)) {
+        _sapp_fail("EGL: OpenGL API not supported");
+    }
+}
+
+_SOKOL_PRIVATE bool _sapp_egl_choose_config(EGLint surface_type, EGLConfig* out_config) {
+    const bool msaa = (_sapp.sample_count > 1) && (surface_type != 0);
+    const EGLint attrs[] = {
+        EGL_SURFACE_TYPE, surface_type,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_DEPTH_SIZE, (surface_type != 0) ? 24 : 0,
+        EGL_STENCIL_SIZE, (surface_type != 0) ? 8 : 0,
+        EGL_SAMPLE_BUFFERS, msaa ? 1 : 0,
+        EGL_SAMPLES, msaa ? _sapp.sample_count : 0,
+        EGL_NONE
+    };
+    EGLint num_configs = 0;
+    if (!_sapp_egl_ChooseConfig(_sapp_egl_display, attrs, out_config, 1, &num_configs)) {
+        return false;
+    }
+    return num_configs > 0;
+}
+
+/* surfaceless contexts have no default framebuffer, so render into an
+   offscreen framebuffer of the requested size instead, this must be bound
+   before the init callback because sokol_gfx picks up the currently bound
+   framebuffer as its default framebuffer, the framebuffer isn't multisampled
+   so that glReadPixels() works on it just like on a window or pbuffer
+*/
+_SOKOL_PRIVATE void _sapp_egl_create_framebuffer(void) {
+    const int w = _sapp.framebuffer_width;
+    const int h = _sapp.framebuffer_height;
+    glGenRenderbuffers(1, &_sapp_egl_color_rb);
+    glBindRenderbuffer(GL_RENDERBUFFER, _sapp_egl_color_rb);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+    glGenRenderbuffers(1, &_sapp_egl_depth_stencil_rb);
+    glBindRenderbuffer(GL_RENDERBUFFER, _sapp_egl_depth_stencil_rb);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glGenFramebuffers(1, &_sapp_egl_fb);
+    glBindFramebuffer(GL_FRAMEBUFFER, _sapp_egl_fb);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _sapp_egl_color_rb);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, _sapp_egl_depth_stencil_rb);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        _sapp_fail("EGL: failed to create offscreen framebuffer");
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_egl_create_context(void) {
+    EGLConfig config = 0;
+    bool surfaceless = false;
+    if (!_sapp_egl_choose_config(EGL_PBUFFER_BIT, &config)) {
+        if (!_sapp_egl_choose_config(0, &config)) {
+            _sapp_fail("EGL: failed to find a suitable config");
+        }
+        surfaceless = true;
+        _sapp.sample_count = 1;
+    }
+    const EGLint ctx_attrs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE, EGL_TRUE,
+        EGL_NONE
+    };
+    _sapp_egl_ctx = _sapp_egl_CreateContext(_sapp_egl_display, config, EGL_NO_CONTEXT, ctx_attrs);
+    if (EGL_NO_CONTEXT == _sapp_egl_ctx) {
+        _sapp_fail("EGL: failed to create GL 3.3 core context");
+    }
+    if (!surfaceless) {
+        const EGLint surf_attrs[] = {
+            EGL_WIDTH, _sapp.framebuffer_width,
+            EGL_HEIGHT, _sapp.framebuffer_height,
+            EGL_NONE
+        };
+        _sapp_egl_surface = _sapp_egl_CreatePbufferSurface(_sapp_egl_display, config, surf_attrs);
+        if (EGL_NO_SURFACE == _sapp_egl_surface) {
+            _sapp_fail("EGL: failed to create pbuffer surface");
+        }
+    }
+    if (!_sapp_egl_MakeCurrent(_sapp_egl_display, _sapp_egl_surface, _sapp_egl_surface, _sapp_egl_ctx)) {
+        _sapp_fail("EGL: failed to make context current");
+    }
+    if (surfaceless) {
+        _sapp_egl_create_framebuffer();
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_egl_destroy_context(void) {
+    if (_sapp_egl_fb) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &_sapp_egl_fb);
+        glDeleteRenderbuffers(1, &_sapp_egl_color_rb);
+        glDeleteRenderbuffers(1, &_sapp_egl_depth_stencil_rb);
+        _sapp_egl_fb = _sapp_egl_color_rb = _sapp_egl_depth_stencil_rb = 0;
+    }
+    _sapp_egl_MakeCurrent(_sapp_egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (_sapp_egl_surface) {
+        _sapp_egl_DestroySurface(_sapp_egl_display, _sapp_egl_surface);
+        _sapp_egl_surface = EGL_NO_SURFACE;
+    }
+    if (_sapp_egl_ctx) {
+        _sapp_egl_DestroyContext(_sapp_egl_display, _sapp_egl_ctx);
+        _sapp_egl_ctx = EGL_NO_CONTEXT;
+    }
+    _sapp_egl_Terminate(_sapp_egl_display);
+    _sapp_egl_display = EGL_NO_DISPLAY;
+    dlclose(_sapp_egl_libegl);
+    _sapp_egl_libegl = 0;
+}
+
+/* headless mode: no window and no input events, the callbacks are driven
+   by a simple loop until sapp_request_quit() is called or the optional
+   frame count has been reached
+*/
+_SOKOL_PRIVATE void _sapp_egl_run_headless(void) {
+    _sapp_egl_init();
+    _sapp_egl_create_context();
+    _sapp.valid = true;
+    while (!_sapp.quit_ordered) {
+        _sapp_frame();
+        glFlush();
+        if ((_sapp.desc.headless_frame_count > 0) && (_sapp.frame_count >= (uint64_t)_sapp.desc.headless_frame_count)) {
+            _sapp.quit_requested = true;
+        }
+        if (_sapp.quit_requested && !_sapp.quit_ordered) {
+            _sapp_x11_app_event(SAPP_EVENTTYPE_QUIT_REQUESTED);
+            if (_sapp.quit_requested) {
+                _sapp.quit_ordered = true;
+            }
+        }
+    }
+    _sapp_call_cleanup();
+    _sapp_egl_destroy_context();
+    _sapp_discard_state();
+}
+
 _SOKOL_PRIVATE void _sapp_run(const sapp_desc* desc) {
     _sapp_init_state(desc);
+    if (_sapp.desc.headless) {
+        _sapp_egl_run_headless();
+        return;
+    }
     _sapp_x11_window_state = NormalState;
 
     XInitThreads();
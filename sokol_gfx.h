@@ -17,6 +17,7 @@
         #define SOKOL_D3D11
         #define SOKOL_METAL
         #define SOKOL_WGPU
+        #define SOKOL_SOFT
         #define SOKOL_DUMMY_BACKEND
 
     I.e. for the GL 3.3 Core Profile it should look like this:
@@ -31,6 +32,9 @@
     stub functions. This is useful for writing tests that need to run on the
     command line.
 
+    The software backend (SOKOL_SOFT) renders on the CPU without any 3D-API,
+    shaders are provided as C functions (search below for SOFTWARE RENDERING).
+
     Optionally provide the following defines with your own implementations:
 
     SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
@@ -41,6 +45,10 @@
     SOKOL_API_DECL      - public function declaration prefix (default: extern)
     SOKOL_API_IMPL      - public function implementation prefix (default: -)
     SOKOL_TRACE_HOOKS   - enable trace hook callbacks (search below for TRACE HOOKS)
+    SOKOL_THREADSAFE_ALLOC - make the sg_alloc_*() functions callable from any thread
+                          (search below for ASYNCHRONOUS RESOURCE CREATION)
+    SOKOL_POOL_SLOT_BITS - number of resource id bits for the pool slot index
+                          (default: 16, search below for 'Resource id typedefs')
 
     If sokol_gfx.h is compiled as a DLL, define the following before
     including the declaration or implementation:
@@ -136,6 +144,48 @@
 
             sg_draw(int base_element, int num_elements, int num_instances)
 
+    --- or, for indexed rendering, kick off a draw call which adds a constant
+        'base_vertex' to each index before fetching vertex data:
+
+            sg_draw_ex(int base_element, int num_elements, int num_instances, int base_vertex)
+
+        this allows to render meshes from different sections of the same
+        vertex buffer without calling sg_apply_bindings() with a new vertex
+        buffer offset for each mesh. If sg_features.base_vertex is true, this
+        maps to a native base-vertex draw call, otherwise (GLES2/WebGL,
+        GLES3/WebGL2, older iOS devices) the vertex buffer offsets are
+        adjusted internally, which is still much cheaper than a full
+        sg_apply_bindings(). The base_vertex value must not be negative.
+
+    --- or kick off a batch of draw calls with the same pipeline and
+        resource bindings with:
+
+            sg_multi_draw(const sg_draw_args* draws, int num_draws)
+
+        this only pays the draw-call validation and tracing overhead once
+        for the whole batch, and on desktop GL, runs of non-instanced
+        draws are issued with glMultiDrawArrays() / glMultiDrawElements()
+
+    --- or draw with draw arguments which have been written into a buffer
+        of type SG_BUFFERTYPE_INDIRECTBUFFER:
+
+            sg_draw_indirect(sg_buffer buf, int offset, int num_draws)
+
+        the buffer at byte offset 'offset' contains 'num_draws' tightly
+        packed sg_draw_indexed_indirect_args structs if the current
+        pipeline uses indexed rendering, otherwise sg_draw_indirect_args
+        structs. The base_instance item must be zero, and the index buffer
+        offset in sg_bindings must be zero.
+
+        If sg_features.draw_indirect is true (desktop GL 4.0 or
+        ARB_draw_indirect), the draw arguments are read by the GPU via
+        glMultiDrawElementsIndirect() (GL4.3 or ARB_multi_draw_indirect),
+        or a loop of glDrawElementsIndirect() with one call per draw
+        (GL4.0..4.2, or GL headers which don't declare the GL4.3 functions).
+        If sg_features.draw_indirect is false, sokol-gfx keeps a CPU-side
+        copy of indirect buffers and sg_draw_indirect() is a loop over
+        regular draw calls.
+
     --- finish the current rendering pass with:
 
             sg_end_pass()
@@ -156,6 +206,15 @@
             sg_destroy_pipeline(sg_pipeline pip)
             sg_destroy_pass(sg_pass pass)
 
+        The resource handle is invalid immediately after the call, but the
+        GL backend keeps the underlying GL buffer, texture, renderbuffer and
+        program objects alive until SG_NUM_INFLIGHT_FRAMES calls to
+        sg_commit() later, and then deletes them in batches. This avoids
+        stalls when many resources are destroyed in the middle of a frame
+        (for instance when a level is unloaded). GL framebuffer objects
+        can't be shared between GL contexts and are still deleted
+        immediately.
+
     --- to set a new viewport rectangle, call
 
             sg_apply_viewport(int x, int y, int width, int height, bool origin_top_left)
@@ -187,6 +246,19 @@
         operation only references the valid (updated) data in the
         buffer or image.
 
+    --- to overwrite a rectangular area in one mipmap level and slice of a
+        SG_USAGE_DYNAMIC image, call:
+
+            sg_update_image_region(sg_image img, const sg_image_region* region, const void* ptr, int num_bytes)
+
+        The pixel data must be tightly packed (without row padding), and
+        the rest of the image content remains unchanged. Any number of
+        region updates is allowed per image and frame. Region updates write
+        into the image in place, so they should only touch areas which
+        aren't used by frames still in flight (like new glyphs in a font
+        atlas). Region updates are supported if sg_features.image_region_update
+        is true (GL, Metal and the dummy backend).
+
     --- to append a chunk of data to a buffer resource, call:
 
             int sg_append_buffer(sg_buffer buf, const void* ptr, int num_bytes)
@@ -237,6 +309,94 @@
         is associated with one draw call, but will be problematic when
         a single indexed draw call spans several appended chunks of indices.
 
+    --- to write new content directly into a buffer resource without
+        going through an intermediate copy, call:
+
+            void* sg_map_buffer(sg_buffer buf, int num_bytes)
+            void sg_unmap_buffer(sg_buffer buf)
+
+        sg_map_buffer() returns a pointer to at least num_bytes of writable
+        memory for the buffer's next in-flight slot, the content is
+        'committed' to the buffer with sg_unmap_buffer(). Mapping a buffer
+        counts as the buffer's one update for the current frame, so the
+        same rules as for sg_update_buffer() apply (the buffer must have
+        been created with SG_USAGE_DYNAMIC or SG_USAGE_STREAM, and may not
+        be updated or appended to in the same frame).
+
+        Code example:
+
+            vertex_t* vtx = (vertex_t*) sg_map_buffer(buf, num_vertices * sizeof(vertex_t));
+            if (vtx) {
+                for (int i = 0; i < num_vertices; i++) {
+                    vtx[i] = ...;
+                }
+                sg_unmap_buffer(buf);
+            }
+
+        The returned pointer is only valid until sg_unmap_buffer(), and the
+        buffer must be unmapped before it is used in sg_apply_bindings().
+        The memory is write-only, don't read from it (it may be uncached
+        GPU memory). On backends which can't expose buffer memory directly
+        to the CPU (GL without persistent mapping, WebGPU and the dummy
+        backend) the pointer refers to a CPU-side shadow buffer which is
+        allocated on first use and copied into the buffer on
+        sg_unmap_buffer().
+
+        sg_map_buffer() returns a null pointer if the buffer is not in the
+        valid state, or if it is already mapped.
+
+    --- to read back the pixels of a render target image, or of the default
+        framebuffer without waiting for the GPU, call (outside of a pass):
+
+            bool sg_read_pixels_async(const sg_read_pixels_desc* desc)
+
+        The sg_read_pixels_desc struct defines the source (a 2D render
+        target image with pixel format SG_PIXELFORMAT_RGBA8, or the default
+        framebuffer if .image is SG_INVALID_ID), the rectangle to read
+        (with the origin in the top-left corner), and a callback function
+        which is called with the pixel data once it is available:
+
+            void my_callback(const sg_read_pixels_result* res) {
+                // res->ptr points to res->width * res->height RGBA8 pixels,
+                // tightly packed, with the top row first
+                ...
+            }
+
+            sg_read_pixels_desc desc = {
+                .image = img,
+                .x = 0, .y = 0, .width = 256, .height = 256,
+                .callback = my_callback,
+                .user_data = ...
+            };
+            sg_read_pixels_async(&desc);
+
+        The pixel data is only valid inside the callback, copy it if you need
+        it later. The content read is whatever has been rendered before the
+        call to sg_read_pixels_async(). Reading from the default framebuffer
+        must happen after the frame's sg_begin_default_pass()/sg_end_pass()
+        and before presenting the frame, the rectangle is checked against
+        the width and height passed to the last sg_begin_default_pass().
+
+        On GL3.3 and GLES3, the pixels are copied into a pixel pack buffer
+        and the callback is called from inside a later sg_commit() when a
+        fence signals that the copy has finished (usually one or two frames
+        later), so the CPU never waits for the GPU. A limited number of
+        readbacks can be in flight, if there are too many pending readbacks
+        sg_read_pixels_async() returns false and the callback will not be
+        called. Pending readbacks are dropped without calling the callback
+        in sg_shutdown().
+
+        On GLES2 and WebGL the pixels are read synchronously and the callback
+        is called from inside sg_read_pixels_async(). The software backend
+        also calls the callback immediately, since the rendering threads
+        have finished all work at the end of a pass. The dummy backend calls the callback immediately
+        too, with a deterministic pixel pattern
+        (red is the x-, green the y-coordinate in the framebuffer, modulo
+        256, blue is 0 and alpha is 255).
+
+        Pixel readback is supported if sg_features.read_pixels is true (GL,
+        the software backend and the dummy backend).
+
     --- to check at runtime for optional features, limits and pixelformat support,
         call:
 
@@ -271,6 +431,58 @@
 
             sg_backend sg_query_backend(void)
 
+    --- consecutive calls to sg_apply_pipeline(), sg_apply_bindings(),
+        sg_apply_viewport() and sg_apply_scissor_rect() with identical
+        arguments are filtered out before any validation and backend work
+        happens (trace hooks are still called for filtered calls). You can
+        query how many calls have been filtered since sg_setup() with:
+
+            sg_filter_stats sg_query_filter_stats(void)
+
+    --- sokol-gfx keeps a few always-on counters (number of draw calls,
+        uniform bytes, resource update bytes, rejected calls etc.), you can
+        get the counters of the previous frame (the last complete frame
+        before the last call to sg_commit()) with:
+
+            sg_frame_stats sg_query_frame_stats(void)
+
+    --- if sg_desc.gpu_timings_enabled is true (and sg_features.gpu_timings
+        is supported), sokol-gfx measures the GPU time spent in each
+        render pass, and between each sg_push_debug_group() and the
+        matching sg_pop_debug_group(). Get the timings of the most recent
+        frame for which the GPU has finished the measurements with:
+
+            sg_gpu_timings sg_query_gpu_timings(void)
+
+        The measurement results are collected in sg_commit() without ever
+        waiting for the GPU, so the returned timings usually lag a few
+        frames behind (check sg_gpu_timings.frame_index), and timings of
+        frames for which the GPU was too far behind are dropped.
+
+    --- the dummy backend (SOKOL_DUMMY_BACKEND) doesn't render anything, but
+        it keeps track of the GPU state a real backend would have to change
+        (render target, pipeline, shader and render state switches, vertex-,
+        index-buffer and texture rebinds, uniform updates and uploaded bytes)
+        and counts those state transitions since sg_setup(). This can be
+        used to catch state-thrashing regressions in automated tests
+        without a GPU:
+
+            sg_dummy_stats sg_query_dummy_stats(void)
+
+        If sg_desc.dummy_log_size is not zero, the dummy backend also
+        writes a deterministic text log of all state transitions, draw
+        calls, resource creation, updates and destruction (one command per
+        line, resources are identified by their pool slot index):
+
+            const char* sg_query_dummy_log(void)
+
+        Both the counters and the log are cleared with:
+
+            void sg_reset_dummy_stats(void)
+
+        On all other backends the counters are always zero, and the log
+        is always an empty string.
+
     --- you can query the default resource creation parameters through the functions
 
             sg_buffer_desc sg_query_buffer_defaults(const sg_buffer_desc* desc)
@@ -300,8 +512,11 @@
                   per uniform update (this worst-case alignment is 256 bytes)
                 - the max size of all dynamic resource updates (sg_update_buffer,
                   sg_append_buffer and sg_update_image) per frame
-                - the max number of entries in the texture sampler cache
-                  (how many unique texture sampler can exist at the same time)
+                - the number of entries in the texture sampler cache
+                  (how many unique texture samplers are kept alive, when
+                  the cache is full, the least recently used sampler which
+                  isn't used by any image is destroyed, if all samplers
+                  are in use the cache grows)
             Not all of those limit values are used by all backends, but it is
             good practice to provide them none-the-less.
 
@@ -347,6 +562,38 @@
                 ...
             };
 
+    --- on GL3.3 and GLES3, a uniform block can also be declared as a GLSL
+        std140 uniform block, in this case provide the block name in
+        sg_shader_uniform_block_desc.name, the member names are then
+        not needed, but the member types must still be provided in the
+        same order as in the GLSL block:
+
+            // GLSL:
+            layout(std140) uniform params {
+                mat4 mvp;
+                vec2 offset0;
+                ...
+            };
+
+            // C:
+            .vs.uniform_blocks[0] = {
+                .size = sizeof(params_t),
+                .name = "params",
+                .uniforms = {
+                    [0] = { .type=SG_UNIFORMTYPE_MAT4 },
+                    [1] = { .type=SG_UNIFORMTYPE_FLOAT2 },
+                    ...
+                }
+            },
+
+        The data passed to sg_apply_uniforms() has the same tightly packed
+        layout in both cases, sokol-gfx converts it to the std140 layout
+        when needed. Uniform blocks are written into a per-frame uniform
+        buffer of sg_desc.uniform_buffer_size bytes and bound with
+        glBindBufferRange(), which is much cheaper than one glUniform*()
+        call per block member. In GLES2 fallback mode, the block name
+        is ignored and the member names are used instead.
+
     --- the Metal and D3D11 backends only need to know the size of uniform blocks,
         not their internal member structure, and they only need to know
         the type of a texture sampler, not its name:
@@ -398,6 +645,64 @@
                 }
             };
 
+    SOFTWARE RENDERING
+    ==================
+    With SOKOL_SOFT, sokol-gfx renders on the CPU without a 3D-API or window
+    system, for instance to render thumbnails on machines without a GPU, or
+    to produce identical golden images in tests on any machine.
+
+    Shaders are plain C functions (see sg_soft_vs_input and friends), the
+    shader desc still needs the uniform block sizes and image types:
+
+        static void vs(const sg_soft_vs_input* in, sg_soft_vs_output* out) {
+            const params_t* params = (const params_t*) in->uniforms[0];
+            mat4_mul_vec4(params->mvp, in->attrs[0], out->pos);
+            memcpy(out->varyings, in->attrs[1], 4 * sizeof(float));
+        }
+        static void fs(const sg_soft_fs_input* in, sg_soft_fs_output* out) {
+            float texel[4];
+            sg_soft_sample(in->images[0], in->varyings[4], in->varyings[5], texel);
+            for (int i = 0; i < 4; i++) {
+                out->color[i] = in->varyings[i] * texel[i];
+            }
+        }
+        ...
+        sg_shader shd = sg_make_shader(&(sg_shader_desc){
+            .vs.uniform_blocks[0].size = sizeof(params_t),
+            .fs.images[0].type = SG_IMAGETYPE_2D,
+            .soft_vs = vs,
+            .soft_fs = fs,
+            .soft_num_varyings = 6
+        });
+
+    Vertex processing happens in the draw call, the resulting triangles are
+    binned into 64x64 pixel tiles, and the tiles are rasterized and shaded
+    in parallel by sg_desc.soft_num_threads threads (including the calling
+    thread) in sg_end_pass(). Since tiles don't overlap, the result doesn't
+    depend on the number of threads. Rasterization follows the D3D/GL
+    conventions: pixel centers at +0.5, vertex positions snapped to 1/16
+    pixel, top-left fill rule, clip-space depth in the GL range (-w..+w)
+    mapped to 0..1, and origin_top_left is true (the first row of a render
+    target or the default framebuffer is the top row).
+
+    The default framebuffer is an RGBA8 color- and float depth-buffer owned
+    by sokol-gfx, it is (re-)allocated in sg_begin_default_pass() with the
+    provided size, and its content can be read with sg_read_pixels_async()
+    (which completes immediately on the software backend).
+
+    The software backend only covers a subset of sokol-gfx:
+
+        - 2D images with SG_PIXELFORMAT_RGBA8 (or SG_PIXELFORMAT_R8 for
+          textures, which is sampled as (r,0,0,1)), and render target depth
+          buffers with SG_PIXELFORMAT_DEPTH or SG_PIXELFORMAT_DEPTH_STENCIL
+          (the stencil buffer is ignored), no MSAA
+        - only the top mipmap is sampled, with sg_image_desc.mag_filter
+          being used for both minification and magnification
+        - a single color attachment per pass
+        - points and lines are rasterized as quads which are always one
+          pixel wide, and are never culled
+        - depth bias, alpha-to-coverage and stencil state is ignored
+
     WORKING WITH CONTEXTS
     =====================
     sokol-gfx allows to switch between different rendering contexts and
@@ -441,6 +746,55 @@
 
     https://github.com/floooh/sokol-samples/blob/master/glfw/multiwindow-glfw.c
 
+    RECORDING COMMAND LISTS
+    =======================
+    The rendering functions sg_apply_viewport(), sg_apply_scissor_rect(),
+    sg_apply_pipeline(), sg_apply_bindings(), sg_apply_uniforms() and sg_draw()
+    can also be recorded into a compact binary command list, and replayed
+    later with a single call. Recording doesn't touch any sokol_gfx state,
+    so command lists can be recorded on worker threads while the render
+    thread keeps calling the regular sokol_gfx functions. Only the replay
+    must happen on the render thread, this is also where validation happens.
+
+    --- provide the memory for a command list and start recording with:
+
+            sg_commands cmds;
+            sg_begin_commands(&cmds, buf_ptr, buf_size);
+
+        The memory is owned by the caller and must remain valid until
+        the command list has been submitted.
+
+    --- record commands with the sg_cmd_* functions, these take the same
+        arguments as their regular counterparts:
+
+            sg_cmd_apply_viewport(&cmds, x, y, width, height, origin_top_left);
+            sg_cmd_apply_scissor_rect(&cmds, x, y, width, height, origin_top_left);
+            sg_cmd_apply_pipeline(&cmds, pip);
+            sg_cmd_apply_bindings(&cmds, &bindings);
+            sg_cmd_apply_uniforms(&cmds, stage, ub_index, data, num_bytes);
+            sg_cmd_draw(&cmds, base_element, num_elements, num_instances);
+
+        Uniform data is copied into the command list, so the data pointer
+        doesn't need to remain valid after sg_cmd_apply_uniforms() returns.
+
+    --- finish recording with:
+
+            bool ok = sg_end_commands(&cmds);
+
+        This returns false if the command list memory was too small, in that
+        case the command list is marked as overflown and can't be submitted.
+
+    --- on the render thread, inside a render pass, replay the command list:
+
+            sg_submit_commands(&cmds);
+
+        This replays the recorded commands through the regular sokol_gfx
+        functions, so that validation, trace hooks and rendering results
+        are identical to calling those functions directly.
+
+    A single command list must only be recorded by one thread at a time,
+    but any number of command lists can be recorded in parallel.
+
     TRACE HOOKS:
     ============
     sokol_gfx.h optionally allows to install "trace hook" callbacks for
@@ -518,9 +872,45 @@
         - SG_VERTEXFORMAT_SHORT4N,
         - SG_VERTEXFORMAT_USHORT4N
 
-    TODO:
-    ====
-    - talk about asynchronous resource creation
+    ASYNCHRONOUS RESOURCE CREATION
+    ==============================
+    Resource creation can be split into an allocation and an initialization
+    step:
+
+        sg_buffer buf = sg_alloc_buffer();
+        ...
+        sg_init_buffer(buf, &desc);     // or sg_fail_buffer(buf)
+
+    The allocated resource id can be used for rendering right away, but
+    rendering operations which involve the resource will be silently
+    dropped until the resource has been initialized (the same is true for
+    resources in the FAILED state).
+
+    By default all sokol-gfx functions must be called from the same thread.
+    If you need to allocate resource ids on asset loader threads (for
+    instance to hand them out before the asset data has been loaded),
+    define SOKOL_THREADSAFE_ALLOC before including the sokol-gfx
+    implementation. This replaces the free-slot queue of the resource
+    pools with a lock-free stack, and makes the following functions
+    safe to call from any thread between sg_setup() and sg_shutdown():
+
+        sg_alloc_buffer()
+        sg_alloc_image()
+        sg_alloc_shader()
+        sg_alloc_pipeline()
+        sg_alloc_pass()
+
+    The sg_init_*(), sg_fail_*() and sg_destroy_*() functions (and all
+    other functions) still must be called on the thread which called
+    sg_setup(). Publishing an allocated resource id to the render thread
+    must happen through the application's own synchronization (e.g. a
+    mutex-protected message queue).
+
+    If SOKOL_TRACE_HOOKS is also defined, note that the alloc trace
+    callbacks will be called on the allocating thread.
+
+    With SOKOL_THREADSAFE_ALLOC the resource pools don't grow on demand,
+    so make sure that the pool sizes in sg_desc are big enough.
 
     zlib/libpng license
 
@@ -593,9 +983,25 @@ BEGIN_EXTERN_C
     'dangling accesses' (trying to use an object which no longer exists, and
     its pool slot has been reused for a new object)
 
+    The number of pool index bits can be changed by defining
+    SOKOL_POOL_SLOT_BITS (8..24) before including sokol_gfx.h, in all
+    places where sokol_gfx.h, sokol_gfx_imgui.h and sokol_gfx_trace.h
+    are included. More index bits allow bigger resource pools (up to
+    (1<<SOKOL_POOL_SLOT_BITS)-1 usable slots), but leave fewer bits
+    for the unique counter, so a stale resource id will look valid again
+    after fewer reuses of its pool slot (e.g. with 18 index bits after
+    16K instead of 64K reuses).
+
     The resource ids are wrapped into a struct so that the compiler
     can complain when the wrong resource type is used.
 */
+#ifndef SOKOL_POOL_SLOT_BITS
+#define SOKOL_POOL_SLOT_BITS (16)
+#endif
+#if (SOKOL_POOL_SLOT_BITS < 8) || (SOKOL_POOL_SLOT_BITS > 24)
+#error "SOKOL_POOL_SLOT_BITS must be between 8 and 24"
+#endif
+
 typedef struct sg_buffer   { uint32_t id; } sg_buffer;
 typedef struct sg_image    { uint32_t id; } sg_image;
 typedef struct sg_shader   { uint32_t id; } sg_shader;
@@ -620,7 +1026,10 @@ enum {
     SG_MAX_UB_MEMBERS = 16,
     SG_MAX_VERTEX_ATTRIBUTES = 16,      /* NOTE: actual max vertex attrs can be less on GLES2, see sg_limits! */
     SG_MAX_MIPMAPS = 16,
-    SG_MAX_TEXTUREARRAY_LAYERS = 128
+    SG_MAX_TEXTUREARRAY_LAYERS = 128,
+    SG_MAX_GPU_TIMINGS = 64,            /* max number of measured passes and debug groups per frame */
+    SG_GPU_TIMING_NAME_SIZE = 32,
+    SG_SOFT_MAX_VARYINGS = 16           /* max number of floats passed from vertex- to fragment-function (SOKOL_SOFT) */
 };
 
 /*
@@ -643,6 +1052,7 @@ typedef enum sg_backend {
     SG_BACKEND_METAL_MACOS,
     SG_BACKEND_METAL_SIMULATOR,
     SG_BACKEND_WGPU,
+    SG_BACKEND_SOFT,
     SG_BACKEND_DUMMY,
 } sg_backend;
 
@@ -796,6 +1206,11 @@ typedef struct sg_features {
     bool imagetype_3d;              /* creation of SG_IMAGETYPE_3D images is supported */
     bool imagetype_array;           /* creation of SG_IMAGETYPE_ARRAY images is supported */
     bool image_clamp_to_border;     /* border color and clamp-to-border UV-wrap mode is supported */
+    bool draw_indirect;             /* sg_draw_indirect() reads draw arguments on the GPU (otherwise emulated on the CPU) */
+    bool base_vertex;               /* sg_draw_ex() maps to a native base-vertex draw call (otherwise emulated with vertex buffer offsets) */
+    bool image_region_update;       /* sg_update_image_region() is supported */
+    bool read_pixels;               /* sg_read_pixels_async() is supported */
+    bool gpu_timings;               /* GPU timer queries for sg_query_gpu_timings() are supported */
 } sg_features;
 
 /*
@@ -859,6 +1274,13 @@ typedef enum sg_resource_state {
     CPU needs to wait for the GPU when attempting to update
     a resource that might be currently accessed by the GPU.
 
+    On desktop GL, when GL 4.4 or the ARB_buffer_storage extension is
+    available, SG_USAGE_STREAM buffers are created as persistently mapped
+    buffer objects, sg_update_buffer() and sg_append_buffer() then write
+    directly into mapped memory instead of calling glBufferSubData(). The
+    CPU waits on a fence only when it is about to overwrite a buffer slot
+    which is still used by a frame in flight.
+
     Resource content is updated with the function sg_update_buffer() for
     buffer objects, and sg_update_image() for image objects. Only
     one update is allowed per frame and resource object. The
@@ -881,8 +1303,9 @@ typedef enum sg_usage {
 /*
     sg_buffer_type
 
-    This indicates whether a buffer contains vertex- or index-data,
-    used in the sg_buffer_desc.type member when creating a buffer.
+    This indicates whether a buffer contains vertex-, index- or indirect
+    draw argument data, used in the sg_buffer_desc.type member when
+    creating a buffer.
 
     The default value is SG_BUFFERTYPE_VERTEXBUFFER.
 */
@@ -890,6 +1313,7 @@ typedef enum sg_buffer_type {
     _SG_BUFFERTYPE_DEFAULT,         /* value 0 reserved for default-init */
     SG_BUFFERTYPE_VERTEXBUFFER,
     SG_BUFFERTYPE_INDEXBUFFER,
+    SG_BUFFERTYPE_INDIRECTBUFFER,   /* draw arguments for sg_draw_indirect() */
     _SG_BUFFERTYPE_NUM,
     _SG_BUFFERTYPE_FORCE_U32 = 0x7FFFFFFF
 } sg_buffer_type;
@@ -1432,6 +1856,44 @@ typedef struct sg_bindings {
     uint32_t _end_canary;
 } sg_bindings;
 
+/*
+    sg_draw_args
+
+    The arguments of one draw call in sg_multi_draw(), same meaning
+    as the arguments of sg_draw().
+*/
+typedef struct sg_draw_args {
+    int base_element;
+    int num_elements;
+    int num_instances;
+} sg_draw_args;
+
+/*
+    sg_draw_indirect_args
+    sg_draw_indexed_indirect_args
+
+    The memory layout of draw arguments in SG_BUFFERTYPE_INDIRECTBUFFER
+    buffers for sg_draw_indirect(), for non-indexed and indexed
+    rendering. These match the draw argument layouts of the 3D-APIs
+    (e.g. DrawArraysIndirectCommand and DrawElementsIndirectCommand in GL).
+
+    The base_instance item is reserved and must be zero.
+*/
+typedef struct sg_draw_indirect_args {
+    uint32_t num_elements;
+    uint32_t num_instances;
+    uint32_t base_element;
+    uint32_t base_instance;
+} sg_draw_indirect_args;
+
+typedef struct sg_draw_indexed_indirect_args {
+    uint32_t num_elements;
+    uint32_t num_instances;
+    uint32_t base_element;
+    int32_t base_vertex;
+    uint32_t base_instance;
+} sg_draw_indexed_indirect_args;
+
 /*
     sg_buffer_desc
 
@@ -1500,8 +1962,9 @@ typedef struct sg_buffer_desc {
 
     For 3D- or array-textures, one sg_subimage_content item
     describes an entire mipmap level consisting of all array- or
-    3D-slices of the mipmap level. It is only possible to update
-    an entire mipmap level, not parts of it.
+    3D-slices of the mipmap level. sg_update_image() always updates
+    entire mipmap levels, use sg_update_image_region() to update
+    parts of a mipmap level.
 */
 typedef struct sg_subimage_content {
     const void* ptr;    /* pointer to subimage data */
@@ -1520,6 +1983,59 @@ typedef struct sg_image_content {
     sg_subimage_content subimage[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS];
 } sg_image_content;
 
+/*
+    sg_image_region
+
+    Describes the rectangular area of an image which is overwritten
+    by sg_update_image_region(). The slice is the cubemap face for
+    cubemaps, the array layer for array textures, and the depth
+    slice for 3D textures (and must be 0 for 2D textures).
+*/
+typedef struct sg_image_region {
+    int mip_level;
+    int slice;
+    int x;
+    int y;
+    int width;
+    int height;
+} sg_image_region;
+
+/*
+    sg_read_pixels_result
+
+    Passed to the callback of sg_read_pixels_async() when the pixel data
+    is available. The pointed-to data is tightly packed RGBA8 pixels with
+    the top row first, and is only valid until the callback returns.
+*/
+typedef struct sg_read_pixels_result {
+    sg_image image;     /* the source image (SG_INVALID_ID for the default framebuffer) */
+    int x, y, width, height;
+    const void* ptr;    /* width * height * 4 bytes of pixel data */
+    int size;
+    void* user_data;    /* from sg_read_pixels_desc.user_data */
+} sg_read_pixels_result;
+
+/*
+    sg_read_pixels_desc
+
+    Describes an asynchronous pixel readback with sg_read_pixels_async():
+
+    .image:     a 2D render target image with pixel format
+                SG_PIXELFORMAT_RGBA8, or SG_INVALID_ID (zero) to read
+                from the default framebuffer
+    .x, .y:     top-left corner of the rectangle to read
+    .width, .height: size of the rectangle to read
+    .callback:  called with the pixel data (must not be null)
+    .user_data: passed through to the callback in
+                sg_read_pixels_result.user_data
+*/
+typedef struct sg_read_pixels_desc {
+    sg_image image;
+    int x, y, width, height;
+    void (*callback)(const sg_read_pixels_result* result);
+    void* user_data;
+} sg_read_pixels_desc;
+
 /*
     sg_image_desc
 
@@ -1635,6 +2151,7 @@ typedef struct sg_image_desc {
                 - member name
                 - member type (SG_UNIFORMTYPE_xxx)
                 - if the member is an array, the number of array items
+            - the GLSL uniform block name (optional, only used on GL3.3 and GLES3)
         - reflection info for the texture images used by the shader stage:
             - the image type (SG_IMAGETYPE_xxx)
             - the sampler type (SG_SAMPLERTYPE_xxx, default is SG_SAMPLERTYPE_FLOAT)
@@ -1661,6 +2178,7 @@ typedef struct sg_shader_uniform_desc {
 typedef struct sg_shader_uniform_block_desc {
     int size;
     sg_shader_uniform_desc uniforms[SG_MAX_UB_MEMBERS];
+    const char* name;           /* GLSL uniform block name (optional, GL3.3 and GLES3 only) */
 } sg_shader_uniform_block_desc;
 
 typedef struct sg_shader_image_desc {
@@ -1669,6 +2187,68 @@ typedef struct sg_shader_image_desc {
     sg_sampler_type sampler_type;
 } sg_shader_image_desc;
 
+/*
+    sg_soft_texture, sg_soft_vs_input, sg_soft_vs_output, sg_soft_fs_input,
+    sg_soft_fs_output
+
+    The shader interface of the software backend (SOKOL_SOFT), a shader
+    is a pair of plain C functions provided in sg_shader_desc.soft_vs and
+    sg_shader_desc.soft_fs (search for SOFTWARE RENDERING for details).
+
+    The vertex function is called once per vertex with the vertex attributes
+    (converted to float4, missing components are (0,0,0,1)) and writes the
+    clip-space position and up to sg_shader_desc.soft_num_varyings floats
+    which are interpolated (perspective-correct) across the triangle.
+
+    The fragment function is called once per covered pixel with the
+    interpolated varyings and writes an RGBA color in the 0..1 range, or
+    sets the discard flag to leave the pixel untouched. Fragment functions
+    are called from several threads at once, so they must not write to
+    shared state.
+
+    Uniform block pointers point to a copy of the data from the last
+    sg_apply_uniforms() call of the shader stage, images can be sampled
+    with sg_soft_sample().
+*/
+typedef struct sg_soft_texture {
+    int width;
+    int height;
+    const uint8_t* pixels;      /* RGBA8 pixels (R8 images are expanded), first row is the top row */
+    sg_filter filter;
+    sg_wrap wrap_u;
+    sg_wrap wrap_v;
+    float border_color[4];
+} sg_soft_texture;
+
+typedef struct sg_soft_vs_input {
+    float attrs[SG_MAX_VERTEX_ATTRIBUTES][4];
+    const void* uniforms[SG_MAX_SHADERSTAGE_UBS];
+    const sg_soft_texture* images[SG_MAX_SHADERSTAGE_IMAGES];
+    int vertex_index;
+    int instance_index;
+} sg_soft_vs_input;
+
+typedef struct sg_soft_vs_output {
+    float pos[4];
+    float varyings[SG_SOFT_MAX_VARYINGS];
+} sg_soft_vs_output;
+
+typedef struct sg_soft_fs_input {
+    const float* varyings;
+    const void* uniforms[SG_MAX_SHADERSTAGE_UBS];
+    const sg_soft_texture* images[SG_MAX_SHADERSTAGE_IMAGES];
+    float frag_coord[4];        /* pixel center x/y, depth (0..1) and 1/w */
+    bool front_facing;
+} sg_soft_fs_input;
+
+typedef struct sg_soft_fs_output {
+    float color[4];
+    bool discard;
+} sg_soft_fs_output;
+
+typedef void (*sg_soft_vs_func)(const sg_soft_vs_input* in, sg_soft_vs_output* out);
+typedef void (*sg_soft_fs_func)(const sg_soft_fs_input* in, sg_soft_fs_output* out);
+
 typedef struct sg_shader_stage_desc {
     const char* source;
     const uint8_t* byte_code;
@@ -1684,6 +2264,10 @@ typedef struct sg_shader_desc {
     sg_shader_stage_desc vs;
     sg_shader_stage_desc fs;
     const char* label;
+    /* software backend specific */
+    sg_soft_vs_func soft_vs;
+    sg_soft_fs_func soft_fs;
+    int soft_num_varyings;
     uint32_t _end_canary;
 } sg_shader_desc;
 
@@ -1898,7 +2482,11 @@ typedef struct sg_trace_hooks {
     void (*destroy_pass)(sg_pass pass, void* user_data);
     void (*update_buffer)(sg_buffer buf, const void* data_ptr, int data_size, void* user_data);
     void (*update_image)(sg_image img, const sg_image_content* data, void* user_data);
+    void (*update_image_region)(sg_image img, const sg_image_region* region, const void* data_ptr, int data_size, void* user_data);
     void (*append_buffer)(sg_buffer buf, const void* data_ptr, int data_size, int result, void* user_data);
+    void (*map_buffer)(sg_buffer buf, int data_size, void* result, void* user_data);
+    void (*unmap_buffer)(sg_buffer buf, void* user_data);
+    void (*read_pixels_async)(const sg_read_pixels_desc* desc, bool result, void* user_data);
     void (*begin_default_pass)(const sg_pass_action* pass_action, int width, int height, void* user_data);
     void (*begin_pass)(sg_pass pass, const sg_pass_action* pass_action, void* user_data);
     void (*apply_viewport)(int x, int y, int width, int height, bool origin_top_left, void* user_data);
@@ -1907,6 +2495,9 @@ typedef struct sg_trace_hooks {
     void (*apply_bindings)(const sg_bindings* bindings, void* user_data);
     void (*apply_uniforms)(sg_shader_stage stage, int ub_index, const void* data, int num_bytes, void* user_data);
     void (*draw)(int base_element, int num_elements, int num_instances, void* user_data);
+    void (*draw_ex)(int base_element, int num_elements, int num_instances, int base_vertex, void* user_data);
+    void (*multi_draw)(const sg_draw_args* draws, int num_draws, void* user_data);
+    void (*draw_indirect)(sg_buffer buf, int offset, int num_draws, void* user_data);
     void (*end_pass)(void* user_data);
     void (*commit)(void* user_data);
     void (*alloc_buffer)(sg_buffer result, void* user_data);
@@ -1993,6 +2584,163 @@ typedef struct sg_pass_info {
     sg_slot_info slot;              /* resource pool slot info */
 } sg_pass_info;
 
+/*
+    sg_filter_stats
+
+    The number of redundant calls which have been filtered out since
+    sg_setup(), returned by sg_query_filter_stats().
+
+    A call is considered redundant if it would apply the same state which
+    has already been applied successfully in the current pass:
+
+    sg_apply_pipeline():        the same pipeline as the last call
+    sg_apply_bindings():        identical bindings with the same pipeline,
+                                and no buffer or image has been updated or
+                                destroyed in between
+    sg_apply_viewport():        the same rectangle as the last call
+    sg_apply_scissor_rect():    the same rectangle as the last call
+
+    Note that a filtered sg_apply_pipeline() still requires a following
+    sg_apply_bindings() (which will usually be filtered too).
+*/
+typedef struct sg_filter_stats {
+    uint32_t num_apply_pipeline;
+    uint32_t num_apply_bindings;
+    uint32_t num_apply_viewport;
+    uint32_t num_apply_scissor_rect;
+} sg_filter_stats;
+
+/*
+    sg_frame_stats
+
+    Per-frame counters returned by sg_query_frame_stats(). The counters
+    are collected between two calls to sg_commit(), and the returned
+    struct always describes the last complete frame.
+
+    The num_apply_* counters only count calls which have reached the
+    backend, redundant calls filtered out by sokol-gfx are not
+    included (see sg_filter_stats).
+
+    The num_rejected_* counters count calls which have been dropped
+    because the current pass isn't valid (pass_invalid), or because the
+    next draw call has been invalidated by a failed validation or a
+    resource in an invalid state (draw_invalid, this also includes
+    draw calls without valid resource bindings).
+*/
+typedef struct sg_frame_stats {
+    uint32_t frame_index;           /* frame index of the frame these stats belong to */
+    uint32_t num_passes;            /* number of successfully begun passes */
+    uint32_t num_apply_pipeline;
+    uint32_t num_apply_bindings;
+    uint32_t num_apply_uniforms;
+    uint32_t size_apply_uniforms;   /* number of uniform bytes */
+    uint32_t num_draw;
+    uint32_t num_elements;          /* sum of num_elements in all sg_draw() calls */
+    uint32_t num_instances;         /* sum of num_instances in all sg_draw() calls */
+    uint32_t num_update_buffer;
+    uint32_t size_update_buffer;    /* number of bytes in sg_update_buffer() */
+    uint32_t num_append_buffer;
+    uint32_t size_append_buffer;    /* number of bytes in sg_append_buffer() */
+    uint32_t num_update_image;
+    uint32_t size_update_image;     /* number of bytes in sg_update_image() */
+    uint32_t num_upload_image_fallback; /* GL: texture uploads which couldn't be staged in a pixel unpack buffer */
+    uint32_t num_rejected_pass_invalid;
+    uint32_t num_rejected_draw_invalid;
+} sg_frame_stats;
+
+/*
+    sg_gpu_timing
+
+    The measured GPU time of one render pass or debug group, part of
+    the sg_gpu_timings struct returned by sg_query_gpu_timings().
+
+    Passes are named "default pass" or "pass" (use the .pass handle to
+    tell offscreen passes apart), debug groups have the name passed to
+    sg_push_debug_group() (truncated to SG_GPU_TIMING_NAME_SIZE-1
+    characters). The depth is the number of enclosing passes and
+    debug groups.
+*/
+typedef struct sg_gpu_timing {
+    char name[SG_GPU_TIMING_NAME_SIZE];
+    bool is_pass;           /* true for passes, false for debug groups */
+    sg_pass pass;           /* the pass handle (SG_INVALID_ID for the default pass and debug groups) */
+    int depth;              /* nesting depth, 0 for top-level passes and debug groups */
+    uint64_t start_ns;      /* start time relative to the first measurement in the frame */
+    uint64_t duration_ns;   /* GPU time between begin and end in nanoseconds */
+} sg_gpu_timing;
+
+/*
+    sg_gpu_timings
+
+    Returned by sg_query_gpu_timings(), the GPU timings of all passes and
+    debug groups of one frame in the order they were started (up to
+    SG_MAX_GPU_TIMINGS items, any additional passes or debug groups in a
+    frame aren't measured). The frame_index is zero if no timings are
+    available yet.
+*/
+typedef struct sg_gpu_timings {
+    uint32_t frame_index;   /* frame index of the frame these timings belong to */
+    int num_timings;
+    sg_gpu_timing timings[SG_MAX_GPU_TIMINGS];
+} sg_gpu_timings;
+
+/*
+    sg_dummy_stats
+
+    The state transition counters of the dummy backend, returned by
+    sg_query_dummy_stats(). The counters are accumulated since sg_setup()
+    or the last call to sg_reset_dummy_stats().
+
+    The dummy backend tracks the current render target, pipeline and
+    resource bindings like a real backend, and only counts actual changes
+    (for instance, binding the same image to the same slot again isn't
+    counted as texture bind, while an image which has been updated since
+    it was bound is). All tracked state is reset at the start of a pass.
+*/
+typedef struct sg_dummy_stats {
+    uint32_t num_passes;
+    uint32_t num_render_target_switches;    /* passes with different attachments than the previous pass */
+    uint32_t num_clears;                    /* number of cleared attachments */
+    uint32_t num_pipeline_switches;
+    uint32_t num_shader_switches;
+    uint32_t num_render_state_changes;      /* changed depth-stencil, blend or rasterizer state */
+    uint32_t num_viewport_changes;
+    uint32_t num_scissor_changes;
+    uint32_t num_vertex_buffer_binds;
+    uint32_t num_index_buffer_binds;
+    uint32_t num_texture_binds;
+    uint32_t num_uniform_updates;
+    uint32_t size_uniform_updates;          /* number of uniform bytes */
+    uint32_t num_draws;                     /* including each draw of sg_multi_draw() */
+    uint32_t num_elements;
+    uint32_t num_instances;
+    uint32_t num_buffer_uploads;
+    uint32_t size_buffer_uploads;           /* bytes in buffer updates, appends, unmaps and immutable buffer content */
+    uint32_t num_image_uploads;
+    uint32_t size_image_uploads;            /* bytes in image updates, image region updates and immutable image content */
+    bool log_overflow;                      /* true if the command log didn't fit into sg_desc.dummy_log_size */
+} sg_dummy_stats;
+
+/*
+    sg_commands
+
+    A command list which records rendering commands into caller-provided
+    memory, see the section RECORDING COMMAND LISTS at the top
+    of this file for details.
+
+    Treat the struct members as read-only, they are only modified
+    by the sg_begin_commands(), sg_cmd_*() and sg_end_commands()
+    functions.
+*/
+typedef struct sg_commands {
+    uint8_t* ptr;           /* start of the command list memory */
+    int size;               /* size of the command list memory in bytes */
+    int pos;                /* number of bytes recorded so far */
+    int num_cmds;           /* number of commands recorded so far */
+    bool recording;         /* true between sg_begin_commands() and sg_end_commands() */
+    bool overflow;          /* true if the command list memory was too small */
+} sg_commands;
+
 /*
     sg_desc
 
@@ -2012,6 +2760,42 @@ typedef struct sg_pass_info {
     .sampler_cache_size     64
     .uniform_buffer_size    4 MB (4*1024*1024)
     .staging_buffer_size    8 MB (8*1024*1024)
+    .pipeline_dedup_enabled false
+    .gpu_timings_enabled    false
+    .soft_num_threads       4
+    .dummy_log_size         0
+
+    The resource pool sizes are the initial number of resource slots, when
+    a pool is exhausted it doubles its size (up to 65535 usable slots, or
+    (1<<SOKOL_POOL_SLOT_BITS)-1 if SOKOL_POOL_SLOT_BITS is defined),
+    existing resource handles remain valid when a pool grows. Resource
+    pools don't grow when SOKOL_THREADSAFE_ALLOC is defined.
+
+    .pipeline_dedup_enabled: if true, sg_make_pipeline() will return an
+    existing pipeline object if a pipeline with an identical desc (after
+    default values have been filled in, ignoring the label) has been
+    created before and is still alive. Shared pipelines are reference
+    counted: each sg_make_pipeline() call returning a shared pipeline
+    must be balanced by a call to sg_destroy_pipeline(), and the pipeline
+    is only destroyed when the last reference is gone. Pipelines created
+    through sg_alloc_pipeline() and sg_init_pipeline() are never shared.
+    The make_pipeline and destroy_pipeline trace hooks only fire when a
+    pipeline object is actually created or destroyed, not when a shared
+    pipeline is returned or one of its references is released.
+
+    .gpu_timings_enabled: if true, and the backend supports GPU timer
+    queries (sg_features.gpu_timings), the GPU time of each render pass
+    and debug group is measured and can be queried with
+    sg_query_gpu_timings() (currently only on desktop GL).
+
+    .soft_num_threads: the number of threads which rasterize tiles on the
+    software backend (SOKOL_SOFT), including the calling thread, so a
+    value of 1 doesn't start any worker threads.
+
+    .dummy_log_size: the size in bytes of the command log which is written
+    by the dummy backend (SOKOL_DUMMY_BACKEND) and returned by
+    sg_query_dummy_log(). The default of zero disables the log, all other
+    backends ignore this value.
 
     .context.color_format: default value depends on selected backend:
         all GL backends:    SG_PIXELFORMAT_RGBA8
@@ -2021,10 +2805,47 @@ typedef struct sg_pass_info {
     .context.sample_count   1
 
     GL specific:
+        .uniform_buffer_size
+            on GL3.3 and GLES3, the size of the per-frame uniform buffer
+            objects for uniform blocks which have been declared with a GLSL
+            uniform block name (see sg_shader_uniform_block_desc.name), the
+            uniform buffers are only created when the first such shader
+            is created
+        .staging_buffer_size
+            on GL3.3 and GLES3 (but not WebGL2), the initial size of the
+            per-frame pixel unpack buffers which texture data is copied into
+            in sg_make_image() and sg_update_image(), the texture upload then
+            happens asynchronously on the GPU, the buffers grow when a frame's
+            image content doesn't fit, if staging fails anyway (e.g. out of
+            memory), the content is uploaded directly from client memory and
+            counted in sg_frame_stats.num_upload_image_fallback
         .context.gl.force_gles2
             if this is true the GL backend will act in "GLES2 fallback mode" even
             when compiled with SOKOL_GLES3, this is useful to fall back
             to traditional WebGL if a browser doesn't support a WebGL2 context
+        .context.gl.program_cache_load_cb
+        .context.gl.program_cache_store_cb
+        .context.gl.program_cache_user_data
+            optional callbacks for a persistent GL program binary cache
+            (only on GL3.3 and GLES3, and only if the GL implementation
+            supports at least one program binary format):
+
+            const void* load_cb(uint64_t key, int* out_num_bytes, void* user_data)
+                called in sg_make_shader() before compiling the shader
+                sources, return a pointer to the data which has been
+                stored under 'key' and write its size to 'out_num_bytes',
+                or return a null pointer if no data is stored under 'key',
+                the data must remain valid until the call to
+                sg_make_shader() returns
+            void store_cb(uint64_t key, const void* data, int num_bytes, void* user_data)
+                called in sg_make_shader() after a program has been
+                compiled and linked from source, the data must be copied
+
+            The key is a hash over the shader sources, attribute, uniform
+            and image names, and the GL vendor, renderer and version
+            strings. If the stored data can't be used (for instance after
+            a driver update), sokol-gfx silently falls back to compiling
+            the shader from source and calls the store callback again.
 
     Metal specific:
         (NOTE: All Objective-C object references are transferred through
@@ -2085,6 +2906,9 @@ typedef struct sg_pass_info {
 */
 typedef struct sg_gl_context_desc {
     bool force_gles2;
+    const void* (*program_cache_load_cb)(uint64_t key, int* out_num_bytes, void* user_data);
+    void (*program_cache_store_cb)(uint64_t key, const void* data, int num_bytes, void* user_data);
+    void* program_cache_user_data;
 } sg_gl_context_desc;
 
 typedef struct sg_mtl_context_desc {
@@ -2128,6 +2952,10 @@ typedef struct sg_desc {
     int uniform_buffer_size;
     int staging_buffer_size;
     int sampler_cache_size;
+    bool pipeline_dedup_enabled;
+    bool gpu_timings_enabled;
+    int soft_num_threads;
+    int dummy_log_size;
     sg_context_desc context;
     uint32_t _end_canary;
 } sg_desc;
@@ -2154,8 +2982,12 @@ SOKOL_API_DECL void sg_destroy_pipeline(sg_pipeline pip);
 SOKOL_API_DECL void sg_destroy_pass(sg_pass pass);
 SOKOL_API_DECL void sg_update_buffer(sg_buffer buf, const void* data_ptr, int data_size);
 SOKOL_API_DECL void sg_update_image(sg_image img, const sg_image_content* data);
+SOKOL_API_DECL void sg_update_image_region(sg_image img, const sg_image_region* region, const void* data_ptr, int data_size);
 SOKOL_API_DECL int sg_append_buffer(sg_buffer buf, const void* data_ptr, int data_size);
 SOKOL_API_DECL bool sg_query_buffer_overflow(sg_buffer buf);
+SOKOL_API_DECL void* sg_map_buffer(sg_buffer buf, int data_size);
+SOKOL_API_DECL void sg_unmap_buffer(sg_buffer buf);
+SOKOL_API_DECL bool sg_read_pixels_async(const sg_read_pixels_desc* desc);
 
 /* rendering functions */
 SOKOL_API_DECL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height);
@@ -2166,15 +2998,35 @@ SOKOL_API_DECL void sg_apply_pipeline(sg_pipeline pip);
 SOKOL_API_DECL void sg_apply_bindings(const sg_bindings* bindings);
 SOKOL_API_DECL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const void* data, int num_bytes);
 SOKOL_API_DECL void sg_draw(int base_element, int num_elements, int num_instances);
+SOKOL_API_DECL void sg_draw_ex(int base_element, int num_elements, int num_instances, int base_vertex);
+SOKOL_API_DECL void sg_multi_draw(const sg_draw_args* draws, int num_draws);
+SOKOL_API_DECL void sg_draw_indirect(sg_buffer buf, int offset, int num_draws);
 SOKOL_API_DECL void sg_end_pass(void);
 SOKOL_API_DECL void sg_commit(void);
 
+/* recording and submitting command lists (recording is thread-safe) */
+SOKOL_API_DECL void sg_begin_commands(sg_commands* cmds, void* ptr, int size);
+SOKOL_API_DECL void sg_cmd_apply_viewport(sg_commands* cmds, int x, int y, int width, int height, bool origin_top_left);
+SOKOL_API_DECL void sg_cmd_apply_scissor_rect(sg_commands* cmds, int x, int y, int width, int height, bool origin_top_left);
+SOKOL_API_DECL void sg_cmd_apply_pipeline(sg_commands* cmds, sg_pipeline pip);
+SOKOL_API_DECL void sg_cmd_apply_bindings(sg_commands* cmds, const sg_bindings* bindings);
+SOKOL_API_DECL void sg_cmd_apply_uniforms(sg_commands* cmds, sg_shader_stage stage, int ub_index, const void* data, int num_bytes);
+SOKOL_API_DECL void sg_cmd_draw(sg_commands* cmds, int base_element, int num_elements, int num_instances);
+SOKOL_API_DECL bool sg_end_commands(sg_commands* cmds);
+SOKOL_API_DECL void sg_submit_commands(const sg_commands* cmds);
+
 /* getting information */
 SOKOL_API_DECL sg_desc sg_query_desc(void);
 SOKOL_API_DECL sg_backend sg_query_backend(void);
 SOKOL_API_DECL sg_features sg_query_features(void);
 SOKOL_API_DECL sg_limits sg_query_limits(void);
 SOKOL_API_DECL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt);
+SOKOL_API_DECL sg_filter_stats sg_query_filter_stats(void);
+SOKOL_API_DECL sg_frame_stats sg_query_frame_stats(void);
+SOKOL_API_DECL sg_gpu_timings sg_query_gpu_timings(void);
+SOKOL_API_DECL sg_dummy_stats sg_query_dummy_stats(void);
+SOKOL_API_DECL const char* sg_query_dummy_log(void);
+SOKOL_API_DECL void sg_reset_dummy_stats(void);
 /* get current state of a resource (INITIAL, ALLOC, VALID, FAILED, INVALID) */
 SOKOL_API_DECL sg_resource_state sg_query_buffer_state(sg_buffer buf);
 SOKOL_API_DECL sg_resource_state sg_query_image_state(sg_image img);
@@ -2216,6 +3068,9 @@ SOKOL_API_DECL sg_context sg_setup_context(void);
 SOKOL_API_DECL void sg_activate_context(sg_context ctx_id);
 SOKOL_API_DECL void sg_discard_context(sg_context ctx_id);
 
+/* software backend: sample an image from a shader function */
+SOKOL_API_DECL void sg_soft_sample(const sg_soft_texture* tex, float u, float v, float* out_rgba);
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -2235,8 +3090,8 @@ END_EXTERN_C
 #ifdef SOKOL_IMPL
 #define SOKOL_GFX_IMPL_INCLUDED (1)
 
-#if !(defined(SOKOL_GLCORE33)||defined(SOKOL_GLES2)||defined(SOKOL_GLES3)||defined(SOKOL_D3D11)||defined(SOKOL_METAL)||defined(SOKOL_WGPU)||defined(SOKOL_DUMMY_BACKEND))
-#error "Please select a backend with SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU or SOKOL_DUMMY_BACKEND"
+#if !(defined(SOKOL_GLCORE33)||defined(SOKOL_GLES2)||defined(SOKOL_GLES3)||defined(SOKOL_D3D11)||defined(SOKOL_METAL)||defined(SOKOL_WGPU)||defined(SOKOL_SOFT)||defined(SOKOL_DUMMY_BACKEND))
+#error "Please select a backend with SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU, SOKOL_SOFT or SOKOL_DUMMY_BACKEND"
 #endif
 #include <string.h> /* memset */
 #include <float.h> /* FLT_MAX */
@@ -2303,6 +3158,11 @@ END_EXTERN_C
 #define _SG_TRACE_NOARGS(fn)
 #endif
 
+#if defined(SOKOL_THREADSAFE_ALLOC) && defined(_MSC_VER)
+    #include <intrin.h>
+    #pragma intrinsic(_InterlockedCompareExchange64)
+#endif
+
 /* default clear values */
 #ifndef SG_DEFAULT_CLEAR_RED
 #define SG_DEFAULT_CLEAR_RED (0.5f)
@@ -2438,6 +3298,34 @@ END_EXTERN_C
     #else
     #   define SOKOL_INSTANCING_ENABLED
     #endif
+    /* program binaries are core in GLES3 and GL4.1, or ARB_get_program_binary */
+    #if !defined(SOKOL_GLES2) && defined(GL_PROGRAM_BINARY_LENGTH)
+    #   define _SOKOL_GL_PROGRAM_BINARY (1)
+    #endif
+    /* persistently mapped buffers are core in GL4.4, or ARB_buffer_storage */
+    #if defined(SOKOL_GLCORE33) && defined(GL_MAP_PERSISTENT_BIT)
+    #   define _SOKOL_GL_BUFFER_STORAGE (1)
+    #endif
+    /* indirect draws are core in GL4.0, or ARB_draw_indirect */
+    #if defined(SOKOL_GLCORE33) && defined(GL_DRAW_INDIRECT_BUFFER)
+    #   define _SOKOL_GL_DRAW_INDIRECT (1)
+    #endif
+    /* multi-draw indirect is core in GL4.3, or ARB_multi_draw_indirect, GL4.0 headers don't declare it */
+    #if defined(_SOKOL_GL_DRAW_INDIRECT) && (defined(GL_VERSION_4_3) || defined(GL_ARB_multi_draw_indirect))
+    #   define _SOKOL_GL_MULTI_DRAW_INDIRECT (1)
+    #endif
+    /* uniform buffer objects are core in GL3.3 and GLES3 */
+    #if !defined(SOKOL_GLES2)
+    #   define _SOKOL_GL_UBO (1)
+    #endif
+    /* timestamp queries are core in GL3.3 (GLES3 only has EXT_disjoint_timer_query) */
+    #if defined(SOKOL_GLCORE33) && defined(GL_TIMESTAMP)
+    #   define _SOKOL_GL_TIMER_QUERY (1)
+    #endif
+    /* pixel unpack buffers are core in GL3.3 and GLES3 (but WebGL2 has no glMapBufferRange()) */
+    #if !defined(SOKOL_GLES2) && !defined(__EMSCRIPTEN__)
+    #   define _SOKOL_GL_PBO (1)
+    #endif
     #define _SG_GL_CHECK_ERROR() { SOKOL_ASSERT(glGetError() == GL_NO_ERROR); }
 
 #elif defined(SOKOL_D3D11)
@@ -2475,6 +3363,21 @@ END_EXTERN_C
     #else
         #include <dawn/webgpu.h>
     #endif
+#elif defined(SOKOL_SOFT)
+    #if defined(_WIN32)
+        #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+        #endif
+        #include <windows.h>
+    #else
+        #include <pthread.h>
+    #endif
+    #include <math.h>   /* floor, ceil */
+    /* the coverage test evaluates 4 pixels at once with SSE2, otherwise falls back to scalar code */
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #include <emmintrin.h>
+        #define _SOKOL_SOFT_SSE2 (1)
+    #endif
 #endif
 
 #if defined(__APPLE__)
@@ -2501,9 +3404,11 @@ typedef struct {
 /* constants */
 enum {
     _SG_STRING_SIZE = 16,
-    _SG_SLOT_SHIFT = 16,
+    _SG_SLOT_SHIFT = SOKOL_POOL_SLOT_BITS,
     _SG_SLOT_MASK = (1<<_SG_SLOT_SHIFT)-1,
     _SG_MAX_POOL_SIZE = (1<<_SG_SLOT_SHIFT),
+    _SG_MAX_POOL_CHUNKS = _SG_SLOT_SHIFT,
+    _SG_CACHE_LINE_SIZE = 64,
     _SG_DEFAULT_BUFFER_POOL_SIZE = 128,
     _SG_DEFAULT_IMAGE_POOL_SIZE = 128,
     _SG_DEFAULT_SHADER_POOL_SIZE = 32,
@@ -2513,6 +3418,7 @@ enum {
     _SG_DEFAULT_SAMPLER_CACHE_CAPACITY = 64,
     _SG_DEFAULT_UB_SIZE = 4 * 1024 * 1024,
     _SG_DEFAULT_STAGING_SIZE = 8 * 1024 * 1024,
+    _SG_DEFAULT_SOFT_NUM_THREADS = 4,
 };
 
 /* fixed-size string */
@@ -2528,16 +3434,25 @@ typedef struct {
 #define _sg_clamp(v,v0,v1) ((v<v0)?(v0):((v>v1)?(v1):(v)))
 #define _sg_fequal(val,cmp,delta) (((val-cmp)> -delta)&&((val-cmp)<delta))
 
+/* the resource structs start with the items which are accessed most
+   often, followed by the items which are only needed for resource
+   updates and queries, the data which sg_apply_bindings() needs is
+   also copied into the buffer and image pool's hot arrays (see
+   _sg_buffer_hot_t and _sg_image_hot_t)
+*/
 typedef struct {
-    int size;
-    int append_pos;
+    int active_slot;
+    int num_slots;
     bool append_overflow;
     sg_buffer_type type;
+    int size;
+    int append_pos;
     sg_usage usage;
     uint32_t update_frame_index;
     uint32_t append_frame_index;
-    int num_slots;
-    int active_slot;
+    int map_size;
+    void* map_ptr;                  /* non-null while mapped */
+    void* shadow_ptr;               /* CPU-side copy for sg_map_buffer(), allocated on demand */
 } _sg_buffer_common_t;
 
 _SOKOL_PRIVATE void _sg_buffer_common_init(_sg_buffer_common_t* cmn, const sg_buffer_desc* desc) {
@@ -2550,9 +3465,22 @@ _SOKOL_PRIVATE void _sg_buffer_common_init(_sg_buffer_common_t* cmn, const sg_bu
     cmn->append_frame_index = 0;
     cmn->num_slots = (cmn->usage == SG_USAGE_IMMUTABLE) ? 1 : SG_NUM_INFLIGHT_FRAMES;
     cmn->active_slot = 0;
+    cmn->map_size = 0;
+    cmn->map_ptr = 0;
+    cmn->shadow_ptr = 0;
+}
+
+_SOKOL_PRIVATE void _sg_buffer_common_discard(_sg_buffer_common_t* cmn) {
+    if (cmn->shadow_ptr) {
+        SOKOL_FREE(cmn->shadow_ptr);
+        cmn->shadow_ptr = 0;
+    }
+    cmn->map_ptr = 0;
 }
 
 typedef struct {
+    int active_slot;
+    int num_slots;
     sg_image_type type;
     bool render_target;
     int width;
@@ -2570,8 +3498,6 @@ typedef struct {
     sg_border_color border_color;
     uint32_t max_anisotropy;
     uint32_t upd_frame_index;
-    int num_slots;
-    int active_slot;
 } _sg_image_common_t;
 
 _SOKOL_PRIVATE void _sg_image_common_init(_sg_image_common_t* cmn, const sg_image_desc* desc) {
@@ -2713,6 +3639,13 @@ _SOKOL_PRIVATE void _sg_pass_common_init(_sg_pass_common_t* cmn, const sg_pass_d
 /*
     this is used by the Metal and WGPU backends to reduce the
     number of sampler state objects created through the backend API
+
+    Items are found through an open-addressing hash table (linear probing).
+    Each item has a reference count (one reference per image using the
+    sampler), and unreferenced items are kept in an LRU list. When the
+    cache is full, the least recently used unreferenced item is evicted
+    and its sampler object is destroyed through a backend callback. If
+    all items are referenced, the cache grows instead.
 */
 typedef struct {
     sg_filter min_filter;
@@ -2724,30 +3657,68 @@ typedef struct {
     uint32_t max_anisotropy;
     int min_lod;    /* orig min/max_lod is float, this is int(min/max_lod*1000.0) */
     int max_lod;
+    uint32_t hash;
     uintptr_t sampler_handle;
+    int ref_count;
+    int lru_prev;   /* links in the list of unreferenced items, -1 if none */
+    int lru_next;
 } _sg_sampler_cache_item_t;
 
+typedef void (*_sg_sampler_cache_destroy_t)(uintptr_t sampler_handle);
+
 typedef struct {
     int capacity;
     int num_items;
     _sg_sampler_cache_item_t* items;
+    int table_size;     /* number of hash table buckets, power of 2 */
+    int* table;         /* item index per bucket, or -1 if empty */
+    int lru_head;       /* least recently released unreferenced item, or -1 */
+    int lru_tail;       /* most recently released unreferenced item, or -1 */
+    _sg_sampler_cache_destroy_t destroy_cb;
 } _sg_sampler_cache_t;
 
-_SOKOL_PRIVATE void _sg_smpcache_init(_sg_sampler_cache_t* cache, int capacity) {
-    SOKOL_ASSERT(cache && (capacity > 0));
-    memset(cache, 0, sizeof(_sg_sampler_cache_t));
+_SOKOL_PRIVATE void _sg_smpcache_alloc(_sg_sampler_cache_t* cache, int capacity) {
     cache->capacity = capacity;
-    const int size = cache->capacity * sizeof(_sg_sampler_cache_item_t);
-    cache->items = (_sg_sampler_cache_item_t*) SOKOL_MALLOC(size);
-    memset(cache->items, 0, size);
+    const int items_size = cache->capacity * (int)sizeof(_sg_sampler_cache_item_t);
+    cache->items = (_sg_sampler_cache_item_t*) SOKOL_MALLOC(items_size);
+    SOKOL_ASSERT(cache->items);
+    memset(cache->items, 0, items_size);
+    /* keep the hash table at most half full */
+    cache->table_size = 1;
+    while (cache->table_size < (2 * capacity)) {
+        cache->table_size <<= 1;
+    }
+    const int table_size = cache->table_size * (int)sizeof(int);
+    cache->table = (int*) SOKOL_MALLOC(table_size);
+    SOKOL_ASSERT(cache->table);
+    memset(cache->table, 0xFF, table_size);
+}
+
+_SOKOL_PRIVATE void _sg_smpcache_init(_sg_sampler_cache_t* cache, int capacity, _sg_sampler_cache_destroy_t destroy_cb) {
+    SOKOL_ASSERT(cache && (capacity > 0) && destroy_cb);
+    memset(cache, 0, sizeof(_sg_sampler_cache_t));
+    _sg_smpcache_alloc(cache, capacity);
+    cache->lru_head = -1;
+    cache->lru_tail = -1;
+    cache->destroy_cb = destroy_cb;
 }
 
+/* destroy all cached sampler objects and free the cache */
 _SOKOL_PRIVATE void _sg_smpcache_discard(_sg_sampler_cache_t* cache) {
-    SOKOL_ASSERT(cache && cache->items);
+    SOKOL_ASSERT(cache && cache->items && cache->table);
+    SOKOL_ASSERT(cache->num_items <= cache->capacity);
+    for (int i = 0; i < cache->num_items; i++) {
+        cache->destroy_cb(cache->items[i].sampler_handle);
+    }
     SOKOL_FREE(cache->items);
     cache->items = 0;
+    SOKOL_FREE(cache->table);
+    cache->table = 0;
     cache->num_items = 0;
     cache->capacity = 0;
+    cache->table_size = 0;
+    cache->lru_head = -1;
+    cache->lru_tail = -1;
 }
 
 _SOKOL_PRIVATE int _sg_smpcache_minlod_int(float min_lod) {
@@ -2758,47 +3729,201 @@ _SOKOL_PRIVATE int _sg_smpcache_maxlod_int(float max_lod) {
     return (int) (_sg_clamp(max_lod, 0.0f, 1000.0f) * 1000.0f);
 }
 
+/* initialize the key part of a cache item from an image desc */
+_SOKOL_PRIVATE void _sg_smpcache_init_key(_sg_sampler_cache_item_t* key, const sg_image_desc* img_desc) {
+    memset(key, 0, sizeof(_sg_sampler_cache_item_t));
+    key->min_filter = img_desc->min_filter;
+    key->mag_filter = img_desc->mag_filter;
+    key->wrap_u = img_desc->wrap_u;
+    key->wrap_v = img_desc->wrap_v;
+    key->wrap_w = img_desc->wrap_w;
+    key->border_color = img_desc->border_color;
+    key->max_anisotropy = img_desc->max_anisotropy;
+    key->min_lod = _sg_smpcache_minlod_int(img_desc->min_lod);
+    key->max_lod = _sg_smpcache_maxlod_int(img_desc->max_lod);
+    /* FNV-1a over the key values */
+    const uint32_t vals[9] = {
+        (uint32_t) key->min_filter,
+        (uint32_t) key->mag_filter,
+        (uint32_t) key->wrap_u,
+        (uint32_t) key->wrap_v,
+        (uint32_t) key->wrap_w,
+        (uint32_t) key->border_color,
+        key->max_anisotropy,
+        (uint32_t) key->min_lod,
+        (uint32_t) key->max_lod
+    };
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < 9; i++) {
+        hash = (hash ^ vals[i]) * 16777619u;
+    }
+    key->hash = hash;
+}
+
+_SOKOL_PRIVATE bool _sg_smpcache_key_equal(const _sg_sampler_cache_item_t* a, const _sg_sampler_cache_item_t* b) {
+    return (a->hash == b->hash) &&
+           (a->min_filter == b->min_filter) &&
+           (a->mag_filter == b->mag_filter) &&
+           (a->wrap_u == b->wrap_u) &&
+           (a->wrap_v == b->wrap_v) &&
+           (a->wrap_w == b->wrap_w) &&
+           (a->max_anisotropy == b->max_anisotropy) &&
+           (a->border_color == b->border_color) &&
+           (a->min_lod == b->min_lod) &&
+           (a->max_lod == b->max_lod);
+}
+
+_SOKOL_PRIVATE void _sg_smpcache_table_insert(_sg_sampler_cache_t* cache, int item_index) {
+    const int mask = cache->table_size - 1;
+    int bucket = (int)(cache->items[item_index].hash & (uint32_t)mask);
+    while (cache->table[bucket] != -1) {
+        bucket = (bucket + 1) & mask;
+    }
+    cache->table[bucket] = item_index;
+}
+
+_SOKOL_PRIVATE void _sg_smpcache_table_remove(_sg_sampler_cache_t* cache, int item_index) {
+    const int mask = cache->table_size - 1;
+    int bucket = (int)(cache->items[item_index].hash & (uint32_t)mask);
+    while (cache->table[bucket] != item_index) {
+        SOKOL_ASSERT(cache->table[bucket] != -1);
+        bucket = (bucket + 1) & mask;
+    }
+    /* backward-shift following entries so that lookups need no tombstones */
+    int next = bucket;
+    for (;;) {
+        next = (next + 1) & mask;
+        if (cache->table[next] == -1) {
+            break;
+        }
+        const int home = (int)(cache->items[cache->table[next]].hash & (uint32_t)mask);
+        /* can the entry at 'next' be moved into the hole at 'bucket'? */
+        const bool move = (bucket <= next) ?
+            ((home <= bucket) || (home > next)) :
+            ((home <= bucket) && (home > next));
+        if (move) {
+            cache->table[bucket] = cache->table[next];
+            bucket = next;
+        }
+    }
+    cache->table[bucket] = -1;
+}
+
+_SOKOL_PRIVATE void _sg_smpcache_lru_unlink(_sg_sampler_cache_t* cache, int item_index) {
+    _sg_sampler_cache_item_t* item = &cache->items[item_index];
+    if (item->lru_prev != -1) {
+        cache->items[item->lru_prev].lru_next = item->lru_next;
+    }
+    else {
+        cache->lru_head = item->lru_next;
+    }
+    if (item->lru_next != -1) {
+        cache->items[item->lru_next].lru_prev = item->lru_prev;
+    }
+    else {
+        cache->lru_tail = item->lru_prev;
+    }
+    item->lru_prev = item->lru_next = -1;
+}
+
+_SOKOL_PRIVATE void _sg_smpcache_lru_append(_sg_sampler_cache_t* cache, int item_index) {
+    _sg_sampler_cache_item_t* item = &cache->items[item_index];
+    item->lru_prev = cache->lru_tail;
+    item->lru_next = -1;
+    if (cache->lru_tail != -1) {
+        cache->items[cache->lru_tail].lru_next = item_index;
+    }
+    else {
+        cache->lru_head = item_index;
+    }
+    cache->lru_tail = item_index;
+}
+
+/* double the capacity, items keep their index */
+_SOKOL_PRIVATE void _sg_smpcache_grow(_sg_sampler_cache_t* cache) {
+    _sg_sampler_cache_item_t* old_items = cache->items;
+    SOKOL_FREE(cache->table);
+    _sg_smpcache_alloc(cache, cache->capacity * 2);
+    memcpy(cache->items, old_items, cache->num_items * sizeof(_sg_sampler_cache_item_t));
+    SOKOL_FREE(old_items);
+    for (int i = 0; i < cache->num_items; i++) {
+        _sg_smpcache_table_insert(cache, i);
+    }
+}
+
 _SOKOL_PRIVATE int _sg_smpcache_find_item(const _sg_sampler_cache_t* cache, const sg_image_desc* img_desc) {
     /* return matching sampler cache item index or -1 */
-    SOKOL_ASSERT(cache && cache->items);
+    SOKOL_ASSERT(cache && cache->items && cache->table);
     SOKOL_ASSERT(img_desc);
-    const int min_lod = _sg_smpcache_minlod_int(img_desc->min_lod);
-    const int max_lod = _sg_smpcache_maxlod_int(img_desc->max_lod);
-    for (int i = 0; i < cache->num_items; i++) {
-        const _sg_sampler_cache_item_t* item = &cache->items[i];
-        if ((img_desc->min_filter == item->min_filter) &&
-            (img_desc->mag_filter == item->mag_filter) &&
-            (img_desc->wrap_u == item->wrap_u) &&
-            (img_desc->wrap_v == item->wrap_v) &&
-            (img_desc->wrap_w == item->wrap_w) &&
-            (img_desc->max_anisotropy == item->max_anisotropy) &&
-            (img_desc->border_color == item->border_color) &&
-            (min_lod == item->min_lod) &&
-            (max_lod == item->max_lod))
-        {
-            return i;
+    _sg_sampler_cache_item_t key;
+    _sg_smpcache_init_key(&key, img_desc);
+    const int mask = cache->table_size - 1;
+    int bucket = (int)(key.hash & (uint32_t)mask);
+    while (cache->table[bucket] != -1) {
+        const int item_index = cache->table[bucket];
+        if (_sg_smpcache_key_equal(&key, &cache->items[item_index])) {
+            return item_index;
         }
+        bucket = (bucket + 1) & mask;
     }
     /* fallthrough: no matching cache item found */
     return -1;
 }
 
-_SOKOL_PRIVATE void _sg_smpcache_add_item(_sg_sampler_cache_t* cache, const sg_image_desc* img_desc, uintptr_t sampler_handle) {
-    SOKOL_ASSERT(cache && cache->items);
+/* add a new unreferenced item, evicts or grows if the cache is full, returns item index */
+_SOKOL_PRIVATE int _sg_smpcache_add_item(_sg_sampler_cache_t* cache, const sg_image_desc* img_desc, uintptr_t sampler_handle) {
+    SOKOL_ASSERT(cache && cache->items && cache->table);
     SOKOL_ASSERT(img_desc);
-    SOKOL_ASSERT(cache->num_items < cache->capacity);
-    const int item_index = cache->num_items++;
+    int item_index;
+    if (cache->num_items < cache->capacity) {
+        item_index = cache->num_items++;
+    }
+    else if (cache->lru_head != -1) {
+        /* evict the least recently used unreferenced item */
+        item_index = cache->lru_head;
+        SOKOL_ASSERT(0 == cache->items[item_index].ref_count);
+        _sg_smpcache_lru_unlink(cache, item_index);
+        _sg_smpcache_table_remove(cache, item_index);
+        cache->destroy_cb(cache->items[item_index].sampler_handle);
+    }
+    else {
+        /* all items are in use */
+        _sg_smpcache_grow(cache);
+        item_index = cache->num_items++;
+    }
     _sg_sampler_cache_item_t* item = &cache->items[item_index];
-    item->min_filter = img_desc->min_filter;
-    item->mag_filter = img_desc->mag_filter;
-    item->wrap_u = img_desc->wrap_u;
-    item->wrap_v = img_desc->wrap_v;
-    item->wrap_w = img_desc->wrap_w;
-    item->border_color = img_desc->border_color;
-    item->max_anisotropy = img_desc->max_anisotropy;
-    item->min_lod = _sg_smpcache_minlod_int(img_desc->min_lod);
-    item->max_lod = _sg_smpcache_maxlod_int(img_desc->max_lod);
+    _sg_smpcache_init_key(item, img_desc);
     item->sampler_handle = sampler_handle;
+    item->ref_count = 0;
+    item->lru_prev = item->lru_next = -1;
+    _sg_smpcache_table_insert(cache, item_index);
+    return item_index;
+}
+
+/* add a reference to an item, returns the sampler handle */
+_SOKOL_PRIVATE uintptr_t _sg_smpcache_use_item(_sg_sampler_cache_t* cache, int item_index) {
+    SOKOL_ASSERT(cache && cache->items);
+    SOKOL_ASSERT((item_index >= 0) && (item_index < cache->num_items));
+    _sg_sampler_cache_item_t* item = &cache->items[item_index];
+    if (0 == item->ref_count) {
+        /* unlink may be a no-op for newly added items */
+        if ((item->lru_prev != -1) || (cache->lru_head == item_index)) {
+            _sg_smpcache_lru_unlink(cache, item_index);
+        }
+    }
+    item->ref_count++;
+    return item->sampler_handle;
+}
+
+/* release a reference to an item, unreferenced items become eviction candidates */
+_SOKOL_PRIVATE void _sg_smpcache_release_item(_sg_sampler_cache_t* cache, int item_index) {
+    SOKOL_ASSERT(cache && cache->items);
+    SOKOL_ASSERT((item_index >= 0) && (item_index < cache->num_items));
+    _sg_sampler_cache_item_t* item = &cache->items[item_index];
+    SOKOL_ASSERT(item->ref_count > 0);
+    if (0 == --item->ref_count) {
+        _sg_smpcache_lru_append(cache, item_index);
+    }
 }
 
 _SOKOL_PRIVATE uintptr_t _sg_smpcache_sampler(_sg_sampler_cache_t* cache, int item_index) {
@@ -2831,6 +3956,9 @@ typedef struct {
     _sg_slot_t slot;
     _sg_shader_t* shader;
     _sg_pipeline_common_t cmn;
+    struct {
+        uint32_t render_state_hash;     /* hash of the depth-stencil, blend and rasterizer state */
+    } dmy;
 } _sg_dummy_pipeline_t;
 typedef _sg_dummy_pipeline_t _sg_pipeline_t;
 
@@ -2854,28 +3982,74 @@ typedef struct {
 } _sg_dummy_context_t;
 typedef _sg_dummy_context_t _sg_context_t;
 
+#define _SG_DUMMY_MAX_LINE_SIZE (128)
+
+/* one line of the command log */
+typedef struct {
+    char buf[_SG_DUMMY_MAX_LINE_SIZE];
+    int pos;
+} _sg_dummy_line_t;
+
+/* a bound buffer or image as seen by the GPU */
+typedef struct {
+    uint32_t id;
+    int active_slot;
+    int offset;
+} _sg_dummy_binding_t;
+
+typedef struct {
+    int x, y, w, h;
+    bool origin_top_left;
+} _sg_dummy_rect_t;
+
+/* the GPU state which is reset at the start of a pass */
+typedef struct {
+    uint32_t pip_id;
+    uint32_t shd_id;
+    uint32_t render_state_hash;
+    _sg_dummy_rect_t viewport;
+    _sg_dummy_rect_t scissor_rect;
+    _sg_dummy_binding_t vbs[SG_MAX_SHADERSTAGE_BUFFERS];
+    _sg_dummy_binding_t ib;
+    _sg_dummy_binding_t imgs[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_IMAGES];
+} _sg_dummy_state_t;
+
+typedef struct {
+    bool rt_valid;                  /* false until the first pass */
+    uint32_t rt_pass_id;            /* pass of the current render target, SG_INVALID_ID for the default pass */
+    _sg_dummy_state_t cur;
+    sg_dummy_stats stats;
+    char* log;
+    int log_size;
+    int log_pos;
+} _sg_dummy_backend_t;
+
 /*== GL BACKEND DECLARATIONS =================================================*/
 #elif defined(_SOKOL_ANY_GL)
 typedef struct {
     _sg_slot_t slot;
-    _sg_buffer_common_t cmn;
     struct {
         GLuint buf[SG_NUM_INFLIGHT_FRAMES];
         bool ext_buffers;   /* if true, external buffers were injected with sg_buffer_desc.gl_buffers */
+        #if defined(_SOKOL_GL_BUFFER_STORAGE)
+        uint8_t* mapped[SG_NUM_INFLIGHT_FRAMES];        /* persistently mapped stream buffer memory, or 0 */
+        uint32_t used_frame_index[SG_NUM_INFLIGHT_FRAMES]; /* last frame which rendered from the slot */
+        #endif
     } gl;
+    _sg_buffer_common_t cmn;
 } _sg_gl_buffer_t;
 typedef _sg_gl_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
         GLenum target;
+        GLuint tex[SG_NUM_INFLIGHT_FRAMES];
         GLuint depth_render_buffer;
         GLuint msaa_render_buffer;
-        GLuint tex[SG_NUM_INFLIGHT_FRAMES];
         bool ext_textures;  /* if true, external textures were injected with sg_image_desc.gl_textures */
     } gl;
+    _sg_image_common_t cmn;
 } _sg_gl_image_t;
 typedef _sg_gl_image_t _sg_image_t;
 
@@ -2884,11 +4058,15 @@ typedef struct {
     sg_uniform_type type;
     uint8_t count;
     uint16_t offset;
+    uint16_t std140_offset;
 } _sg_gl_uniform_t;
 
 typedef struct {
     int num_uniforms;
     _sg_gl_uniform_t uniforms[SG_MAX_UB_MEMBERS];
+    bool ubo;               /* true if this is a GLSL uniform block, updated through _sg.gl.ub */
+    bool std140_packed;     /* true if the std140 layout is identical with the packed input layout */
+    int std140_size;
 } _sg_gl_uniform_block_t;
 
 typedef struct {
@@ -2914,6 +4092,18 @@ typedef struct {
         _sg_gl_shader_stage_t stage[SG_NUM_SHADER_STAGES];
     } gl;
 } _sg_gl_shader_t;
+
+/* header of the program cache data, followed by the program binary */
+typedef struct {
+    uint64_t key;
+    uint32_t magic;
+    uint32_t version;
+    uint32_t binary_format;
+    int32_t binary_size;
+    int32_t uniform_locs[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS][SG_MAX_UB_MEMBERS];
+    int32_t image_locs[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_IMAGES];
+    int32_t image_tex_slots[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_IMAGES];
+} _sg_gl_program_cache_header_t;
 typedef _sg_gl_shader_t _sg_shader_t;
 
 typedef struct {
@@ -2957,20 +4147,35 @@ typedef struct {
 typedef _sg_gl_pass_t _sg_pass_t;
 typedef _sg_attachment_common_t _sg_attachment_t;
 
+typedef struct {
+    _sg_gl_attr_t gl_attr;
+    GLuint gl_vbuf;
+} _sg_gl_cache_attr_t;
+
+/* a cached vertex array object, the vertex attribute state is
+   also the lookup key
+*/
+#define _SG_GL_VAO_CACHE_SIZE (32)
+typedef struct {
+    GLuint vao;
+    uint32_t hash;          /* hash of attrs[] */
+    uint32_t last_use;      /* for least-recently-used eviction */
+    GLuint gl_ib;           /* GL_ELEMENT_ARRAY_BUFFER binding of the vao */
+    int base_vertex;        /* emulated base_vertex applied to the per-vertex attribute pointers, not part of the key */
+    _sg_gl_cache_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
+} _sg_gl_vao_t;
+
 typedef struct {
     _sg_slot_t slot;
     #if !defined(SOKOL_GLES2)
     GLuint vao;
+    _sg_gl_vao_t* vao_cache;    /* _SG_GL_VAO_CACHE_SIZE items, null in GLES2 fallback mode */
+    uint32_t vao_use_counter;
     #endif
     GLuint default_framebuffer;
 } _sg_gl_context_t;
 typedef _sg_gl_context_t _sg_context_t;
 
-typedef struct {
-    _sg_gl_attr_t gl_attr;
-    GLuint gl_vbuf;
-} _sg_gl_cache_attr_t;
-
 typedef struct {
     GLenum target;
     GLuint texture;
@@ -2986,8 +4191,20 @@ typedef struct {
     GLuint index_buffer;
     GLuint stored_vertex_buffer;
     GLuint stored_index_buffer;
+    #if defined(_SOKOL_GL_DRAW_INDIRECT)
+    GLuint indirect_buffer;
+    GLuint stored_indirect_buffer;
+    #endif
     _sg_gl_texture_bind_slot textures[SG_MAX_SHADERSTAGE_IMAGES];
     _sg_gl_texture_bind_slot stored_texture;
+    #if !defined(SOKOL_GLES2)
+    _sg_gl_vao_t* cur_vao;      /* 0 if the context's default vao is bound */
+    #endif
+    #if !defined(SOKOL_GLCORE33)
+    /* vertex attribute state from sg_apply_bindings(), for emulating base_vertex */
+    _sg_gl_cache_attr_t bind_attrs[SG_MAX_VERTEX_ATTRIBUTES];
+    int cur_base_vertex;
+    #endif
     int cur_ib_offset;
     GLenum cur_primitive_type;
     GLenum cur_index_type;
@@ -2995,6 +4212,95 @@ typedef struct {
     sg_pipeline cur_pipeline_id;
 } _sg_gl_state_cache_t;
 
+/* per-frame uniform buffer objects for GLSL uniform blocks */
+typedef struct {
+    bool valid;
+    int num_bytes;          /* size of each uniform buffer */
+    int align;              /* GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT */
+    int offset;             /* current write offset into the current frame's uniform buffer */
+    int frame_index;        /* current index into buf[] */
+    GLuint buf[SG_NUM_INFLIGHT_FRAMES];
+    uint8_t* scratch;       /* for converting uniform data to the std140 layout */
+    int scratch_size;
+} _sg_gl_ubpool_t;
+
+/* per-frame pixel unpack buffers for asynchronous texture uploads */
+typedef struct {
+    bool valid;
+    int num_bytes;          /* size of each pixel unpack buffer */
+    int offset;             /* current write offset into the current frame's pixel unpack buffer */
+    int frame_index;        /* current index into buf[] */
+    bool fallback_logged;   /* the first client memory fallback has been logged */
+    GLuint buf[SG_NUM_INFLIGHT_FRAMES];
+} _sg_gl_pbopool_t;
+
+#if defined(_SOKOL_GL_PBO)
+/* a pending sg_read_pixels_async() request */
+#define _SG_GL_MAX_READBACKS (16)
+typedef struct {
+    sg_read_pixels_desc desc;
+    GLuint buf;             /* pixel pack buffer, grows as needed */
+    int buf_size;
+    GLsync fence;           /* signals when glReadPixels() into buf has finished */
+} _sg_gl_readback_t;
+#endif
+
+/* queue of pending pixel readbacks, these finish in order */
+typedef struct {
+    #if defined(_SOKOL_GL_PBO)
+    int head;               /* index of the oldest pending readback */
+    int num;                /* number of pending readbacks */
+    _sg_gl_readback_t items[_SG_GL_MAX_READBACKS];
+    #endif
+    uint8_t* scratch;       /* for flipping the rows into top-to-bottom order */
+    int scratch_size;
+} _sg_gl_readback_queue_t;
+
+/* GL object types which are deleted by the deferred deletion queue */
+typedef enum {
+    _SG_GL_DELETE_BUFFERS,
+    _SG_GL_DELETE_TEXTURES,
+    _SG_GL_DELETE_RENDERBUFFERS,
+    _SG_GL_DELETE_PROGRAMS,
+    _SG_GL_DELETE_NUM
+} _sg_gl_delete_type_t;
+
+#define _SG_GL_DELETE_LIST_INITIAL_CAPACITY (64)
+typedef struct {
+    int num;
+    int capacity;
+    GLuint* names;
+} _sg_gl_delete_list_t;
+
+/* destroyed GL objects are queued per frame (indexed by frame_index % SG_NUM_INFLIGHT_FRAMES),
+   and deleted in batches SG_NUM_INFLIGHT_FRAMES calls to sg_commit() later
+*/
+typedef struct {
+    _sg_gl_delete_list_t lists[SG_NUM_INFLIGHT_FRAMES][_SG_GL_DELETE_NUM];
+} _sg_gl_delete_queue_t;
+
+#if defined(_SOKOL_GL_TIMER_QUERY)
+/* GPU timestamps of the passes and debug groups of one frame */
+#define _SG_GL_TIMER_FRAMES (SG_NUM_INFLIGHT_FRAMES + 2)
+#define _SG_GL_TIMER_MAX_DEPTH (16)
+typedef struct {
+    bool pending;           /* true until the query results have been read */
+    uint32_t frame_index;
+    int num_scopes;
+    int num_queries;        /* number of issued timestamp queries */
+    sg_gpu_timing scopes[SG_MAX_GPU_TIMINGS];
+    GLuint queries[2 * SG_MAX_GPU_TIMINGS];     /* begin and end timestamp of each scope */
+} _sg_gl_timer_frame_t;
+
+typedef struct {
+    bool valid;
+    int cur_frame;          /* index into frames[] of the frame being recorded */
+    int depth;              /* number of open scopes */
+    int stack[_SG_GL_TIMER_MAX_DEPTH];  /* scope indices of open scopes, -1 if not measured */
+    _sg_gl_timer_frame_t frames[_SG_GL_TIMER_FRAMES];
+} _sg_gl_timer_t;
+#endif
+
 typedef struct {
     bool valid;
     bool gles2;
@@ -3008,6 +4314,29 @@ typedef struct {
     bool ext_anisotropic;
     GLint max_anisotropy;
     GLint max_combined_texture_image_units;
+    #if defined(_SOKOL_GL_PROGRAM_BINARY)
+    bool program_cache_enabled;
+    uint64_t program_cache_salt;    /* hash of GL vendor, renderer and version */
+    #endif
+    #if defined(_SOKOL_GL_UBO)
+    _sg_gl_ubpool_t ub;
+    #endif
+    #if defined(_SOKOL_GL_PBO)
+    _sg_gl_pbopool_t pbo;
+    #endif
+    _sg_gl_readback_queue_t readback;
+    _sg_gl_delete_queue_t delete_queue;
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    _sg_gl_timer_t timer;
+    #endif
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    bool buffer_storage;            /* GL4.4 or ARB_buffer_storage */
+    int num_mapped_buffers;         /* number of alive persistently mapped buffers */
+    GLsync frame_fences[SG_NUM_INFLIGHT_FRAMES];    /* indexed by frame_index % SG_NUM_INFLIGHT_FRAMES */
+    #endif
+    #if defined(_SOKOL_GL_MULTI_DRAW_INDIRECT)
+    bool multi_draw_indirect;       /* GL4.3 or ARB_multi_draw_indirect */
+    #endif
 } _sg_gl_backend_t;
 
 /*== D3D11 BACKEND DECLARATIONS ==============================================*/
@@ -3015,25 +4344,25 @@ typedef struct {
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_buffer_common_t cmn;
     struct {
         ID3D11Buffer* buf;
     } d3d11;
+    _sg_buffer_common_t cmn;
 } _sg_d3d11_buffer_t;
 typedef _sg_d3d11_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
+        ID3D11ShaderResourceView* srv;
+        ID3D11SamplerState* smp;
         DXGI_FORMAT format;
         ID3D11Texture2D* tex2d;
         ID3D11Texture3D* tex3d;
         ID3D11Texture2D* texds;
         ID3D11Texture2D* texmsaa;
-        ID3D11ShaderResourceView* srv;
-        ID3D11SamplerState* smp;
     } d3d11;
+    _sg_image_common_t cmn;
 } _sg_d3d11_image_t;
 typedef _sg_d3d11_image_t _sg_image_t;
 
@@ -3167,22 +4496,23 @@ typedef struct {
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_buffer_common_t cmn;
     struct {
         uint32_t buf[SG_NUM_INFLIGHT_FRAMES];  /* index into _sg_mtl_pool */
     } mtl;
+    _sg_buffer_common_t cmn;
 } _sg_mtl_buffer_t;
 typedef _sg_mtl_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
         uint32_t tex[SG_NUM_INFLIGHT_FRAMES];
+        uint32_t sampler_state;
         uint32_t depth_tex;
         uint32_t msaa_tex;
-        uint32_t sampler_state;
+        int sampler_cache_item;     /* only valid if sampler_state is valid */
     } mtl;
+    _sg_image_common_t cmn;
 } _sg_mtl_image_t;
 typedef _sg_mtl_image_t _sg_image_t;
 
@@ -3213,6 +4543,7 @@ typedef struct {
         uint32_t stencil_ref;
         uint32_t rps;
         uint32_t dss;
+        int vb_strides[SG_MAX_SHADERSTAGE_BUFFERS];     /* 0 for per-instance buffers, for emulating base_vertex */
     } mtl;
 } _sg_mtl_pipeline_t;
 typedef _sg_mtl_pipeline_t _sg_pipeline_t;
@@ -3291,22 +4622,23 @@ static dispatch_semaphore_t _sg_mtl_sem;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_buffer_common_t cmn;
     struct {
         WGPUBuffer buf;
     } wgpu;
+    _sg_buffer_common_t cmn;
 } _sg_wgpu_buffer_t;
 typedef _sg_wgpu_buffer_t _sg_buffer_t;
 
 typedef struct {
     _sg_slot_t slot;
-    _sg_image_common_t cmn;
     struct {
-        WGPUTexture tex;
         WGPUTextureView tex_view;
-        WGPUTexture msaa_tex;
         WGPUSampler sampler;
+        WGPUTexture tex;
+        WGPUTexture msaa_tex;
+        int sampler_cache_item;     /* only valid if sampler is valid */
     } wgpu;
+    _sg_image_common_t cmn;
 } _sg_wgpu_image_t;
 typedef _sg_wgpu_image_t _sg_image_t;
 
@@ -3406,6 +4738,202 @@ typedef struct {
     _sg_wgpu_ubpool_t ub;
     _sg_wgpu_stagingpool_t staging;
 } _sg_wgpu_backend_t;
+
+/*=== SOFT BACKEND DECLARATIONS ==============================================*/
+#elif defined(SOKOL_SOFT)
+
+enum {
+    _SG_SOFT_TILE_SHIFT = 6,                            /* 64x64 pixel tiles */
+    _SG_SOFT_TILE_SIZE = (1<<_SG_SOFT_TILE_SHIFT),
+    _SG_SOFT_SUBPIXEL_BITS = 4,                         /* vertex positions are snapped to 1/16 pixel */
+    _SG_SOFT_MAX_THREADS = 64,
+    _SG_SOFT_MAX_BATCH_TRIANGLES = 16 * 1024,           /* queued triangles are rasterized when any batch limit is reached */
+    _SG_SOFT_MAX_BATCH_DRAWS = 1024,
+    _SG_SOFT_BATCH_UB_SIZE = 256 * 1024,
+    _SG_SOFT_MAX_UB_SIZE = 4 * 1024,                    /* max size of a single uniform block */
+    _SG_SOFT_VERTEX_CACHE_SIZE = 32,                    /* must be 2^N */
+    _SG_SOFT_MAX_CLIP_VERTICES = 3 + 6,                 /* a triangle clipped against 6 planes */
+    _SG_SOFT_GUARD_BAND = 16,                           /* triangles are only clipped in x/y beyond 16x the viewport */
+};
+
+typedef struct {
+    _sg_slot_t slot;
+    struct {
+        uint8_t* ptr;
+    } soft;
+    _sg_buffer_common_t cmn;
+} _sg_soft_buffer_t;
+typedef _sg_soft_buffer_t _sg_buffer_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    struct {
+        void* pixels;           /* RGBA8, or float for depth buffers, first row is the top row */
+        sg_soft_texture tex;    /* the image as seen by shader functions */
+    } soft;
+    _sg_image_common_t cmn;
+} _sg_soft_image_t;
+typedef _sg_soft_image_t _sg_image_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_shader_common_t cmn;
+    struct {
+        sg_soft_vs_func vs;
+        sg_soft_fs_func fs;
+        int num_varyings;
+    } soft;
+} _sg_soft_shader_t;
+typedef _sg_soft_shader_t _sg_shader_t;
+
+typedef struct {
+    sg_vertex_format format;
+    int buffer_index;
+    int offset;
+} _sg_soft_attr_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_shader_t* shader;
+    struct {
+        int num_attrs;
+        _sg_soft_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
+        int vb_strides[SG_MAX_SHADERSTAGE_BUFFERS];
+        sg_vertex_step vb_step_funcs[SG_MAX_SHADERSTAGE_BUFFERS];
+        int vb_step_rates[SG_MAX_SHADERSTAGE_BUFFERS];
+        sg_primitive_type primitive_type;
+        bool quads;         /* points and lines are rasterized as quads, which are never culled */
+        sg_cull_mode cull_mode;
+        sg_face_winding face_winding;
+        sg_compare_func depth_compare_func;
+        bool depth_write_enabled;
+        sg_blend_state blend;
+    } soft;
+    _sg_pipeline_common_t cmn;
+} _sg_soft_pipeline_t;
+typedef _sg_soft_pipeline_t _sg_pipeline_t;
+
+typedef struct {
+    _sg_image_t* image;
+} _sg_soft_attachment_t;
+
+typedef struct {
+    _sg_slot_t slot;
+    _sg_pass_common_t cmn;
+    struct {
+        _sg_soft_attachment_t color_atts[SG_MAX_COLOR_ATTACHMENTS];
+        _sg_soft_attachment_t ds_att;
+    } soft;
+} _sg_soft_pass_t;
+typedef _sg_soft_pass_t _sg_pass_t;
+typedef _sg_attachment_common_t _sg_attachment_t;
+
+typedef struct {
+    _sg_slot_t slot;
+} _sg_soft_context_t;
+typedef _sg_soft_context_t _sg_context_t;
+
+/* the state a queued draw call needs for shading, copied because the
+   pipeline and bindings may change before the triangles are rasterized
+*/
+typedef struct {
+    sg_soft_fs_func fs;
+    int num_varyings;
+    sg_compare_func depth_compare_func;
+    bool depth_write_enabled;
+    sg_blend_state blend;
+    const void* fs_uniforms[SG_MAX_SHADERSTAGE_UBS];    /* point into the batch's uniform data */
+    sg_soft_texture fs_images[SG_MAX_SHADERSTAGE_IMAGES];
+} _sg_soft_draw_t;
+
+/* a triangle after clipping and setup, the edge functions are evaluated at
+   pixel centers in fixed point units (1/256 pixel^2), all values are integers
+   which are exactly representable as double, so coverage is exact
+*/
+typedef struct {
+    double a[3], b[3], c[3];        /* edge k (opposite vertex k): e = a*x + b*y + c */
+    double thr[3];                  /* top-left fill rule: 0 for top or left edges, 1 otherwise */
+    double inv_area;
+    float z[3];
+    float inv_w[3];
+    int x0, y0, x1, y1;             /* pixel bounds clipped to viewport and scissor rect, x1/y1 exclusive */
+    int draw_index;
+    bool front_facing;
+    float varyings[3][SG_SOFT_MAX_VARYINGS];    /* pre-multiplied with inv_w */
+} _sg_soft_tri_t;
+
+typedef struct {
+    int num_draws;
+    int num_tris;
+    int ub_pos;
+    int num_tiles_x;
+    int num_tiles_y;
+    int tiles_capacity;
+    int bins_capacity;
+    _sg_soft_draw_t* draws;
+    _sg_soft_tri_t* tris;
+    uint8_t* ub_data;               /* snapshot of fragment stage uniforms of all queued draws */
+    int* tile_offsets;              /* start of each tile's triangle indices in bins (num_tiles+1 entries) */
+    int* bins;                      /* triangle indices sorted by tile, in submission order */
+} _sg_soft_batch_t;
+
+/* the worker threads rasterize tiles together with the calling thread */
+typedef struct {
+    #if defined(_WIN32)
+    CRITICAL_SECTION mutex;
+    CONDITION_VARIABLE work_cond;
+    CONDITION_VARIABLE done_cond;
+    HANDLE threads[_SG_SOFT_MAX_THREADS];
+    #else
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    pthread_t threads[_SG_SOFT_MAX_THREADS];
+    #endif
+    int num_threads;                /* number of worker threads, not including the calling thread */
+    uint32_t job_id;                /* incremented for each rasterized batch */
+    int num_tiles;
+    int next_tile;
+    int num_tiles_done;
+    bool quit;
+} _sg_soft_workers_t;
+
+typedef struct {
+    int index;                      /* vertex index, or -1 if unused */
+    sg_soft_vs_output out;
+} _sg_soft_cached_vertex_t;
+
+typedef struct {
+    bool valid;
+    /* the default framebuffer, resized in sg_begin_default_pass() */
+    struct {
+        int width;
+        int height;
+        uint8_t* color;
+        float* depth;
+    } def_fb;
+    /* the render target of the current pass */
+    struct {
+        int width;
+        int height;
+        uint8_t* color;
+        float* depth;
+    } target;
+    int vp_x, vp_y, vp_w, vp_h;     /* viewport with origin in top-left corner */
+    int sc_x0, sc_y0, sc_x1, sc_y1; /* scissor rect clipped to the render target, x1/y1 exclusive */
+    _sg_pipeline_t* cur_pipeline;
+    const uint8_t* cur_vbs[SG_MAX_SHADERSTAGE_BUFFERS];    /* vertex buffer data at binding offset */
+    int cur_vb_sizes[SG_MAX_SHADERSTAGE_BUFFERS];
+    const uint8_t* cur_ib;
+    int cur_ib_size;
+    const sg_soft_texture* cur_vs_images[SG_MAX_SHADERSTAGE_IMAGES];
+    const sg_soft_texture* cur_fs_images[SG_MAX_SHADERSTAGE_IMAGES];
+    int cur_draw_index;             /* index of the queued draw matching the current state, or -1 */
+    float ub[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS][_SG_SOFT_MAX_UB_SIZE/4];
+    _sg_soft_cached_vertex_t vcache[_SG_SOFT_VERTEX_CACHE_SIZE];
+    _sg_soft_batch_t batch;
+    _sg_soft_workers_t workers;
+} _sg_soft_backend_t;
 #endif
 
 /*=== RESOURCE POOL DECLARATIONS =============================================*/
@@ -3413,11 +4941,94 @@ typedef struct {
 /* this *MUST* remain 0 */
 #define _SG_INVALID_SLOT_INDEX (0)
 
+/* the per-draw data of buffers and images, sg_apply_bindings() only
+   reads these compact copies, which live in arrays parallel to the
+   buffer and image pools, instead of the much bigger resource items,
+   the resource items remain the owners of the data, whenever it changes,
+   _sg_sync_buffer_hot() or _sg_sync_image_hot() must be called
+*/
+typedef struct {
+    uint32_t id;            /* slot.id, 0 for free slots */
+    uint8_t state;          /* slot.state */
+    uint8_t active_slot;    /* cmn.active_slot */
+    bool append_overflow;   /* cmn.append_overflow */
+    _sg_buffer_t* buf;      /* the complete buffer */
+    #if defined(_SOKOL_ANY_GL)
+    struct {
+        GLuint buf;         /* gl.buf[active_slot] */
+        bool mapped;        /* the buffer is persistently mapped */
+    } gl;
+    #elif defined(SOKOL_METAL)
+    struct {
+        uint32_t buf;       /* mtl.buf[active_slot] */
+    } mtl;
+    #elif defined(SOKOL_D3D11)
+    struct {
+        ID3D11Buffer* buf;
+    } d3d11;
+    #elif defined(SOKOL_WGPU)
+    struct {
+        WGPUBuffer buf;
+    } wgpu;
+    #elif defined(SOKOL_SOFT)
+    struct {
+        uint8_t* ptr;
+    } soft;
+    #endif
+} _sg_buffer_hot_t;
+
+typedef struct {
+    uint32_t id;            /* slot.id, 0 for free slots */
+    uint8_t state;          /* slot.state */
+    uint8_t active_slot;    /* cmn.active_slot */
+    _sg_image_t* img;       /* the complete image */
+    #if defined(_SOKOL_ANY_GL)
+    struct {
+        GLenum target;
+        GLuint tex;         /* gl.tex[active_slot] */
+    } gl;
+    #elif defined(SOKOL_METAL)
+    struct {
+        uint32_t tex;       /* mtl.tex[active_slot] */
+        uint32_t sampler_state;
+    } mtl;
+    #elif defined(SOKOL_D3D11)
+    struct {
+        ID3D11ShaderResourceView* srv;
+        ID3D11SamplerState* smp;
+    } d3d11;
+    #elif defined(SOKOL_WGPU)
+    struct {
+        WGPUTextureView tex_view;
+        WGPUSampler sampler;
+    } wgpu;
+    #endif
+} _sg_image_hot_t;
+
+/* pools grow on demand by adding chunks of items, the items themselves
+   never move, so that pointers to resources remain valid
+*/
 typedef struct {
     int size;
-    int queue_top;
+    int item_size;
+    int hot_item_size;      /* 0 if the pool has no hot array */
+    int num_chunks;
+    void* chunks[_SG_MAX_POOL_CHUNKS];
+    void** items;           /* item pointers indexable by pool slot index */
+    void* hot;              /* per-draw item data indexable by pool slot index */
     uint32_t* gen_ctrs;
+    #if defined(SOKOL_THREADSAFE_ALLOC)
+    /* lock-free stack of free slots: the low 32 bits of free_head are the
+       first free slot index (0 if the pool is exhausted), the high 32 bits
+       are a tag which is bumped on each change to prevent the ABA problem,
+       free_next[] links each free slot to the next one
+    */
+    volatile uint64_t free_head;
+    volatile int* free_next;
+    #else
+    int queue_top;
     int* free_queue;
+    #endif
 } _sg_pool_t;
 
 typedef struct {
@@ -3427,12 +5038,6 @@ typedef struct {
     _sg_pool_t pipeline_pool;
     _sg_pool_t pass_pool;
     _sg_pool_t context_pool;
-    _sg_buffer_t* buffers;
-    _sg_image_t* images;
-    _sg_shader_t* shaders;
-    _sg_pipeline_t* pipelines;
-    _sg_pass_t* passes;
-    _sg_context_t* contexts;
 } _sg_pools_t;
 
 /*=== VALIDATION LAYER DECLARATIONS ==========================================*/
@@ -3465,6 +5070,8 @@ typedef enum {
     _SG_VALIDATE_SHADERDESC_BYTECODE,
     _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE,
     _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE,
+    _SG_VALIDATE_SHADERDESC_SOFT_FUNCS,
+    _SG_VALIDATE_SHADERDESC_SOFT_NUM_VARYINGS,
     _SG_VALIDATE_SHADERDESC_NO_CONT_UBS,
     _SG_VALIDATE_SHADERDESC_NO_CONT_IMGS,
     _SG_VALIDATE_SHADERDESC_NO_CONT_UB_MEMBERS,
@@ -3523,11 +5130,13 @@ typedef enum {
     _SG_VALIDATE_ABND_VB_EXISTS,
     _SG_VALIDATE_ABND_VB_TYPE,
     _SG_VALIDATE_ABND_VB_OVERFLOW,
+    _SG_VALIDATE_ABND_VB_MAPPED,
     _SG_VALIDATE_ABND_NO_IB,
     _SG_VALIDATE_ABND_IB,
     _SG_VALIDATE_ABND_IB_EXISTS,
     _SG_VALIDATE_ABND_IB_TYPE,
     _SG_VALIDATE_ABND_IB_OVERFLOW,
+    _SG_VALIDATE_ABND_IB_MAPPED,
     _SG_VALIDATE_ABND_VS_IMGS,
     _SG_VALIDATE_ABND_VS_IMG_EXISTS,
     _SG_VALIDATE_ABND_VS_IMG_TYPES,
@@ -3551,16 +5160,144 @@ typedef enum {
     _SG_VALIDATE_APPENDBUF_SIZE,
     _SG_VALIDATE_APPENDBUF_UPDATE,
 
+    /* sg_draw_indirect validation */
+    _SG_VALIDATE_DRAWINDIRECT_BUF,
+    _SG_VALIDATE_DRAWINDIRECT_TYPE,
+    _SG_VALIDATE_DRAWINDIRECT_OFFSET,
+    _SG_VALIDATE_DRAWINDIRECT_SIZE,
+    _SG_VALIDATE_DRAWINDIRECT_MAPPED,
+    _SG_VALIDATE_DRAWINDIRECT_IBOFFSET,
+
+    /* sg_map_buffer validation */
+    _SG_VALIDATE_MAPBUF_USAGE,
+    _SG_VALIDATE_MAPBUF_SIZE,
+    _SG_VALIDATE_MAPBUF_ONCE,
+    _SG_VALIDATE_MAPBUF_APPEND,
+
+    /* sg_unmap_buffer validation */
+    _SG_VALIDATE_UNMAPBUF_NOTMAPPED,
+
     /* sg_update_image validation */
     _SG_VALIDATE_UPDIMG_USAGE,
     _SG_VALIDATE_UPDIMG_NOTENOUGHDATA,
     _SG_VALIDATE_UPDIMG_SIZE,
     _SG_VALIDATE_UPDIMG_COMPRESSED,
-    _SG_VALIDATE_UPDIMG_ONCE
+    _SG_VALIDATE_UPDIMG_ONCE,
+
+    /* sg_update_image_region validation */
+    _SG_VALIDATE_UPDIMGREG_FEATURE,
+    _SG_VALIDATE_UPDIMGREG_USAGE,
+    _SG_VALIDATE_UPDIMGREG_COMPRESSED,
+    _SG_VALIDATE_UPDIMGREG_MIPLEVEL,
+    _SG_VALIDATE_UPDIMGREG_SLICE,
+    _SG_VALIDATE_UPDIMGREG_RECT,
+    _SG_VALIDATE_UPDIMGREG_DATA,
+
+    /* sg_read_pixels_async validation */
+    _SG_VALIDATE_READPIX_FEATURE,
+    _SG_VALIDATE_READPIX_PASS,
+    _SG_VALIDATE_READPIX_CALLBACK,
+    _SG_VALIDATE_READPIX_IMAGE,
+    _SG_VALIDATE_READPIX_RENDERTARGET,
+    _SG_VALIDATE_READPIX_IMAGETYPE,
+    _SG_VALIDATE_READPIX_FORMAT,
+    _SG_VALIDATE_READPIX_DEFAULTPASS,
+    _SG_VALIDATE_READPIX_RECT
 } _sg_validate_error_t;
 
+/*=== COMMAND LIST DECLARATIONS ==============================================*/
+typedef enum {
+    _SG_CMD_INVALID,
+    _SG_CMD_APPLY_VIEWPORT,
+    _SG_CMD_APPLY_SCISSOR_RECT,
+    _SG_CMD_APPLY_PIPELINE,
+    _SG_CMD_APPLY_BINDINGS,
+    _SG_CMD_APPLY_UNIFORMS,
+    _SG_CMD_DRAW,
+} _sg_cmd_type_t;
+
+/* all recorded commands start with this header, sizes are multiples of 4 */
+typedef struct {
+    uint32_t type;
+    uint32_t size;      /* size of the command in bytes, including the header */
+} _sg_cmd_header_t;
+
+typedef struct {
+    _sg_cmd_header_t hdr;
+    int x, y, w, h;
+    uint32_t origin_top_left;
+} _sg_cmd_rect_t;
+
+typedef struct {
+    _sg_cmd_header_t hdr;
+    uint32_t pip_id;
+} _sg_cmd_apply_pipeline_t;
+
+/* followed by uint32_t vb ids, vb offsets, ib id and offset, vs image ids, fs image ids */
+typedef struct {
+    _sg_cmd_header_t hdr;
+    uint8_t num_vbs;
+    uint8_t has_ib;
+    uint8_t num_vs_imgs;
+    uint8_t num_fs_imgs;
+} _sg_cmd_apply_bindings_t;
+
+/* followed by the uniform data */
+typedef struct {
+    _sg_cmd_header_t hdr;
+    uint32_t stage;
+    int ub_index;
+    int num_bytes;
+} _sg_cmd_apply_uniforms_t;
+
+typedef struct {
+    _sg_cmd_header_t hdr;
+    int base_element;
+    int num_elements;
+    int num_instances;
+} _sg_cmd_draw_t;
+
 /*=== GENERIC BACKEND STATE ==================================================*/
 
+/* pipeline deduplication, one entry per pipeline pool slot, shared
+   entries are found through an open-addressing hash table keyed on
+   the desc hash (linear probing, at most half full)
+*/
+enum {
+    _SG_PIPDEDUP_KEY_SIZE = 3*SG_MAX_SHADERSTAGE_BUFFERS + 3*SG_MAX_VERTEX_ATTRIBUTES + 39,
+};
+
+typedef struct {
+    uint32_t pip_id;
+    uint32_t hash;
+    int ref_count;      /* 0 if the pipeline isn't shared */
+    uint32_t key[_SG_PIPDEDUP_KEY_SIZE];
+} _sg_pipdedup_entry_t;
+
+typedef struct {
+    bool enabled;
+    int num_slots;
+    _sg_pipdedup_entry_t* entries;
+    int table_size;     /* number of hash table buckets, power of 2 */
+    int* table;         /* entry slot index per bucket, or -1 if empty */
+} _sg_pipdedup_t;
+
+/* the last successfully applied state for filtering redundant calls */
+typedef struct {
+    bool valid;
+    int x, y, w, h;
+    bool origin_top_left;
+} _sg_filter_rect_t;
+
+typedef struct {
+    uint32_t pip_id;            /* SG_INVALID_ID if no valid pipeline applied */
+    bool bindings_valid;        /* true if 'bindings' have been applied with pip_id */
+    sg_bindings bindings;
+    _sg_filter_rect_t viewport;
+    _sg_filter_rect_t scissor_rect;
+    sg_filter_stats stats;
+} _sg_filter_t;
+
 typedef struct {
     bool valid;
     sg_desc desc;       /* original desc with default values patched in */
@@ -3568,12 +5305,20 @@ typedef struct {
     sg_context active_context;
     sg_pass cur_pass;
     sg_pipeline cur_pipeline;
+    int default_pass_width;     /* framebuffer size of the last sg_begin_default_pass() */
+    int default_pass_height;
     bool pass_valid;
     bool bindings_valid;
     bool next_draw_valid;
     #if defined(SOKOL_DEBUG)
     _sg_validate_error_t validate_error;
+    int cur_ib_offset;          /* index buffer offset of the last sg_apply_bindings() */
     #endif
+    _sg_filter_t filter;
+    _sg_pipdedup_t pipdedup;
+    sg_frame_stats frame_stats;         /* counters of the current frame */
+    sg_frame_stats prev_frame_stats;    /* counters of the last complete frame */
+    sg_gpu_timings gpu_timings;         /* most recent complete GPU timings, written by the backend */
     _sg_pools_t pools;
     sg_backend backend;
     sg_features features;
@@ -3587,6 +5332,10 @@ typedef struct {
     _sg_d3d11_backend_t d3d11;
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_backend_t wgpu;
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_backend_t soft;
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_backend_t dmy;
     #endif
     #if defined(SOKOL_TRACE_HOOKS)
     sg_trace_hooks hooks;
@@ -3953,79 +5702,303 @@ _SOKOL_PRIVATE void _sg_resolve_default_pass_action(const sg_pass_action* from,
     }
 }
 
+/* call the callback of an sg_read_pixels_async() request with the read pixels */
+_SOKOL_PRIVATE void _sg_read_pixels_callback(const sg_read_pixels_desc* desc, const void* ptr, int size) {
+    SOKOL_ASSERT(desc && desc->callback && ptr && (size > 0));
+    sg_read_pixels_result res;
+    memset(&res, 0, sizeof(res));
+    res.image = desc->image;
+    res.x = desc->x;
+    res.y = desc->y;
+    res.width = desc->width;
+    res.height = desc->height;
+    res.ptr = ptr;
+    res.size = size;
+    res.user_data = desc->user_data;
+    desc->callback(&res);
+}
+
 /*== DUMMY BACKEND IMPL ======================================================*/
 #if defined(SOKOL_DUMMY_BACKEND)
 
-_SOKOL_PRIVATE void _sg_dummy_setup_backend(const sg_desc* desc) {
-    SOKOL_ASSERT(desc);
-    _SOKOL_UNUSED(desc);
-    _sg.backend = SG_BACKEND_DUMMY;
-    for (int i = SG_PIXELFORMAT_R8; i < SG_PIXELFORMAT_BC1_RGBA; i++) {
-        _sg.formats[i].sample = true;
-        _sg.formats[i].filter = true;
-        _sg.formats[i].render = true;
-        _sg.formats[i].blend = true;
-        _sg.formats[i].msaa = true;
+/* the dummy backend identifies resources by their pool slot index in the command log */
+_SOKOL_PRIVATE int _sg_dummy_slot_index(uint32_t id) {
+    return (int) (id & _SG_SLOT_MASK);
+}
+
+/* the command lines are only formatted if sg_desc.dummy_log_size isn't zero */
+_SOKOL_PRIVATE void _sg_dummy_line_str(_sg_dummy_line_t* line, const char* str) {
+    if (0 == _sg.dmy.log) {
+        return;
+    }
+    while (*str && (line->pos < (_SG_DUMMY_MAX_LINE_SIZE - 1))) {
+        line->buf[line->pos++] = *str++;
     }
-    _sg.formats[SG_PIXELFORMAT_DEPTH].depth = true;
-    _sg.formats[SG_PIXELFORMAT_DEPTH_STENCIL].depth = true;
 }
 
-_SOKOL_PRIVATE void _sg_dummy_discard_backend(void) {
-    /* empty */
+_SOKOL_PRIVATE void _sg_dummy_line_begin(_sg_dummy_line_t* line, const char* cmd) {
+    line->pos = 0;
+    _sg_dummy_line_str(line, cmd);
 }
 
-_SOKOL_PRIVATE void _sg_dummy_reset_state_cache(void) {
-    /* empty*/
+_SOKOL_PRIVATE void _sg_dummy_line_arg_str(_sg_dummy_line_t* line, const char* key, const char* val) {
+    _sg_dummy_line_str(line, " ");
+    _sg_dummy_line_str(line, key);
+    _sg_dummy_line_str(line, "=");
+    _sg_dummy_line_str(line, val);
 }
 
-_SOKOL_PRIVATE sg_resource_state _sg_dummy_create_context(_sg_context_t* ctx) {
-    SOKOL_ASSERT(ctx);
-    _SOKOL_UNUSED(ctx);
-    return SG_RESOURCESTATE_VALID;
+_SOKOL_PRIVATE void _sg_dummy_line_arg(_sg_dummy_line_t* line, const char* key, int val) {
+    if (0 == _sg.dmy.log) {
+        return;
+    }
+    char digits[12];
+    int num_digits = 0;
+    uint32_t u = (val < 0) ? (0u - (uint32_t)val) : (uint32_t)val;
+    do {
+        digits[num_digits++] = (char)('0' + (u % 10));
+        u /= 10;
+    } while (u > 0);
+    if (val < 0) {
+        digits[num_digits++] = '-';
+    }
+    char str[12];
+    int i = 0;
+    while (num_digits > 0) {
+        str[i++] = digits[--num_digits];
+    }
+    str[i] = 0;
+    _sg_dummy_line_arg_str(line, key, str);
 }
 
-_SOKOL_PRIVATE void _sg_dummy_destroy_context(_sg_context_t* ctx) {
-    SOKOL_ASSERT(ctx);
-    _SOKOL_UNUSED(ctx);
+/* appends a complete line to the command log, the log always remains null-terminated */
+_SOKOL_PRIVATE void _sg_dummy_line_end(_sg_dummy_line_t* line) {
+    if ((0 == _sg.dmy.log) || _sg.dmy.stats.log_overflow) {
+        return;
+    }
+    if ((_sg.dmy.log_pos + line->pos + 2) > _sg.dmy.log_size) {
+        _sg.dmy.stats.log_overflow = true;
+        return;
+    }
+    memcpy(&_sg.dmy.log[_sg.dmy.log_pos], line->buf, (size_t)line->pos);
+    _sg.dmy.log_pos += line->pos;
+    _sg.dmy.log[_sg.dmy.log_pos++] = '\n';
+    _sg.dmy.log[_sg.dmy.log_pos] = 0;
 }
 
-_SOKOL_PRIVATE void _sg_dummy_activate_context(_sg_context_t* ctx) {
-    SOKOL_ASSERT(ctx);
-    _SOKOL_UNUSED(ctx);
+_SOKOL_PRIVATE void _sg_dummy_log_resource(const char* cmd, const char* key, uint32_t id, int size) {
+    _sg_dummy_line_t line;
+    _sg_dummy_line_begin(&line, cmd);
+    _sg_dummy_line_arg(&line, key, _sg_dummy_slot_index(id));
+    _sg_dummy_line_arg(&line, "size", size);
+    _sg_dummy_line_end(&line);
 }
 
-_SOKOL_PRIVATE sg_resource_state _sg_dummy_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
-    SOKOL_ASSERT(buf && desc);
+_SOKOL_PRIVATE void _sg_dummy_log_id(const char* cmd, const char* key, uint32_t id) {
+    _sg_dummy_line_t line;
+    _sg_dummy_line_begin(&line, cmd);
+    _sg_dummy_line_arg(&line, key, _sg_dummy_slot_index(id));
+    _sg_dummy_line_end(&line);
+}
+
+/* the number of bytes a real backend would upload for an image */
+_SOKOL_PRIVATE int _sg_dummy_image_content_size(const sg_image_content* content) {
+    int size = 0;
+    for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+        for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+            if (content->subimage[face_index][mip_index].ptr) {
+                size += content->subimage[face_index][mip_index].size;
+            }
+        }
+    }
+    return size;
+}
+
+/* updates a tracked binding, returns true if the GPU would need to rebind */
+_SOKOL_PRIVATE bool _sg_dummy_rebind(_sg_dummy_binding_t* b, uint32_t id, int active_slot, int offset) {
+    if ((b->id == id) && (b->active_slot == active_slot) && (b->offset == offset)) {
+        return false;
+    }
+    b->id = id;
+    b->active_slot = active_slot;
+    b->offset = offset;
+    return true;
+}
+
+/* updates a tracked viewport or scissor rect, returns true if it has changed */
+_SOKOL_PRIVATE bool _sg_dummy_set_rect(_sg_dummy_rect_t* r, int x, int y, int w, int h, bool origin_top_left) {
+    if ((r->x == x) && (r->y == y) && (r->w == w) && (r->h == h) && (r->origin_top_left == origin_top_left)) {
+        return false;
+    }
+    r->x = x; r->y = y; r->w = w; r->h = h;
+    r->origin_top_left = origin_top_left;
+    return true;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_log_rect(const char* cmd, const _sg_dummy_rect_t* r) {
+    _sg_dummy_line_t line;
+    _sg_dummy_line_begin(&line, cmd);
+    _sg_dummy_line_arg(&line, "x", r->x);
+    _sg_dummy_line_arg(&line, "y", r->y);
+    _sg_dummy_line_arg(&line, "w", r->w);
+    _sg_dummy_line_arg(&line, "h", r->h);
+    _sg_dummy_line_arg(&line, "top_left", r->origin_top_left ? 1 : 0);
+    _sg_dummy_line_end(&line);
+}
+
+_SOKOL_PRIVATE uint32_t _sg_dummy_hash(uint32_t hash, uint32_t val) {
+    /* FNV-1a */
+    return (hash ^ val) * 16777619u;
+}
+
+_SOKOL_PRIVATE uint32_t _sg_dummy_hash_float(uint32_t hash, float val) {
+    uint32_t u;
+    memcpy(&u, &val, sizeof(u));
+    return _sg_dummy_hash(hash, u);
+}
+
+_SOKOL_PRIVATE uint32_t _sg_dummy_render_state_hash(const sg_pipeline_desc* desc) {
+    uint32_t h = 2166136261u;
+    const sg_depth_stencil_state* ds = &desc->depth_stencil;
+    const sg_stencil_state* stencil[2] = { &ds->stencil_front, &ds->stencil_back };
+    for (int i = 0; i < 2; i++) {
+        h = _sg_dummy_hash(h, (uint32_t) stencil[i]->fail_op);
+        h = _sg_dummy_hash(h, (uint32_t) stencil[i]->depth_fail_op);
+        h = _sg_dummy_hash(h, (uint32_t) stencil[i]->pass_op);
+        h = _sg_dummy_hash(h, (uint32_t) stencil[i]->compare_func);
+    }
+    h = _sg_dummy_hash(h, (uint32_t) ds->depth_compare_func);
+    h = _sg_dummy_hash(h, ds->depth_write_enabled ? 1 : 0);
+    h = _sg_dummy_hash(h, ds->stencil_enabled ? 1 : 0);
+    h = _sg_dummy_hash(h, ds->stencil_read_mask);
+    h = _sg_dummy_hash(h, ds->stencil_write_mask);
+    h = _sg_dummy_hash(h, ds->stencil_ref);
+    const sg_blend_state* bs = &desc->blend;
+    h = _sg_dummy_hash(h, bs->enabled ? 1 : 0);
+    h = _sg_dummy_hash(h, (uint32_t) bs->src_factor_rgb);
+    h = _sg_dummy_hash(h, (uint32_t) bs->dst_factor_rgb);
+    h = _sg_dummy_hash(h, (uint32_t) bs->op_rgb);
+    h = _sg_dummy_hash(h, (uint32_t) bs->src_factor_alpha);
+    h = _sg_dummy_hash(h, (uint32_t) bs->dst_factor_alpha);
+    h = _sg_dummy_hash(h, (uint32_t) bs->op_alpha);
+    h = _sg_dummy_hash(h, bs->color_write_mask);
+    for (int i = 0; i < 4; i++) {
+        h = _sg_dummy_hash_float(h, bs->blend_color[i]);
+    }
+    const sg_rasterizer_state* rs = &desc->rasterizer;
+    h = _sg_dummy_hash(h, rs->alpha_to_coverage_enabled ? 1 : 0);
+    h = _sg_dummy_hash(h, (uint32_t) rs->cull_mode);
+    h = _sg_dummy_hash(h, (uint32_t) rs->face_winding);
+    h = _sg_dummy_hash_float(h, rs->depth_bias);
+    h = _sg_dummy_hash_float(h, rs->depth_bias_slope_scale);
+    h = _sg_dummy_hash_float(h, rs->depth_bias_clamp);
+    return h;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_setup_backend(const sg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    _sg.backend = SG_BACKEND_DUMMY;
+    _sg.features.image_region_update = true;
+    _sg.features.read_pixels = true;
+    for (int i = SG_PIXELFORMAT_R8; i < SG_PIXELFORMAT_BC1_RGBA; i++) {
+        _sg.formats[i].sample = true;
+        _sg.formats[i].filter = true;
+        _sg.formats[i].render = true;
+        _sg.formats[i].blend = true;
+        _sg.formats[i].msaa = true;
+    }
+    _sg.formats[SG_PIXELFORMAT_DEPTH].depth = true;
+    _sg.formats[SG_PIXELFORMAT_DEPTH_STENCIL].depth = true;
+    if (desc->dummy_log_size > 0) {
+        _sg.dmy.log_size = desc->dummy_log_size;
+        _sg.dmy.log = (char*) SOKOL_MALLOC((size_t)_sg.dmy.log_size);
+        SOKOL_ASSERT(_sg.dmy.log);
+        _sg.dmy.log[0] = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_dummy_discard_backend(void) {
+    if (_sg.dmy.log) {
+        SOKOL_FREE(_sg.dmy.log);
+        _sg.dmy.log = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_dummy_reset_state_cache(void) {
+    _sg.dmy.rt_valid = false;
+    memset(&_sg.dmy.cur, 0, sizeof(_sg.dmy.cur));
+}
+
+_SOKOL_PRIVATE void _sg_dummy_reset_stats(void) {
+    memset(&_sg.dmy.stats, 0, sizeof(_sg.dmy.stats));
+    _sg.dmy.log_pos = 0;
+    if (_sg.dmy.log) {
+        _sg.dmy.log[0] = 0;
+    }
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_dummy_create_context(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    _SOKOL_UNUSED(ctx);
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_destroy_context(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    _SOKOL_UNUSED(ctx);
+}
+
+_SOKOL_PRIVATE void _sg_dummy_activate_context(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    _SOKOL_UNUSED(ctx);
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_dummy_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(buf && desc);
     _sg_buffer_common_init(&buf->cmn, desc);
+    /* immutable buffers upload their content on creation */
+    const int size = desc->content ? desc->size : 0;
+    if (size > 0) {
+        _sg.dmy.stats.num_buffer_uploads++;
+        _sg.dmy.stats.size_buffer_uploads += (uint32_t)size;
+    }
+    _sg_dummy_log_resource("make_buffer", "buf", buf->slot.id, size);
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf);
-    _SOKOL_UNUSED(buf);
+    _sg_dummy_log_id("destroy_buffer", "buf", buf->slot.id);
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_image(_sg_image_t* img, const sg_image_desc* desc) {
     SOKOL_ASSERT(img && desc);
     _sg_image_common_init(&img->cmn, desc);
+    /* immutable images upload their content on creation */
+    const int size = _sg_dummy_image_content_size(&desc->content);
+    if (size > 0) {
+        _sg.dmy.stats.num_image_uploads++;
+        _sg.dmy.stats.size_image_uploads += (uint32_t)size;
+    }
+    _sg_dummy_log_resource("make_image", "img", img->slot.id, size);
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_image(_sg_image_t* img) {
     SOKOL_ASSERT(img);
-    _SOKOL_UNUSED(img);
+    _sg_dummy_log_id("destroy_image", "img", img->slot.id);
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
     SOKOL_ASSERT(shd && desc);
     _sg_shader_common_init(&shd->cmn, desc);
+    _sg_dummy_log_id("make_shader", "shd", shd->slot.id);
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_shader(_sg_shader_t* shd) {
     SOKOL_ASSERT(shd);
-    _SOKOL_UNUSED(shd);
+    _sg_dummy_log_id("destroy_shader", "shd", shd->slot.id);
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
@@ -4040,12 +6013,14 @@ _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_pipeline(_sg_pipeline_t* pip,
         SOKOL_ASSERT((a_desc->buffer_index >= 0) && (a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
         pip->cmn.vertex_layout_valid[a_desc->buffer_index] = true;
     }
+    pip->dmy.render_state_hash = _sg_dummy_render_state_hash(desc);
+    _sg_dummy_log_id("make_pipeline", "pip", pip->slot.id);
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
-    _SOKOL_UNUSED(pip);
+    _sg_dummy_log_id("destroy_pipeline", "pip", pip->slot.id);
 }
 
 _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_pass(_sg_pass_t* pass, _sg_image_t** att_images, const sg_pass_desc* desc) {
@@ -4072,12 +6047,13 @@ _SOKOL_PRIVATE sg_resource_state _sg_dummy_create_pass(_sg_pass_t* pass, _sg_ima
         SOKOL_ASSERT(_sg_is_valid_rendertarget_depth_format(att_images[ds_img_index]->cmn.pixel_format));
         pass->dmy.ds_att.image = att_images[ds_img_index];
     }
+    _sg_dummy_log_id("make_pass", "pass", pass->slot.id);
     return SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_dummy_destroy_pass(_sg_pass_t* pass) {
     SOKOL_ASSERT(pass);
-    _SOKOL_UNUSED(pass);
+    _sg_dummy_log_id("destroy_pass", "pass", pass->slot.id);
 }
 
 _SOKOL_PRIVATE _sg_image_t* _sg_dummy_pass_color_image(const _sg_pass_t* pass, int index) {
@@ -4094,103 +6070,261 @@ _SOKOL_PRIVATE _sg_image_t* _sg_dummy_pass_ds_image(const _sg_pass_t* pass) {
 
 _SOKOL_PRIVATE void _sg_dummy_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
     SOKOL_ASSERT(action);
-    _SOKOL_UNUSED(pass);
-    _SOKOL_UNUSED(action);
-    _SOKOL_UNUSED(w);
-    _SOKOL_UNUSED(h);
+    const uint32_t pass_id = pass ? pass->slot.id : (uint32_t)SG_INVALID_ID;
+    _sg.dmy.stats.num_passes++;
+    if (!_sg.dmy.rt_valid || (_sg.dmy.rt_pass_id != pass_id)) {
+        _sg.dmy.rt_valid = true;
+        _sg.dmy.rt_pass_id = pass_id;
+        _sg.dmy.stats.num_render_target_switches++;
+    }
+    int num_color_atts;
+    bool has_ds_att;
+    if (pass) {
+        num_color_atts = pass->cmn.num_color_atts;
+        has_ds_att = 0 != pass->dmy.ds_att.image;
+    }
+    else {
+        num_color_atts = 1;
+        has_ds_att = _sg.desc.context.depth_format != SG_PIXELFORMAT_NONE;
+    }
+    int num_clears = 0;
+    for (int i = 0; i < num_color_atts; i++) {
+        if (action->colors[i].action == SG_ACTION_CLEAR) {
+            num_clears++;
+        }
+    }
+    if (has_ds_att && ((action->depth.action == SG_ACTION_CLEAR) || (action->stencil.action == SG_ACTION_CLEAR))) {
+        num_clears++;
+    }
+    _sg.dmy.stats.num_clears += (uint32_t)num_clears;
+
+    /* like a Metal render command encoder, each pass starts with a clean
+       state, and the viewport and scissor rect covering the framebuffer
+    */
+    memset(&_sg.dmy.cur, 0, sizeof(_sg.dmy.cur));
+    _sg_dummy_set_rect(&_sg.dmy.cur.viewport, 0, 0, w, h, true);
+    _sg_dummy_set_rect(&_sg.dmy.cur.scissor_rect, 0, 0, w, h, true);
+
+    _sg_dummy_line_t line;
+    _sg_dummy_line_begin(&line, "begin_pass");
+    _sg_dummy_line_arg(&line, "pass", _sg_dummy_slot_index(pass_id));
+    _sg_dummy_line_arg(&line, "w", w);
+    _sg_dummy_line_arg(&line, "h", h);
+    _sg_dummy_line_arg(&line, "clears", num_clears);
+    _sg_dummy_line_end(&line);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_end_pass(void) {
-    /* empty */
+    _sg_dummy_line_t line;
+    _sg_dummy_line_begin(&line, "end_pass");
+    _sg_dummy_line_end(&line);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_commit(void) {
-    /* empty */
+    _sg_dummy_line_t line;
+    _sg_dummy_line_begin(&line, "commit");
+    _sg_dummy_line_end(&line);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
-    _SOKOL_UNUSED(x);
-    _SOKOL_UNUSED(y);
-    _SOKOL_UNUSED(w);
-    _SOKOL_UNUSED(h);
-    _SOKOL_UNUSED(origin_top_left);
+    if (_sg_dummy_set_rect(&_sg.dmy.cur.viewport, x, y, w, h, origin_top_left)) {
+        _sg.dmy.stats.num_viewport_changes++;
+        _sg_dummy_log_rect("viewport", &_sg.dmy.cur.viewport);
+    }
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
-    _SOKOL_UNUSED(x);
-    _SOKOL_UNUSED(y);
-    _SOKOL_UNUSED(w);
-    _SOKOL_UNUSED(h);
-    _SOKOL_UNUSED(origin_top_left);
+    if (_sg_dummy_set_rect(&_sg.dmy.cur.scissor_rect, x, y, w, h, origin_top_left)) {
+        _sg.dmy.stats.num_scissor_changes++;
+        _sg_dummy_log_rect("scissor_rect", &_sg.dmy.cur.scissor_rect);
+    }
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
-    _SOKOL_UNUSED(pip);
+    _sg_dummy_state_t* cur = &_sg.dmy.cur;
+    if (cur->pip_id == pip->slot.id) {
+        return;
+    }
+    _sg_dummy_line_t line;
+    cur->pip_id = pip->slot.id;
+    _sg.dmy.stats.num_pipeline_switches++;
+    _sg_dummy_line_begin(&line, "pipeline");
+    _sg_dummy_line_arg(&line, "pip", _sg_dummy_slot_index(pip->slot.id));
+    _sg_dummy_line_end(&line);
+    if (cur->shd_id != pip->cmn.shader_id.id) {
+        cur->shd_id = pip->cmn.shader_id.id;
+        _sg.dmy.stats.num_shader_switches++;
+        _sg_dummy_line_begin(&line, "shader");
+        _sg_dummy_line_arg(&line, "shd", _sg_dummy_slot_index(cur->shd_id));
+        _sg_dummy_line_end(&line);
+    }
+    if (cur->render_state_hash != pip->dmy.render_state_hash) {
+        cur->render_state_hash = pip->dmy.render_state_hash;
+        _sg.dmy.stats.num_render_state_changes++;
+        _sg_dummy_line_begin(&line, "render_state");
+        _sg_dummy_line_arg(&line, "pip", _sg_dummy_slot_index(pip->slot.id));
+        _sg_dummy_line_end(&line);
+    }
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_bindings(
     _sg_pipeline_t* pip,
-    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
-    _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    const _sg_buffer_hot_t** vbs, const int* vb_offsets, int num_vbs,
+    const _sg_buffer_hot_t* ib, int ib_offset,
+    const _sg_image_hot_t** vs_imgs, int num_vs_imgs,
+    const _sg_image_hot_t** fs_imgs, int num_fs_imgs)
 {
     SOKOL_ASSERT(pip);
     SOKOL_ASSERT(vbs && vb_offsets);
     SOKOL_ASSERT(vs_imgs);
     SOKOL_ASSERT(fs_imgs);
     _SOKOL_UNUSED(pip);
-    _SOKOL_UNUSED(vbs); _SOKOL_UNUSED(vb_offsets); _SOKOL_UNUSED(num_vbs);
-    _SOKOL_UNUSED(ib); _SOKOL_UNUSED(ib_offset);
-    _SOKOL_UNUSED(vs_imgs); _SOKOL_UNUSED(num_vs_imgs);
-    _SOKOL_UNUSED(fs_imgs); _SOKOL_UNUSED(num_fs_imgs);
+    _sg_dummy_state_t* cur = &_sg.dmy.cur;
+    _sg_dummy_line_t line;
+    for (int i = 0; i < num_vbs; i++) {
+        if (_sg_dummy_rebind(&cur->vbs[i], vbs[i]->id, vbs[i]->active_slot, vb_offsets[i])) {
+            _sg.dmy.stats.num_vertex_buffer_binds++;
+            _sg_dummy_line_begin(&line, "vertex_buffer");
+            _sg_dummy_line_arg(&line, "slot", i);
+            _sg_dummy_line_arg(&line, "buf", _sg_dummy_slot_index(vbs[i]->id));
+            _sg_dummy_line_arg(&line, "offset", vb_offsets[i]);
+            _sg_dummy_line_end(&line);
+        }
+    }
+    if (ib && _sg_dummy_rebind(&cur->ib, ib->id, ib->active_slot, ib_offset)) {
+        _sg.dmy.stats.num_index_buffer_binds++;
+        _sg_dummy_line_begin(&line, "index_buffer");
+        _sg_dummy_line_arg(&line, "buf", _sg_dummy_slot_index(ib->id));
+        _sg_dummy_line_arg(&line, "offset", ib_offset);
+        _sg_dummy_line_end(&line);
+    }
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        const _sg_image_hot_t** imgs = (stage_index == SG_SHADERSTAGE_VS) ? vs_imgs : fs_imgs;
+        const int num_imgs = (stage_index == SG_SHADERSTAGE_VS) ? num_vs_imgs : num_fs_imgs;
+        for (int i = 0; i < num_imgs; i++) {
+            if (_sg_dummy_rebind(&cur->imgs[stage_index][i], imgs[i]->id, imgs[i]->active_slot, 0)) {
+                _sg.dmy.stats.num_texture_binds++;
+                _sg_dummy_line_begin(&line, "texture");
+                _sg_dummy_line_arg_str(&line, "stage", (stage_index == SG_SHADERSTAGE_VS) ? "vs" : "fs");
+                _sg_dummy_line_arg(&line, "slot", i);
+                _sg_dummy_line_arg(&line, "img", _sg_dummy_slot_index(imgs[i]->id));
+                _sg_dummy_line_end(&line);
+            }
+        }
+    }
 }
 
 _SOKOL_PRIVATE void _sg_dummy_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
     SOKOL_ASSERT(data && (num_bytes > 0));
     SOKOL_ASSERT((stage_index >= 0) && ((int)stage_index < SG_NUM_SHADER_STAGES));
     SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
-    _SOKOL_UNUSED(stage_index);
-    _SOKOL_UNUSED(ub_index);
     _SOKOL_UNUSED(data);
-    _SOKOL_UNUSED(num_bytes);
-}
-
-_SOKOL_PRIVATE void _sg_dummy_draw(int base_element, int num_elements, int num_instances) {
-    _SOKOL_UNUSED(base_element);
-    _SOKOL_UNUSED(num_elements);
-    _SOKOL_UNUSED(num_instances);
+    _sg.dmy.stats.num_uniform_updates++;
+    _sg.dmy.stats.size_uniform_updates += (uint32_t)num_bytes;
+    _sg_dummy_line_t line;
+    _sg_dummy_line_begin(&line, "uniforms");
+    _sg_dummy_line_arg_str(&line, "stage", (stage_index == SG_SHADERSTAGE_VS) ? "vs" : "fs");
+    _sg_dummy_line_arg(&line, "ub", ub_index);
+    _sg_dummy_line_arg(&line, "size", num_bytes);
+    _sg_dummy_line_end(&line);
+}
+
+_SOKOL_PRIVATE void _sg_dummy_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
+    _sg.dmy.stats.num_draws++;
+    _sg.dmy.stats.num_elements += (uint32_t)num_elements;
+    _sg.dmy.stats.num_instances += (uint32_t)num_instances;
+    _sg_dummy_line_t line;
+    _sg_dummy_line_begin(&line, "draw");
+    _sg_dummy_line_arg(&line, "base", base_element);
+    _sg_dummy_line_arg(&line, "num", num_elements);
+    _sg_dummy_line_arg(&line, "instances", num_instances);
+    _sg_dummy_line_arg(&line, "base_vertex", base_vertex);
+    _sg_dummy_line_end(&line);
 }
 
 _SOKOL_PRIVATE void _sg_dummy_update_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size) {
     SOKOL_ASSERT(buf && data && (data_size > 0));
     _SOKOL_UNUSED(data);
-    _SOKOL_UNUSED(data_size);
     if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
         buf->cmn.active_slot = 0;
     }
+    _sg.dmy.stats.num_buffer_uploads++;
+    _sg.dmy.stats.size_buffer_uploads += data_size;
+    _sg_dummy_log_resource("update_buffer", "buf", buf->slot.id, (int)data_size);
 }
 
 _SOKOL_PRIVATE uint32_t _sg_dummy_append_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size, bool new_frame) {
     SOKOL_ASSERT(buf && data && (data_size > 0));
     _SOKOL_UNUSED(data);
-    _SOKOL_UNUSED(data_size);
     if (new_frame) {
         if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
             buf->cmn.active_slot = 0;
         }
     }
+    _sg.dmy.stats.num_buffer_uploads++;
+    _sg.dmy.stats.size_buffer_uploads += data_size;
+    _sg_dummy_log_resource("append_buffer", "buf", buf->slot.id, (int)data_size);
     /* NOTE: this is a requirement from WebGPU, but we want identical behaviour across all backend */
     return _sg_roundup(data_size, 4);
 }
 
+_SOKOL_PRIVATE void* _sg_dummy_map_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
+        buf->cmn.active_slot = 0;
+    }
+    /* no buffer memory, sg_map_buffer() falls back to the shadow buffer */
+    return 0;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_unmap_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size) {
+    SOKOL_ASSERT(buf);
+    _SOKOL_UNUSED(data);
+    _sg.dmy.stats.num_buffer_uploads++;
+    _sg.dmy.stats.size_buffer_uploads += data_size;
+    _sg_dummy_log_resource("unmap_buffer", "buf", buf->slot.id, (int)data_size);
+}
+
 _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_content* data) {
     SOKOL_ASSERT(img && data);
-    _SOKOL_UNUSED(data);
     if (++img->cmn.active_slot >= img->cmn.num_slots) {
         img->cmn.active_slot = 0;
     }
+    const int data_size = _sg_dummy_image_content_size(data);
+    _sg.dmy.stats.num_image_uploads++;
+    _sg.dmy.stats.size_image_uploads += (uint32_t)data_size;
+    _sg_dummy_log_resource("update_image", "img", img->slot.id, data_size);
+}
+
+_SOKOL_PRIVATE void _sg_dummy_update_image_region(_sg_image_t* img, const sg_image_region* region, const void* data, int data_size) {
+    SOKOL_ASSERT(img && region && data && (data_size > 0));
+    _SOKOL_UNUSED(region);
+    _SOKOL_UNUSED(data);
+    _sg.dmy.stats.num_image_uploads++;
+    _sg.dmy.stats.size_image_uploads += (uint32_t)data_size;
+    _sg_dummy_log_resource("update_image_region", "img", img->slot.id, data_size);
+}
+
+/* completes immediately with a pattern built from the framebuffer coordinates */
+_SOKOL_PRIVATE bool _sg_dummy_read_pixels(_sg_image_t* img, const sg_read_pixels_desc* desc) {
+    SOKOL_ASSERT(desc && desc->callback && (desc->width > 0) && (desc->height > 0));
+    _SOKOL_UNUSED(img);
+    const int num_bytes = desc->width * desc->height * 4;
+    uint8_t* pixels = (uint8_t*) SOKOL_MALLOC((size_t)num_bytes);
+    SOKOL_ASSERT(pixels);
+    uint8_t* dst = pixels;
+    for (int y = 0; y < desc->height; y++) {
+        for (int x = 0; x < desc->width; x++) {
+            *dst++ = (uint8_t)(desc->x + x);
+            *dst++ = (uint8_t)(desc->y + y);
+            *dst++ = 0;
+            *dst++ = 0xFF;
+        }
+    }
+    _sg_read_pixels_callback(desc, pixels, num_bytes);
+    SOKOL_FREE(pixels);
+    return true;
 }
 
 /*== GL BACKEND ==============================================================*/
@@ -4201,6 +6335,14 @@ _SOKOL_PRIVATE GLenum _sg_gl_buffer_target(sg_buffer_type t) {
     switch (t) {
         case SG_BUFFERTYPE_VERTEXBUFFER:    return GL_ARRAY_BUFFER;
         case SG_BUFFERTYPE_INDEXBUFFER:     return GL_ELEMENT_ARRAY_BUFFER;
+        case SG_BUFFERTYPE_INDIRECTBUFFER:
+            #if defined(_SOKOL_GL_DRAW_INDIRECT)
+            if (_sg.features.draw_indirect) {
+                return GL_DRAW_INDIRECT_BUFFER;
+            }
+            #endif
+            /* draw_indirect is emulated from a CPU-side copy, the GL buffer is unused */
+            return GL_ARRAY_BUFFER;
         default: SOKOL_UNREACHABLE; return 0;
     }
 }
@@ -4983,6 +7125,12 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
     _sg.features.imagetype_3d = true;
     _sg.features.imagetype_array = true;
     _sg.features.image_clamp_to_border = true;
+    _sg.features.image_region_update = true;
+    _sg.features.read_pixels = true;
+    _sg.features.base_vertex = true;
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    _sg.features.gpu_timings = true;
+    #endif
 
     /* scan extensions */
     bool has_s3tc = false;  /* BC1..BC3 */
@@ -5013,8 +7161,45 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
             else if (strstr(ext, "_texture_filter_anisotropic")) {
                 _sg.gl.ext_anisotropic = true;
             }
+            #if defined(_SOKOL_GL_BUFFER_STORAGE)
+            else if (strstr(ext, "_buffer_storage")) {
+                _sg.gl.buffer_storage = true;
+            }
+            #endif
+            #if defined(_SOKOL_GL_DRAW_INDIRECT)
+            else if (strstr(ext, "_multi_draw_indirect")) {
+                #if defined(_SOKOL_GL_MULTI_DRAW_INDIRECT)
+                _sg.gl.multi_draw_indirect = true;
+                #endif
+            }
+            else if (strstr(ext, "_draw_indirect")) {
+                _sg.features.draw_indirect = true;
+            }
+            #endif
         }
     }
+    GLint major_version = 0;
+    GLint minor_version = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major_version);
+    glGetIntegerv(GL_MINOR_VERSION, &minor_version);
+    const int version = major_version * 10 + minor_version;
+    _SOKOL_UNUSED(version);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (version >= 44) {
+        _sg.gl.buffer_storage = true;
+    }
+    #endif
+    #if defined(_SOKOL_GL_DRAW_INDIRECT)
+    if (version >= 40) {
+        _sg.features.draw_indirect = true;
+    }
+    #endif
+    #if defined(_SOKOL_GL_MULTI_DRAW_INDIRECT)
+    if (version >= 43) {
+        _sg.gl.multi_draw_indirect = true;
+    }
+    _sg.gl.multi_draw_indirect &= _sg.features.draw_indirect;
+    #endif
 
     /* limits */
     _sg_gl_init_limits();
@@ -5058,6 +7243,8 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
     _sg.features.imagetype_3d = true;
     _sg.features.imagetype_array = true;
     _sg.features.image_clamp_to_border = false;
+    _sg.features.image_region_update = true;
+    _sg.features.read_pixels = true;
 
     bool has_s3tc = false;  /* BC1..BC3 */
     bool has_rgtc = false;  /* BC4 and BC5 */
@@ -5186,6 +7373,8 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles2(void) {
     _sg.features.imagetype_3d = false;
     _sg.features.imagetype_array = false;
     _sg.features.image_clamp_to_border = false;
+    _sg.features.image_region_update = true;
+    _sg.features.read_pixels = true;
 
     /* limits */
     _sg_gl_init_limits();
@@ -5234,9 +7423,24 @@ _SOKOL_PRIVATE void _sg_gl_clear_buffer_bindings(bool force) {
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
         _sg.gl.cache.index_buffer = 0;
     }
+    #if defined(_SOKOL_GL_DRAW_INDIRECT)
+    if (_sg.features.draw_indirect && (force || (_sg.gl.cache.indirect_buffer != 0))) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        _sg.gl.cache.indirect_buffer = 0;
+    }
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_bind_buffer(GLenum target, GLuint buffer) {
+    #if defined(_SOKOL_GL_DRAW_INDIRECT)
+    if (target == GL_DRAW_INDIRECT_BUFFER) {
+        if (_sg.gl.cache.indirect_buffer != buffer) {
+            _sg.gl.cache.indirect_buffer = buffer;
+            glBindBuffer(target, buffer);
+        }
+        return;
+    }
+    #endif
     SOKOL_ASSERT((GL_ARRAY_BUFFER == target) || (GL_ELEMENT_ARRAY_BUFFER == target));
     if (target == GL_ARRAY_BUFFER) {
         if (_sg.gl.cache.vertex_buffer != buffer) {
@@ -5253,6 +7457,12 @@ _SOKOL_PRIVATE void _sg_gl_bind_buffer(GLenum target, GLuint buffer) {
 }
 
 _SOKOL_PRIVATE void _sg_gl_store_buffer_binding(GLenum target) {
+    #if defined(_SOKOL_GL_DRAW_INDIRECT)
+    if (target == GL_DRAW_INDIRECT_BUFFER) {
+        _sg.gl.cache.stored_indirect_buffer = _sg.gl.cache.indirect_buffer;
+        return;
+    }
+    #endif
     if (target == GL_ARRAY_BUFFER) {
         _sg.gl.cache.stored_vertex_buffer = _sg.gl.cache.vertex_buffer;
     }
@@ -5262,6 +7472,12 @@ _SOKOL_PRIVATE void _sg_gl_store_buffer_binding(GLenum target) {
 }
 
 _SOKOL_PRIVATE void _sg_gl_restore_buffer_binding(GLenum target) {
+    #if defined(_SOKOL_GL_DRAW_INDIRECT)
+    if (target == GL_DRAW_INDIRECT_BUFFER) {
+        _sg_gl_bind_buffer(target, _sg.gl.cache.stored_indirect_buffer);
+        return;
+    }
+    #endif
     if (target == GL_ARRAY_BUFFER) {
         _sg_gl_bind_buffer(target, _sg.gl.cache.stored_vertex_buffer);
     }
@@ -5270,6 +7486,73 @@ _SOKOL_PRIVATE void _sg_gl_restore_buffer_binding(GLenum target) {
     }
 }
 
+#if !defined(SOKOL_GLES2)
+_SOKOL_PRIVATE void _sg_gl_bind_default_vao(void) {
+    SOKOL_ASSERT(_sg.gl.cur_context);
+    glBindVertexArray(_sg.gl.cur_context->vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    _sg.gl.cache.index_buffer = 0;
+    _sg.gl.cache.cur_vao = 0;
+}
+#endif
+
+/* called before a GL buffer object is deleted, GL buffer names may be
+   reused, so any cached state referencing the buffer must be dropped
+*/
+_SOKOL_PRIVATE void _sg_gl_invalidate_buffer(GLuint buf) {
+    #if !defined(SOKOL_GLES2)
+    _sg_context_t* ctx = _sg.gl.cur_context;
+    if (ctx && ctx->vao_cache) {
+        for (int i = 0; i < _SG_GL_VAO_CACHE_SIZE; i++) {
+            _sg_gl_vao_t* vao = &ctx->vao_cache[i];
+            if (0 == vao->vao) {
+                continue;
+            }
+            bool uses_buf = (vao->gl_ib == buf);
+            for (uint32_t attr_index = 0; attr_index < _sg.limits.max_vertex_attrs; attr_index++) {
+                uses_buf |= (vao->attrs[attr_index].gl_vbuf == buf);
+            }
+            if (vao == _sg.gl.cache.cur_vao) {
+                /* the current vao's index buffer binding lives in the state cache */
+                uses_buf |= (_sg.gl.cache.index_buffer == buf);
+                if (uses_buf) {
+                    _sg_gl_bind_default_vao();
+                }
+            }
+            if (uses_buf) {
+                glDeleteVertexArrays(1, &vao->vao);
+                memset(vao, 0, sizeof(_sg_gl_vao_t));
+            }
+        }
+    }
+    #endif
+    if (_sg.gl.cache.vertex_buffer == buf) {
+        _sg.gl.cache.vertex_buffer = 0;
+    }
+    if (_sg.gl.cache.index_buffer == buf) {
+        _sg.gl.cache.index_buffer = 0;
+    }
+    if (_sg.gl.cache.stored_vertex_buffer == buf) {
+        _sg.gl.cache.stored_vertex_buffer = 0;
+    }
+    if (_sg.gl.cache.stored_index_buffer == buf) {
+        _sg.gl.cache.stored_index_buffer = 0;
+    }
+    #if defined(_SOKOL_GL_DRAW_INDIRECT)
+    if (_sg.gl.cache.indirect_buffer == buf) {
+        _sg.gl.cache.indirect_buffer = 0;
+    }
+    if (_sg.gl.cache.stored_indirect_buffer == buf) {
+        _sg.gl.cache.stored_indirect_buffer = 0;
+    }
+    #endif
+    for (uint32_t attr_index = 0; attr_index < _sg.limits.max_vertex_attrs; attr_index++) {
+        if (_sg.gl.cache.attrs[attr_index].gl_vbuf == buf) {
+            _sg.gl.cache.attrs[attr_index].gl_vbuf = 0;
+        }
+    }
+}
+
 _SOKOL_PRIVATE void _sg_gl_clear_texture_bindings(bool force) {
     for (int i = 0; (i < SG_MAX_SHADERSTAGE_IMAGES) && (i < _sg.gl.max_combined_texture_image_units); i++) {
         if (force || (_sg.gl.cache.textures[i].texture != 0)) {
@@ -5324,59 +7607,776 @@ _SOKOL_PRIVATE void _sg_gl_restore_texture_binding(int slot_index) {
     _sg_gl_bind_texture(slot_index, slot->target, slot->texture);
 }
 
-_SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
-    /* assumes that _sg.gl is already zero-initialized */
-    _sg.gl.valid = true;
-    #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
-    _sg.gl.gles2 = desc->context.gl.force_gles2;
-    #else
-    _SOKOL_UNUSED(desc);
-    _sg.gl.gles2 = false;
-    #endif
+#if defined(_SOKOL_GL_PROGRAM_BINARY)
+/*-- GL program binary cache -------------------------------------------------*/
+#define _SG_GL_FNV64_SEED (14695981039346656037ull)
+#define _SG_GL_PROGRAM_CACHE_MAGIC (0x42505347)     /* 'GSPB' */
+#define _SG_GL_PROGRAM_CACHE_VERSION (1)
 
-    /* clear initial GL error state */
-    #if defined(SOKOL_DEBUG)
-        while (glGetError() != GL_NO_ERROR);
-    #endif
-    #if defined(SOKOL_GLCORE33)
-        _sg_gl_init_caps_glcore33();
-    #elif defined(SOKOL_GLES3)
-        if (_sg.gl.gles2) {
-            _sg_gl_init_caps_gles2();
+/* FNV-1a, a null pointer hashes like an empty string */
+_SOKOL_PRIVATE uint64_t _sg_gl_hash_str(uint64_t hash, const char* str) {
+    if (str) {
+        while (*str) {
+            hash = (hash ^ (uint8_t)*str++) * 1099511628211ull;
         }
-        else {
-            _sg_gl_init_caps_gles3();
+    }
+    /* also hash the terminator, so that "ab"+"c" and "a"+"bc" differ */
+    return hash * 1099511628211ull;
+}
+
+_SOKOL_PRIVATE uint64_t _sg_gl_program_cache_key(const sg_shader_desc* desc) {
+    uint64_t key = _sg.gl.program_cache_salt;
+    key = _sg_gl_hash_str(key, desc->vs.source);
+    key = _sg_gl_hash_str(key, desc->fs.source);
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        key = _sg_gl_hash_str(key, desc->attrs[i].name);
+    }
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        const sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &desc->vs : &desc->fs;
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+                key = _sg_gl_hash_str(key, stage_desc->uniform_blocks[ub_index].uniforms[u_index].name);
+            }
         }
-    #else
-        _sg_gl_init_caps_gles2();
-    #endif
+        for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+            key = _sg_gl_hash_str(key, stage_desc->images[img_index].name);
+        }
+    }
+    return key;
 }
 
-_SOKOL_PRIVATE void _sg_gl_discard_backend(void) {
-    SOKOL_ASSERT(_sg.gl.valid);
-    _sg.gl.valid = false;
+/* create a program object from the program cache, returns 0 on cache miss */
+_SOKOL_PRIVATE GLuint _sg_gl_load_program(uint64_t key, _sg_gl_program_cache_header_t* hdr) {
+    int num_bytes = 0;
+    const uint8_t* ptr = (const uint8_t*) _sg.desc.context.gl.program_cache_load_cb(key, &num_bytes, _sg.desc.context.gl.program_cache_user_data);
+    if ((0 == ptr) || (num_bytes < (int)sizeof(_sg_gl_program_cache_header_t))) {
+        return 0;
+    }
+    /* the data isn't necessarily aligned */
+    memcpy(hdr, ptr, sizeof(_sg_gl_program_cache_header_t));
+    if ((hdr->key != key) ||
+        (hdr->magic != _SG_GL_PROGRAM_CACHE_MAGIC) ||
+        (hdr->version != _SG_GL_PROGRAM_CACHE_VERSION) ||
+        (hdr->binary_size <= 0) ||
+        ((num_bytes - (int)sizeof(_sg_gl_program_cache_header_t)) != hdr->binary_size))
+    {
+        SOKOL_LOG("_sg_gl_load_program: ignoring invalid program cache data");
+        return 0;
+    }
+    GLuint gl_prog = glCreateProgram();
+    glProgramBinary(gl_prog, (GLenum)hdr->binary_format, ptr + sizeof(_sg_gl_program_cache_header_t), hdr->binary_size);
+    /* an unsupported binary format results in a GL error */
+    while (glGetError() != GL_NO_ERROR);
+    GLint link_status = 0;
+    glGetProgramiv(gl_prog, GL_LINK_STATUS, &link_status);
+    if (!link_status) {
+        /* for instance after a driver update */
+        glDeleteProgram(gl_prog);
+        return 0;
+    }
+    return gl_prog;
 }
 
-_SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
-    if (_sg.gl.cur_context) {
-        _SG_GL_CHECK_ERROR();
-        #if !defined(SOKOL_GLES2)
-        if (!_sg.gl.gles2) {
-            glBindVertexArray(_sg.gl.cur_context->vao);
-            _SG_GL_CHECK_ERROR();
-        }
-        #endif
-        memset(&_sg.gl.cache, 0, sizeof(_sg.gl.cache));
-        _sg_gl_clear_buffer_bindings(true);
-        _SG_GL_CHECK_ERROR();
-        _sg_gl_clear_texture_bindings(true);
-        _SG_GL_CHECK_ERROR();
-        for (uint32_t i = 0; i < _sg.limits.max_vertex_attrs; i++) {
-            _sg_gl_init_attr(&_sg.gl.cache.attrs[i].gl_attr);
-            glDisableVertexAttribArray(i);
-            _SG_GL_CHECK_ERROR();
-        }
-        _sg.gl.cache.cur_primitive_type = GL_TRIANGLES;
+_SOKOL_PRIVATE void _sg_gl_store_program(uint64_t key, GLuint gl_prog, _sg_gl_program_cache_header_t* hdr) {
+    GLint binary_size = 0;
+    glGetProgramiv(gl_prog, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+    if (binary_size <= 0) {
+        return;
+    }
+    const int num_bytes = (int)sizeof(_sg_gl_program_cache_header_t) + binary_size;
+    uint8_t* ptr = (uint8_t*) SOKOL_MALLOC(num_bytes);
+    SOKOL_ASSERT(ptr);
+    GLsizei written = 0;
+    GLenum binary_format = 0;
+    glGetProgramBinary(gl_prog, binary_size, &written, &binary_format, ptr + sizeof(_sg_gl_program_cache_header_t));
+    _SG_GL_CHECK_ERROR();
+    if (written > 0) {
+        hdr->key = key;
+        hdr->magic = _SG_GL_PROGRAM_CACHE_MAGIC;
+        hdr->version = _SG_GL_PROGRAM_CACHE_VERSION;
+        hdr->binary_format = (uint32_t) binary_format;
+        hdr->binary_size = written;
+        memcpy(ptr, hdr, sizeof(_sg_gl_program_cache_header_t));
+        _sg.desc.context.gl.program_cache_store_cb(key, ptr, (int)sizeof(_sg_gl_program_cache_header_t) + written, _sg.desc.context.gl.program_cache_user_data);
+    }
+    SOKOL_FREE(ptr);
+}
+#endif
+
+#if defined(_SOKOL_GL_UBO)
+/*-- GL uniform buffer objects -----------------------------------------------*/
+_SOKOL_PRIVATE int _sg_gl_std140_align(sg_uniform_type type, int count) {
+    /* array items are always aligned to 16 bytes */
+    if (count > 1) {
+        return 16;
+    }
+    switch (type) {
+        case SG_UNIFORMTYPE_FLOAT:  return 4;
+        case SG_UNIFORMTYPE_FLOAT2: return 8;
+        default:                    return 16;
+    }
+}
+
+_SOKOL_PRIVATE int _sg_gl_std140_stride(sg_uniform_type type, int count) {
+    const int item_size = _sg_uniform_size(type, 1);
+    return (count > 1) ? _sg_roundup(item_size, 16) : item_size;
+}
+
+/* compute the std140 member offsets and block size of a uniform block */
+_SOKOL_PRIVATE void _sg_gl_std140_layout(_sg_gl_uniform_block_t* ub, int packed_size) {
+    int offset = 0;
+    bool packed = true;
+    for (int u_index = 0; u_index < ub->num_uniforms; u_index++) {
+        _sg_gl_uniform_t* u = &ub->uniforms[u_index];
+        offset = _sg_roundup(offset, _sg_gl_std140_align(u->type, u->count));
+        u->std140_offset = (uint16_t) offset;
+        if ((u->std140_offset != u->offset) || (_sg_gl_std140_stride(u->type, u->count) != _sg_uniform_size(u->type, 1))) {
+            packed = false;
+        }
+        offset += _sg_gl_std140_stride(u->type, u->count) * u->count;
+    }
+    ub->std140_size = _sg_roundup(offset, 16);
+    ub->std140_packed = packed && (ub->std140_size == packed_size);
+}
+
+/* the uniform buffers are only created when the first shader with a uniform block is created */
+_SOKOL_PRIVATE void _sg_gl_init_ubpool(void) {
+    SOKOL_ASSERT(!_sg.gl.ub.valid);
+    SOKOL_ASSERT(_sg.desc.uniform_buffer_size > 0);
+    _SG_GL_CHECK_ERROR();
+    GLint align = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+    _sg.gl.ub.align = (align > 0) ? align : 256;
+    _sg.gl.ub.num_bytes = _sg.desc.uniform_buffer_size;
+    _sg.gl.ub.offset = 0;
+    _sg.gl.ub.frame_index = 0;
+    glGenBuffers(SG_NUM_INFLIGHT_FRAMES, _sg.gl.ub.buf);
+    for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
+        glBindBuffer(GL_UNIFORM_BUFFER, _sg.gl.ub.buf[i]);
+        glBufferData(GL_UNIFORM_BUFFER, _sg.gl.ub.num_bytes, 0, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    _SG_GL_CHECK_ERROR();
+    _sg.gl.ub.valid = true;
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_ubpool(void) {
+    if (_sg.gl.ub.valid) {
+        glDeleteBuffers(SG_NUM_INFLIGHT_FRAMES, _sg.gl.ub.buf);
+        _sg.gl.ub.valid = false;
+    }
+    if (_sg.gl.ub.scratch) {
+        SOKOL_FREE(_sg.gl.ub.scratch);
+        _sg.gl.ub.scratch = 0;
+        _sg.gl.ub.scratch_size = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_reserve_ub_scratch(int num_bytes) {
+    if (num_bytes > _sg.gl.ub.scratch_size) {
+        if (_sg.gl.ub.scratch) {
+            SOKOL_FREE(_sg.gl.ub.scratch);
+        }
+        _sg.gl.ub.scratch = (uint8_t*) SOKOL_MALLOC(num_bytes);
+        SOKOL_ASSERT(_sg.gl.ub.scratch);
+        memset(_sg.gl.ub.scratch, 0, num_bytes);
+        _sg.gl.ub.scratch_size = num_bytes;
+    }
+}
+
+/* copy a uniform block into the current frame's uniform buffer and bind it */
+_SOKOL_PRIVATE void _sg_gl_apply_ubo(int stage_index, int ub_index, const _sg_gl_uniform_block_t* gl_ub, const void* data) {
+    SOKOL_ASSERT(_sg.gl.ub.valid);
+    const int num_bytes = gl_ub->std140_size;
+    SOKOL_ASSERT((_sg.gl.ub.offset + num_bytes) <= _sg.gl.ub.num_bytes);
+    const void* src = data;
+    if (!gl_ub->std140_packed) {
+        SOKOL_ASSERT(_sg.gl.ub.scratch_size >= num_bytes);
+        for (int u_index = 0; u_index < gl_ub->num_uniforms; u_index++) {
+            const _sg_gl_uniform_t* u = &gl_ub->uniforms[u_index];
+            const int item_size = _sg_uniform_size(u->type, 1);
+            const int dst_stride = _sg_gl_std140_stride(u->type, u->count);
+            const uint8_t* src_ptr = ((const uint8_t*)data) + u->offset;
+            uint8_t* dst_ptr = _sg.gl.ub.scratch + u->std140_offset;
+            for (int i = 0; i < u->count; i++) {
+                memcpy(dst_ptr, src_ptr, item_size);
+                src_ptr += item_size;
+                dst_ptr += dst_stride;
+            }
+        }
+        src = _sg.gl.ub.scratch;
+    }
+    const GLuint gl_buf = _sg.gl.ub.buf[_sg.gl.ub.frame_index];
+    const GLuint binding = (GLuint) (stage_index * SG_MAX_SHADERSTAGE_UBS + ub_index);
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, gl_buf, _sg.gl.ub.offset, num_bytes);
+    if (0 == _sg.gl.ub.offset) {
+        /* first update this frame, orphan the buffer to avoid a GPU sync */
+        glBufferData(GL_UNIFORM_BUFFER, _sg.gl.ub.num_bytes, 0, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_UNIFORM_BUFFER, _sg.gl.ub.offset, num_bytes, src);
+    _SG_GL_CHECK_ERROR();
+    _sg.gl.ub.offset = _sg_roundup(_sg.gl.ub.offset + num_bytes, _sg.gl.ub.align);
+}
+#endif
+
+#if defined(_SOKOL_GL_PBO)
+/*-- GL pixel unpack buffers for asynchronous texture uploads ----------------*/
+#define _SG_GL_PBO_ALIGN (16)
+
+/* the pixel unpack buffers are only created with the first texture upload */
+_SOKOL_PRIVATE void _sg_gl_init_pbopool(void) {
+    SOKOL_ASSERT(!_sg.gl.pbo.valid);
+    SOKOL_ASSERT(_sg.desc.staging_buffer_size > 0);
+    _SG_GL_CHECK_ERROR();
+    _sg.gl.pbo.num_bytes = _sg.desc.staging_buffer_size;
+    _sg.gl.pbo.offset = 0;
+    _sg.gl.pbo.frame_index = 0;
+    glGenBuffers(SG_NUM_INFLIGHT_FRAMES, _sg.gl.pbo.buf);
+    for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.pbo.buf[i]);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, _sg.gl.pbo.num_bytes, 0, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    _SG_GL_CHECK_ERROR();
+    _sg.gl.pbo.valid = true;
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_pbopool(void) {
+    if (_sg.gl.pbo.valid) {
+        glDeleteBuffers(SG_NUM_INFLIGHT_FRAMES, _sg.gl.pbo.buf);
+        _sg.gl.pbo.valid = false;
+    }
+}
+
+/* number of bytes glTex(Sub)Image*() reads for a mipmap with the default GL_UNPACK_ALIGNMENT */
+_SOKOL_PRIVATE int _sg_gl_mip_read_size(const _sg_image_t* img, int mip_index, int data_size) {
+    if (_sg_is_compressed_pixel_format(img->cmn.pixel_format)) {
+        return data_size;
+    }
+    const int mip_width = _sg_max(img->cmn.width >> mip_index, 1);
+    const int mip_height = _sg_max(img->cmn.height >> mip_index, 1);
+    const int mip_depth = (SG_IMAGETYPE_3D == img->cmn.type) ? _sg_max(img->cmn.depth >> mip_index, 1) : img->cmn.depth;
+    const int read_size = (int)_sg_surface_pitch(img->cmn.pixel_format, (uint32_t)mip_width, (uint32_t)mip_height, 4) * mip_depth;
+    return _sg_max(read_size, data_size);
+}
+
+/* called when an upload couldn't be staged and goes through client memory */
+_SOKOL_PRIVATE void _sg_gl_pbo_fallback(void) {
+    _sg.frame_stats.num_upload_image_fallback++;
+    if (!_sg.gl.pbo.fallback_logged) {
+        SOKOL_LOG("sokol_gfx.h: texture upload couldn't be staged in a pixel unpack buffer, uploading from client memory\n");
+        _sg.gl.pbo.fallback_logged = true;
+    }
+}
+
+/* copy the image content into the current frame's pixel unpack buffer,
+   on success, the pixel unpack buffer remains bound and out_offsets
+   contains the buffer offsets to pass as data pointers to glTex(Sub)Image*(),
+   if the content doesn't fit, the pixel unpack buffers grow (the current
+   frame's buffer is orphaned, so uploads already issued this frame keep
+   their data), if staging fails anyway, return false and upload from
+   client memory
+*/
+_SOKOL_PRIVATE bool _sg_gl_stage_image_content(const _sg_image_t* img, const sg_image_content* content, int out_offsets[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS]) {
+    SOKOL_ASSERT(img && content);
+    if (!_sg.gl.pbo.valid) {
+        _sg_gl_init_pbopool();
+    }
+    const int num_faces = (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+    const int num_mips = img->cmn.num_mipmaps;
+    int start = _sg.gl.pbo.offset;
+    int end = start;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < num_mips; mip_index++) {
+            const int data_size = content->subimage[face_index][mip_index].size;
+            out_offsets[face_index][mip_index] = end;
+            end = _sg_roundup(end + _sg_gl_mip_read_size(img, mip_index, data_size), _SG_GL_PBO_ALIGN);
+        }
+    }
+    if (end > _sg.gl.pbo.num_bytes) {
+        /* grow the pixel unpack buffers and restart at the begin of a fresh
+           buffer, the other frames' buffers are resized with their first
+           upload, since that orphans them anyway
+        */
+        _sg.gl.pbo.num_bytes = _sg_max(2 * _sg.gl.pbo.num_bytes, end);
+        for (int face_index = 0; face_index < num_faces; face_index++) {
+            for (int mip_index = 0; mip_index < num_mips; mip_index++) {
+                out_offsets[face_index][mip_index] -= start;
+            }
+        }
+        end -= start;
+        start = 0;
+    }
+    _SG_GL_CHECK_ERROR();
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.pbo.buf[_sg.gl.pbo.frame_index]);
+    if (0 == start) {
+        /* first upload this frame, orphan the buffer to avoid a GPU sync */
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, _sg.gl.pbo.num_bytes, 0, GL_STREAM_DRAW);
+    }
+    /* the mapped range isn't used by the GPU yet, so no need to synchronize */
+    uint8_t* dst = (uint8_t*) glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, start, end - start,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (0 == dst) {
+        /* e.g. out of memory when growing the buffer */
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        _sg_gl_pbo_fallback();
+        return false;
+    }
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < num_mips; mip_index++) {
+            const sg_subimage_content* sub = &content->subimage[face_index][mip_index];
+            memcpy(dst + (out_offsets[face_index][mip_index] - start), sub->ptr, (size_t)sub->size);
+        }
+    }
+    if (!glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+        /* buffer content was lost (e.g. display mode change) */
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        _sg_gl_pbo_fallback();
+        return false;
+    }
+    _SG_GL_CHECK_ERROR();
+    _sg.gl.pbo.offset = end;
+    return true;
+}
+#endif
+
+/*-- GL pixel readback -------------------------------------------------------*/
+_SOKOL_PRIVATE uint8_t* _sg_gl_readback_scratch(int num_bytes) {
+    if (_sg.gl.readback.scratch_size < num_bytes) {
+        if (_sg.gl.readback.scratch) {
+            SOKOL_FREE(_sg.gl.readback.scratch);
+        }
+        _sg.gl.readback.scratch = (uint8_t*) SOKOL_MALLOC((size_t)num_bytes);
+        SOKOL_ASSERT(_sg.gl.readback.scratch);
+        _sg.gl.readback.scratch_size = num_bytes;
+    }
+    return _sg.gl.readback.scratch;
+}
+
+/* glReadPixels() returns the bottom row first, sg_read_pixels_async() the top row */
+_SOKOL_PRIVATE void _sg_gl_flip_rows(uint8_t* dst, const uint8_t* src, int width, int height) {
+    const int row_pitch = width * 4;
+    for (int y = 0; y < height; y++) {
+        memcpy(dst + y * row_pitch, src + (height - 1 - y) * row_pitch, (size_t)row_pitch);
+    }
+}
+
+#if defined(_SOKOL_GL_PBO)
+/* called from _sg_gl_commit(), delivers the readbacks which have finished
+   on the GPU, without waiting for the ones still in flight
+*/
+_SOKOL_PRIVATE void _sg_gl_poll_readbacks(void) {
+    while (_sg.gl.readback.num > 0) {
+        _sg_gl_readback_t* rb = &_sg.gl.readback.items[_sg.gl.readback.head];
+        SOKOL_ASSERT(rb->fence);
+        /* a zero timeout doesn't wait, but the flush is needed to make
+           sure that the fence is eventually signalled
+        */
+        const GLenum res = glClientWaitSync(rb->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if ((res != GL_ALREADY_SIGNALED) && (res != GL_CONDITION_SATISFIED)) {
+            /* readbacks finish in order, so all following are still in flight too */
+            break;
+        }
+        glDeleteSync(rb->fence);
+        rb->fence = 0;
+        if (++_sg.gl.readback.head >= _SG_GL_MAX_READBACKS) {
+            _sg.gl.readback.head = 0;
+        }
+        _sg.gl.readback.num--;
+
+        /* the callback may issue new readbacks, so copy the request */
+        const sg_read_pixels_desc desc = rb->desc;
+        const int num_bytes = desc.width * desc.height * 4;
+        uint8_t* dst = _sg_gl_readback_scratch(num_bytes);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, rb->buf);
+        const uint8_t* src = (const uint8_t*) glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, num_bytes, GL_MAP_READ_BIT);
+        bool valid = false;
+        if (src) {
+            _sg_gl_flip_rows(dst, src, desc.width, desc.height);
+            /* buffer content may have been lost (e.g. display mode change) */
+            valid = glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        _SG_GL_CHECK_ERROR();
+        if (valid) {
+            _sg_read_pixels_callback(&desc, dst, num_bytes);
+        }
+        else {
+            SOKOL_LOG("sg_read_pixels_async: failed to map pixel pack buffer, readback dropped");
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_readbacks(void) {
+    for (int i = 0; i < _SG_GL_MAX_READBACKS; i++) {
+        _sg_gl_readback_t* rb = &_sg.gl.readback.items[i];
+        if (rb->fence) {
+            glDeleteSync(rb->fence);
+            rb->fence = 0;
+        }
+        if (rb->buf) {
+            glDeleteBuffers(1, &rb->buf);
+            rb->buf = 0;
+            rb->buf_size = 0;
+        }
+    }
+    _sg.gl.readback.head = 0;
+    _sg.gl.readback.num = 0;
+}
+#endif
+
+#if defined(_SOKOL_GL_TIMER_QUERY)
+/*-- GL timestamp queries for GPU timings ------------------------------------*/
+
+/* the query objects are only created with the first measurement */
+_SOKOL_PRIVATE void _sg_gl_init_timer(void) {
+    SOKOL_ASSERT(!_sg.gl.timer.valid);
+    for (int i = 0; i < _SG_GL_TIMER_FRAMES; i++) {
+        glGenQueries(2 * SG_MAX_GPU_TIMINGS, _sg.gl.timer.frames[i].queries);
+    }
+    _SG_GL_CHECK_ERROR();
+    _sg.gl.timer.valid = true;
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_timer(void) {
+    if (_sg.gl.timer.valid) {
+        for (int i = 0; i < _SG_GL_TIMER_FRAMES; i++) {
+            glDeleteQueries(2 * SG_MAX_GPU_TIMINGS, _sg.gl.timer.frames[i].queries);
+        }
+        _sg.gl.timer.valid = false;
+    }
+}
+
+/* timestamps instead of GL_TIME_ELAPSED queries, because those can't be nested */
+_SOKOL_PRIVATE void _sg_gl_begin_gpu_timing(const char* name, bool is_pass, sg_pass pass) {
+    if (!_sg.gl.timer.valid) {
+        _sg_gl_init_timer();
+    }
+    _sg_gl_timer_frame_t* frame = &_sg.gl.timer.frames[_sg.gl.timer.cur_frame];
+    const int depth = _sg.gl.timer.depth++;
+    if (depth >= _SG_GL_TIMER_MAX_DEPTH) {
+        return;
+    }
+    int scope_index = -1;
+    if (frame->num_scopes < SG_MAX_GPU_TIMINGS) {
+        scope_index = frame->num_scopes++;
+        sg_gpu_timing* scope = &frame->scopes[scope_index];
+        memset(scope, 0, sizeof(sg_gpu_timing));
+        if (name) {
+            #if defined(_MSC_VER)
+            strncpy_s(scope->name, SG_GPU_TIMING_NAME_SIZE, name, (SG_GPU_TIMING_NAME_SIZE-1));
+            #else
+            strncpy(scope->name, name, SG_GPU_TIMING_NAME_SIZE);
+            #endif
+            scope->name[SG_GPU_TIMING_NAME_SIZE-1] = 0;
+        }
+        scope->is_pass = is_pass;
+        scope->pass = pass;
+        scope->depth = depth;
+        glQueryCounter(frame->queries[2 * scope_index], GL_TIMESTAMP);
+        frame->num_queries++;
+    }
+    _sg.gl.timer.stack[depth] = scope_index;
+}
+
+_SOKOL_PRIVATE void _sg_gl_end_gpu_timing(void) {
+    if (!_sg.gl.timer.valid || (0 == _sg.gl.timer.depth)) {
+        return;
+    }
+    const int depth = --_sg.gl.timer.depth;
+    if (depth >= _SG_GL_TIMER_MAX_DEPTH) {
+        return;
+    }
+    const int scope_index = _sg.gl.timer.stack[depth];
+    if (scope_index >= 0) {
+        _sg_gl_timer_frame_t* frame = &_sg.gl.timer.frames[_sg.gl.timer.cur_frame];
+        glQueryCounter(frame->queries[2 * scope_index + 1], GL_TIMESTAMP);
+        frame->num_queries++;
+    }
+}
+
+/* read the results of a frame's queries if all of them are available */
+_SOKOL_PRIVATE bool _sg_gl_read_timer_frame(_sg_gl_timer_frame_t* frame) {
+    SOKOL_ASSERT(frame->pending && (frame->num_queries == 2 * frame->num_scopes));
+    for (int i = 0; i < frame->num_queries; i++) {
+        GLint available = 0;
+        glGetQueryObjectiv(frame->queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+    }
+    GLuint64 first_ts = 0;
+    for (int i = 0; i < frame->num_scopes; i++) {
+        GLuint64 begin_ts = 0, end_ts = 0;
+        glGetQueryObjectui64v(frame->queries[2 * i], GL_QUERY_RESULT, &begin_ts);
+        glGetQueryObjectui64v(frame->queries[2 * i + 1], GL_QUERY_RESULT, &end_ts);
+        if (0 == i) {
+            first_ts = begin_ts;
+        }
+        sg_gpu_timing* scope = &frame->scopes[i];
+        scope->start_ns = (begin_ts > first_ts) ? (begin_ts - first_ts) : 0;
+        scope->duration_ns = (end_ts > begin_ts) ? (end_ts - begin_ts) : 0;
+    }
+    _SG_GL_CHECK_ERROR();
+    return true;
+}
+
+/* called from _sg_gl_commit(), this never waits for query results, if the
+   GPU is too far behind, the oldest frame's measurements are dropped
+*/
+_SOKOL_PRIVATE void _sg_gl_commit_timer(void) {
+    if (!_sg.gl.timer.valid) {
+        return;
+    }
+    /* close debug groups which haven't been popped in this frame */
+    while (_sg.gl.timer.depth > 0) {
+        _sg_gl_end_gpu_timing();
+    }
+    _sg_gl_timer_frame_t* cur = &_sg.gl.timer.frames[_sg.gl.timer.cur_frame];
+    cur->frame_index = _sg.frame_index;
+    cur->pending = (cur->num_scopes > 0);
+    if (++_sg.gl.timer.cur_frame >= _SG_GL_TIMER_FRAMES) {
+        _sg.gl.timer.cur_frame = 0;
+    }
+    /* check the pending frames from oldest to newest, queries finish in order */
+    for (int i = 0; i < _SG_GL_TIMER_FRAMES; i++) {
+        const int frame_index = (_sg.gl.timer.cur_frame + i) % _SG_GL_TIMER_FRAMES;
+        _sg_gl_timer_frame_t* frame = &_sg.gl.timer.frames[frame_index];
+        if (!frame->pending) {
+            continue;
+        }
+        if (!_sg_gl_read_timer_frame(frame)) {
+            break;
+        }
+        _sg.gpu_timings.frame_index = frame->frame_index;
+        _sg.gpu_timings.num_timings = frame->num_scopes;
+        memcpy(_sg.gpu_timings.timings, frame->scopes, (size_t)frame->num_scopes * sizeof(sg_gpu_timing));
+        frame->pending = false;
+    }
+    /* the next recorded frame reuses the oldest frame's query objects */
+    _sg_gl_timer_frame_t* next = &_sg.gl.timer.frames[_sg.gl.timer.cur_frame];
+    next->pending = false;
+    next->num_scopes = 0;
+    next->num_queries = 0;
+}
+#endif
+
+#if defined(_SOKOL_GL_BUFFER_STORAGE)
+/*-- GL persistently mapped stream buffers -----------------------------------*/
+_SOKOL_PRIVATE void _sg_gl_client_wait(GLsync fence) {
+    GLenum res;
+    do {
+        res = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    } while (res == GL_TIMEOUT_EXPIRED);
+}
+
+/* called from _sg_gl_commit(), keeps the CPU at most SG_NUM_INFLIGHT_FRAMES
+   frames ahead of the GPU, so that only the fences of the last
+   SG_NUM_INFLIGHT_FRAMES frames need to be kept around
+*/
+_SOKOL_PRIVATE void _sg_gl_frame_fence(void) {
+    const int fence_index = (int)(_sg.frame_index % SG_NUM_INFLIGHT_FRAMES);
+    GLsync* fence = &_sg.gl.frame_fences[fence_index];
+    if (*fence) {
+        _sg_gl_client_wait(*fence);
+        glDeleteSync(*fence);
+        *fence = 0;
+    }
+    if (_sg.gl.num_mapped_buffers > 0) {
+        *fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_frame_fences(void) {
+    for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
+        if (_sg.gl.frame_fences[i]) {
+            glDeleteSync(_sg.gl.frame_fences[i]);
+            _sg.gl.frame_fences[i] = 0;
+        }
+    }
+}
+
+/* wait until the GPU is done with the last frame which rendered
+   from the buffer's active slot, call this before writing to a slot
+   which has been rotated in
+*/
+_SOKOL_PRIVATE void _sg_gl_wait_buffer_slot(const _sg_buffer_t* buf) {
+    const uint32_t used_frame_index = buf->gl.used_frame_index[buf->cmn.active_slot];
+    if (0 == used_frame_index) {
+        /* never rendered from */
+        return;
+    }
+    SOKOL_ASSERT(used_frame_index < _sg.frame_index);
+    if ((used_frame_index + SG_NUM_INFLIGHT_FRAMES) < _sg.frame_index) {
+        /* already waited for in _sg_gl_frame_fence() */
+        return;
+    }
+    GLsync fence = _sg.gl.frame_fences[used_frame_index % SG_NUM_INFLIGHT_FRAMES];
+    if (fence) {
+        _sg_gl_client_wait(fence);
+    }
+}
+#endif
+
+/*-- GL deferred object deletion ---------------------------------------------*/
+_SOKOL_PRIVATE void _sg_gl_delete_later(_sg_gl_delete_type_t type, GLuint name) {
+    SOKOL_ASSERT((type >= 0) && (type < _SG_GL_DELETE_NUM) && (0 != name));
+    const int frame_slot = (int)(_sg.frame_index % SG_NUM_INFLIGHT_FRAMES);
+    _sg_gl_delete_list_t* list = &_sg.gl.delete_queue.lists[frame_slot][type];
+    if (list->num == list->capacity) {
+        const int new_capacity = list->capacity ? (2 * list->capacity) : _SG_GL_DELETE_LIST_INITIAL_CAPACITY;
+        GLuint* new_names = (GLuint*) SOKOL_MALLOC((size_t)new_capacity * sizeof(GLuint));
+        SOKOL_ASSERT(new_names);
+        if (list->names) {
+            memcpy(new_names, list->names, (size_t)list->num * sizeof(GLuint));
+            SOKOL_FREE(list->names);
+        }
+        list->names = new_names;
+        list->capacity = new_capacity;
+    }
+    list->names[list->num++] = name;
+}
+
+/* delete all GL objects queued in one frame slot, the lists keep their capacity */
+_SOKOL_PRIVATE void _sg_gl_delete_queued(int frame_slot) {
+    SOKOL_ASSERT((frame_slot >= 0) && (frame_slot < SG_NUM_INFLIGHT_FRAMES));
+    _sg_gl_delete_list_t* lists = _sg.gl.delete_queue.lists[frame_slot];
+    _SG_GL_CHECK_ERROR();
+    if (lists[_SG_GL_DELETE_BUFFERS].num > 0) {
+        glDeleteBuffers(lists[_SG_GL_DELETE_BUFFERS].num, lists[_SG_GL_DELETE_BUFFERS].names);
+    }
+    if (lists[_SG_GL_DELETE_TEXTURES].num > 0) {
+        glDeleteTextures(lists[_SG_GL_DELETE_TEXTURES].num, lists[_SG_GL_DELETE_TEXTURES].names);
+    }
+    if (lists[_SG_GL_DELETE_RENDERBUFFERS].num > 0) {
+        glDeleteRenderbuffers(lists[_SG_GL_DELETE_RENDERBUFFERS].num, lists[_SG_GL_DELETE_RENDERBUFFERS].names);
+    }
+    /* there's no batched version of glDeleteProgram() */
+    for (int i = 0; i < lists[_SG_GL_DELETE_PROGRAMS].num; i++) {
+        glDeleteProgram(lists[_SG_GL_DELETE_PROGRAMS].names[i]);
+    }
+    for (int type = 0; type < _SG_GL_DELETE_NUM; type++) {
+        lists[type].num = 0;
+    }
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE void _sg_gl_delete_all_queued(void) {
+    for (int frame_slot = 0; frame_slot < SG_NUM_INFLIGHT_FRAMES; frame_slot++) {
+        _sg_gl_delete_queued(frame_slot);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_delete_queue(void) {
+    _sg_gl_delete_all_queued();
+    for (int frame_slot = 0; frame_slot < SG_NUM_INFLIGHT_FRAMES; frame_slot++) {
+        for (int type = 0; type < _SG_GL_DELETE_NUM; type++) {
+            _sg_gl_delete_list_t* list = &_sg.gl.delete_queue.lists[frame_slot][type];
+            if (list->names) {
+                SOKOL_FREE(list->names);
+            }
+            memset(list, 0, sizeof(_sg_gl_delete_list_t));
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
+    /* assumes that _sg.gl is already zero-initialized */
+    _sg.gl.valid = true;
+    #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+    _sg.gl.gles2 = desc->context.gl.force_gles2;
+    #else
+    _SOKOL_UNUSED(desc);
+    _sg.gl.gles2 = false;
+    #endif
+
+    /* clear initial GL error state */
+    #if defined(SOKOL_DEBUG)
+        while (glGetError() != GL_NO_ERROR);
+    #endif
+    #if defined(SOKOL_GLCORE33)
+        _sg_gl_init_caps_glcore33();
+    #elif defined(SOKOL_GLES3)
+        if (_sg.gl.gles2) {
+            _sg_gl_init_caps_gles2();
+        }
+        else {
+            _sg_gl_init_caps_gles3();
+        }
+    #else
+        _sg_gl_init_caps_gles2();
+    #endif
+
+    #if defined(_SOKOL_GL_PROGRAM_BINARY)
+    if (!_sg.gl.gles2 && desc->context.gl.program_cache_load_cb && desc->context.gl.program_cache_store_cb) {
+        GLint num_formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+        /* GL 3.3 without ARB_get_program_binary may report an error here */
+        while (glGetError() != GL_NO_ERROR);
+        if (num_formats > 0) {
+            _sg.gl.program_cache_enabled = true;
+            uint64_t salt = _SG_GL_FNV64_SEED;
+            salt = _sg_gl_hash_str(salt, (const char*)glGetString(GL_VENDOR));
+            salt = _sg_gl_hash_str(salt, (const char*)glGetString(GL_RENDERER));
+            salt = _sg_gl_hash_str(salt, (const char*)glGetString(GL_VERSION));
+            _sg.gl.program_cache_salt = salt;
+        }
+    }
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_backend(void) {
+    SOKOL_ASSERT(_sg.gl.valid);
+    _sg_gl_discard_delete_queue();
+    #if defined(_SOKOL_GL_UBO)
+    _sg_gl_discard_ubpool();
+    #endif
+    #if defined(_SOKOL_GL_PBO)
+    _sg_gl_discard_pbopool();
+    #endif
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    _sg_gl_discard_frame_fences();
+    #endif
+    #if defined(_SOKOL_GL_PBO)
+    _sg_gl_discard_readbacks();
+    #endif
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    _sg_gl_discard_timer();
+    #endif
+    if (_sg.gl.readback.scratch) {
+        SOKOL_FREE(_sg.gl.readback.scratch);
+        _sg.gl.readback.scratch = 0;
+        _sg.gl.readback.scratch_size = 0;
+    }
+    _sg.gl.valid = false;
+}
+
+_SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
+    if (_sg.gl.cur_context) {
+        _SG_GL_CHECK_ERROR();
+        #if !defined(SOKOL_GLES2)
+        if (!_sg.gl.gles2) {
+            /* native GL code may have modified the cached vao which was bound last */
+            _sg_gl_vao_t* cur_vao = _sg.gl.cache.cur_vao;
+            if (cur_vao) {
+                glDeleteVertexArrays(1, &cur_vao->vao);
+                memset(cur_vao, 0, sizeof(_sg_gl_vao_t));
+            }
+            glBindVertexArray(_sg.gl.cur_context->vao);
+            _SG_GL_CHECK_ERROR();
+        }
+        #endif
+        memset(&_sg.gl.cache, 0, sizeof(_sg.gl.cache));
+        _sg_gl_clear_buffer_bindings(true);
+        _SG_GL_CHECK_ERROR();
+        _sg_gl_clear_texture_bindings(true);
+        _SG_GL_CHECK_ERROR();
+        for (uint32_t i = 0; i < _sg.limits.max_vertex_attrs; i++) {
+            _sg_gl_init_attr(&_sg.gl.cache.attrs[i].gl_attr);
+            glDisableVertexAttribArray(i);
+            _SG_GL_CHECK_ERROR();
+        }
+        _sg.gl.cache.cur_primitive_type = GL_TRIANGLES;
 
         /* depth-stencil state */
         _sg_gl_init_depth_stencil_state(&_sg.gl.cache.ds);
@@ -5417,6 +8417,10 @@ _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
 _SOKOL_PRIVATE void _sg_gl_activate_context(_sg_context_t* ctx) {
     SOKOL_ASSERT(_sg.gl.valid);
     /* NOTE: ctx can be 0 to unset the current context */
+    #if !defined(SOKOL_GLES2)
+    /* the current vao belongs to the previous context */
+    _sg.gl.cache.cur_vao = 0;
+    #endif
     _sg.gl.cur_context = ctx;
     _sg_gl_reset_state_cache();
 }
@@ -5434,6 +8438,10 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_context(_sg_context_t* ctx) {
         glGenVertexArrays(1, &ctx->vao);
         glBindVertexArray(ctx->vao);
         _SG_GL_CHECK_ERROR();
+        const int vao_cache_size = _SG_GL_VAO_CACHE_SIZE * (int)sizeof(_sg_gl_vao_t);
+        ctx->vao_cache = (_sg_gl_vao_t*) SOKOL_MALLOC(vao_cache_size);
+        SOKOL_ASSERT(ctx->vao_cache);
+        memset(ctx->vao_cache, 0, vao_cache_size);
     }
     #endif
     return SG_RESOURCESTATE_VALID;
@@ -5441,10 +8449,24 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_context(_sg_context_t* ctx) {
 
 _SOKOL_PRIVATE void _sg_gl_destroy_context(_sg_context_t* ctx) {
     SOKOL_ASSERT(ctx);
+    /* the GL context may go away after this, so don't defer any deletions */
+    _sg_gl_delete_all_queued();
     #if !defined(SOKOL_GLES2)
     if (!_sg.gl.gles2) {
-        if (ctx->vao) {
-            glDeleteVertexArrays(1, &ctx->vao);
+        if (ctx->vao_cache) {
+            for (int i = 0; i < _SG_GL_VAO_CACHE_SIZE; i++) {
+                if (ctx->vao_cache[i].vao) {
+                    glDeleteVertexArrays(1, &ctx->vao_cache[i].vao);
+                }
+            }
+            SOKOL_FREE(ctx->vao_cache);
+            ctx->vao_cache = 0;
+            if (_sg.gl.cur_context == ctx) {
+                _sg.gl.cache.cur_vao = 0;
+            }
+        }
+        if (ctx->vao) {
+            glDeleteVertexArrays(1, &ctx->vao);
         }
         _SG_GL_CHECK_ERROR();
     }
@@ -5458,6 +8480,10 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
     buf->gl.ext_buffers = (0 != desc->gl_buffers[0]);
     GLenum gl_target = _sg_gl_buffer_target(buf->cmn.type);
     GLenum gl_usage  = _sg_gl_usage(buf->cmn.usage);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    /* stream buffers are persistently mapped if possible, updates are then a memcpy */
+    const bool persistent = _sg.gl.buffer_storage && !buf->gl.ext_buffers && (buf->cmn.usage == SG_USAGE_STREAM);
+    #endif
     for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
         GLuint gl_buf = 0;
         if (buf->gl.ext_buffers) {
@@ -5468,15 +8494,37 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
             glGenBuffers(1, &gl_buf);
             _sg_gl_store_buffer_binding(gl_target);
             _sg_gl_bind_buffer(gl_target, gl_buf);
-            glBufferData(gl_target, buf->cmn.size, 0, gl_usage);
-            if (buf->cmn.usage == SG_USAGE_IMMUTABLE) {
-                SOKOL_ASSERT(desc->content);
-                glBufferSubData(gl_target, 0, buf->cmn.size, desc->content);
+            #if defined(_SOKOL_GL_BUFFER_STORAGE)
+            if (persistent) {
+                const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                glBufferStorage(gl_target, buf->cmn.size, 0, flags);
+                buf->gl.mapped[slot] = (uint8_t*) glMapBufferRange(gl_target, 0, buf->cmn.size, flags);
+            }
+            else
+            #endif
+            {
+                glBufferData(gl_target, buf->cmn.size, 0, gl_usage);
+                if (buf->cmn.usage == SG_USAGE_IMMUTABLE) {
+                    SOKOL_ASSERT(desc->content);
+                    glBufferSubData(gl_target, 0, buf->cmn.size, desc->content);
+                }
             }
             _sg_gl_restore_buffer_binding(gl_target);
         }
         buf->gl.buf[slot] = gl_buf;
+        #if defined(_SOKOL_GL_BUFFER_STORAGE)
+        if (persistent && (0 == buf->gl.mapped[slot])) {
+            SOKOL_LOG("_sg_gl_create_buffer: failed to map stream buffer");
+            memset(buf->gl.mapped, 0, sizeof(buf->gl.mapped));
+            return SG_RESOURCESTATE_FAILED;
+        }
+        #endif
     }
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (persistent) {
+        _sg.gl.num_mapped_buffers++;
+    }
+    #endif
     _SG_GL_CHECK_ERROR();
     return SG_RESOURCESTATE_VALID;
 }
@@ -5485,9 +8533,17 @@ _SOKOL_PRIVATE void _sg_gl_destroy_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf);
     _SG_GL_CHECK_ERROR();
     if (!buf->gl.ext_buffers) {
+        #if defined(_SOKOL_GL_BUFFER_STORAGE)
+        if (buf->gl.mapped[0]) {
+            /* deleting the buffer objects also unmaps them */
+            SOKOL_ASSERT(_sg.gl.num_mapped_buffers > 0);
+            _sg.gl.num_mapped_buffers--;
+        }
+        #endif
         for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
             if (buf->gl.buf[slot]) {
-                glDeleteBuffers(1, &buf->gl.buf[slot]);
+                _sg_gl_invalidate_buffer(buf->gl.buf[slot]);
+                _sg_gl_delete_later(_SG_GL_DELETE_BUFFERS, buf->gl.buf[slot]);
             }
         }
         _SG_GL_CHECK_ERROR();
@@ -5570,6 +8626,14 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
             /* create our own GL texture(s) */
             const GLenum gl_format = _sg_gl_teximage_format(img->cmn.pixel_format);
             const bool is_compressed = _sg_is_compressed_pixel_format(img->cmn.pixel_format);
+            #if defined(_SOKOL_GL_PBO)
+            /* stage the initial content once in a pixel unpack buffer, this
+               is shared by all slots of a dynamic or stream image
+            */
+            int pbo_offsets[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS];
+            const bool use_pbo = !_sg.gl.gles2 && (0 != desc->content.subimage[0][0].ptr) &&
+                _sg_gl_stage_image_content(img, &desc->content, pbo_offsets);
+            #endif
             for (int slot = 0; slot < img->cmn.num_slots; slot++) {
                 glGenTextures(1, &img->gl.tex[slot]);
                 _sg_gl_store_texture_binding(0);
@@ -5632,6 +8696,11 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                         }
                         const GLvoid* data_ptr = desc->content.subimage[face_index][mip_index].ptr;
                         const int data_size = desc->content.subimage[face_index][mip_index].size;
+                        #if defined(_SOKOL_GL_PBO)
+                        if (use_pbo) {
+                            data_ptr = (const GLvoid*)(GLintptr)pbo_offsets[face_index][mip_index];
+                        }
+                        #endif
                         int mip_width = img->cmn.width >> mip_index;
                         if (mip_width == 0) {
                             mip_width = 1;
@@ -5675,6 +8744,11 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                 }
                 _sg_gl_restore_texture_binding(0);
             }
+            #if defined(_SOKOL_GL_PBO)
+            if (use_pbo) {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            #endif
         }
     }
     _SG_GL_CHECK_ERROR();
@@ -5687,15 +8761,15 @@ _SOKOL_PRIVATE void _sg_gl_destroy_image(_sg_image_t* img) {
     if (!img->gl.ext_textures) {
         for (int slot = 0; slot < img->cmn.num_slots; slot++) {
             if (img->gl.tex[slot]) {
-                glDeleteTextures(1, &img->gl.tex[slot]);
+                _sg_gl_delete_later(_SG_GL_DELETE_TEXTURES, img->gl.tex[slot]);
             }
         }
     }
     if (img->gl.depth_render_buffer) {
-        glDeleteRenderbuffers(1, &img->gl.depth_render_buffer);
+        _sg_gl_delete_later(_SG_GL_DELETE_RENDERBUFFERS, img->gl.depth_render_buffer);
     }
     if (img->gl.msaa_render_buffer) {
-        glDeleteRenderbuffers(1, &img->gl.msaa_render_buffer);
+        _sg_gl_delete_later(_SG_GL_DELETE_RENDERBUFFERS, img->gl.msaa_render_buffer);
     }
     _SG_GL_CHECK_ERROR();
 }
@@ -5737,32 +8811,53 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
         _sg_strcpy(&shd->gl.attrs[i].name, desc->attrs[i].name);
     }
 
-    GLuint gl_vs = _sg_gl_compile_shader(SG_SHADERSTAGE_VS, desc->vs.source);
-    GLuint gl_fs = _sg_gl_compile_shader(SG_SHADERSTAGE_FS, desc->fs.source);
-    if (!(gl_vs && gl_fs)) {
-        return SG_RESOURCESTATE_FAILED;
+    /* try the program binary cache first */
+    _sg_gl_program_cache_header_t cache_hdr;
+    memset(&cache_hdr, 0, sizeof(cache_hdr));
+    GLuint gl_prog = 0;
+    bool from_cache = false;
+    #if defined(_SOKOL_GL_PROGRAM_BINARY)
+    uint64_t cache_key = 0;
+    if (_sg.gl.program_cache_enabled) {
+        cache_key = _sg_gl_program_cache_key(desc);
+        gl_prog = _sg_gl_load_program(cache_key, &cache_hdr);
+        from_cache = (0 != gl_prog);
     }
-    GLuint gl_prog = glCreateProgram();
-    glAttachShader(gl_prog, gl_vs);
-    glAttachShader(gl_prog, gl_fs);
-    glLinkProgram(gl_prog);
-    glDeleteShader(gl_vs);
-    glDeleteShader(gl_fs);
-    _SG_GL_CHECK_ERROR();
+    #endif
 
-    GLint link_status;
-    glGetProgramiv(gl_prog, GL_LINK_STATUS, &link_status);
-    if (!link_status) {
-        GLint log_len = 0;
-        glGetProgramiv(gl_prog, GL_INFO_LOG_LENGTH, &log_len);
-        if (log_len > 0) {
-            GLchar* log_buf = (GLchar*) SOKOL_MALLOC(log_len);
-            glGetProgramInfoLog(gl_prog, log_len, &log_len, log_buf);
-            SOKOL_LOG(log_buf);
-            SOKOL_FREE(log_buf);
+    if (!from_cache) {
+        GLuint gl_vs = _sg_gl_compile_shader(SG_SHADERSTAGE_VS, desc->vs.source);
+        GLuint gl_fs = _sg_gl_compile_shader(SG_SHADERSTAGE_FS, desc->fs.source);
+        if (!(gl_vs && gl_fs)) {
+            return SG_RESOURCESTATE_FAILED;
+        }
+        gl_prog = glCreateProgram();
+        glAttachShader(gl_prog, gl_vs);
+        glAttachShader(gl_prog, gl_fs);
+        #if defined(_SOKOL_GL_PROGRAM_BINARY)
+        if (_sg.gl.program_cache_enabled) {
+            glProgramParameteri(gl_prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        #endif
+        glLinkProgram(gl_prog);
+        glDeleteShader(gl_vs);
+        glDeleteShader(gl_fs);
+        _SG_GL_CHECK_ERROR();
+
+        GLint link_status;
+        glGetProgramiv(gl_prog, GL_LINK_STATUS, &link_status);
+        if (!link_status) {
+            GLint log_len = 0;
+            glGetProgramiv(gl_prog, GL_INFO_LOG_LENGTH, &log_len);
+            if (log_len > 0) {
+                GLchar* log_buf = (GLchar*) SOKOL_MALLOC(log_len);
+                glGetProgramInfoLog(gl_prog, log_len, &log_len, log_buf);
+                SOKOL_LOG(log_buf);
+                SOKOL_FREE(log_buf);
+            }
+            glDeleteProgram(gl_prog);
+            return SG_RESOURCESTATE_FAILED;
         }
-        glDeleteProgram(gl_prog);
-        return SG_RESOURCESTATE_FAILED;
     }
     shd->gl.prog = gl_prog;
 
@@ -5787,15 +8882,36 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
                 u->count = (uint8_t) u_desc->array_count;
                 u->offset = (uint16_t) cur_uniform_offset;
                 cur_uniform_offset += _sg_uniform_size(u->type, u->count);
-                if (u_desc->name) {
+                if (from_cache) {
+                    u->gl_loc = cache_hdr.uniform_locs[stage_index][ub_index][u_index];
+                }
+                else if (u_desc->name) {
                     u->gl_loc = glGetUniformLocation(gl_prog, u_desc->name);
                 }
                 else {
                     u->gl_loc = u_index;
                 }
+                cache_hdr.uniform_locs[stage_index][ub_index][u_index] = u->gl_loc;
                 ub->num_uniforms++;
             }
             SOKOL_ASSERT(ub_desc->size == cur_uniform_offset);
+            #if defined(_SOKOL_GL_UBO)
+            if (!_sg.gl.gles2 && ub_desc->name) {
+                /* the uniform block binding isn't part of the program binary, so always set it */
+                const GLuint gl_block_index = glGetUniformBlockIndex(gl_prog, ub_desc->name);
+                if (GL_INVALID_INDEX != gl_block_index) {
+                    glUniformBlockBinding(gl_prog, gl_block_index, (GLuint)(stage_index * SG_MAX_SHADERSTAGE_UBS + ub_index));
+                    ub->ubo = true;
+                    _sg_gl_std140_layout(ub, ub_desc->size);
+                    if (!ub->std140_packed) {
+                        _sg_gl_reserve_ub_scratch(ub->std140_size);
+                    }
+                    if (!_sg.gl.ub.valid) {
+                        _sg_gl_init_ubpool();
+                    }
+                }
+            }
+            #endif
         }
     }
 
@@ -5809,6 +8925,11 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
             const sg_shader_image_desc* img_desc = &stage_desc->images[img_index];
             SOKOL_ASSERT(img_desc->type != _SG_IMAGETYPE_DEFAULT);
             _sg_gl_shader_image_t* gl_img = &gl_stage->images[img_index];
+            if (from_cache) {
+                gl_img->gl_loc = cache_hdr.image_locs[stage_index][img_index];
+                gl_img->gl_tex_slot = cache_hdr.image_tex_slots[stage_index][img_index];
+                continue;
+            }
             gl_img->gl_loc = img_index;
             if (img_desc->name) {
                 gl_img->gl_loc = glGetUniformLocation(gl_prog, img_desc->name);
@@ -5819,9 +8940,16 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
             else {
                 gl_img->gl_tex_slot = -1;
             }
+            cache_hdr.image_locs[stage_index][img_index] = gl_img->gl_loc;
+            cache_hdr.image_tex_slots[stage_index][img_index] = gl_img->gl_tex_slot;
         }
     }
     _SG_GL_CHECK_ERROR();
+    #if defined(_SOKOL_GL_PROGRAM_BINARY)
+    if (_sg.gl.program_cache_enabled && !from_cache) {
+        _sg_gl_store_program(cache_key, gl_prog, &cache_hdr);
+    }
+    #endif
     return SG_RESOURCESTATE_VALID;
 }
 
@@ -5829,7 +8957,7 @@ _SOKOL_PRIVATE void _sg_gl_destroy_shader(_sg_shader_t* shd) {
     SOKOL_ASSERT(shd);
     _SG_GL_CHECK_ERROR();
     if (shd->gl.prog) {
-        glDeleteProgram(shd->gl.prog);
+        _sg_gl_delete_later(_SG_GL_DELETE_PROGRAMS, shd->gl.prog);
     }
     _SG_GL_CHECK_ERROR();
 }
@@ -6425,12 +9553,168 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
     }
 }
 
+/* issue the GL calls to get from the vertex attribute state in cache_attrs
+   to the state in attrs, and update cache_attrs accordingly
+*/
+_SOKOL_PRIVATE void _sg_gl_update_vertex_attrs(_sg_gl_cache_attr_t* cache_attrs, const _sg_gl_cache_attr_t* attrs) {
+    for (uint32_t attr_index = 0; attr_index < _sg.limits.max_vertex_attrs; attr_index++) {
+        const _sg_gl_cache_attr_t* attr = &attrs[attr_index];
+        _sg_gl_cache_attr_t* cache_attr = &cache_attrs[attr_index];
+        bool cache_attr_dirty = false;
+        if (attr->gl_attr.vb_index >= 0) {
+            /* attribute is enabled */
+            if ((attr->gl_vbuf != cache_attr->gl_vbuf) ||
+                (attr->gl_attr.size != cache_attr->gl_attr.size) ||
+                (attr->gl_attr.type != cache_attr->gl_attr.type) ||
+                (attr->gl_attr.normalized != cache_attr->gl_attr.normalized) ||
+                (attr->gl_attr.stride != cache_attr->gl_attr.stride) ||
+                (attr->gl_attr.offset != cache_attr->gl_attr.offset) ||
+                (attr->gl_attr.divisor != cache_attr->gl_attr.divisor))
+            {
+                _sg_gl_bind_buffer(GL_ARRAY_BUFFER, attr->gl_vbuf);
+                glVertexAttribPointer(attr_index, attr->gl_attr.size, attr->gl_attr.type,
+                    attr->gl_attr.normalized, attr->gl_attr.stride,
+                    (const GLvoid*)(GLintptr)attr->gl_attr.offset);
+                #ifdef SOKOL_INSTANCING_ENABLED
+                    if (_sg.features.instancing) {
+                        glVertexAttribDivisor(attr_index, attr->gl_attr.divisor);
+                    }
+                #endif
+                cache_attr_dirty = true;
+            }
+            if (cache_attr->gl_attr.vb_index == -1) {
+                glEnableVertexAttribArray(attr_index);
+                cache_attr_dirty = true;
+            }
+        }
+        else {
+            /* attribute is disabled */
+            if (cache_attr->gl_attr.vb_index != -1) {
+                glDisableVertexAttribArray(attr_index);
+                cache_attr_dirty = true;
+            }
+        }
+        if (cache_attr_dirty) {
+            *cache_attr = *attr;
+        }
+    }
+}
+
+#if !defined(SOKOL_GLES2)
+/*-- GL vertex array object cache --------------------------------------------*/
+_SOKOL_PRIVATE uint32_t _sg_gl_hash_vertex_attrs(const _sg_gl_cache_attr_t* attrs) {
+    /* FNV-1a over the enabled attributes */
+    uint32_t hash = 2166136261u;
+    for (uint32_t attr_index = 0; attr_index < _sg.limits.max_vertex_attrs; attr_index++) {
+        const _sg_gl_cache_attr_t* attr = &attrs[attr_index];
+        if (attr->gl_attr.vb_index >= 0) {
+            const uint32_t vals[5] = {
+                attr_index,
+                attr->gl_vbuf,
+                (uint32_t)attr->gl_attr.offset,
+                attr->gl_attr.type,
+                (uint32_t)((attr->gl_attr.size << 24) | (attr->gl_attr.stride << 16) | (attr->gl_attr.normalized << 8) | (uint8_t)attr->gl_attr.divisor)
+            };
+            for (int i = 0; i < 5; i++) {
+                hash = (hash ^ vals[i]) * 16777619u;
+            }
+        }
+    }
+    return hash;
+}
+
+_SOKOL_PRIVATE bool _sg_gl_equal_vertex_attrs(const _sg_gl_cache_attr_t* a, const _sg_gl_cache_attr_t* b) {
+    for (uint32_t attr_index = 0; attr_index < _sg.limits.max_vertex_attrs; attr_index++) {
+        const _sg_gl_cache_attr_t* a0 = &a[attr_index];
+        const _sg_gl_cache_attr_t* a1 = &b[attr_index];
+        if ((a0->gl_attr.vb_index >= 0) != (a1->gl_attr.vb_index >= 0)) {
+            return false;
+        }
+        if (a0->gl_attr.vb_index >= 0) {
+            if ((a0->gl_vbuf != a1->gl_vbuf) ||
+                (a0->gl_attr.size != a1->gl_attr.size) ||
+                (a0->gl_attr.type != a1->gl_attr.type) ||
+                (a0->gl_attr.normalized != a1->gl_attr.normalized) ||
+                (a0->gl_attr.stride != a1->gl_attr.stride) ||
+                (a0->gl_attr.offset != a1->gl_attr.offset) ||
+                (a0->gl_attr.divisor != a1->gl_attr.divisor))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* bind a vertex array object with the required vertex attribute state,
+   in the common case this is a cache hit and only needs a single
+   glBindVertexArray() (or nothing if the vao is already bound), on a
+   cache miss the least recently used vao is reconfigured
+*/
+_SOKOL_PRIVATE void _sg_gl_apply_vao(const _sg_gl_cache_attr_t* attrs, GLuint gl_ib) {
+    _sg_context_t* ctx = _sg.gl.cur_context;
+    SOKOL_ASSERT(ctx && ctx->vao_cache);
+    const uint32_t hash = _sg_gl_hash_vertex_attrs(attrs);
+    _sg_gl_vao_t* vao = _sg.gl.cache.cur_vao;
+    bool hit = vao && (vao->hash == hash) && _sg_gl_equal_vertex_attrs(vao->attrs, attrs);
+    if (!hit) {
+        _sg_gl_vao_t* lru = &ctx->vao_cache[0];
+        for (int i = 0; i < _SG_GL_VAO_CACHE_SIZE; i++) {
+            _sg_gl_vao_t* item = &ctx->vao_cache[i];
+            if (item->vao && (item->hash == hash) && _sg_gl_equal_vertex_attrs(item->attrs, attrs)) {
+                vao = item;
+                hit = true;
+                break;
+            }
+            if (item->last_use < lru->last_use) {
+                lru = item;
+            }
+        }
+        if (!hit) {
+            vao = lru;
+            if (0 == vao->vao) {
+                /* a new vao has all attributes disabled */
+                glGenVertexArrays(1, &vao->vao);
+                vao->gl_ib = 0;
+                for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+                    memset(&vao->attrs[i], 0, sizeof(_sg_gl_cache_attr_t));
+                    _sg_gl_init_attr(&vao->attrs[i].gl_attr);
+                }
+            }
+            else if (0 != vao->base_vertex) {
+                /* the per-vertex attribute pointers don't match attrs[], force an update */
+                for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+                    if ((vao->attrs[i].gl_attr.vb_index >= 0) && (0 == vao->attrs[i].gl_attr.divisor)) {
+                        vao->attrs[i].gl_attr.offset = -1;
+                    }
+                }
+            }
+            vao->base_vertex = 0;
+        }
+    }
+    if (vao != _sg.gl.cache.cur_vao) {
+        if (_sg.gl.cache.cur_vao) {
+            _sg.gl.cache.cur_vao->gl_ib = _sg.gl.cache.index_buffer;
+        }
+        glBindVertexArray(vao->vao);
+        _sg.gl.cache.index_buffer = vao->gl_ib;
+        _sg.gl.cache.cur_vao = vao;
+    }
+    if (!hit) {
+        _sg_gl_update_vertex_attrs(vao->attrs, attrs);
+        vao->hash = hash;
+    }
+    vao->last_use = ++ctx->vao_use_counter;
+    _sg_gl_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_apply_bindings(
     _sg_pipeline_t* pip,
-    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
-    _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    const _sg_buffer_hot_t** vbs, const int* vb_offsets, int num_vbs,
+    const _sg_buffer_hot_t* ib, int ib_offset,
+    const _sg_image_hot_t** vs_imgs, int num_vs_imgs,
+    const _sg_image_hot_t** fs_imgs, int num_fs_imgs)
 {
     SOKOL_ASSERT(pip);
     _SOKOL_UNUSED(num_fs_imgs);
@@ -6443,80 +9727,119 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
     for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
         const _sg_shader_stage_t* stage = &pip->shader->cmn.stage[stage_index];
         const _sg_gl_shader_stage_t* gl_stage = &pip->shader->gl.stage[stage_index];
-        _sg_image_t** imgs = (stage_index == SG_SHADERSTAGE_VS)? vs_imgs : fs_imgs;
+        const _sg_image_hot_t** imgs = (stage_index == SG_SHADERSTAGE_VS)? vs_imgs : fs_imgs;
         SOKOL_ASSERT(((stage_index == SG_SHADERSTAGE_VS)? num_vs_imgs : num_fs_imgs) == stage->num_images);
         for (int img_index = 0; img_index < stage->num_images; img_index++) {
             const _sg_gl_shader_image_t* gl_shd_img = &gl_stage->images[img_index];
             if (gl_shd_img->gl_loc != -1) {
-                _sg_image_t* img = imgs[img_index];
-                const GLuint gl_tex = img->gl.tex[img->cmn.active_slot];
+                const _sg_image_hot_t* img = imgs[img_index];
                 SOKOL_ASSERT(img && img->gl.target);
-                SOKOL_ASSERT((gl_shd_img->gl_tex_slot != -1) && gl_tex);
+                SOKOL_ASSERT((gl_shd_img->gl_tex_slot != -1) && img->gl.tex);
                 glUniform1i(gl_shd_img->gl_loc, gl_shd_img->gl_tex_slot);
-                _sg_gl_bind_texture(gl_shd_img->gl_tex_slot, img->gl.target, gl_tex);
+                _sg_gl_bind_texture(gl_shd_img->gl_tex_slot, img->gl.target, img->gl.tex);
             }
         }
     }
     _SG_GL_CHECK_ERROR();
 
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    /* remember which frame rendered from persistently mapped buffer slots */
+    for (int i = 0; i < num_vbs; i++) {
+        if (vbs[i]->gl.mapped) {
+            vbs[i]->buf->gl.used_frame_index[vbs[i]->active_slot] = _sg.frame_index;
+        }
+    }
+    if (ib && ib->gl.mapped) {
+        ib->buf->gl.used_frame_index[ib->active_slot] = _sg.frame_index;
+    }
+    #endif
+
     /* index buffer (can be 0) */
-    const GLuint gl_ib = ib ? ib->gl.buf[ib->cmn.active_slot] : 0;
-    _sg_gl_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
+    const GLuint gl_ib = ib ? ib->gl.buf : 0;
     _sg.gl.cache.cur_ib_offset = ib_offset;
 
-    /* vertex attributes */
+    /* required vertex attribute state */
+    _sg_gl_cache_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
     for (uint32_t attr_index = 0; attr_index < _sg.limits.max_vertex_attrs; attr_index++) {
-        _sg_gl_attr_t* attr = &pip->gl.attrs[attr_index];
-        _sg_gl_cache_attr_t* cache_attr = &_sg.gl.cache.attrs[attr_index];
-        bool cache_attr_dirty = false;
-        int vb_offset = 0;
-        GLuint gl_vb = 0;
-        if (attr->vb_index >= 0) {
+        const _sg_gl_attr_t* pip_attr = &pip->gl.attrs[attr_index];
+        _sg_gl_cache_attr_t* attr = &attrs[attr_index];
+        if (pip_attr->vb_index >= 0) {
             /* attribute is enabled */
-            SOKOL_ASSERT(attr->vb_index < num_vbs);
-            _sg_buffer_t* vb = vbs[attr->vb_index];
+            SOKOL_ASSERT(pip_attr->vb_index < num_vbs);
+            const _sg_buffer_hot_t* vb = vbs[pip_attr->vb_index];
             SOKOL_ASSERT(vb);
-            gl_vb = vb->gl.buf[vb->cmn.active_slot];
-            vb_offset = vb_offsets[attr->vb_index] + attr->offset;
-            if ((gl_vb != cache_attr->gl_vbuf) ||
-                (attr->size != cache_attr->gl_attr.size) ||
-                (attr->type != cache_attr->gl_attr.type) ||
-                (attr->normalized != cache_attr->gl_attr.normalized) ||
-                (attr->stride != cache_attr->gl_attr.stride) ||
-                (vb_offset != cache_attr->gl_attr.offset) ||
-                (cache_attr->gl_attr.divisor != attr->divisor))
-            {
-                _sg_gl_bind_buffer(GL_ARRAY_BUFFER, gl_vb);
-                glVertexAttribPointer(attr_index, attr->size, attr->type,
-                    attr->normalized, attr->stride,
-                    (const GLvoid*)(GLintptr)vb_offset);
-                #ifdef SOKOL_INSTANCING_ENABLED
-                    if (_sg.features.instancing) {
-                        glVertexAttribDivisor(attr_index, attr->divisor);
-                    }
-                #endif
-                cache_attr_dirty = true;
-            }
-            if (cache_attr->gl_attr.vb_index == -1) {
-                glEnableVertexAttribArray(attr_index);
-                cache_attr_dirty = true;
-            }
+            attr->gl_attr = *pip_attr;
+            attr->gl_attr.offset = vb_offsets[pip_attr->vb_index] + pip_attr->offset;
+            attr->gl_vbuf = vb->gl.buf;
         }
         else {
             /* attribute is disabled */
-            if (cache_attr->gl_attr.vb_index != -1) {
-                glDisableVertexAttribArray(attr_index);
-                cache_attr_dirty = true;
+            memset(attr, 0, sizeof(_sg_gl_cache_attr_t));
+            _sg_gl_init_attr(&attr->gl_attr);
+        }
+    }
+
+    #if !defined(SOKOL_GLCORE33)
+    memcpy(_sg.gl.cache.bind_attrs, attrs, sizeof(attrs));
+    _sg.gl.cache.cur_base_vertex = 0;
+    #endif
+
+    #if !defined(SOKOL_GLES2)
+    if (!_sg.gl.gles2) {
+        _sg_gl_apply_vao(attrs, gl_ib);
+    }
+    else
+    #endif
+    {
+        _sg_gl_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
+        _sg_gl_update_vertex_attrs(_sg.gl.cache.attrs, attrs);
+    }
+    _SG_GL_CHECK_ERROR();
+}
+
+#if !defined(SOKOL_GLCORE33)
+/* GLES2 and GLES3 have no glDrawElementsBaseVertex(), instead move the
+   per-vertex attribute pointers by base_vertex vertices
+*/
+_SOKOL_PRIVATE void _sg_gl_apply_base_vertex(int base_vertex) {
+    #if !defined(SOKOL_GLES2)
+    if (!_sg.gl.gles2) {
+        /* re-point the attributes of the bound vao, this keeps the vao's
+           cache key, so that different base_vertex values share one vao
+        */
+        _sg_gl_vao_t* vao = _sg.gl.cache.cur_vao;
+        if (vao && (base_vertex != vao->base_vertex)) {
+            vao->base_vertex = base_vertex;
+            for (uint32_t attr_index = 0; attr_index < _sg.limits.max_vertex_attrs; attr_index++) {
+                const _sg_gl_cache_attr_t* attr = &vao->attrs[attr_index];
+                if ((attr->gl_attr.vb_index >= 0) && (0 == attr->gl_attr.divisor)) {
+                    _sg_gl_bind_buffer(GL_ARRAY_BUFFER, attr->gl_vbuf);
+                    glVertexAttribPointer(attr_index, attr->gl_attr.size, attr->gl_attr.type,
+                        attr->gl_attr.normalized, attr->gl_attr.stride,
+                        (const GLvoid*)(GLintptr)(attr->gl_attr.offset + base_vertex * attr->gl_attr.stride));
+                }
             }
+            _SG_GL_CHECK_ERROR();
         }
-        if (cache_attr_dirty) {
-            cache_attr->gl_attr = *attr;
-            cache_attr->gl_attr.offset = vb_offset;
-            cache_attr->gl_vbuf = gl_vb;
+        return;
+    }
+    #endif
+    if (base_vertex == _sg.gl.cache.cur_base_vertex) {
+        return;
+    }
+    _sg.gl.cache.cur_base_vertex = base_vertex;
+    _sg_gl_cache_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
+    for (uint32_t attr_index = 0; attr_index < _sg.limits.max_vertex_attrs; attr_index++) {
+        attrs[attr_index] = _sg.gl.cache.bind_attrs[attr_index];
+        _sg_gl_attr_t* gl_attr = &attrs[attr_index].gl_attr;
+        if ((gl_attr->vb_index >= 0) && (0 == gl_attr->divisor)) {
+            gl_attr->offset += base_vertex * gl_attr->stride;
         }
     }
+    _sg_gl_update_vertex_attrs(_sg.gl.cache.attrs, attrs);
     _SG_GL_CHECK_ERROR();
 }
+#endif
 
 _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
     _SOKOL_UNUSED(num_bytes);
@@ -6529,6 +9852,12 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->shader->cmn.stage[stage_index].uniform_blocks[ub_index].size == num_bytes);
     const _sg_gl_shader_stage_t* gl_stage = &_sg.gl.cache.cur_pipeline->shader->gl.stage[stage_index];
     const _sg_gl_uniform_block_t* gl_ub = &gl_stage->uniform_blocks[ub_index];
+    #if defined(_SOKOL_GL_UBO)
+    if (gl_ub->ubo) {
+        _sg_gl_apply_ubo(stage_index, ub_index, gl_ub, data);
+        return;
+    }
+    #endif
     for (int u_index = 0; u_index < gl_ub->num_uniforms; u_index++) {
         const _sg_gl_uniform_t* u = &gl_ub->uniforms[u_index];
         SOKOL_ASSERT(u->type != SG_UNIFORMTYPE_INVALID);
@@ -6561,7 +9890,7 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
     }
 }
 
-_SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_instances) {
+_SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
     const GLenum i_type = _sg.gl.cache.cur_index_type;
     const GLenum p_type = _sg.gl.cache.cur_primitive_type;
     if (0 != i_type) {
@@ -6569,6 +9898,19 @@ _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_inst
         const int i_size = (i_type == GL_UNSIGNED_SHORT) ? 2 : 4;
         const int ib_offset = _sg.gl.cache.cur_ib_offset;
         const GLvoid* indices = (const GLvoid*)(GLintptr)(base_element*i_size+ib_offset);
+        #if defined(SOKOL_GLCORE33)
+        if (0 != base_vertex) {
+            if (num_instances == 1) {
+                glDrawElementsBaseVertex(p_type, num_elements, i_type, indices, base_vertex);
+            }
+            else {
+                glDrawElementsInstancedBaseVertex(p_type, num_elements, i_type, indices, num_instances, base_vertex);
+            }
+            return;
+        }
+        #else
+        _sg_gl_apply_base_vertex(base_vertex);
+        #endif
         if (num_instances == 1) {
             glDrawElements(p_type, num_elements, i_type, indices);
         }
@@ -6580,22 +9922,139 @@ _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_inst
     }
     else {
         /* non-indexed rendering */
+        #if !defined(SOKOL_GLCORE33)
+        /* a vao may still be shared with an earlier sg_draw_ex() */
+        _sg_gl_apply_base_vertex(0);
+        #endif
         if (num_instances == 1) {
-            glDrawArrays(p_type, base_element, num_elements);
+            glDrawArrays(p_type, base_element + base_vertex, num_elements);
         }
         else {
             if (_sg.features.instancing) {
-                glDrawArraysInstanced(p_type, base_element, num_elements, num_instances);
+                glDrawArraysInstanced(p_type, base_element + base_vertex, num_elements, num_instances);
             }
         }
     }
 }
 
+/* max number of draws per glMultiDraw*() call */
+#define _SG_GL_MULTI_DRAW_BATCH_SIZE (64)
+
+_SOKOL_PRIVATE void _sg_gl_multi_draw(const sg_draw_args* draws, int num_draws) {
+    SOKOL_ASSERT(draws && (num_draws > 0));
+    #if defined(SOKOL_GLCORE33)
+    /* batch runs of non-instanced draws into glMultiDrawElements() / glMultiDrawArrays() */
+    const GLenum i_type = _sg.gl.cache.cur_index_type;
+    const GLenum p_type = _sg.gl.cache.cur_primitive_type;
+    const int i_size = (i_type == GL_UNSIGNED_SHORT) ? 2 : 4;
+    const int ib_offset = _sg.gl.cache.cur_ib_offset;
+    GLint firsts[_SG_GL_MULTI_DRAW_BATCH_SIZE];
+    GLsizei counts[_SG_GL_MULTI_DRAW_BATCH_SIZE];
+    const GLvoid* indices[_SG_GL_MULTI_DRAW_BATCH_SIZE];
+    int i = 0;
+    while (i < num_draws) {
+        if (draws[i].num_instances != 1) {
+            _sg_gl_draw(draws[i].base_element, draws[i].num_elements, draws[i].num_instances, 0);
+            i++;
+            continue;
+        }
+        int n = 0;
+        while ((i < num_draws) && (draws[i].num_instances == 1) && (n < _SG_GL_MULTI_DRAW_BATCH_SIZE)) {
+            firsts[n] = draws[i].base_element;
+            counts[n] = draws[i].num_elements;
+            indices[n] = (const GLvoid*)(GLintptr)(draws[i].base_element*i_size+ib_offset);
+            n++;
+            i++;
+        }
+        if (0 != i_type) {
+            glMultiDrawElements(p_type, counts, i_type, indices, n);
+        }
+        else {
+            glMultiDrawArrays(p_type, firsts, counts, n);
+        }
+    }
+    #else
+    /* no glMultiDraw*() in GLES */
+    for (int i = 0; i < num_draws; i++) {
+        _sg_gl_draw(draws[i].base_element, draws[i].num_elements, draws[i].num_instances, 0);
+    }
+    #endif
+}
+
+#if defined(_SOKOL_GL_DRAW_INDIRECT)
+_SOKOL_PRIVATE void _sg_gl_draw_indirect(_sg_buffer_t* buf, int offset, int num_draws) {
+    SOKOL_ASSERT(buf && (num_draws > 0));
+    SOKOL_ASSERT(_sg.features.draw_indirect);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (buf->gl.mapped[0]) {
+        buf->gl.used_frame_index[buf->cmn.active_slot] = _sg.frame_index;
+    }
+    #endif
+    _sg_gl_bind_buffer(GL_DRAW_INDIRECT_BUFFER, buf->gl.buf[buf->cmn.active_slot]);
+    const GLenum i_type = _sg.gl.cache.cur_index_type;
+    const GLenum p_type = _sg.gl.cache.cur_primitive_type;
+    if (0 != i_type) {
+        /* NOTE: the index buffer offset from sg_bindings can't be applied here */
+        #if defined(_SOKOL_GL_MULTI_DRAW_INDIRECT)
+        if (_sg.gl.multi_draw_indirect) {
+            glMultiDrawElementsIndirect(p_type, i_type, (const GLvoid*)(GLintptr)offset, num_draws, 0);
+            return;
+        }
+        #endif
+        for (int i = 0; i < num_draws; i++) {
+            const int cmd_offset = offset + i * (int)sizeof(sg_draw_indexed_indirect_args);
+            glDrawElementsIndirect(p_type, i_type, (const GLvoid*)(GLintptr)cmd_offset);
+        }
+    }
+    else {
+        #if defined(_SOKOL_GL_MULTI_DRAW_INDIRECT)
+        if (_sg.gl.multi_draw_indirect) {
+            glMultiDrawArraysIndirect(p_type, (const GLvoid*)(GLintptr)offset, num_draws, 0);
+            return;
+        }
+        #endif
+        for (int i = 0; i < num_draws; i++) {
+            const int cmd_offset = offset + i * (int)sizeof(sg_draw_indirect_args);
+            glDrawArraysIndirect(p_type, (const GLvoid*)(GLintptr)cmd_offset);
+        }
+    }
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_commit(void) {
     SOKOL_ASSERT(!_sg.gl.in_pass);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    _sg_gl_frame_fence();
+    #endif
+    #if defined(_SOKOL_GL_UBO)
+    if (_sg.gl.ub.valid) {
+        /* rotate to the next frame's uniform buffer */
+        if (++_sg.gl.ub.frame_index >= SG_NUM_INFLIGHT_FRAMES) {
+            _sg.gl.ub.frame_index = 0;
+        }
+        _sg.gl.ub.offset = 0;
+    }
+    #endif
+    #if defined(_SOKOL_GL_PBO)
+    if (_sg.gl.pbo.valid) {
+        /* rotate to the next frame's pixel unpack buffer */
+        if (++_sg.gl.pbo.frame_index >= SG_NUM_INFLIGHT_FRAMES) {
+            _sg.gl.pbo.frame_index = 0;
+        }
+        _sg.gl.pbo.offset = 0;
+    }
+    if (!_sg.gl.gles2) {
+        _sg_gl_poll_readbacks();
+    }
+    #endif
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    _sg_gl_commit_timer();
+    #endif
     /* "soft" clear bindings (only those that are actually bound) */
     _sg_gl_clear_buffer_bindings(false);
     _sg_gl_clear_texture_bindings(false);
+    /* the next frame reuses the deletion lists of the frame SG_NUM_INFLIGHT_FRAMES commits ago */
+    _sg_gl_delete_queued((int)((_sg.frame_index + 1) % SG_NUM_INFLIGHT_FRAMES));
 }
 
 _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const void* data_ptr, uint32_t data_size) {
@@ -6604,8 +10063,15 @@ _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const void* data_ptr
     if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
         buf->cmn.active_slot = 0;
     }
-    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
     SOKOL_ASSERT(buf->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (buf->gl.mapped[0]) {
+        _sg_gl_wait_buffer_slot(buf);
+        memcpy(buf->gl.mapped[buf->cmn.active_slot], data_ptr, data_size);
+        return;
+    }
+    #endif
+    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
     GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
     SOKOL_ASSERT(gl_buf);
     _SG_GL_CHECK_ERROR();
@@ -6623,8 +10089,17 @@ _SOKOL_PRIVATE uint32_t _sg_gl_append_buffer(_sg_buffer_t* buf, const void* data
             buf->cmn.active_slot = 0;
         }
     }
-    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
     SOKOL_ASSERT(buf->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (buf->gl.mapped[0]) {
+        if (new_frame) {
+            _sg_gl_wait_buffer_slot(buf);
+        }
+        memcpy(buf->gl.mapped[buf->cmn.active_slot] + buf->cmn.append_pos, data_ptr, data_size);
+        return _sg_roundup(data_size, 4);
+    }
+    #endif
+    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
     GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
     SOKOL_ASSERT(gl_buf);
     _SG_GL_CHECK_ERROR();
@@ -6637,6 +10112,39 @@ _SOKOL_PRIVATE uint32_t _sg_gl_append_buffer(_sg_buffer_t* buf, const void* data
     return _sg_roundup(data_size, 4);
 }
 
+_SOKOL_PRIVATE void* _sg_gl_map_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
+        buf->cmn.active_slot = 0;
+    }
+    SOKOL_ASSERT(buf->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    if (buf->gl.mapped[0]) {
+        _sg_gl_wait_buffer_slot(buf);
+        return buf->gl.mapped[buf->cmn.active_slot];
+    }
+    #endif
+    /* not persistently mapped, write into the shadow buffer */
+    return 0;
+}
+
+_SOKOL_PRIVATE void _sg_gl_unmap_buffer(_sg_buffer_t* buf, const void* data_ptr, uint32_t data_size) {
+    SOKOL_ASSERT(buf);
+    if (data_ptr) {
+        /* copy the shadow buffer into the active slot */
+        GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
+        GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
+        SOKOL_ASSERT(gl_buf);
+        _SG_GL_CHECK_ERROR();
+        _sg_gl_store_buffer_binding(gl_tgt);
+        _sg_gl_bind_buffer(gl_tgt, gl_buf);
+        glBufferSubData(gl_tgt, 0, data_size, data_ptr);
+        _sg_gl_restore_buffer_binding(gl_tgt);
+        _SG_GL_CHECK_ERROR();
+    }
+    /* nothing to do for persistently mapped buffers, they are coherent */
+}
+
 _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_content* data) {
     SOKOL_ASSERT(img && data);
     /* only one update per image per frame allowed */
@@ -6651,13 +10159,25 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_content
     const GLenum gl_img_type = _sg_gl_teximage_type(img->cmn.pixel_format);
     const int num_faces = img->cmn.type == SG_IMAGETYPE_CUBE ? 6 : 1;
     const int num_mips = img->cmn.num_mipmaps;
-    for (int face_index = 0; face_index < num_faces; face_index++) {
+    #if defined(_SOKOL_GL_PBO)
+    /* upload from a pixel unpack buffer, so that glTexSubImage*() doesn't
+       need to copy or convert the data synchronously
+    */
+    int pbo_offsets[SG_CUBEFACE_NUM][SG_MAX_MIPMAPS];
+    const bool use_pbo = !_sg.gl.gles2 && _sg_gl_stage_image_content(img, data, pbo_offsets);
+    #endif
+    for (int face_index = 0; face_index < num_faces; face_index++) {
         for (int mip_index = 0; mip_index < num_mips; mip_index++) {
             GLenum gl_img_target = img->gl.target;
             if (SG_IMAGETYPE_CUBE == img->cmn.type) {
                 gl_img_target = _sg_gl_cubeface_target(face_index);
             }
             const GLvoid* data_ptr = data->subimage[face_index][mip_index].ptr;
+            #if defined(_SOKOL_GL_PBO)
+            if (use_pbo) {
+                data_ptr = (const GLvoid*)(GLintptr)pbo_offsets[face_index][mip_index];
+            }
+            #endif
             int mip_width = img->cmn.width >> mip_index;
             if (mip_width == 0) {
                 mip_width = 1;
@@ -6689,7 +10209,116 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_content
             #endif
         }
     }
+    #if defined(_SOKOL_GL_PBO)
+    if (use_pbo) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    #endif
+    _sg_gl_restore_texture_binding(0);
+}
+
+_SOKOL_PRIVATE void _sg_gl_update_image_region(_sg_image_t* img, const sg_image_region* region, const void* data_ptr, int data_size) {
+    SOKOL_ASSERT(img && region && data_ptr && (data_size > 0));
+    _SOKOL_UNUSED(data_size);
+    /* region updates write into the active slot, there's no slot rotation */
+    SOKOL_ASSERT(0 != img->gl.tex[img->cmn.active_slot]);
+    _sg_gl_store_texture_binding(0);
+    _sg_gl_bind_texture(0, img->gl.target, img->gl.tex[img->cmn.active_slot]);
+    const GLenum gl_img_format = _sg_gl_teximage_format(img->cmn.pixel_format);
+    const GLenum gl_img_type = _sg_gl_teximage_type(img->cmn.pixel_format);
+    /* region rows are tightly packed */
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if ((SG_IMAGETYPE_2D == img->cmn.type) || (SG_IMAGETYPE_CUBE == img->cmn.type)) {
+        GLenum gl_img_target = img->gl.target;
+        if (SG_IMAGETYPE_CUBE == img->cmn.type) {
+            gl_img_target = _sg_gl_cubeface_target(region->slice);
+        }
+        glTexSubImage2D(gl_img_target, region->mip_level,
+            region->x, region->y,
+            region->width, region->height,
+            gl_img_format, gl_img_type,
+            data_ptr);
+    }
+    #if !defined(SOKOL_GLES2)
+    else if (!_sg.gl.gles2 && ((SG_IMAGETYPE_3D == img->cmn.type) || (SG_IMAGETYPE_ARRAY == img->cmn.type))) {
+        glTexSubImage3D(img->gl.target, region->mip_level,
+            region->x, region->y, region->slice,
+            region->width, region->height, 1,
+            gl_img_format, gl_img_type,
+            data_ptr);
+    }
+    #endif
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     _sg_gl_restore_texture_binding(0);
+    _SG_GL_CHECK_ERROR();
+}
+
+_SOKOL_PRIVATE bool _sg_gl_read_pixels(_sg_image_t* img, const sg_read_pixels_desc* desc) {
+    SOKOL_ASSERT(!_sg.gl.in_pass);
+    SOKOL_ASSERT(desc && desc->callback && (desc->width > 0) && (desc->height > 0));
+    #if defined(_SOKOL_GL_PBO)
+    if (!_sg.gl.gles2 && (_sg.gl.readback.num >= _SG_GL_MAX_READBACKS)) {
+        SOKOL_LOG("sg_read_pixels_async: too many readbacks in flight");
+        return false;
+    }
+    #endif
+    _SG_GL_CHECK_ERROR();
+    const int num_bytes = desc->width * desc->height * 4;
+    /* the rectangle origin is top-left, the GL framebuffer origin is bottom-left */
+    const int fb_height = img ? img->cmn.height : _sg.default_pass_height;
+    const GLint gl_y = fb_height - (desc->y + desc->height);
+
+    /* render targets are read through a temporary framebuffer object */
+    GLuint gl_fb = 0;
+    if (img) {
+        SOKOL_ASSERT(img->gl.tex[0]);
+        glGenFramebuffers(1, &gl_fb);
+        glBindFramebuffer(GL_FRAMEBUFFER, gl_fb);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, img->gl.tex[0], 0);
+    }
+    else {
+        glBindFramebuffer(GL_FRAMEBUFFER, _sg.gl.cur_context->default_framebuffer);
+    }
+    uint8_t* sync_pixels = 0;
+    #if defined(_SOKOL_GL_PBO)
+    if (!_sg.gl.gles2) {
+        /* read into a pixel pack buffer, the result is picked up in _sg_gl_commit() */
+        const int index = (_sg.gl.readback.head + _sg.gl.readback.num) % _SG_GL_MAX_READBACKS;
+        _sg_gl_readback_t* rb = &_sg.gl.readback.items[index];
+        SOKOL_ASSERT(0 == rb->fence);
+        if (0 == rb->buf) {
+            glGenBuffers(1, &rb->buf);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, rb->buf);
+        if (rb->buf_size < num_bytes) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, num_bytes, 0, GL_STREAM_READ);
+            rb->buf_size = num_bytes;
+        }
+        glReadPixels(desc->x, gl_y, desc->width, desc->height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        rb->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        rb->desc = *desc;
+        _sg.gl.readback.num++;
+    }
+    else
+    #endif
+    {
+        /* no pixel pack buffers or fences, need to read synchronously,
+           the upper half of the scratch buffer receives the unflipped rows
+        */
+        sync_pixels = _sg_gl_readback_scratch(2 * num_bytes);
+        glReadPixels(desc->x, gl_y, desc->width, desc->height, GL_RGBA, GL_UNSIGNED_BYTE, sync_pixels + num_bytes);
+        _sg_gl_flip_rows(sync_pixels, sync_pixels + num_bytes, desc->width, desc->height);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, _sg.gl.cur_context->default_framebuffer);
+    if (gl_fb) {
+        glDeleteFramebuffers(1, &gl_fb);
+    }
+    _SG_GL_CHECK_ERROR();
+    if (sync_pixels) {
+        _sg_read_pixels_callback(desc, sync_pixels, num_bytes);
+    }
+    return true;
 }
 
 /*== D3D11 BACKEND IMPLEMENTATION ============================================*/
@@ -6974,6 +10603,7 @@ _SOKOL_PRIVATE void _sg_d3d11_init_caps(void) {
     _sg.features.imagetype_3d = true;
     _sg.features.imagetype_array = true;
     _sg.features.image_clamp_to_border = true;
+    _sg.features.base_vertex = true;
 
     _sg.limits.max_image_size_2d = 16 * 1024;
     _sg.limits.max_image_size_cube = 16 * 1024;
@@ -7072,12 +10702,15 @@ _SOKOL_PRIVATE sg_resource_state _sg_d3d11_create_buffer(_sg_buffer_t* buf, cons
         buf->d3d11.buf = (ID3D11Buffer*) desc->d3d11_buffer;
         ID3D11Buffer_AddRef(buf->d3d11.buf);
     }
+    else if (SG_BUFFERTYPE_INDIRECTBUFFER == buf->cmn.type) {
+        /* indirect buffers only live in the CPU-side shadow buffer, see sg_draw_indirect() */
+    }
     else {
         D3D11_BUFFER_DESC d3d11_desc;
         memset(&d3d11_desc, 0, sizeof(d3d11_desc));
         d3d11_desc.ByteWidth = buf->cmn.size;
         d3d11_desc.Usage = _sg_d3d11_usage(buf->cmn.usage);
-        d3d11_desc.BindFlags = buf->cmn.type == SG_BUFFERTYPE_VERTEXBUFFER ? D3D11_BIND_VERTEX_BUFFER : D3D11_BIND_INDEX_BUFFER;
+        d3d11_desc.BindFlags = buf->cmn.type == SG_BUFFERTYPE_INDEXBUFFER ? D3D11_BIND_INDEX_BUFFER : D3D11_BIND_VERTEX_BUFFER;
         d3d11_desc.CPUAccessFlags = _sg_d3d11_cpu_access_flags(buf->cmn.usage);
         D3D11_SUBRESOURCE_DATA* init_data_ptr = 0;
         D3D11_SUBRESOURCE_DATA init_data;
@@ -7919,10 +11552,10 @@ _SOKOL_PRIVATE void _sg_d3d11_apply_pipeline(_sg_pipeline_t* pip) {
 
 _SOKOL_PRIVATE void _sg_d3d11_apply_bindings(
     _sg_pipeline_t* pip,
-    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
-    _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    const _sg_buffer_hot_t** vbs, const int* vb_offsets, int num_vbs,
+    const _sg_buffer_hot_t* ib, int ib_offset,
+    const _sg_image_hot_t** vs_imgs, int num_vs_imgs,
+    const _sg_image_hot_t** fs_imgs, int num_fs_imgs)
 {
     SOKOL_ASSERT(pip);
     SOKOL_ASSERT(_sg.d3d11.ctx);
@@ -7990,22 +11623,22 @@ _SOKOL_PRIVATE void _sg_d3d11_apply_uniforms(sg_shader_stage stage_index, int ub
     ID3D11DeviceContext_UpdateSubresource(_sg.d3d11.ctx, (ID3D11Resource*)cb, 0, NULL, data, 0, 0);
 }
 
-_SOKOL_PRIVATE void _sg_d3d11_draw(int base_element, int num_elements, int num_instances) {
+_SOKOL_PRIVATE void _sg_d3d11_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
     SOKOL_ASSERT(_sg.d3d11.in_pass);
     if (_sg.d3d11.use_indexed_draw) {
         if (1 == num_instances) {
-            ID3D11DeviceContext_DrawIndexed(_sg.d3d11.ctx, num_elements, base_element, 0);
+            ID3D11DeviceContext_DrawIndexed(_sg.d3d11.ctx, num_elements, base_element, base_vertex);
         }
         else {
-            ID3D11DeviceContext_DrawIndexedInstanced(_sg.d3d11.ctx, num_elements, num_instances, base_element, 0, 0);
+            ID3D11DeviceContext_DrawIndexedInstanced(_sg.d3d11.ctx, num_elements, num_instances, base_element, base_vertex, 0);
         }
     }
     else {
         if (1 == num_instances) {
-            ID3D11DeviceContext_Draw(_sg.d3d11.ctx, num_elements, base_element);
+            ID3D11DeviceContext_Draw(_sg.d3d11.ctx, num_elements, base_element + base_vertex);
         }
         else {
-            ID3D11DeviceContext_DrawInstanced(_sg.d3d11.ctx, num_elements, num_instances, base_element, 0);
+            ID3D11DeviceContext_DrawInstanced(_sg.d3d11.ctx, num_elements, num_instances, base_element + base_vertex, 0);
         }
     }
 }
@@ -8042,6 +11675,32 @@ _SOKOL_PRIVATE uint32_t _sg_d3d11_append_buffer(_sg_buffer_t* buf, const void* d
     return _sg_roundup(data_size, 4);
 }
 
+_SOKOL_PRIVATE void* _sg_d3d11_map_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    SOKOL_ASSERT(_sg.d3d11.ctx);
+    SOKOL_ASSERT(buf->d3d11.buf);
+    D3D11_MAPPED_SUBRESOURCE d3d11_msr;
+    HRESULT hr = ID3D11DeviceContext_Map(_sg.d3d11.ctx, (ID3D11Resource*)buf->d3d11.buf, 0, D3D11_MAP_WRITE_DISCARD, 0, &d3d11_msr);
+    if (FAILED(hr)) {
+        SOKOL_LOG("_sg_d3d11_map_buffer: ID3D11DeviceContext_Map() failed\n");
+        return 0;
+    }
+    return d3d11_msr.pData;
+}
+
+_SOKOL_PRIVATE void _sg_d3d11_unmap_buffer(_sg_buffer_t* buf, const void* data_ptr, uint32_t data_size) {
+    SOKOL_ASSERT(buf);
+    SOKOL_ASSERT(_sg.d3d11.ctx);
+    SOKOL_ASSERT(buf->d3d11.buf);
+    if (data_ptr) {
+        /* the buffer couldn't be mapped in _sg_d3d11_map_buffer() */
+        _sg_d3d11_update_buffer(buf, data_ptr, data_size);
+    }
+    else {
+        ID3D11DeviceContext_Unmap(_sg.d3d11.ctx, (ID3D11Resource*)buf->d3d11.buf, 0);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_d3d11_update_image(_sg_image_t* img, const sg_image_content* data) {
     SOKOL_ASSERT(img && data);
     SOKOL_ASSERT(_sg.d3d11.ctx);
@@ -8462,8 +12121,51 @@ _SOKOL_PRIVATE void _sg_mtl_destroy_pool(void) {
     _sg_mtl_idpool = nil;
 }
 
+/* double the pool size when the free-queue is exhausted, this
+   happens after the sokol-gfx resource pools have grown
+*/
+_SOKOL_PRIVATE void _sg_mtl_grow_pool(void) {
+    SOKOL_ASSERT(0 == _sg.mtl.idpool.free_queue_top);
+    const uint32_t old_num_slots = _sg.mtl.idpool.num_slots;
+    const uint32_t new_num_slots = 2 * old_num_slots;
+    NSNull* null = [NSNull null];
+    for (uint32_t i = old_num_slots; i < new_num_slots; i++) {
+        [_sg_mtl_idpool addObject:null];
+    }
+    SOKOL_ASSERT([_sg_mtl_idpool count] == new_num_slots);
+    /* the free queue is empty, only the new slots need to be added */
+    SOKOL_FREE(_sg.mtl.idpool.free_queue);
+    _sg.mtl.idpool.free_queue = (uint32_t*)SOKOL_MALLOC(new_num_slots * sizeof(uint32_t));
+    for (uint32_t i = new_num_slots-1; i >= old_num_slots; i--) {
+        _sg.mtl.idpool.free_queue[_sg.mtl.idpool.free_queue_top++] = i;
+    }
+    /* move the pending release items to the start of the new release queue */
+    _sg_mtl_release_item_t* release_queue = (_sg_mtl_release_item_t*)SOKOL_MALLOC(new_num_slots * sizeof(_sg_mtl_release_item_t));
+    uint32_t num_items = 0;
+    uint32_t i = _sg.mtl.idpool.release_queue_back;
+    while (i != _sg.mtl.idpool.release_queue_front) {
+        release_queue[num_items++] = _sg.mtl.idpool.release_queue[i];
+        if (++i >= old_num_slots) {
+            /* wrap-around */
+            i = 0;
+        }
+    }
+    for (uint32_t j = num_items; j < new_num_slots; j++) {
+        release_queue[j].frame_index = 0;
+        release_queue[j].slot_index = _SG_MTL_INVALID_SLOT_INDEX;
+    }
+    SOKOL_FREE(_sg.mtl.idpool.release_queue);
+    _sg.mtl.idpool.release_queue = release_queue;
+    _sg.mtl.idpool.release_queue_back = 0;
+    _sg.mtl.idpool.release_queue_front = num_items;
+    _sg.mtl.idpool.num_slots = new_num_slots;
+}
+
 /* get a new free resource pool slot */
 _SOKOL_PRIVATE uint32_t _sg_mtl_alloc_pool_slot(void) {
+    if (0 == _sg.mtl.idpool.free_queue_top) {
+        _sg_mtl_grow_pool();
+    }
     SOKOL_ASSERT(_sg.mtl.idpool.free_queue_top > 0);
     const uint32_t slot_index = _sg.mtl.idpool.free_queue[--_sg.mtl.idpool.free_queue_top];
     SOKOL_ASSERT((slot_index > 0) && (slot_index < _sg.mtl.idpool.num_slots));
@@ -8537,33 +12239,30 @@ _SOKOL_PRIVATE void _sg_mtl_garbage_collect(uint32_t frame_index) {
     }
 }
 
+/* called by the sampler cache when a sampler is evicted or the cache is destroyed */
+_SOKOL_PRIVATE void _sg_mtl_destroy_sampler(uintptr_t sampler_handle) {
+    _sg_mtl_release_resource(_sg.mtl.frame_index, (uint32_t)sampler_handle);
+}
+
 _SOKOL_PRIVATE void _sg_mtl_init_sampler_cache(const sg_desc* desc) {
     SOKOL_ASSERT(desc->sampler_cache_size > 0);
-    _sg_smpcache_init(&_sg.mtl.sampler_cache, desc->sampler_cache_size);
+    _sg_smpcache_init(&_sg.mtl.sampler_cache, desc->sampler_cache_size, _sg_mtl_destroy_sampler);
 }
 
 /* destroy the sampler cache, and release all sampler objects */
-_SOKOL_PRIVATE void _sg_mtl_destroy_sampler_cache(uint32_t frame_index) {
-    SOKOL_ASSERT(_sg.mtl.sampler_cache.items);
-    SOKOL_ASSERT(_sg.mtl.sampler_cache.num_items <= _sg.mtl.sampler_cache.capacity);
-    for (int i = 0; i < _sg.mtl.sampler_cache.num_items; i++) {
-        _sg_mtl_release_resource(frame_index, (uint32_t)_sg_smpcache_sampler(&_sg.mtl.sampler_cache, i));
-    }
+_SOKOL_PRIVATE void _sg_mtl_destroy_sampler_cache(void) {
     _sg_smpcache_discard(&_sg.mtl.sampler_cache);
 }
 
 /*
-    create and add an MTLSamplerStateObject and return its resource pool index,
-    reuse identical sampler state if one exists
+    create and add an MTLSamplerStateObject and return its sampler cache
+    item index, reuse identical sampler state if one exists, the
+    returned item has one reference added
 */
-_SOKOL_PRIVATE uint32_t _sg_mtl_create_sampler(id<MTLDevice> mtl_device, const sg_image_desc* img_desc) {
+_SOKOL_PRIVATE int _sg_mtl_create_sampler(id<MTLDevice> mtl_device, const sg_image_desc* img_desc) {
     SOKOL_ASSERT(img_desc);
     int index = _sg_smpcache_find_item(&_sg.mtl.sampler_cache, img_desc);
-    if (index >= 0) {
-        /* reuse existing sampler */
-        return (uint32_t) _sg_smpcache_sampler(&_sg.mtl.sampler_cache, index);
-    }
-    else {
+    if (index < 0) {
         /* create a new Metal sampler state object and add to sampler cache */
         MTLSamplerDescriptor* mtl_desc = [[MTLSamplerDescriptor alloc] init];
         mtl_desc.sAddressMode = _sg_mtl_address_mode(img_desc->wrap_u);
@@ -8583,9 +12282,10 @@ _SOKOL_PRIVATE uint32_t _sg_mtl_create_sampler(id<MTLDevice> mtl_device, const s
         mtl_desc.normalizedCoordinates = YES;
         id<MTLSamplerState> mtl_sampler = [mtl_device newSamplerStateWithDescriptor:mtl_desc];
         uint32_t sampler_handle = _sg_mtl_add_resource(mtl_sampler);
-        _sg_smpcache_add_item(&_sg.mtl.sampler_cache, img_desc, sampler_handle);
-        return sampler_handle;
+        index = _sg_smpcache_add_item(&_sg.mtl.sampler_cache, img_desc, sampler_handle);
     }
+    _sg_smpcache_use_item(&_sg.mtl.sampler_cache, index);
+    return index;
 }
 
 _SOKOL_PRIVATE void _sg_mtl_clear_state_cache(void) {
@@ -8609,10 +12309,14 @@ _SOKOL_PRIVATE void _sg_mtl_init_caps(void) {
     _sg.features.msaa_render_targets = true;
     _sg.features.imagetype_3d = true;
     _sg.features.imagetype_array = true;
+    _sg.features.image_region_update = true;
     #if defined(_SG_TARGET_MACOS)
         _sg.features.image_clamp_to_border = true;
+        _sg.features.base_vertex = true;
     #else
         _sg.features.image_clamp_to_border = false;
+        /* base-vertex draws need an A9 GPU or better */
+        _sg.features.base_vertex = [_sg_mtl_device supportsFeatureSet:MTLFeatureSet_iOS_GPUFamily3_v1];
     #endif
 
     #if defined(_SG_TARGET_MACOS)
@@ -8768,7 +12472,7 @@ _SOKOL_PRIVATE void _sg_mtl_discard_backend(void) {
     for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
         dispatch_semaphore_wait(_sg_mtl_sem, DISPATCH_TIME_FOREVER);
     }
-    _sg_mtl_destroy_sampler_cache(_sg.mtl.frame_index);
+    _sg_mtl_destroy_sampler_cache();
     _sg_mtl_garbage_collect(_sg.mtl.frame_index + SG_NUM_INFLIGHT_FRAMES + 2);
     _sg_mtl_destroy_pool();
     _sg.mtl.valid = false;
@@ -9030,7 +12734,8 @@ _SOKOL_PRIVATE sg_resource_state _sg_mtl_create_image(_sg_image_t* img, const sg
         }
 
         /* create (possibly shared) sampler state */
-        img->mtl.sampler_state = _sg_mtl_create_sampler(_sg_mtl_device, desc);
+        img->mtl.sampler_cache_item = _sg_mtl_create_sampler(_sg_mtl_device, desc);
+        img->mtl.sampler_state = (uint32_t) _sg_smpcache_sampler(&_sg.mtl.sampler_cache, img->mtl.sampler_cache_item);
     }
     return SG_RESOURCESTATE_VALID;
 }
@@ -9043,7 +12748,10 @@ _SOKOL_PRIVATE void _sg_mtl_destroy_image(_sg_image_t* img) {
     }
     _sg_mtl_release_resource(_sg.mtl.frame_index, img->mtl.depth_tex);
     _sg_mtl_release_resource(_sg.mtl.frame_index, img->mtl.msaa_tex);
-    /* NOTE: sampler state objects are shared and not released until shutdown */
+    /* NOTE: sampler state objects are shared, only release the reference */
+    if (img->mtl.sampler_state != _SG_MTL_INVALID_SLOT_INDEX) {
+        _sg_smpcache_release_item(&_sg.mtl.sampler_cache, img->mtl.sampler_cache_item);
+    }
 }
 
 _SOKOL_PRIVATE id<MTLLibrary> _sg_mtl_compile_library(const char* src) {
@@ -9167,6 +12875,9 @@ _SOKOL_PRIVATE sg_resource_state _sg_mtl_create_pipeline(_sg_pipeline_t* pip, _s
             vtx_desc.layouts[mtl_vb_slot].stride = l_desc->stride;
             vtx_desc.layouts[mtl_vb_slot].stepFunction = _sg_mtl_step_function(l_desc->step_func);
             vtx_desc.layouts[mtl_vb_slot].stepRate = l_desc->step_rate;
+            if (SG_VERTEXSTEP_PER_VERTEX == l_desc->step_func) {
+                pip->mtl.vb_strides[layout_index] = l_desc->stride;
+            }
         }
     }
 
@@ -9542,10 +13253,10 @@ _SOKOL_PRIVATE void _sg_mtl_apply_pipeline(_sg_pipeline_t* pip) {
 
 _SOKOL_PRIVATE void _sg_mtl_apply_bindings(
     _sg_pipeline_t* pip,
-    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
-    _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    const _sg_buffer_hot_t** vbs, const int* vb_offsets, int num_vbs,
+    const _sg_buffer_hot_t* ib, int ib_offset,
+    const _sg_image_hot_t** vs_imgs, int num_vs_imgs,
+    const _sg_image_hot_t** fs_imgs, int num_fs_imgs)
 {
     SOKOL_ASSERT(_sg.mtl.in_pass);
     if (!_sg.mtl.pass_valid) {
@@ -9554,11 +13265,11 @@ _SOKOL_PRIVATE void _sg_mtl_apply_bindings(
     SOKOL_ASSERT(_sg_mtl_cmd_encoder);
 
     /* store index buffer binding, this will be needed later in sg_draw() */
-    _sg.mtl.state_cache.cur_indexbuffer = ib;
+    _sg.mtl.state_cache.cur_indexbuffer = ib ? ib->buf : 0;
     _sg.mtl.state_cache.cur_indexbuffer_offset = ib_offset;
     if (ib) {
         SOKOL_ASSERT(pip->cmn.index_type != SG_INDEXTYPE_NONE);
-        _sg.mtl.state_cache.cur_indexbuffer_id.id = ib->slot.id;
+        _sg.mtl.state_cache.cur_indexbuffer_id.id = ib->id;
     }
     else {
         SOKOL_ASSERT(pip->cmn.index_type == SG_INDEXTYPE_NONE);
@@ -9568,17 +13279,17 @@ _SOKOL_PRIVATE void _sg_mtl_apply_bindings(
     /* apply vertex buffers */
     int slot;
     for (slot = 0; slot < num_vbs; slot++) {
-        const _sg_buffer_t* vb = vbs[slot];
-        if ((_sg.mtl.state_cache.cur_vertexbuffers[slot] != vb) ||
+        const _sg_buffer_hot_t* vb = vbs[slot];
+        if ((_sg.mtl.state_cache.cur_vertexbuffers[slot] != vb->buf) ||
             (_sg.mtl.state_cache.cur_vertexbuffer_offsets[slot] != vb_offsets[slot]) ||
-            (_sg.mtl.state_cache.cur_vertexbuffer_ids[slot].id != vb->slot.id))
+            (_sg.mtl.state_cache.cur_vertexbuffer_ids[slot].id != vb->id))
         {
-            _sg.mtl.state_cache.cur_vertexbuffers[slot] = vb;
+            _sg.mtl.state_cache.cur_vertexbuffers[slot] = vb->buf;
             _sg.mtl.state_cache.cur_vertexbuffer_offsets[slot] = vb_offsets[slot];
-            _sg.mtl.state_cache.cur_vertexbuffer_ids[slot].id = vb->slot.id;
+            _sg.mtl.state_cache.cur_vertexbuffer_ids[slot].id = vb->id;
             const NSUInteger mtl_slot = SG_MAX_SHADERSTAGE_UBS + slot;
-            SOKOL_ASSERT(vb->mtl.buf[vb->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
-            [_sg_mtl_cmd_encoder setVertexBuffer:_sg_mtl_idpool[vb->mtl.buf[vb->cmn.active_slot]]
+            SOKOL_ASSERT(vb->mtl.buf != _SG_MTL_INVALID_SLOT_INDEX);
+            [_sg_mtl_cmd_encoder setVertexBuffer:_sg_mtl_idpool[vb->mtl.buf]
                 offset:vb_offsets[slot]
                 atIndex:mtl_slot];
         }
@@ -9586,12 +13297,12 @@ _SOKOL_PRIVATE void _sg_mtl_apply_bindings(
 
     /* apply vertex shader images */
     for (slot = 0; slot < num_vs_imgs; slot++) {
-        const _sg_image_t* img = vs_imgs[slot];
-        if ((_sg.mtl.state_cache.cur_vs_images[slot] != img) || (_sg.mtl.state_cache.cur_vs_image_ids[slot].id != img->slot.id)) {
-            _sg.mtl.state_cache.cur_vs_images[slot] = img;
-            _sg.mtl.state_cache.cur_vs_image_ids[slot].id = img->slot.id;
-            SOKOL_ASSERT(img->mtl.tex[img->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
-            [_sg_mtl_cmd_encoder setVertexTexture:_sg_mtl_idpool[img->mtl.tex[img->cmn.active_slot]] atIndex:slot];
+        const _sg_image_hot_t* img = vs_imgs[slot];
+        if ((_sg.mtl.state_cache.cur_vs_images[slot] != img->img) || (_sg.mtl.state_cache.cur_vs_image_ids[slot].id != img->id)) {
+            _sg.mtl.state_cache.cur_vs_images[slot] = img->img;
+            _sg.mtl.state_cache.cur_vs_image_ids[slot].id = img->id;
+            SOKOL_ASSERT(img->mtl.tex != _SG_MTL_INVALID_SLOT_INDEX);
+            [_sg_mtl_cmd_encoder setVertexTexture:_sg_mtl_idpool[img->mtl.tex] atIndex:slot];
             SOKOL_ASSERT(img->mtl.sampler_state != _SG_MTL_INVALID_SLOT_INDEX);
             [_sg_mtl_cmd_encoder setVertexSamplerState:_sg_mtl_idpool[img->mtl.sampler_state] atIndex:slot];
         }
@@ -9599,12 +13310,12 @@ _SOKOL_PRIVATE void _sg_mtl_apply_bindings(
 
     /* apply fragment shader images */
     for (slot = 0; slot < num_fs_imgs; slot++) {
-        const _sg_image_t* img = fs_imgs[slot];
-        if ((_sg.mtl.state_cache.cur_fs_images[slot] != img) || (_sg.mtl.state_cache.cur_fs_image_ids[slot].id != img->slot.id)) {
-            _sg.mtl.state_cache.cur_fs_images[slot] = img;
-            _sg.mtl.state_cache.cur_fs_image_ids[slot].id = img->slot.id;
-            SOKOL_ASSERT(img->mtl.tex[img->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
-            [_sg_mtl_cmd_encoder setFragmentTexture:_sg_mtl_idpool[img->mtl.tex[img->cmn.active_slot]] atIndex:slot];
+        const _sg_image_hot_t* img = fs_imgs[slot];
+        if ((_sg.mtl.state_cache.cur_fs_images[slot] != img->img) || (_sg.mtl.state_cache.cur_fs_image_ids[slot].id != img->id)) {
+            _sg.mtl.state_cache.cur_fs_images[slot] = img->img;
+            _sg.mtl.state_cache.cur_fs_image_ids[slot].id = img->id;
+            SOKOL_ASSERT(img->mtl.tex != _SG_MTL_INVALID_SLOT_INDEX);
+            [_sg_mtl_cmd_encoder setFragmentTexture:_sg_mtl_idpool[img->mtl.tex] atIndex:slot];
             SOKOL_ASSERT(img->mtl.sampler_state != _SG_MTL_INVALID_SLOT_INDEX);
             [_sg_mtl_cmd_encoder setFragmentSamplerState:_sg_mtl_idpool[img->mtl.sampler_state] atIndex:slot];
         }
@@ -9640,7 +13351,7 @@ _SOKOL_PRIVATE void _sg_mtl_apply_uniforms(sg_shader_stage stage_index, int ub_i
     _sg.mtl.cur_ub_offset = _sg_roundup(_sg.mtl.cur_ub_offset + num_bytes, _SG_MTL_UB_ALIGN);
 }
 
-_SOKOL_PRIVATE void _sg_mtl_draw(int base_element, int num_elements, int num_instances) {
+_SOKOL_PRIVATE void _sg_mtl_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
     SOKOL_ASSERT(_sg.mtl.in_pass);
     if (!_sg.mtl.pass_valid) {
         return;
@@ -9654,17 +13365,51 @@ _SOKOL_PRIVATE void _sg_mtl_draw(int base_element, int num_elements, int num_ins
         SOKOL_ASSERT(ib->mtl.buf[ib->cmn.active_slot] != _SG_MTL_INVALID_SLOT_INDEX);
         const NSUInteger index_buffer_offset = _sg.mtl.state_cache.cur_indexbuffer_offset +
             base_element * _sg.mtl.state_cache.cur_pipeline->mtl.index_size;
-        [_sg_mtl_cmd_encoder drawIndexedPrimitives:_sg.mtl.state_cache.cur_pipeline->mtl.prim_type
-            indexCount:num_elements
-            indexType:_sg.mtl.state_cache.cur_pipeline->mtl.index_type
-            indexBuffer:_sg_mtl_idpool[ib->mtl.buf[ib->cmn.active_slot]]
-            indexBufferOffset:index_buffer_offset
-            instanceCount:num_instances];
+        if (0 == base_vertex) {
+            [_sg_mtl_cmd_encoder drawIndexedPrimitives:_sg.mtl.state_cache.cur_pipeline->mtl.prim_type
+                indexCount:num_elements
+                indexType:_sg.mtl.state_cache.cur_pipeline->mtl.index_type
+                indexBuffer:_sg_mtl_idpool[ib->mtl.buf[ib->cmn.active_slot]]
+                indexBufferOffset:index_buffer_offset
+                instanceCount:num_instances];
+        }
+        else if (_sg.features.base_vertex) {
+            [_sg_mtl_cmd_encoder drawIndexedPrimitives:_sg.mtl.state_cache.cur_pipeline->mtl.prim_type
+                indexCount:num_elements
+                indexType:_sg.mtl.state_cache.cur_pipeline->mtl.index_type
+                indexBuffer:_sg_mtl_idpool[ib->mtl.buf[ib->cmn.active_slot]]
+                indexBufferOffset:index_buffer_offset
+                instanceCount:num_instances
+                baseVertex:base_vertex
+                baseInstance:0];
+        }
+        else {
+            /* no native base-vertex support, temporarily move the per-vertex buffer offsets */
+            const int* vb_strides = _sg.mtl.state_cache.cur_pipeline->mtl.vb_strides;
+            for (int slot = 0; slot < SG_MAX_SHADERSTAGE_BUFFERS; slot++) {
+                if (vb_strides[slot] > 0) {
+                    [_sg_mtl_cmd_encoder setVertexBufferOffset:_sg.mtl.state_cache.cur_vertexbuffer_offsets[slot] + base_vertex * vb_strides[slot]
+                        atIndex:SG_MAX_SHADERSTAGE_UBS + slot];
+                }
+            }
+            [_sg_mtl_cmd_encoder drawIndexedPrimitives:_sg.mtl.state_cache.cur_pipeline->mtl.prim_type
+                indexCount:num_elements
+                indexType:_sg.mtl.state_cache.cur_pipeline->mtl.index_type
+                indexBuffer:_sg_mtl_idpool[ib->mtl.buf[ib->cmn.active_slot]]
+                indexBufferOffset:index_buffer_offset
+                instanceCount:num_instances];
+            for (int slot = 0; slot < SG_MAX_SHADERSTAGE_BUFFERS; slot++) {
+                if (vb_strides[slot] > 0) {
+                    [_sg_mtl_cmd_encoder setVertexBufferOffset:_sg.mtl.state_cache.cur_vertexbuffer_offsets[slot]
+                        atIndex:SG_MAX_SHADERSTAGE_UBS + slot];
+                }
+            }
+        }
     }
     else {
         /* non-indexed rendering */
         [_sg_mtl_cmd_encoder drawPrimitives:_sg.mtl.state_cache.cur_pipeline->mtl.prim_type
-            vertexStart:base_element
+            vertexStart:base_element + base_vertex
             vertexCount:num_elements
             instanceCount:num_instances];
     }
@@ -9701,6 +13446,27 @@ _SOKOL_PRIVATE uint32_t _sg_mtl_append_buffer(_sg_buffer_t* buf, const void* dat
     return _sg_roundup(data_size, 4);
 }
 
+_SOKOL_PRIVATE void* _sg_mtl_map_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
+        buf->cmn.active_slot = 0;
+    }
+    __unsafe_unretained id<MTLBuffer> mtl_buf = _sg_mtl_idpool[buf->mtl.buf[buf->cmn.active_slot]];
+    return [mtl_buf contents];
+}
+
+_SOKOL_PRIVATE void _sg_mtl_unmap_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size) {
+    SOKOL_ASSERT(buf && (0 == data));
+    _SOKOL_UNUSED(data);
+    #if defined(_SG_TARGET_MACOS)
+    __unsafe_unretained id<MTLBuffer> mtl_buf = _sg_mtl_idpool[buf->mtl.buf[buf->cmn.active_slot]];
+    [mtl_buf didModifyRange:NSMakeRange(0, data_size)];
+    #else
+    _SOKOL_UNUSED(buf);
+    _SOKOL_UNUSED(data_size);
+    #endif
+}
+
 _SOKOL_PRIVATE void _sg_mtl_update_image(_sg_image_t* img, const sg_image_content* data) {
     SOKOL_ASSERT(img && data);
     if (++img->cmn.active_slot >= img->cmn.num_slots) {
@@ -9710,6 +13476,29 @@ _SOKOL_PRIVATE void _sg_mtl_update_image(_sg_image_t* img, const sg_image_conten
     _sg_mtl_copy_image_content(img, mtl_tex, data);
 }
 
+_SOKOL_PRIVATE void _sg_mtl_update_image_region(_sg_image_t* img, const sg_image_region* region, const void* data_ptr, int data_size) {
+    SOKOL_ASSERT(img && region && data_ptr && (data_size > 0));
+    /* region updates write into the active slot, there's no slot rotation */
+    __unsafe_unretained id<MTLTexture> mtl_tex = _sg_mtl_idpool[img->mtl.tex[img->cmn.active_slot]];
+    const int bytes_per_row = _sg_row_pitch(img->cmn.pixel_format, region->width, 1);
+    MTLRegion mtl_region;
+    int mtl_slice_index;
+    if (img->cmn.type == SG_IMAGETYPE_3D) {
+        mtl_region = MTLRegionMake3D(region->x, region->y, region->slice, region->width, region->height, 1);
+        mtl_slice_index = 0;
+    }
+    else {
+        mtl_region = MTLRegionMake2D(region->x, region->y, region->width, region->height);
+        mtl_slice_index = region->slice;
+    }
+    [mtl_tex replaceRegion:mtl_region
+        mipmapLevel:region->mip_level
+        slice:mtl_slice_index
+        withBytes:data_ptr
+        bytesPerRow:bytes_per_row
+        bytesPerImage:data_size];
+}
+
 /*== WEBGPU BACKEND IMPLEMENTATION ===========================================*/
 #elif defined(SOKOL_WGPU)
 
@@ -9718,9 +13507,12 @@ _SOKOL_PRIVATE WGPUBufferUsageFlags _sg_wgpu_buffer_usage(sg_buffer_type t, sg_u
     if (SG_BUFFERTYPE_VERTEXBUFFER == t) {
         res |= WGPUBufferUsage_Vertex;
     }
-    else {
+    else if (SG_BUFFERTYPE_INDEXBUFFER == t) {
         res |= WGPUBufferUsage_Index;
     }
+    else {
+        res |= WGPUBufferUsage_Indirect;
+    }
     if (SG_USAGE_IMMUTABLE != u) {
         res |= WGPUBufferUsage_CopyDst;
     }
@@ -10041,6 +13833,7 @@ _SOKOL_PRIVATE void _sg_wgpu_init_caps(void) {
     _sg.features.imagetype_3d = true;
     _sg.features.imagetype_array = true;
     _sg.features.image_clamp_to_border = false;
+    _sg.features.base_vertex = true;
 
     /* FIXME: max images size??? */
     _sg.limits.max_image_size_2d = 8 * 1024;
@@ -10500,28 +14293,25 @@ _SOKOL_PRIVATE void _sg_wgpu_staging_unmap(void) {
 }
 
 /*--- WGPU sampler cache functions ---*/
+/* called by the sampler cache when a sampler is evicted or the cache is destroyed */
+_SOKOL_PRIVATE void _sg_wgpu_destroy_sampler(uintptr_t sampler_handle) {
+    wgpuSamplerRelease((WGPUSampler)sampler_handle);
+}
+
 _SOKOL_PRIVATE void _sg_wgpu_init_sampler_cache(const sg_desc* desc) {
     SOKOL_ASSERT(desc->sampler_cache_size > 0);
-    _sg_smpcache_init(&_sg.wgpu.sampler_cache, desc->sampler_cache_size);
+    _sg_smpcache_init(&_sg.wgpu.sampler_cache, desc->sampler_cache_size, _sg_wgpu_destroy_sampler);
 }
 
 _SOKOL_PRIVATE void _sg_wgpu_destroy_sampler_cache(void) {
-    SOKOL_ASSERT(_sg.wgpu.sampler_cache.items);
-    SOKOL_ASSERT(_sg.wgpu.sampler_cache.num_items <= _sg.wgpu.sampler_cache.capacity);
-    for (int i = 0; i < _sg.wgpu.sampler_cache.num_items; i++) {
-        wgpuSamplerRelease((WGPUSampler)_sg_smpcache_sampler(&_sg.wgpu.sampler_cache, i));
-    }
     _sg_smpcache_discard(&_sg.wgpu.sampler_cache);
 }
 
-_SOKOL_PRIVATE WGPUSampler _sg_wgpu_create_sampler(const sg_image_desc* img_desc) {
+/* returns the sampler cache item index, with one reference added */
+_SOKOL_PRIVATE int _sg_wgpu_create_sampler(const sg_image_desc* img_desc) {
     SOKOL_ASSERT(img_desc);
     int index = _sg_smpcache_find_item(&_sg.wgpu.sampler_cache, img_desc);
-    if (index >= 0) {
-        /* reuse existing sampler */
-        return (WGPUSampler) _sg_smpcache_sampler(&_sg.wgpu.sampler_cache, index);
-    }
-    else {
+    if (index < 0) {
         /* create a new WGPU sampler and add to sampler cache */
         /* FIXME: anisotropic filtering not supported? */
         WGPUSamplerDescriptor smp_desc;
@@ -10536,9 +14326,10 @@ _SOKOL_PRIVATE WGPUSampler _sg_wgpu_create_sampler(const sg_image_desc* img_desc
         smp_desc.lodMaxClamp = img_desc->max_lod;
         WGPUSampler smp = wgpuDeviceCreateSampler(_sg.wgpu.dev, &smp_desc);
         SOKOL_ASSERT(smp);
-        _sg_smpcache_add_item(&_sg.wgpu.sampler_cache, img_desc, (uintptr_t)smp);
-        return smp;
+        index = _sg_smpcache_add_item(&_sg.wgpu.sampler_cache, img_desc, (uintptr_t)smp);
     }
+    _sg_smpcache_use_item(&_sg.wgpu.sampler_cache, index);
+    return index;
 }
 
 /*--- WGPU backend API functions ---*/
@@ -10764,7 +14555,8 @@ _SOKOL_PRIVATE sg_resource_state _sg_wgpu_create_image(_sg_image_t* img, const s
         }
 
         /* create sampler via shared-sampler-cache */
-        img->wgpu.sampler = _sg_wgpu_create_sampler(desc);
+        img->wgpu.sampler_cache_item = _sg_wgpu_create_sampler(desc);
+        img->wgpu.sampler = (WGPUSampler) _sg_smpcache_sampler(&_sg.wgpu.sampler_cache, img->wgpu.sampler_cache_item);
         SOKOL_ASSERT(img->wgpu.sampler);
     }
     return SG_RESOURCESTATE_VALID;
@@ -10784,8 +14576,13 @@ _SOKOL_PRIVATE void _sg_wgpu_destroy_image(_sg_image_t* img) {
         wgpuTextureRelease(img->wgpu.msaa_tex);
         img->wgpu.msaa_tex = 0;
     }
-    /* NOTE: do *not* destroy the sampler from the shared-sampler-cache */
-    img->wgpu.sampler = 0;
+    /* NOTE: do *not* destroy the sampler from the shared-sampler-cache,
+       only release the reference
+    */
+    if (img->wgpu.sampler) {
+        _sg_smpcache_release_item(&_sg.wgpu.sampler_cache, img->wgpu.sampler_cache_item);
+        img->wgpu.sampler = 0;
+    }
 }
 
 /*
@@ -11255,174 +15052,1568 @@ _SOKOL_PRIVATE void _sg_wgpu_apply_viewport(int x, int y, int w, int h, bool ori
     wgpuRenderPassEncoderSetViewport(_sg.wgpu.pass_enc, xf, yf, wf, hf, 0.0f, 1.0f);
 }
 
-_SOKOL_PRIVATE void _sg_wgpu_apply_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
-    SOKOL_ASSERT(_sg.wgpu.in_pass);
-    SOKOL_ASSERT(_sg.wgpu.pass_enc);
-    SOKOL_ASSERT(_sg.wgpu.in_pass);
-    SOKOL_ASSERT(_sg.wgpu.pass_enc);
+_SOKOL_PRIVATE void _sg_wgpu_apply_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
+    SOKOL_ASSERT(_sg.wgpu.in_pass);
+    SOKOL_ASSERT(_sg.wgpu.pass_enc);
+    SOKOL_ASSERT(_sg.wgpu.in_pass);
+    SOKOL_ASSERT(_sg.wgpu.pass_enc);
+
+    /* clip against framebuffer rect */
+    x = _sg_min(_sg_max(0, x), _sg.wgpu.cur_width-1);
+    y = _sg_min(_sg_max(0, y), _sg.wgpu.cur_height-1);
+    if ((x + w) > _sg.wgpu.cur_width) {
+        w = _sg.wgpu.cur_width - x;
+    }
+    if ((y + h) > _sg.wgpu.cur_height) {
+        h = _sg.wgpu.cur_height - y;
+    }
+    w = _sg_max(w, 1);
+    h = _sg_max(h, 1);
+
+    uint32_t sx = (uint32_t) x;
+    uint32_t sy = origin_top_left ? y : (_sg.wgpu.cur_height - (y + h));
+    uint32_t sw = w;
+    uint32_t sh = h;
+    wgpuRenderPassEncoderSetScissorRect(_sg.wgpu.pass_enc, sx, sy, sw, sh);
+}
+
+_SOKOL_PRIVATE void _sg_wgpu_apply_pipeline(_sg_pipeline_t* pip) {
+    SOKOL_ASSERT(pip);
+    SOKOL_ASSERT(pip->wgpu.pip);
+    SOKOL_ASSERT(_sg.wgpu.in_pass);
+    SOKOL_ASSERT(_sg.wgpu.pass_enc);
+    _sg.wgpu.draw_indexed = (pip->cmn.index_type != SG_INDEXTYPE_NONE);
+    _sg.wgpu.cur_pipeline = pip;
+    _sg.wgpu.cur_pipeline_id.id = pip->slot.id;
+    wgpuRenderPassEncoderSetPipeline(_sg.wgpu.pass_enc, pip->wgpu.pip);
+    wgpuRenderPassEncoderSetBlendColor(_sg.wgpu.pass_enc, (WGPUColor*)pip->cmn.blend_color);
+    wgpuRenderPassEncoderSetStencilReference(_sg.wgpu.pass_enc, pip->wgpu.stencil_ref);
+}
+
+_SOKOL_PRIVATE WGPUBindGroup _sg_wgpu_create_images_bindgroup(WGPUBindGroupLayout bgl, const _sg_image_hot_t** imgs, int num_imgs) {
+    SOKOL_ASSERT(_sg.wgpu.dev);
+    SOKOL_ASSERT(num_imgs <= _SG_WGPU_MAX_SHADERSTAGE_IMAGES);
+    WGPUBindGroupBinding img_bgb[_SG_WGPU_MAX_SHADERSTAGE_IMAGES * 2];
+    memset(&img_bgb, 0, sizeof(img_bgb));
+    for (int img_index = 0; img_index < num_imgs; img_index++) {
+        WGPUBindGroupBinding* tex_bdg = &img_bgb[img_index*2 + 0];
+        WGPUBindGroupBinding* smp_bdg = &img_bgb[img_index*2 + 1];
+        tex_bdg->binding = img_index;
+        tex_bdg->textureView = imgs[img_index]->wgpu.tex_view;
+        smp_bdg->binding = img_index + _SG_WGPU_MAX_SHADERSTAGE_IMAGES;
+        smp_bdg->sampler = imgs[img_index]->wgpu.sampler;
+    }
+    WGPUBindGroupDescriptor bg_desc;
+    memset(&bg_desc, 0, sizeof(bg_desc));
+    bg_desc.layout = bgl;
+    bg_desc.bindingCount = 2 * num_imgs;
+    bg_desc.bindings = &img_bgb[0];
+    WGPUBindGroup bg = wgpuDeviceCreateBindGroup(_sg.wgpu.dev, &bg_desc);
+    SOKOL_ASSERT(bg);
+    return bg;
+}
+
+_SOKOL_PRIVATE void _sg_wgpu_apply_bindings(
+    _sg_pipeline_t* pip,
+    const _sg_buffer_hot_t** vbs, const int* vb_offsets, int num_vbs,
+    const _sg_buffer_hot_t* ib, int ib_offset,
+    const _sg_image_hot_t** vs_imgs, int num_vs_imgs,
+    const _sg_image_hot_t** fs_imgs, int num_fs_imgs)
+{
+    SOKOL_ASSERT(_sg.wgpu.in_pass);
+    SOKOL_ASSERT(_sg.wgpu.pass_enc);
+    SOKOL_ASSERT(pip->shader && (pip->cmn.shader_id.id == pip->shader->slot.id));
+
+    /* index buffer */
+    if (ib) {
+        wgpuRenderPassEncoderSetIndexBuffer(_sg.wgpu.pass_enc, ib->wgpu.buf, ib_offset);
+    }
+
+    /* vertex buffers */
+    for (uint32_t slot = 0; slot < (uint32_t)num_vbs; slot++) {
+        wgpuRenderPassEncoderSetVertexBuffer(_sg.wgpu.pass_enc, slot, vbs[slot]->wgpu.buf, (uint64_t)vb_offsets[slot]);
+    }
+
+    /* need to create throw-away bind groups for images */
+    if (num_vs_imgs > 0) {
+        if (num_vs_imgs > _SG_WGPU_MAX_SHADERSTAGE_IMAGES) {
+            num_vs_imgs = _SG_WGPU_MAX_SHADERSTAGE_IMAGES;
+        }
+        WGPUBindGroupLayout vs_bgl = pip->shader->wgpu.stage[SG_SHADERSTAGE_VS].bind_group_layout;
+        SOKOL_ASSERT(vs_bgl);
+        WGPUBindGroup vs_img_bg = _sg_wgpu_create_images_bindgroup(vs_bgl, vs_imgs, num_vs_imgs);
+        wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 1, vs_img_bg, 0, 0);
+        wgpuBindGroupRelease(vs_img_bg);
+    }
+    else {
+        wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 1, _sg.wgpu.empty_bind_group, 0, 0);
+    }
+    if (num_fs_imgs > 0) {
+        if (num_fs_imgs > _SG_WGPU_MAX_SHADERSTAGE_IMAGES) {
+            num_fs_imgs = _SG_WGPU_MAX_SHADERSTAGE_IMAGES;
+        }
+        WGPUBindGroupLayout fs_bgl = pip->shader->wgpu.stage[SG_SHADERSTAGE_FS].bind_group_layout;
+        SOKOL_ASSERT(fs_bgl);
+        WGPUBindGroup fs_img_bg = _sg_wgpu_create_images_bindgroup(fs_bgl, fs_imgs, num_fs_imgs);
+        wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 2, fs_img_bg, 0, 0);
+        wgpuBindGroupRelease(fs_img_bg);
+    }
+    else {
+        wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 2, _sg.wgpu.empty_bind_group, 0, 0);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_wgpu_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
+    SOKOL_ASSERT(_sg.wgpu.in_pass);
+    SOKOL_ASSERT(_sg.wgpu.pass_enc);
+    SOKOL_ASSERT(data && (num_bytes > 0));
+    SOKOL_ASSERT((stage_index >= 0) && ((int)stage_index < SG_NUM_SHADER_STAGES));
+    SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
+    SOKOL_ASSERT((_sg.wgpu.ub.offset + num_bytes) <= _sg.wgpu.ub.num_bytes);
+    SOKOL_ASSERT((_sg.wgpu.ub.offset & (_SG_WGPU_STAGING_ALIGN-1)) == 0);
+    SOKOL_ASSERT(_sg.wgpu.cur_pipeline && _sg.wgpu.cur_pipeline->shader);
+    SOKOL_ASSERT(_sg.wgpu.cur_pipeline->slot.id == _sg.wgpu.cur_pipeline_id.id);
+    SOKOL_ASSERT(_sg.wgpu.cur_pipeline->shader->slot.id == _sg.wgpu.cur_pipeline->cmn.shader_id.id);
+    SOKOL_ASSERT(ub_index < _sg.wgpu.cur_pipeline->shader->cmn.stage[stage_index].num_uniform_blocks);
+    SOKOL_ASSERT(num_bytes <= _sg.wgpu.cur_pipeline->shader->cmn.stage[stage_index].uniform_blocks[ub_index].size);
+    SOKOL_ASSERT(num_bytes <= _SG_WGPU_MAX_UNIFORM_UPDATE_SIZE);
+    SOKOL_ASSERT(0 != _sg.wgpu.ub.stage.ptr[_sg.wgpu.ub.stage.cur]);
+
+    uint8_t* dst_ptr = _sg.wgpu.ub.stage.ptr[_sg.wgpu.ub.stage.cur] + _sg.wgpu.ub.offset;
+    memcpy(dst_ptr, data, num_bytes);
+    _sg.wgpu.ub.bind_offsets[stage_index][ub_index] = _sg.wgpu.ub.offset;
+    wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc,
+                                      0, /* groupIndex 0 is reserved for uniform buffers */
+                                      _sg.wgpu.ub.bindgroup,
+                                      SG_NUM_SHADER_STAGES * SG_MAX_SHADERSTAGE_UBS,
+                                      &_sg.wgpu.ub.bind_offsets[0][0]);
+    _sg.wgpu.ub.offset = _sg_roundup(_sg.wgpu.ub.offset + num_bytes, _SG_WGPU_STAGING_ALIGN);
+}
+
+_SOKOL_PRIVATE void _sg_wgpu_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
+    SOKOL_ASSERT(_sg.wgpu.in_pass);
+    SOKOL_ASSERT(_sg.wgpu.pass_enc);
+    if (_sg.wgpu.draw_indexed) {
+        wgpuRenderPassEncoderDrawIndexed(_sg.wgpu.pass_enc, num_elements, num_instances, base_element, base_vertex, 0);
+    }
+    else {
+        wgpuRenderPassEncoderDraw(_sg.wgpu.pass_enc, num_elements, num_instances, base_element + base_vertex, 0);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_wgpu_update_buffer(_sg_buffer_t* buf, const void* data, uint32_t num_bytes) {
+    SOKOL_ASSERT(buf && data && (num_bytes > 0));
+    uint32_t copied_num_bytes = _sg_wgpu_staging_copy_to_buffer(buf->wgpu.buf, 0, data, (uint32_t)num_bytes);
+    SOKOL_ASSERT(copied_num_bytes > 0); _SOKOL_UNUSED(copied_num_bytes);
+}
+
+_SOKOL_PRIVATE uint32_t _sg_wgpu_append_buffer(_sg_buffer_t* buf, const void* data, uint32_t num_bytes, bool new_frame) {
+    SOKOL_ASSERT(buf && data && (num_bytes > 0));
+    _SOKOL_UNUSED(new_frame);
+    uint32_t copied_num_bytes = _sg_wgpu_staging_copy_to_buffer(buf->wgpu.buf, buf->cmn.append_pos, data, num_bytes);
+    SOKOL_ASSERT(copied_num_bytes > 0); _SOKOL_UNUSED(copied_num_bytes);
+    return copied_num_bytes;
+}
+
+_SOKOL_PRIVATE void* _sg_wgpu_map_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    _SOKOL_UNUSED(buf);
+    /* buffer updates go through the staging buffer, use the shadow buffer */
+    return 0;
+}
+
+_SOKOL_PRIVATE void _sg_wgpu_unmap_buffer(_sg_buffer_t* buf, const void* data, uint32_t num_bytes) {
+    SOKOL_ASSERT(buf && data);
+    _sg_wgpu_update_buffer(buf, data, num_bytes);
+}
+
+_SOKOL_PRIVATE void _sg_wgpu_update_image(_sg_image_t* img, const sg_image_content* data) {
+    SOKOL_ASSERT(img && data);
+    bool success = _sg_wgpu_staging_copy_to_texture(img, data);
+    SOKOL_ASSERT(success);
+    _SOKOL_UNUSED(success);
+}
+/*== SOFT BACKEND IMPL =======================================================*/
+#elif defined(SOKOL_SOFT)
+
+/*-- worker threads ----------------------------------------------------------*/
+_SOKOL_PRIVATE void _sg_soft_lock(void) {
+    #if defined(_WIN32)
+    EnterCriticalSection(&_sg.soft.workers.mutex);
+    #else
+    pthread_mutex_lock(&_sg.soft.workers.mutex);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_soft_unlock(void) {
+    #if defined(_WIN32)
+    LeaveCriticalSection(&_sg.soft.workers.mutex);
+    #else
+    pthread_mutex_unlock(&_sg.soft.workers.mutex);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_soft_wait_for_work(void) {
+    #if defined(_WIN32)
+    SleepConditionVariableCS(&_sg.soft.workers.work_cond, &_sg.soft.workers.mutex, INFINITE);
+    #else
+    pthread_cond_wait(&_sg.soft.workers.work_cond, &_sg.soft.workers.mutex);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_soft_wait_for_done(void) {
+    #if defined(_WIN32)
+    SleepConditionVariableCS(&_sg.soft.workers.done_cond, &_sg.soft.workers.mutex, INFINITE);
+    #else
+    pthread_cond_wait(&_sg.soft.workers.done_cond, &_sg.soft.workers.mutex);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_soft_signal_work(void) {
+    #if defined(_WIN32)
+    WakeAllConditionVariable(&_sg.soft.workers.work_cond);
+    #else
+    pthread_cond_broadcast(&_sg.soft.workers.work_cond);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_soft_signal_done(void) {
+    #if defined(_WIN32)
+    WakeConditionVariable(&_sg.soft.workers.done_cond);
+    #else
+    pthread_cond_signal(&_sg.soft.workers.done_cond);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_soft_raster_tile(int tile_index);
+
+/* grab and rasterize tiles until all tiles of the current batch are taken,
+   called by the worker threads and the thread which flushes the batch
+*/
+_SOKOL_PRIVATE void _sg_soft_raster_tiles(void) {
+    _sg_soft_workers_t* w = &_sg.soft.workers;
+    _sg_soft_lock();
+    while (w->next_tile < w->num_tiles) {
+        const int tile_index = w->next_tile++;
+        _sg_soft_unlock();
+        _sg_soft_raster_tile(tile_index);
+        _sg_soft_lock();
+        if (++w->num_tiles_done == w->num_tiles) {
+            _sg_soft_signal_done();
+        }
+    }
+    _sg_soft_unlock();
+}
+
+#if defined(_WIN32)
+_SOKOL_PRIVATE DWORD WINAPI _sg_soft_worker_func(LPVOID arg) {
+#else
+_SOKOL_PRIVATE void* _sg_soft_worker_func(void* arg) {
+#endif
+    _SOKOL_UNUSED(arg);
+    _sg_soft_workers_t* w = &_sg.soft.workers;
+    uint32_t job_id = 0;
+    for (;;) {
+        _sg_soft_lock();
+        while (!w->quit && (w->job_id == job_id)) {
+            _sg_soft_wait_for_work();
+        }
+        const bool quit = w->quit;
+        job_id = w->job_id;
+        _sg_soft_unlock();
+        if (quit) {
+            break;
+        }
+        _sg_soft_raster_tiles();
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE void _sg_soft_setup_workers(int num_threads) {
+    _sg_soft_workers_t* w = &_sg.soft.workers;
+    #if defined(_WIN32)
+    InitializeCriticalSection(&w->mutex);
+    InitializeConditionVariable(&w->work_cond);
+    InitializeConditionVariable(&w->done_cond);
+    #else
+    pthread_mutex_init(&w->mutex, 0);
+    pthread_cond_init(&w->work_cond, 0);
+    pthread_cond_init(&w->done_cond, 0);
+    #endif
+    /* the calling thread rasterizes tiles too */
+    const int num_workers = _sg_min(num_threads, (int)_SG_SOFT_MAX_THREADS) - 1;
+    for (int i = 0; i < num_workers; i++) {
+        #if defined(_WIN32)
+        w->threads[i] = CreateThread(NULL, 0, _sg_soft_worker_func, NULL, 0, NULL);
+        const bool ok = (NULL != w->threads[i]);
+        #else
+        const bool ok = (0 == pthread_create(&w->threads[i], 0, _sg_soft_worker_func, 0));
+        #endif
+        if (!ok) {
+            SOKOL_LOG("_sg_soft_setup_workers: failed to create worker thread\n");
+            break;
+        }
+        w->num_threads++;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_soft_discard_workers(void) {
+    _sg_soft_workers_t* w = &_sg.soft.workers;
+    _sg_soft_lock();
+    w->quit = true;
+    _sg_soft_signal_work();
+    _sg_soft_unlock();
+    for (int i = 0; i < w->num_threads; i++) {
+        #if defined(_WIN32)
+        WaitForSingleObject(w->threads[i], INFINITE);
+        CloseHandle(w->threads[i]);
+        #else
+        pthread_join(w->threads[i], 0);
+        #endif
+    }
+    w->num_threads = 0;
+    #if defined(_WIN32)
+    DeleteCriticalSection(&w->mutex);
+    #else
+    pthread_cond_destroy(&w->done_cond);
+    pthread_cond_destroy(&w->work_cond);
+    pthread_mutex_destroy(&w->mutex);
+    #endif
+}
+
+/* rasterize tiles [0, num_tiles) on all threads, returns when all tiles are done */
+_SOKOL_PRIVATE void _sg_soft_run_tiles(int num_tiles) {
+    _sg_soft_workers_t* w = &_sg.soft.workers;
+    if (0 == w->num_threads) {
+        for (int tile_index = 0; tile_index < num_tiles; tile_index++) {
+            _sg_soft_raster_tile(tile_index);
+        }
+        return;
+    }
+    _sg_soft_lock();
+    w->num_tiles = num_tiles;
+    w->next_tile = 0;
+    w->num_tiles_done = 0;
+    w->job_id++;
+    _sg_soft_signal_work();
+    _sg_soft_unlock();
+    _sg_soft_raster_tiles();
+    _sg_soft_lock();
+    while (w->num_tiles_done < w->num_tiles) {
+        _sg_soft_wait_for_done();
+    }
+    _sg_soft_unlock();
+}
+
+/*-- pixel processing --------------------------------------------------------*/
+_SOKOL_PRIVATE float _sg_soft_saturate(float v) {
+    return (v < 0.0f) ? 0.0f : ((v > 1.0f) ? 1.0f : v);
+}
+
+_SOKOL_PRIVATE uint8_t _sg_soft_unorm8(float v) {
+    return (uint8_t)(_sg_soft_saturate(v) * 255.0f + 0.5f);
+}
+
+_SOKOL_PRIVATE bool _sg_soft_compare(sg_compare_func func, float val, float ref) {
+    switch (func) {
+        case SG_COMPAREFUNC_NEVER:          return false;
+        case SG_COMPAREFUNC_LESS:           return val < ref;
+        case SG_COMPAREFUNC_EQUAL:          return val == ref;
+        case SG_COMPAREFUNC_LESS_EQUAL:     return val <= ref;
+        case SG_COMPAREFUNC_GREATER:        return val > ref;
+        case SG_COMPAREFUNC_NOT_EQUAL:      return val != ref;
+        case SG_COMPAREFUNC_GREATER_EQUAL:  return val >= ref;
+        default:                            return true;
+    }
+}
+
+_SOKOL_PRIVATE float _sg_soft_blend_factor(sg_blend_factor f, const float* src, const float* dst, const float* blend_color, int chn) {
+    switch (f) {
+        case SG_BLENDFACTOR_ZERO:                   return 0.0f;
+        case SG_BLENDFACTOR_ONE:                    return 1.0f;
+        case SG_BLENDFACTOR_SRC_COLOR:              return src[chn];
+        case SG_BLENDFACTOR_ONE_MINUS_SRC_COLOR:    return 1.0f - src[chn];
+        case SG_BLENDFACTOR_SRC_ALPHA:              return src[3];
+        case SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA:    return 1.0f - src[3];
+        case SG_BLENDFACTOR_DST_COLOR:              return dst[chn];
+        case SG_BLENDFACTOR_ONE_MINUS_DST_COLOR:    return 1.0f - dst[chn];
+        case SG_BLENDFACTOR_DST_ALPHA:              return dst[3];
+        case SG_BLENDFACTOR_ONE_MINUS_DST_ALPHA:    return 1.0f - dst[3];
+        case SG_BLENDFACTOR_SRC_ALPHA_SATURATED:    return (3 == chn) ? 1.0f : _sg_min(src[3], 1.0f - dst[3]);
+        case SG_BLENDFACTOR_BLEND_COLOR:            return blend_color[chn];
+        case SG_BLENDFACTOR_ONE_MINUS_BLEND_COLOR:  return 1.0f - blend_color[chn];
+        case SG_BLENDFACTOR_BLEND_ALPHA:            return blend_color[3];
+        case SG_BLENDFACTOR_ONE_MINUS_BLEND_ALPHA:  return 1.0f - blend_color[3];
+        default:                                    return 1.0f;
+    }
+}
+
+_SOKOL_PRIVATE float _sg_soft_blend_op(sg_blend_op op, float src, float dst) {
+    switch (op) {
+        case SG_BLENDOP_SUBTRACT:           return src - dst;
+        case SG_BLENDOP_REVERSE_SUBTRACT:   return dst - src;
+        default:                            return src + dst;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_soft_write_color(const sg_blend_state* bs, uint8_t* dst_pixel, const float* color) {
+    float src[4];
+    float res[4];
+    for (int i = 0; i < 4; i++) {
+        src[i] = _sg_soft_saturate(color[i]);
+    }
+    if (bs->enabled) {
+        float dst[4];
+        for (int i = 0; i < 4; i++) {
+            dst[i] = (float)dst_pixel[i] / 255.0f;
+        }
+        for (int i = 0; i < 4; i++) {
+            const bool alpha = (3 == i);
+            const float sf = _sg_soft_blend_factor(alpha ? bs->src_factor_alpha : bs->src_factor_rgb, src, dst, bs->blend_color, i);
+            const float df = _sg_soft_blend_factor(alpha ? bs->dst_factor_alpha : bs->dst_factor_rgb, src, dst, bs->blend_color, i);
+            res[i] = _sg_soft_blend_op(alpha ? bs->op_alpha : bs->op_rgb, src[i] * sf, dst[i] * df);
+        }
+    }
+    else {
+        memcpy(res, src, sizeof(res));
+    }
+    for (int i = 0; i < 4; i++) {
+        if (bs->color_write_mask & (1<<i)) {
+            dst_pixel[i] = _sg_soft_unorm8(res[i]);
+        }
+    }
+}
+
+/* shade a covered pixel, e[] are the exact edge function values at the pixel center */
+_SOKOL_PRIVATE void _sg_soft_shade_pixel(const _sg_soft_tri_t* tri, const _sg_soft_draw_t* draw, sg_soft_fs_input* in, float* varyings, int x, int y, const double* e) {
+    const int pixel_index = y * _sg.soft.target.width + x;
+    const double l0 = e[0] * tri->inv_area;
+    const double l1 = e[1] * tri->inv_area;
+    const double l2 = e[2] * tri->inv_area;
+    const float z = _sg_soft_saturate((float)(l0 * tri->z[0] + l1 * tri->z[1] + l2 * tri->z[2]));
+    float* depth = _sg.soft.target.depth ? &_sg.soft.target.depth[pixel_index] : 0;
+    if (depth && !_sg_soft_compare(draw->depth_compare_func, z, *depth)) {
+        return;
+    }
+    /* perspective-correct interpolation */
+    const double inv_w = l0 * tri->inv_w[0] + l1 * tri->inv_w[1] + l2 * tri->inv_w[2];
+    const double w = 1.0 / inv_w;
+    for (int i = 0; i < draw->num_varyings; i++) {
+        varyings[i] = (float)((l0 * tri->varyings[0][i] + l1 * tri->varyings[1][i] + l2 * tri->varyings[2][i]) * w);
+    }
+    in->frag_coord[0] = (float)x + 0.5f;
+    in->frag_coord[1] = (float)y + 0.5f;
+    in->frag_coord[2] = z;
+    in->frag_coord[3] = (float)inv_w;
+    sg_soft_fs_output out;
+    memset(&out, 0, sizeof(out));
+    draw->fs(in, &out);
+    if (out.discard) {
+        return;
+    }
+    if (depth && draw->depth_write_enabled) {
+        *depth = z;
+    }
+    _sg_soft_write_color(&draw->blend, &_sg.soft.target.color[pixel_index * 4], out.color);
+}
+
+/* coverage of 4 horizontally adjacent pixels starting at the edge function values e[], one bit per pixel */
+_SOKOL_PRIVATE int _sg_soft_coverage4(const _sg_soft_tri_t* tri, const double* e) {
+    #if defined(_SOKOL_SOFT_SSE2)
+    __m128d mask_lo = _mm_cmpeq_pd(_mm_setzero_pd(), _mm_setzero_pd());
+    __m128d mask_hi = mask_lo;
+    const __m128d steps_lo = _mm_set_pd(1.0, 0.0);
+    const __m128d steps_hi = _mm_set_pd(3.0, 2.0);
+    for (int i = 0; i < 3; i++) {
+        const __m128d a = _mm_set1_pd(tri->a[i]);
+        const __m128d e0 = _mm_set1_pd(e[i]);
+        const __m128d thr = _mm_set1_pd(tri->thr[i]);
+        mask_lo = _mm_and_pd(mask_lo, _mm_cmpge_pd(_mm_add_pd(e0, _mm_mul_pd(a, steps_lo)), thr));
+        mask_hi = _mm_and_pd(mask_hi, _mm_cmpge_pd(_mm_add_pd(e0, _mm_mul_pd(a, steps_hi)), thr));
+    }
+    return _mm_movemask_pd(mask_lo) | (_mm_movemask_pd(mask_hi) << 2);
+    #else
+    int mask = 0;
+    for (int px = 0; px < 4; px++) {
+        if (((e[0] + px * tri->a[0]) >= tri->thr[0]) &&
+            ((e[1] + px * tri->a[1]) >= tri->thr[1]) &&
+            ((e[2] + px * tri->a[2]) >= tri->thr[2]))
+        {
+            mask |= 1<<px;
+        }
+    }
+    return mask;
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_soft_raster_triangle(const _sg_soft_tri_t* tri, int x0, int y0, int x1, int y1) {
+    const _sg_soft_draw_t* draw = &_sg.soft.batch.draws[tri->draw_index];
+    float varyings[SG_SOFT_MAX_VARYINGS];
+    sg_soft_fs_input in;
+    memset(&in, 0, sizeof(in));
+    in.varyings = varyings;
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_UBS; i++) {
+        in.uniforms[i] = draw->fs_uniforms[i];
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        in.images[i] = draw->fs_images[i].pixels ? &draw->fs_images[i] : 0;
+    }
+    in.front_facing = tri->front_facing;
+    /* all edge function values are integers, so stepping them is exact */
+    for (int y = y0; y < y1; y++) {
+        double e[3];
+        for (int i = 0; i < 3; i++) {
+            e[i] = tri->a[i] * (double)x0 + tri->b[i] * (double)y + tri->c[i];
+        }
+        for (int x = x0; x < x1; x += 4) {
+            int mask = _sg_soft_coverage4(tri, e);
+            if ((x + 4) > x1) {
+                mask &= (1 << (x1 - x)) - 1;
+            }
+            for (int px = 0; mask; px++, mask >>= 1) {
+                if (mask & 1) {
+                    double pe[3];
+                    for (int i = 0; i < 3; i++) {
+                        pe[i] = e[i] + px * tri->a[i];
+                    }
+                    _sg_soft_shade_pixel(tri, draw, &in, varyings, x + px, y, pe);
+                }
+            }
+            for (int i = 0; i < 3; i++) {
+                e[i] += 4.0 * tri->a[i];
+            }
+        }
+    }
+}
+
+/* tiles don't overlap, and each tile renders its triangles in submission order */
+_SOKOL_PRIVATE void _sg_soft_raster_tile(int tile_index) {
+    const _sg_soft_batch_t* batch = &_sg.soft.batch;
+    const int tile_x0 = (tile_index % batch->num_tiles_x) << _SG_SOFT_TILE_SHIFT;
+    const int tile_y0 = (tile_index / batch->num_tiles_x) << _SG_SOFT_TILE_SHIFT;
+    const int tile_x1 = _sg_min(tile_x0 + _SG_SOFT_TILE_SIZE, _sg.soft.target.width);
+    const int tile_y1 = _sg_min(tile_y0 + _SG_SOFT_TILE_SIZE, _sg.soft.target.height);
+    for (int i = batch->tile_offsets[tile_index]; i < batch->tile_offsets[tile_index + 1]; i++) {
+        const _sg_soft_tri_t* tri = &batch->tris[batch->bins[i]];
+        const int x0 = _sg_max(tri->x0, tile_x0);
+        const int y0 = _sg_max(tri->y0, tile_y0);
+        const int x1 = _sg_min(tri->x1, tile_x1);
+        const int y1 = _sg_min(tri->y1, tile_y1);
+        _sg_soft_raster_triangle(tri, x0, y0, x1, y1);
+    }
+}
+
+/*-- binning -----------------------------------------------------------------*/
+
+/* test the tile corner which maximizes each edge function, x1/y1 inclusive */
+_SOKOL_PRIVATE bool _sg_soft_tri_overlaps_tile(const _sg_soft_tri_t* tri, int x0, int y0, int x1, int y1) {
+    for (int i = 0; i < 3; i++) {
+        const double x = (tri->a[i] > 0.0) ? (double)x1 : (double)x0;
+        const double y = (tri->b[i] > 0.0) ? (double)y1 : (double)y0;
+        if ((tri->a[i] * x + tri->b[i] * y + tri->c[i]) < tri->thr[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* calls func(tile_index, tri_index) for each tile overlapped by a queued triangle */
+#define _SG_SOFT_FOREACH_TILE_OVERLAP(batch, stmt) \
+    for (int tri_index = 0; tri_index < batch->num_tris; tri_index++) { \
+        const _sg_soft_tri_t* tri = &batch->tris[tri_index]; \
+        for (int ty = (tri->y0 >> _SG_SOFT_TILE_SHIFT); ty <= ((tri->y1 - 1) >> _SG_SOFT_TILE_SHIFT); ty++) { \
+            for (int tx = (tri->x0 >> _SG_SOFT_TILE_SHIFT); tx <= ((tri->x1 - 1) >> _SG_SOFT_TILE_SHIFT); tx++) { \
+                const int x0 = _sg_max(tri->x0, tx << _SG_SOFT_TILE_SHIFT); \
+                const int y0 = _sg_max(tri->y0, ty << _SG_SOFT_TILE_SHIFT); \
+                const int x1 = _sg_min(tri->x1, (tx + 1) << _SG_SOFT_TILE_SHIFT) - 1; \
+                const int y1 = _sg_min(tri->y1, (ty + 1) << _SG_SOFT_TILE_SHIFT) - 1; \
+                if (_sg_soft_tri_overlaps_tile(tri, x0, y0, x1, y1)) { \
+                    const int tile_index = ty * batch->num_tiles_x + tx; \
+                    stmt; \
+                } \
+            } \
+        } \
+    }
+
+/* rasterize all queued triangles into the current render target */
+_SOKOL_PRIVATE void _sg_soft_flush(void) {
+    _sg_soft_batch_t* batch = &_sg.soft.batch;
+    if (batch->num_tris > 0) {
+        batch->num_tiles_x = (_sg.soft.target.width + _SG_SOFT_TILE_SIZE - 1) >> _SG_SOFT_TILE_SHIFT;
+        batch->num_tiles_y = (_sg.soft.target.height + _SG_SOFT_TILE_SIZE - 1) >> _SG_SOFT_TILE_SHIFT;
+        const int num_tiles = batch->num_tiles_x * batch->num_tiles_y;
+        if ((num_tiles + 1) > batch->tiles_capacity) {
+            SOKOL_FREE(batch->tile_offsets);
+            batch->tiles_capacity = num_tiles + 1;
+            batch->tile_offsets = (int*) SOKOL_MALLOC((size_t)batch->tiles_capacity * sizeof(int));
+            SOKOL_ASSERT(batch->tile_offsets);
+        }
+        int* offsets = batch->tile_offsets;
+        memset(offsets, 0, (size_t)(num_tiles + 1) * sizeof(int));
+
+        /* counting sort of triangles into tile bins, keeping submission order */
+        _SG_SOFT_FOREACH_TILE_OVERLAP(batch, offsets[tile_index + 1]++);
+        for (int i = 1; i <= num_tiles; i++) {
+            offsets[i] += offsets[i - 1];
+        }
+        const int num_entries = offsets[num_tiles];
+        if (num_entries > batch->bins_capacity) {
+            SOKOL_FREE(batch->bins);
+            batch->bins_capacity = _sg_max(num_entries, 2 * batch->bins_capacity);
+            batch->bins = (int*) SOKOL_MALLOC((size_t)batch->bins_capacity * sizeof(int));
+            SOKOL_ASSERT(batch->bins);
+        }
+        /* offsets[i] is used as write cursor and ends up at the start of tile i+1 */
+        _SG_SOFT_FOREACH_TILE_OVERLAP(batch, batch->bins[offsets[tile_index]++] = tri_index);
+        memmove(&offsets[1], &offsets[0], (size_t)num_tiles * sizeof(int));
+        offsets[0] = 0;
+
+        _sg_soft_run_tiles(num_tiles);
+    }
+    batch->num_tris = 0;
+    batch->num_draws = 0;
+    batch->ub_pos = 0;
+    _sg.soft.cur_draw_index = -1;
+}
+
+/*-- vertex processing -------------------------------------------------------*/
+_SOKOL_PRIVATE void _sg_soft_fetch_attr(sg_vertex_format fmt, const uint8_t* ptr, float* out) {
+    switch (fmt) {
+        case SG_VERTEXFORMAT_FLOAT:     memcpy(out, ptr, 1 * sizeof(float)); break;
+        case SG_VERTEXFORMAT_FLOAT2:    memcpy(out, ptr, 2 * sizeof(float)); break;
+        case SG_VERTEXFORMAT_FLOAT3:    memcpy(out, ptr, 3 * sizeof(float)); break;
+        case SG_VERTEXFORMAT_FLOAT4:    memcpy(out, ptr, 4 * sizeof(float)); break;
+        case SG_VERTEXFORMAT_BYTE4:
+        case SG_VERTEXFORMAT_BYTE4N:
+            for (int i = 0; i < 4; i++) {
+                const float v = (float)(int8_t)ptr[i];
+                out[i] = (SG_VERTEXFORMAT_BYTE4N == fmt) ? _sg_max(v / 127.0f, -1.0f) : v;
+            }
+            break;
+        case SG_VERTEXFORMAT_UBYTE4:
+        case SG_VERTEXFORMAT_UBYTE4N:
+            for (int i = 0; i < 4; i++) {
+                out[i] = (SG_VERTEXFORMAT_UBYTE4N == fmt) ? ((float)ptr[i] / 255.0f) : (float)ptr[i];
+            }
+            break;
+        case SG_VERTEXFORMAT_SHORT2:
+        case SG_VERTEXFORMAT_SHORT2N:
+        case SG_VERTEXFORMAT_SHORT4:
+        case SG_VERTEXFORMAT_SHORT4N:
+            {
+                int16_t v[4];
+                const int n = ((SG_VERTEXFORMAT_SHORT2 == fmt) || (SG_VERTEXFORMAT_SHORT2N == fmt)) ? 2 : 4;
+                const bool norm = (SG_VERTEXFORMAT_SHORT2N == fmt) || (SG_VERTEXFORMAT_SHORT4N == fmt);
+                memcpy(v, ptr, (size_t)n * sizeof(int16_t));
+                for (int i = 0; i < n; i++) {
+                    out[i] = norm ? _sg_max((float)v[i] / 32767.0f, -1.0f) : (float)v[i];
+                }
+            }
+            break;
+        case SG_VERTEXFORMAT_USHORT2N:
+        case SG_VERTEXFORMAT_USHORT4N:
+            {
+                uint16_t v[4];
+                const int n = (SG_VERTEXFORMAT_USHORT2N == fmt) ? 2 : 4;
+                memcpy(v, ptr, (size_t)n * sizeof(uint16_t));
+                for (int i = 0; i < n; i++) {
+                    out[i] = (float)v[i] / 65535.0f;
+                }
+            }
+            break;
+        case SG_VERTEXFORMAT_UINT10_N2:
+            {
+                uint32_t v;
+                memcpy(&v, ptr, sizeof(v));
+                out[0] = (float)(v & 0x3FF) / 1023.0f;
+                out[1] = (float)((v >> 10) & 0x3FF) / 1023.0f;
+                out[2] = (float)((v >> 20) & 0x3FF) / 1023.0f;
+                out[3] = (float)(v >> 30) / 3.0f;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* run the vertex function, or return the cached result, vertices outside the
+   bound vertex buffers read (0,0,0,1) for all attributes
+*/
+_SOKOL_PRIVATE const sg_soft_vs_output* _sg_soft_process_vertex(int vertex_index, int instance_index) {
+    _sg_soft_cached_vertex_t* cv = &_sg.soft.vcache[vertex_index & (_SG_SOFT_VERTEX_CACHE_SIZE - 1)];
+    if ((vertex_index >= 0) && (cv->index == vertex_index)) {
+        return &cv->out;
+    }
+    const _sg_pipeline_t* pip = _sg.soft.cur_pipeline;
+    const _sg_shader_t* shd = pip->shader;
+    sg_soft_vs_input in;
+    memset(&in, 0, sizeof(in));
+    for (int attr_index = 0; attr_index < pip->soft.num_attrs; attr_index++) {
+        const _sg_soft_attr_t* attr = &pip->soft.attrs[attr_index];
+        const int vb_index = attr->buffer_index;
+        float* dst = in.attrs[attr_index];
+        dst[3] = 1.0f;
+        int element = vertex_index;
+        if (SG_VERTEXSTEP_PER_INSTANCE == pip->soft.vb_step_funcs[vb_index]) {
+            element = instance_index / pip->soft.vb_step_rates[vb_index];
+        }
+        if (_sg.soft.cur_vbs[vb_index] && (element >= 0)) {
+            const int64_t offset = (int64_t)element * pip->soft.vb_strides[vb_index] + attr->offset;
+            if ((offset + _sg_vertexformat_bytesize(attr->format)) <= _sg.soft.cur_vb_sizes[vb_index]) {
+                _sg_soft_fetch_attr(attr->format, _sg.soft.cur_vbs[vb_index] + offset, dst);
+            }
+        }
+    }
+    for (int ub_index = 0; ub_index < shd->cmn.stage[SG_SHADERSTAGE_VS].num_uniform_blocks; ub_index++) {
+        in.uniforms[ub_index] = _sg.soft.ub[SG_SHADERSTAGE_VS][ub_index];
+    }
+    for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+        in.images[img_index] = _sg.soft.cur_vs_images[img_index];
+    }
+    in.vertex_index = vertex_index;
+    in.instance_index = instance_index;
+    cv->index = vertex_index;
+    memset(&cv->out, 0, sizeof(cv->out));
+    shd->soft.vs(&in, &cv->out);
+    return &cv->out;
+}
+
+/* start a new queued draw with a snapshot of the current fragment stage state */
+_SOKOL_PRIVATE void _sg_soft_begin_draw(void) {
+    _sg_soft_batch_t* batch = &_sg.soft.batch;
+    const _sg_pipeline_t* pip = _sg.soft.cur_pipeline;
+    const _sg_shader_t* shd = pip->shader;
+    const _sg_shader_stage_t* stage = &shd->cmn.stage[SG_SHADERSTAGE_FS];
+    int ub_size = 0;
+    for (int ub_index = 0; ub_index < stage->num_uniform_blocks; ub_index++) {
+        ub_size += _sg_roundup(stage->uniform_blocks[ub_index].size, 16);
+    }
+    if ((batch->num_draws == _SG_SOFT_MAX_BATCH_DRAWS) || ((batch->ub_pos + ub_size) > _SG_SOFT_BATCH_UB_SIZE)) {
+        _sg_soft_flush();
+    }
+    _sg_soft_draw_t* draw = &batch->draws[batch->num_draws];
+    memset(draw, 0, sizeof(_sg_soft_draw_t));
+    draw->fs = shd->soft.fs;
+    draw->num_varyings = shd->soft.num_varyings;
+    draw->depth_compare_func = pip->soft.depth_compare_func;
+    draw->depth_write_enabled = pip->soft.depth_write_enabled;
+    draw->blend = pip->soft.blend;
+    for (int ub_index = 0; ub_index < stage->num_uniform_blocks; ub_index++) {
+        const int size = stage->uniform_blocks[ub_index].size;
+        uint8_t* ptr = batch->ub_data + batch->ub_pos;
+        memcpy(ptr, _sg.soft.ub[SG_SHADERSTAGE_FS][ub_index], (size_t)size);
+        draw->fs_uniforms[ub_index] = ptr;
+        batch->ub_pos += _sg_roundup(size, 16);
+    }
+    for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+        if (_sg.soft.cur_fs_images[img_index]) {
+            draw->fs_images[img_index] = *_sg.soft.cur_fs_images[img_index];
+        }
+    }
+    _sg.soft.cur_draw_index = batch->num_draws++;
+}
+
+_SOKOL_PRIVATE int64_t _sg_soft_floor_div16(int64_t v) {
+    return (v >= 0) ? (v / 16) : -((15 - v) / 16);
+}
+
+_SOKOL_PRIVATE int _sg_soft_clamp_int(int64_t v, int min_val, int max_val) {
+    return (v < min_val) ? min_val : ((v > max_val) ? max_val : (int)v);
+}
+
+/* setup of a triangle inside the guard band, and add it to the batch */
+_SOKOL_PRIVATE void _sg_soft_setup_triangle(const sg_soft_vs_output* v0, const sg_soft_vs_output* v1, const sg_soft_vs_output* v2) {
+    const _sg_pipeline_t* pip = _sg.soft.cur_pipeline;
+    const sg_soft_vs_output* v[3] = { v0, v1, v2 };
+    double inv_w[3];
+    int64_t x[3], y[3];
+    for (int i = 0; i < 3; i++) {
+        /* only possible for degenerate triangles touching the eye point */
+        if (!(v[i]->pos[3] > 0.0f)) {
+            return;
+        }
+        inv_w[i] = 1.0 / (double)v[i]->pos[3];
+        const double sx = _sg.soft.vp_x + ((double)v[i]->pos[0] * inv_w[i] + 1.0) * 0.5 * _sg.soft.vp_w;
+        const double sy = _sg.soft.vp_y + (1.0 - (double)v[i]->pos[1] * inv_w[i]) * 0.5 * _sg.soft.vp_h;
+        x[i] = (int64_t) floor(sx * (1<<_SG_SOFT_SUBPIXEL_BITS) + 0.5);
+        y[i] = (int64_t) floor(sy * (1<<_SG_SOFT_SUBPIXEL_BITS) + 0.5);
+    }
+    const int64_t area2 = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (0 == area2) {
+        return;
+    }
+    /* the y axis points down, so a negative area means counter-clockwise */
+    const bool ccw = area2 < 0;
+    /* like in GL, points and lines are always front facing */
+    const bool front_facing = pip->soft.quads || ((SG_FACEWINDING_CCW == pip->soft.face_winding) ? ccw : !ccw);
+    if (((SG_CULLMODE_FRONT == pip->soft.cull_mode) && front_facing && !pip->soft.quads) ||
+        ((SG_CULLMODE_BACK == pip->soft.cull_mode) && !front_facing))
+    {
+        return;
+    }
+
+    /* pixel bounds of all pixel centers inside the vertex bounding box */
+    const int64_t min_x = _sg_min(_sg_min(x[0], x[1]), x[2]);
+    const int64_t min_y = _sg_min(_sg_min(y[0], y[1]), y[2]);
+    const int64_t max_x = _sg_max(_sg_max(x[0], x[1]), x[2]);
+    const int64_t max_y = _sg_max(_sg_max(y[0], y[1]), y[2]);
+    const int clip_x0 = _sg_max(_sg.soft.vp_x, _sg.soft.sc_x0);
+    const int clip_y0 = _sg_max(_sg.soft.vp_y, _sg.soft.sc_y0);
+    const int clip_x1 = _sg_min(_sg.soft.vp_x + _sg.soft.vp_w, _sg.soft.sc_x1);
+    const int clip_y1 = _sg_min(_sg.soft.vp_y + _sg.soft.vp_h, _sg.soft.sc_y1);
+    const int x0 = _sg_soft_clamp_int(_sg_soft_floor_div16(min_x + 7) , clip_x0, clip_x1);
+    const int y0 = _sg_soft_clamp_int(_sg_soft_floor_div16(min_y + 7), clip_y0, clip_y1);
+    const int x1 = _sg_soft_clamp_int(_sg_soft_floor_div16(max_x - 8) + 1, clip_x0, clip_x1);
+    const int y1 = _sg_soft_clamp_int(_sg_soft_floor_div16(max_y - 8) + 1, clip_y0, clip_y1);
+    if ((x0 >= x1) || (y0 >= y1)) {
+        return;
+    }
+
+    _sg_soft_batch_t* batch = &_sg.soft.batch;
+    if (batch->num_tris == _SG_SOFT_MAX_BATCH_TRIANGLES) {
+        _sg_soft_flush();
+    }
+    if (_sg.soft.cur_draw_index < 0) {
+        _sg_soft_begin_draw();
+    }
+    _sg_soft_tri_t* tri = &batch->tris[batch->num_tris++];
+    tri->x0 = x0;
+    tri->y0 = y0;
+    tri->x1 = x1;
+    tri->y1 = y1;
+    tri->draw_index = _sg.soft.cur_draw_index;
+    tri->front_facing = front_facing;
+    tri->inv_area = 1.0 / (double)(ccw ? -area2 : area2);
+
+    /* swap to clockwise order, so that inside pixels have positive edge function values */
+    const int order[3] = { 0, ccw ? 2 : 1, ccw ? 1 : 2 };
+    const int num_varyings = pip->shader->soft.num_varyings;
+    for (int i = 0; i < 3; i++) {
+        const int vi = order[i];
+        const int p = order[(i + 1) % 3];
+        const int q = order[(i + 2) % 3];
+        const int64_t dx = x[q] - x[p];
+        const int64_t dy = y[q] - y[p];
+        /* e = dx * (py - y[p]) - dy * (px - x[p]) at pixel centers (16*px+8, 16*py+8) */
+        tri->a[i] = (double)(-16 * dy);
+        tri->b[i] = (double)(16 * dx);
+        tri->c[i] = (double)(dx * (8 - y[p]) - dy * (8 - x[p]));
+        /* top-left fill rule: pixel centers exactly on a top or left edge are inside */
+        tri->thr[i] = (((0 == dy) && (dx > 0)) || (dy < 0)) ? 0.0 : 1.0;
+        tri->z[i] = (float)((double)v[vi]->pos[2] * inv_w[vi] * 0.5 + 0.5);
+        tri->inv_w[i] = (float)inv_w[vi];
+        for (int j = 0; j < num_varyings; j++) {
+            tri->varyings[i][j] = (float)((double)v[vi]->varyings[j] * inv_w[vi]);
+        }
+    }
+}
+
+/* signed distance to the clip planes: near, far and the guard band */
+_SOKOL_PRIVATE float _sg_soft_clip_dist(int plane, const float* pos) {
+    const float gw = _SG_SOFT_GUARD_BAND * pos[3];
+    switch (plane) {
+        case 0:     return pos[2] + pos[3];
+        case 1:     return pos[3] - pos[2];
+        case 2:     return pos[0] + gw;
+        case 3:     return gw - pos[0];
+        case 4:     return pos[1] + gw;
+        default:    return gw - pos[1];
+    }
+}
+
+_SOKOL_PRIVATE uint32_t _sg_soft_clip_code(const float* pos) {
+    uint32_t code = 0;
+    for (int plane = 0; plane < 6; plane++) {
+        if (_sg_soft_clip_dist(plane, pos) < 0.0f) {
+            code |= 1<<plane;
+        }
+    }
+    return code;
+}
+
+_SOKOL_PRIVATE void _sg_soft_clip_lerp(const sg_soft_vs_output* a, const sg_soft_vs_output* b, float t, int num_varyings, sg_soft_vs_output* out) {
+    for (int i = 0; i < 4; i++) {
+        out->pos[i] = a->pos[i] + t * (b->pos[i] - a->pos[i]);
+    }
+    for (int i = 0; i < num_varyings; i++) {
+        out->varyings[i] = a->varyings[i] + t * (b->varyings[i] - a->varyings[i]);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_soft_triangle(const sg_soft_vs_output* v0, const sg_soft_vs_output* v1, const sg_soft_vs_output* v2) {
+    const uint32_t c0 = _sg_soft_clip_code(v0->pos);
+    const uint32_t c1 = _sg_soft_clip_code(v1->pos);
+    const uint32_t c2 = _sg_soft_clip_code(v2->pos);
+    if (c0 & c1 & c2) {
+        return;
+    }
+    const uint32_t clip_mask = c0 | c1 | c2;
+    if (0 == clip_mask) {
+        _sg_soft_setup_triangle(v0, v1, v2);
+        return;
+    }
+    /* Sutherland-Hodgman clipping against the crossed planes, followed by
+       a triangle fan, intersections are always computed from the inside
+       vertex, so that triangles sharing an edge get identical vertices
+    */
+    const int num_varyings = _sg.soft.cur_pipeline->shader->soft.num_varyings;
+    sg_soft_vs_output poly[2][_SG_SOFT_MAX_CLIP_VERTICES];
+    int cur = 0;
+    int num = 3;
+    poly[0][0] = *v0;
+    poly[0][1] = *v1;
+    poly[0][2] = *v2;
+    for (int plane = 0; plane < 6; plane++) {
+        if (0 == (clip_mask & (1<<plane))) {
+            continue;
+        }
+        const sg_soft_vs_output* src = poly[cur];
+        sg_soft_vs_output* dst = poly[cur ^ 1];
+        int dst_num = 0;
+        for (int i = 0; i < num; i++) {
+            const sg_soft_vs_output* a = &src[i];
+            const sg_soft_vs_output* b = &src[(i + 1) % num];
+            const float da = _sg_soft_clip_dist(plane, a->pos);
+            const float db = _sg_soft_clip_dist(plane, b->pos);
+            if ((da >= 0.0f) && (dst_num < _SG_SOFT_MAX_CLIP_VERTICES)) {
+                dst[dst_num++] = *a;
+            }
+            if (((da >= 0.0f) != (db >= 0.0f)) && (dst_num < _SG_SOFT_MAX_CLIP_VERTICES)) {
+                if (da >= 0.0f) {
+                    _sg_soft_clip_lerp(a, b, da / (da - db), num_varyings, &dst[dst_num++]);
+                }
+                else {
+                    _sg_soft_clip_lerp(b, a, db / (db - da), num_varyings, &dst[dst_num++]);
+                }
+            }
+        }
+        cur ^= 1;
+        num = dst_num;
+        if (num < 3) {
+            return;
+        }
+    }
+    for (int i = 1; i < (num - 1); i++) {
+        _sg_soft_setup_triangle(&poly[cur][0], &poly[cur][i], &poly[cur][i + 1]);
+    }
+}
+
+/* a quad along the segment v0 -> v1, extended to both sides by the NDC offset (dx, dy) */
+_SOKOL_PRIVATE void _sg_soft_quad(const sg_soft_vs_output* v0, const sg_soft_vs_output* v1, float dx, float dy) {
+    sg_soft_vs_output c[4] = { *v0, *v0, *v1, *v1 };
+    const float s0 = v0->pos[3];
+    const float s1 = v1->pos[3];
+    c[0].pos[0] += dx * s0; c[0].pos[1] += dy * s0;
+    c[1].pos[0] -= dx * s0; c[1].pos[1] -= dy * s0;
+    c[2].pos[0] -= dx * s1; c[2].pos[1] -= dy * s1;
+    c[3].pos[0] += dx * s1; c[3].pos[1] += dy * s1;
+    /* the shared diagonal is covered only once thanks to the fill rule */
+    _sg_soft_triangle(&c[0], &c[1], &c[2]);
+    _sg_soft_triangle(&c[0], &c[2], &c[3]);
+}
+
+/* a point is a 1x1 pixel quad centered on the vertex */
+_SOKOL_PRIVATE void _sg_soft_point(const sg_soft_vs_output* v) {
+    /* near and far clipping for points is all-or-nothing */
+    if ((_sg_soft_clip_code(v->pos) & 3) || !(v->pos[3] > 0.0f)) {
+        return;
+    }
+    /* half a pixel in NDC */
+    const float hx = 1.0f / (float)_sg.soft.vp_w;
+    const float hy = 1.0f / (float)_sg.soft.vp_h;
+    sg_soft_vs_output v0 = *v;
+    sg_soft_vs_output v1 = *v;
+    v0.pos[1] -= hy * v->pos[3];
+    v1.pos[1] += hy * v->pos[3];
+    _sg_soft_quad(&v0, &v1, hx, 0.0f);
+}
+
+/* a line is a one pixel wide quad along the segment */
+_SOKOL_PRIVATE void _sg_soft_line(const sg_soft_vs_output* v0, const sg_soft_vs_output* v1) {
+    /* clip the segment against the near and far planes first, the quad
+       is built from the projected end points, the guard band clipping
+       happens later on the quad's triangles
+    */
+    const int num_varyings = _sg.soft.cur_pipeline->shader->soft.num_varyings;
+    sg_soft_vs_output p[2] = { *v0, *v1 };
+    for (int plane = 0; plane < 2; plane++) {
+        const float d0 = _sg_soft_clip_dist(plane, p[0].pos);
+        const float d1 = _sg_soft_clip_dist(plane, p[1].pos);
+        if ((d0 < 0.0f) && (d1 < 0.0f)) {
+            return;
+        }
+        sg_soft_vs_output tmp;
+        if (d0 < 0.0f) {
+            _sg_soft_clip_lerp(&p[1], &p[0], d1 / (d1 - d0), num_varyings, &tmp);
+            p[0] = tmp;
+        }
+        else if (d1 < 0.0f) {
+            _sg_soft_clip_lerp(&p[0], &p[1], d0 / (d0 - d1), num_varyings, &tmp);
+            p[1] = tmp;
+        }
+    }
+    if (!(p[0].pos[3] > 0.0f) || !(p[1].pos[3] > 0.0f)) {
+        return;
+    }
+    /* segment direction in pixels, and the offset of half a pixel to each side in NDC */
+    const float half_w = 0.5f * (float)_sg.soft.vp_w;
+    const float half_h = 0.5f * (float)_sg.soft.vp_h;
+    const float dx = (p[1].pos[0] / p[1].pos[3] - p[0].pos[0] / p[0].pos[3]) * half_w;
+    const float dy = (p[1].pos[1] / p[1].pos[3] - p[0].pos[1] / p[0].pos[3]) * half_h;
+    const float len = sqrtf(dx * dx + dy * dy);
+    if (!(len > 0.0f)) {
+        return;
+    }
+    _sg_soft_quad(&p[0], &p[1], (-dy / len) * 0.5f / half_w, (dx / len) * 0.5f / half_h);
+}
+
+/*-- backend functions -------------------------------------------------------*/
+_SOKOL_PRIVATE void _sg_soft_setup_backend(const sg_desc* desc) {
+    SOKOL_ASSERT(desc);
+    _sg.soft.valid = true;
+    _sg.backend = SG_BACKEND_SOFT;
+
+    _sg.features.instancing = true;
+    _sg.features.origin_top_left = true;
+    _sg.features.image_clamp_to_border = true;
+    _sg.features.base_vertex = true;
+    _sg.features.image_region_update = true;
+    _sg.features.read_pixels = true;
+
+    _sg.limits.max_image_size_2d = 16 * 1024;
+    _sg.limits.max_vertex_attrs = SG_MAX_VERTEX_ATTRIBUTES;
+
+    _sg_pixelformat_sfbr(&_sg.formats[SG_PIXELFORMAT_RGBA8]);
+    _sg_pixelformat_sf(&_sg.formats[SG_PIXELFORMAT_R8]);
+    _sg.formats[SG_PIXELFORMAT_DEPTH].render = true;
+    _sg.formats[SG_PIXELFORMAT_DEPTH].depth = true;
+    _sg.formats[SG_PIXELFORMAT_DEPTH_STENCIL].render = true;
+    _sg.formats[SG_PIXELFORMAT_DEPTH_STENCIL].depth = true;
+
+    _sg_soft_batch_t* batch = &_sg.soft.batch;
+    batch->draws = (_sg_soft_draw_t*) SOKOL_MALLOC(_SG_SOFT_MAX_BATCH_DRAWS * sizeof(_sg_soft_draw_t));
+    batch->tris = (_sg_soft_tri_t*) SOKOL_MALLOC(_SG_SOFT_MAX_BATCH_TRIANGLES * sizeof(_sg_soft_tri_t));
+    batch->ub_data = (uint8_t*) SOKOL_MALLOC(_SG_SOFT_BATCH_UB_SIZE);
+    SOKOL_ASSERT(batch->draws && batch->tris && batch->ub_data);
+    for (int i = 0; i < _SG_SOFT_VERTEX_CACHE_SIZE; i++) {
+        _sg.soft.vcache[i].index = -1;
+    }
+    _sg.soft.cur_draw_index = -1;
+    _sg_soft_setup_workers(desc->soft_num_threads);
+}
+
+_SOKOL_PRIVATE void _sg_soft_discard_backend(void) {
+    SOKOL_ASSERT(_sg.soft.valid);
+    _sg_soft_discard_workers();
+    _sg_soft_batch_t* batch = &_sg.soft.batch;
+    SOKOL_FREE(batch->bins);
+    SOKOL_FREE(batch->tile_offsets);
+    SOKOL_FREE(batch->ub_data);
+    SOKOL_FREE(batch->tris);
+    SOKOL_FREE(batch->draws);
+    SOKOL_FREE(_sg.soft.def_fb.depth);
+    SOKOL_FREE(_sg.soft.def_fb.color);
+    _sg.soft.valid = false;
+}
+
+_SOKOL_PRIVATE void _sg_soft_reset_state_cache(void) {
+    /* empty*/
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_soft_create_context(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    _SOKOL_UNUSED(ctx);
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_soft_destroy_context(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    _SOKOL_UNUSED(ctx);
+}
+
+_SOKOL_PRIVATE void _sg_soft_activate_context(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    _SOKOL_UNUSED(ctx);
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_soft_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(buf && desc);
+    _sg_buffer_common_init(&buf->cmn, desc);
+    buf->soft.ptr = (uint8_t*) SOKOL_MALLOC((size_t)buf->cmn.size);
+    SOKOL_ASSERT(buf->soft.ptr);
+    if (desc->content) {
+        memcpy(buf->soft.ptr, desc->content, (size_t)buf->cmn.size);
+    }
+    else {
+        memset(buf->soft.ptr, 0, (size_t)buf->cmn.size);
+    }
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_soft_destroy_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    /* vertices are processed in the draw call, so queued triangles don't reference buffers */
+    SOKOL_FREE(buf->soft.ptr);
+}
+
+/* copy tightly packed rows into an image, sampled images are stored as
+   RGBA8, R8 content is expanded to (r,0,0,1) like on the 3D backends
+*/
+_SOKOL_PRIVATE void _sg_soft_copy_rows(_sg_image_t* img, int x, int y, int width, int height, const void* data, int data_size) {
+    const int src_bpp = (SG_PIXELFORMAT_R8 == img->cmn.pixel_format) ? 1 : 4;
+    const int src_pitch = width * src_bpp;
+    height = _sg_min(height, data_size / src_pitch);
+    const uint8_t* src = (const uint8_t*) data;
+    uint8_t* dst = (uint8_t*)img->soft.pixels + (y * img->cmn.width + x) * 4;
+    for (int row = 0; row < height; row++, src += src_pitch, dst += img->cmn.width * 4) {
+        if (4 == src_bpp) {
+            memcpy(dst, src, (size_t)src_pitch);
+        }
+        else {
+            for (int i = 0; i < width; i++) {
+                dst[i*4 + 0] = src[i];
+                dst[i*4 + 1] = 0;
+                dst[i*4 + 2] = 0;
+                dst[i*4 + 3] = 0xFF;
+            }
+        }
+    }
+}
+
+_SOKOL_PRIVATE sg_resource_state _sg_soft_create_image(_sg_image_t* img, const sg_image_desc* desc) {
+    SOKOL_ASSERT(img && desc);
+    _sg_image_common_init(&img->cmn, desc);
+    if (SG_IMAGETYPE_2D != img->cmn.type) {
+        SOKOL_LOG("soft backend: only 2D images are supported\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    if (img->cmn.sample_count > 1) {
+        SOKOL_LOG("soft backend: MSAA images are not supported\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    const size_t num_pixels = (size_t)img->cmn.width * (size_t)img->cmn.height;
+    if (_sg_is_valid_rendertarget_depth_format(img->cmn.pixel_format)) {
+        float* depth = (float*) SOKOL_MALLOC(num_pixels * sizeof(float));
+        SOKOL_ASSERT(depth);
+        for (size_t i = 0; i < num_pixels; i++) {
+            depth[i] = 1.0f;
+        }
+        img->soft.pixels = depth;
+    }
+    else if ((SG_PIXELFORMAT_RGBA8 == img->cmn.pixel_format) || (SG_PIXELFORMAT_R8 == img->cmn.pixel_format)) {
+        uint8_t* pixels = (uint8_t*) SOKOL_MALLOC(num_pixels * 4);
+        SOKOL_ASSERT(pixels);
+        memset(pixels, 0, num_pixels * 4);
+        img->soft.pixels = pixels;
+        const sg_subimage_content* sub = &desc->content.subimage[0][0];
+        if (sub->ptr && (sub->size > 0)) {
+            _sg_soft_copy_rows(img, 0, 0, img->cmn.width, img->cmn.height, sub->ptr, sub->size);
+        }
+        sg_soft_texture* tex = &img->soft.tex;
+        tex->width = img->cmn.width;
+        tex->height = img->cmn.height;
+        tex->pixels = pixels;
+        /* no mipmaps, so the magnification filter is used for minification too */
+        tex->filter = (SG_FILTER_LINEAR == img->cmn.mag_filter) ? SG_FILTER_LINEAR : SG_FILTER_NEAREST;
+        tex->wrap_u = img->cmn.wrap_u;
+        tex->wrap_v = img->cmn.wrap_v;
+        const float border_val = (SG_BORDERCOLOR_OPAQUE_WHITE == img->cmn.border_color) ? 1.0f : 0.0f;
+        tex->border_color[0] = border_val;
+        tex->border_color[1] = border_val;
+        tex->border_color[2] = border_val;
+        tex->border_color[3] = (SG_BORDERCOLOR_TRANSPARENT_BLACK == img->cmn.border_color) ? 0.0f : 1.0f;
+    }
+    else {
+        SOKOL_LOG("soft backend: only RGBA8, R8 and depth pixel formats are supported\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_soft_destroy_image(_sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    /* queued draws may sample the image */
+    _sg_soft_flush();
+    SOKOL_FREE(img->soft.pixels);
+}
 
-    /* clip against framebuffer rect */
-    x = _sg_min(_sg_max(0, x), _sg.wgpu.cur_width-1);
-    y = _sg_min(_sg_max(0, y), _sg.wgpu.cur_height-1);
-    if ((x + w) > _sg.wgpu.cur_width) {
-        w = _sg.wgpu.cur_width - x;
-    }
-    if ((y + h) > _sg.wgpu.cur_height) {
-        h = _sg.wgpu.cur_height - y;
+_SOKOL_PRIVATE sg_resource_state _sg_soft_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
+    SOKOL_ASSERT(shd && desc);
+    _sg_shader_common_init(&shd->cmn, desc);
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        const _sg_shader_stage_t* stage = &shd->cmn.stage[stage_index];
+        for (int ub_index = 0; ub_index < stage->num_uniform_blocks; ub_index++) {
+            if (stage->uniform_blocks[ub_index].size > _SG_SOFT_MAX_UB_SIZE) {
+                SOKOL_LOG("soft backend: uniform block too big\n");
+                return SG_RESOURCESTATE_FAILED;
+            }
+        }
     }
-    w = _sg_max(w, 1);
-    h = _sg_max(h, 1);
+    SOKOL_ASSERT(desc->soft_vs && desc->soft_fs);
+    SOKOL_ASSERT((desc->soft_num_varyings >= 0) && (desc->soft_num_varyings <= SG_SOFT_MAX_VARYINGS));
+    shd->soft.vs = desc->soft_vs;
+    shd->soft.fs = desc->soft_fs;
+    shd->soft.num_varyings = desc->soft_num_varyings;
+    return SG_RESOURCESTATE_VALID;
+}
 
-    uint32_t sx = (uint32_t) x;
-    uint32_t sy = origin_top_left ? y : (_sg.wgpu.cur_height - (y + h));
-    uint32_t sw = w;
-    uint32_t sh = h;
-    wgpuRenderPassEncoderSetScissorRect(_sg.wgpu.pass_enc, sx, sy, sw, sh);
+_SOKOL_PRIVATE void _sg_soft_destroy_shader(_sg_shader_t* shd) {
+    SOKOL_ASSERT(shd);
+    _SOKOL_UNUSED(shd);
 }
 
-_SOKOL_PRIVATE void _sg_wgpu_apply_pipeline(_sg_pipeline_t* pip) {
+_SOKOL_PRIVATE sg_resource_state _sg_soft_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
+    SOKOL_ASSERT(pip && shd && desc);
+    pip->shader = shd;
+    _sg_pipeline_common_init(&pip->cmn, desc);
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        const sg_vertex_attr_desc* a_desc = &desc->layout.attrs[attr_index];
+        if (a_desc->format == SG_VERTEXFORMAT_INVALID) {
+            break;
+        }
+        SOKOL_ASSERT((a_desc->buffer_index >= 0) && (a_desc->buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
+        pip->cmn.vertex_layout_valid[a_desc->buffer_index] = true;
+        pip->soft.attrs[attr_index].format = a_desc->format;
+        pip->soft.attrs[attr_index].buffer_index = a_desc->buffer_index;
+        pip->soft.attrs[attr_index].offset = a_desc->offset;
+        pip->soft.num_attrs++;
+    }
+    for (int vb_index = 0; vb_index < SG_MAX_SHADERSTAGE_BUFFERS; vb_index++) {
+        const sg_buffer_layout_desc* l_desc = &desc->layout.buffers[vb_index];
+        pip->soft.vb_strides[vb_index] = l_desc->stride;
+        pip->soft.vb_step_funcs[vb_index] = l_desc->step_func;
+        pip->soft.vb_step_rates[vb_index] = _sg_max(l_desc->step_rate, 1);
+    }
+    pip->soft.primitive_type = desc->primitive_type;
+    pip->soft.quads = (SG_PRIMITIVETYPE_TRIANGLES != desc->primitive_type) && (SG_PRIMITIVETYPE_TRIANGLE_STRIP != desc->primitive_type);
+    pip->soft.cull_mode = desc->rasterizer.cull_mode;
+    pip->soft.face_winding = desc->rasterizer.face_winding;
+    pip->soft.depth_compare_func = desc->depth_stencil.depth_compare_func;
+    pip->soft.depth_write_enabled = desc->depth_stencil.depth_write_enabled;
+    pip->soft.blend = desc->blend;
+    return SG_RESOURCESTATE_VALID;
+}
+
+_SOKOL_PRIVATE void _sg_soft_destroy_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
-    SOKOL_ASSERT(pip->wgpu.pip);
-    SOKOL_ASSERT(_sg.wgpu.in_pass);
-    SOKOL_ASSERT(_sg.wgpu.pass_enc);
-    _sg.wgpu.draw_indexed = (pip->cmn.index_type != SG_INDEXTYPE_NONE);
-    _sg.wgpu.cur_pipeline = pip;
-    _sg.wgpu.cur_pipeline_id.id = pip->slot.id;
-    wgpuRenderPassEncoderSetPipeline(_sg.wgpu.pass_enc, pip->wgpu.pip);
-    wgpuRenderPassEncoderSetBlendColor(_sg.wgpu.pass_enc, (WGPUColor*)pip->cmn.blend_color);
-    wgpuRenderPassEncoderSetStencilReference(_sg.wgpu.pass_enc, pip->wgpu.stencil_ref);
+    if (pip == _sg.soft.cur_pipeline) {
+        _sg.soft.cur_pipeline = 0;
+    }
 }
 
-_SOKOL_PRIVATE WGPUBindGroup _sg_wgpu_create_images_bindgroup(WGPUBindGroupLayout bgl, _sg_image_t** imgs, int num_imgs) {
-    SOKOL_ASSERT(_sg.wgpu.dev);
-    SOKOL_ASSERT(num_imgs <= _SG_WGPU_MAX_SHADERSTAGE_IMAGES);
-    WGPUBindGroupBinding img_bgb[_SG_WGPU_MAX_SHADERSTAGE_IMAGES * 2];
-    memset(&img_bgb, 0, sizeof(img_bgb));
-    for (int img_index = 0; img_index < num_imgs; img_index++) {
-        WGPUBindGroupBinding* tex_bdg = &img_bgb[img_index*2 + 0];
-        WGPUBindGroupBinding* smp_bdg = &img_bgb[img_index*2 + 1];
-        tex_bdg->binding = img_index;
-        tex_bdg->textureView = imgs[img_index]->wgpu.tex_view;
-        smp_bdg->binding = img_index + _SG_WGPU_MAX_SHADERSTAGE_IMAGES;
-        smp_bdg->sampler = imgs[img_index]->wgpu.sampler;
+_SOKOL_PRIVATE sg_resource_state _sg_soft_create_pass(_sg_pass_t* pass, _sg_image_t** att_images, const sg_pass_desc* desc) {
+    SOKOL_ASSERT(pass && desc);
+    SOKOL_ASSERT(att_images && att_images[0]);
+    _sg_pass_common_init(&pass->cmn, desc);
+    if (pass->cmn.num_color_atts > 1) {
+        SOKOL_LOG("soft backend: only one color attachment per pass is supported\n");
+        return SG_RESOURCESTATE_FAILED;
     }
-    WGPUBindGroupDescriptor bg_desc;
-    memset(&bg_desc, 0, sizeof(bg_desc));
-    bg_desc.layout = bgl;
-    bg_desc.bindingCount = 2 * num_imgs;
-    bg_desc.bindings = &img_bgb[0];
-    WGPUBindGroup bg = wgpuDeviceCreateBindGroup(_sg.wgpu.dev, &bg_desc);
-    SOKOL_ASSERT(bg);
-    return bg;
+    const sg_attachment_desc* att_desc = &desc->color_attachments[0];
+    SOKOL_ASSERT(att_images[0]->slot.id == att_desc->image.id);
+    SOKOL_ASSERT(_sg_is_valid_rendertarget_color_format(att_images[0]->cmn.pixel_format));
+    if ((att_desc->mip_level != 0) || (att_desc->slice != 0)) {
+        SOKOL_LOG("soft backend: pass attachments must be mip level 0 and slice 0\n");
+        return SG_RESOURCESTATE_FAILED;
+    }
+    pass->soft.color_atts[0].image = att_images[0];
+    att_desc = &desc->depth_stencil_attachment;
+    if (att_desc->image.id != SG_INVALID_ID) {
+        const int ds_img_index = SG_MAX_COLOR_ATTACHMENTS;
+        SOKOL_ASSERT(att_images[ds_img_index] && (att_images[ds_img_index]->slot.id == att_desc->image.id));
+        SOKOL_ASSERT(_sg_is_valid_rendertarget_depth_format(att_images[ds_img_index]->cmn.pixel_format));
+        pass->soft.ds_att.image = att_images[ds_img_index];
+    }
+    return SG_RESOURCESTATE_VALID;
 }
 
-_SOKOL_PRIVATE void _sg_wgpu_apply_bindings(
-    _sg_pipeline_t* pip,
-    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
-    _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
-{
-    SOKOL_ASSERT(_sg.wgpu.in_pass);
-    SOKOL_ASSERT(_sg.wgpu.pass_enc);
-    SOKOL_ASSERT(pip->shader && (pip->cmn.shader_id.id == pip->shader->slot.id));
+_SOKOL_PRIVATE void _sg_soft_destroy_pass(_sg_pass_t* pass) {
+    SOKOL_ASSERT(pass);
+    _SOKOL_UNUSED(pass);
+}
 
-    /* index buffer */
-    if (ib) {
-        wgpuRenderPassEncoderSetIndexBuffer(_sg.wgpu.pass_enc, ib->wgpu.buf, ib_offset);
-    }
+_SOKOL_PRIVATE _sg_image_t* _sg_soft_pass_color_image(const _sg_pass_t* pass, int index) {
+    SOKOL_ASSERT(pass && (index >= 0) && (index < SG_MAX_COLOR_ATTACHMENTS));
+    /* NOTE: may return null */
+    return pass->soft.color_atts[index].image;
+}
 
-    /* vertex buffers */
-    for (uint32_t slot = 0; slot < (uint32_t)num_vbs; slot++) {
-        wgpuRenderPassEncoderSetVertexBuffer(_sg.wgpu.pass_enc, slot, vbs[slot]->wgpu.buf, (uint64_t)vb_offsets[slot]);
-    }
+_SOKOL_PRIVATE _sg_image_t* _sg_soft_pass_ds_image(const _sg_pass_t* pass) {
+    /* NOTE: may return null */
+    SOKOL_ASSERT(pass);
+    return pass->soft.ds_att.image;
+}
 
-    /* need to create throw-away bind groups for images */
-    if (num_vs_imgs > 0) {
-        if (num_vs_imgs > _SG_WGPU_MAX_SHADERSTAGE_IMAGES) {
-            num_vs_imgs = _SG_WGPU_MAX_SHADERSTAGE_IMAGES;
-        }
-        WGPUBindGroupLayout vs_bgl = pip->shader->wgpu.stage[SG_SHADERSTAGE_VS].bind_group_layout;
-        SOKOL_ASSERT(vs_bgl);
-        WGPUBindGroup vs_img_bg = _sg_wgpu_create_images_bindgroup(vs_bgl, vs_imgs, num_vs_imgs);
-        wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 1, vs_img_bg, 0, 0);
-        wgpuBindGroupRelease(vs_img_bg);
+_SOKOL_PRIVATE void _sg_soft_begin_pass(_sg_pass_t* pass, const sg_pass_action* action, int w, int h) {
+    SOKOL_ASSERT(action);
+    SOKOL_ASSERT(0 == _sg.soft.batch.num_tris);
+    if (pass) {
+        const _sg_image_t* color_img = pass->soft.color_atts[0].image;
+        const _sg_image_t* ds_img = pass->soft.ds_att.image;
+        SOKOL_ASSERT(color_img);
+        _sg.soft.target.width = color_img->cmn.width;
+        _sg.soft.target.height = color_img->cmn.height;
+        _sg.soft.target.color = (uint8_t*) color_img->soft.pixels;
+        _sg.soft.target.depth = ds_img ? (float*) ds_img->soft.pixels : 0;
     }
     else {
-        wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 1, _sg.wgpu.empty_bind_group, 0, 0);
+        /* (re-)allocate the default framebuffer */
+        w = _sg_max(w, 1);
+        h = _sg_max(h, 1);
+        if ((w != _sg.soft.def_fb.width) || (h != _sg.soft.def_fb.height)) {
+            SOKOL_FREE(_sg.soft.def_fb.color);
+            SOKOL_FREE(_sg.soft.def_fb.depth);
+            const size_t num_pixels = (size_t)w * (size_t)h;
+            _sg.soft.def_fb.width = w;
+            _sg.soft.def_fb.height = h;
+            _sg.soft.def_fb.color = (uint8_t*) SOKOL_MALLOC(num_pixels * 4);
+            _sg.soft.def_fb.depth = (float*) SOKOL_MALLOC(num_pixels * sizeof(float));
+            SOKOL_ASSERT(_sg.soft.def_fb.color && _sg.soft.def_fb.depth);
+            memset(_sg.soft.def_fb.color, 0, num_pixels * 4);
+            for (size_t i = 0; i < num_pixels; i++) {
+                _sg.soft.def_fb.depth[i] = 1.0f;
+            }
+        }
+        _sg.soft.target.width = w;
+        _sg.soft.target.height = h;
+        _sg.soft.target.color = _sg.soft.def_fb.color;
+        _sg.soft.target.depth = _sg.soft.def_fb.depth;
+    }
+    const int num_pixels = _sg.soft.target.width * _sg.soft.target.height;
+    if (SG_ACTION_CLEAR == action->colors[0].action) {
+        uint8_t clear_val[4];
+        for (int i = 0; i < 4; i++) {
+            clear_val[i] = _sg_soft_unorm8(action->colors[0].val[i]);
+        }
+        uint8_t* dst = _sg.soft.target.color;
+        for (int i = 0; i < num_pixels; i++, dst += 4) {
+            memcpy(dst, clear_val, 4);
+        }
     }
-    if (num_fs_imgs > 0) {
-        if (num_fs_imgs > _SG_WGPU_MAX_SHADERSTAGE_IMAGES) {
-            num_fs_imgs = _SG_WGPU_MAX_SHADERSTAGE_IMAGES;
+    if (_sg.soft.target.depth && (SG_ACTION_CLEAR == action->depth.action)) {
+        for (int i = 0; i < num_pixels; i++) {
+            _sg.soft.target.depth[i] = action->depth.val;
         }
-        WGPUBindGroupLayout fs_bgl = pip->shader->wgpu.stage[SG_SHADERSTAGE_FS].bind_group_layout;
-        SOKOL_ASSERT(fs_bgl);
-        WGPUBindGroup fs_img_bg = _sg_wgpu_create_images_bindgroup(fs_bgl, fs_imgs, num_fs_imgs);
-        wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 2, fs_img_bg, 0, 0);
-        wgpuBindGroupRelease(fs_img_bg);
     }
-    else {
-        wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc, 2, _sg.wgpu.empty_bind_group, 0, 0);
+    _sg.soft.vp_x = 0;
+    _sg.soft.vp_y = 0;
+    _sg.soft.vp_w = _sg.soft.target.width;
+    _sg.soft.vp_h = _sg.soft.target.height;
+    _sg.soft.sc_x0 = 0;
+    _sg.soft.sc_y0 = 0;
+    _sg.soft.sc_x1 = _sg.soft.target.width;
+    _sg.soft.sc_y1 = _sg.soft.target.height;
+    _sg.soft.cur_pipeline = 0;
+    _sg.soft.cur_draw_index = -1;
+}
+
+_SOKOL_PRIVATE void _sg_soft_end_pass(void) {
+    _sg_soft_flush();
+    memset(&_sg.soft.target, 0, sizeof(_sg.soft.target));
+    _sg.soft.cur_pipeline = 0;
+}
+
+_SOKOL_PRIVATE void _sg_soft_commit(void) {
+    /* empty, all rendering is finished in sg_end_pass() */
+}
+
+_SOKOL_PRIVATE void _sg_soft_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
+    _sg.soft.vp_x = x;
+    _sg.soft.vp_y = origin_top_left ? y : (_sg.soft.target.height - (y + h));
+    _sg.soft.vp_w = w;
+    _sg.soft.vp_h = h;
+}
+
+_SOKOL_PRIVATE void _sg_soft_apply_scissor_rect(int x, int y, int w, int h, bool origin_top_left) {
+    const int y0 = origin_top_left ? y : (_sg.soft.target.height - (y + h));
+    _sg.soft.sc_x0 = _sg_max(x, 0);
+    _sg.soft.sc_y0 = _sg_max(y0, 0);
+    _sg.soft.sc_x1 = _sg_min(x + w, _sg.soft.target.width);
+    _sg.soft.sc_y1 = _sg_min(y0 + h, _sg.soft.target.height);
+}
+
+_SOKOL_PRIVATE void _sg_soft_apply_pipeline(_sg_pipeline_t* pip) {
+    SOKOL_ASSERT(pip && pip->shader);
+    _sg.soft.cur_pipeline = pip;
+    _sg.soft.cur_draw_index = -1;
+}
+
+_SOKOL_PRIVATE void _sg_soft_apply_bindings(
+    _sg_pipeline_t* pip,
+    const _sg_buffer_hot_t** vbs, const int* vb_offsets, int num_vbs,
+    const _sg_buffer_hot_t* ib, int ib_offset,
+    const _sg_image_hot_t** vs_imgs, int num_vs_imgs,
+    const _sg_image_hot_t** fs_imgs, int num_fs_imgs)
+{
+    SOKOL_ASSERT(pip);
+    SOKOL_ASSERT(vbs && vb_offsets);
+    SOKOL_ASSERT(vs_imgs);
+    SOKOL_ASSERT(fs_imgs);
+    _SOKOL_UNUSED(pip);
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        const bool bound = (i < num_vbs) && vbs[i];
+        _sg.soft.cur_vbs[i] = bound ? (vbs[i]->soft.ptr + vb_offsets[i]) : 0;
+        _sg.soft.cur_vb_sizes[i] = bound ? (vbs[i]->buf->cmn.size - vb_offsets[i]) : 0;
+    }
+    _sg.soft.cur_ib = ib ? (ib->soft.ptr + ib_offset) : 0;
+    _sg.soft.cur_ib_size = ib ? (ib->buf->cmn.size - ib_offset) : 0;
+    /* the shader functions sample the images directly */
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        _sg.soft.cur_vs_images[i] = ((i < num_vs_imgs) && vs_imgs[i]) ? &vs_imgs[i]->img->soft.tex : 0;
+        _sg.soft.cur_fs_images[i] = ((i < num_fs_imgs) && fs_imgs[i]) ? &fs_imgs[i]->img->soft.tex : 0;
     }
+    _sg.soft.cur_draw_index = -1;
 }
 
-_SOKOL_PRIVATE void _sg_wgpu_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
-    SOKOL_ASSERT(_sg.wgpu.in_pass);
-    SOKOL_ASSERT(_sg.wgpu.pass_enc);
+_SOKOL_PRIVATE void _sg_soft_apply_uniforms(sg_shader_stage stage_index, int ub_index, const void* data, int num_bytes) {
     SOKOL_ASSERT(data && (num_bytes > 0));
     SOKOL_ASSERT((stage_index >= 0) && ((int)stage_index < SG_NUM_SHADER_STAGES));
     SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
-    SOKOL_ASSERT((_sg.wgpu.ub.offset + num_bytes) <= _sg.wgpu.ub.num_bytes);
-    SOKOL_ASSERT((_sg.wgpu.ub.offset & (_SG_WGPU_STAGING_ALIGN-1)) == 0);
-    SOKOL_ASSERT(_sg.wgpu.cur_pipeline && _sg.wgpu.cur_pipeline->shader);
-    SOKOL_ASSERT(_sg.wgpu.cur_pipeline->slot.id == _sg.wgpu.cur_pipeline_id.id);
-    SOKOL_ASSERT(_sg.wgpu.cur_pipeline->shader->slot.id == _sg.wgpu.cur_pipeline->cmn.shader_id.id);
-    SOKOL_ASSERT(ub_index < _sg.wgpu.cur_pipeline->shader->cmn.stage[stage_index].num_uniform_blocks);
-    SOKOL_ASSERT(num_bytes <= _sg.wgpu.cur_pipeline->shader->cmn.stage[stage_index].uniform_blocks[ub_index].size);
-    SOKOL_ASSERT(num_bytes <= _SG_WGPU_MAX_UNIFORM_UPDATE_SIZE);
-    SOKOL_ASSERT(0 != _sg.wgpu.ub.stage.ptr[_sg.wgpu.ub.stage.cur]);
-
-    uint8_t* dst_ptr = _sg.wgpu.ub.stage.ptr[_sg.wgpu.ub.stage.cur] + _sg.wgpu.ub.offset;
-    memcpy(dst_ptr, data, num_bytes);
-    _sg.wgpu.ub.bind_offsets[stage_index][ub_index] = _sg.wgpu.ub.offset;
-    wgpuRenderPassEncoderSetBindGroup(_sg.wgpu.pass_enc,
-                                      0, /* groupIndex 0 is reserved for uniform buffers */
-                                      _sg.wgpu.ub.bindgroup,
-                                      SG_NUM_SHADER_STAGES * SG_MAX_SHADERSTAGE_UBS,
-                                      &_sg.wgpu.ub.bind_offsets[0][0]);
-    _sg.wgpu.ub.offset = _sg_roundup(_sg.wgpu.ub.offset + num_bytes, _SG_WGPU_STAGING_ALIGN);
+    SOKOL_ASSERT(num_bytes <= _SG_SOFT_MAX_UB_SIZE);
+    memcpy(_sg.soft.ub[stage_index][ub_index], data, (size_t)num_bytes);
+    if (SG_SHADERSTAGE_FS == stage_index) {
+        _sg.soft.cur_draw_index = -1;
+    }
 }
 
-_SOKOL_PRIVATE void _sg_wgpu_draw(int base_element, int num_elements, int num_instances) {
-    SOKOL_ASSERT(_sg.wgpu.in_pass);
-    SOKOL_ASSERT(_sg.wgpu.pass_enc);
-    if (_sg.wgpu.draw_indexed) {
-        wgpuRenderPassEncoderDrawIndexed(_sg.wgpu.pass_enc, num_elements, num_instances, base_element, 0, 0);
+/* vertices are processed and triangles are set up immediately, rasterization
+   and fragment shading happen when the batch is flushed
+*/
+_SOKOL_PRIVATE void _sg_soft_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
+    const _sg_pipeline_t* pip = _sg.soft.cur_pipeline;
+    if ((0 == pip) || (0 == _sg.soft.target.color)) {
+        return;
     }
-    else {
-        wgpuRenderPassEncoderDraw(_sg.wgpu.pass_enc, num_elements, num_instances, base_element, 0);
+    const sg_index_type index_type = pip->cmn.index_type;
+    const int index_size = (SG_INDEXTYPE_UINT16 == index_type) ? 2 : 4;
+    if (SG_INDEXTYPE_NONE != index_type) {
+        /* ignore indices past the end of the index buffer */
+        const int max_elements = _sg.soft.cur_ib ? ((_sg.soft.cur_ib_size / index_size) - base_element) : 0;
+        num_elements = _sg_min(num_elements, max_elements);
+    }
+    int num_verts;  /* per primitive */
+    int num_prims;
+    switch (pip->soft.primitive_type) {
+        case SG_PRIMITIVETYPE_POINTS:           num_verts = 1; num_prims = num_elements; break;
+        case SG_PRIMITIVETYPE_LINES:            num_verts = 2; num_prims = num_elements / 2; break;
+        case SG_PRIMITIVETYPE_LINE_STRIP:       num_verts = 2; num_prims = num_elements - 1; break;
+        case SG_PRIMITIVETYPE_TRIANGLE_STRIP:   num_verts = 3; num_prims = num_elements - 2; break;
+        default:                                num_verts = 3; num_prims = num_elements / 3; break;
+    }
+    const bool strip = (SG_PRIMITIVETYPE_LINE_STRIP == pip->soft.primitive_type) ||
+                       (SG_PRIMITIVETYPE_TRIANGLE_STRIP == pip->soft.primitive_type);
+    for (int instance_index = 0; instance_index < num_instances; instance_index++) {
+        for (int i = 0; i < _SG_SOFT_VERTEX_CACHE_SIZE; i++) {
+            _sg.soft.vcache[i].index = -1;
+        }
+        for (int prim_index = 0; prim_index < num_prims; prim_index++) {
+            int elements[3];
+            if (strip) {
+                /* every other strip triangle is flipped to keep the winding */
+                const int odd = (3 == num_verts) ? (prim_index & 1) : 0;
+                elements[0] = prim_index + odd;
+                elements[1] = prim_index + 1 - odd;
+                elements[2] = prim_index + 2;
+            }
+            else {
+                elements[0] = prim_index * num_verts;
+                elements[1] = prim_index * num_verts + 1;
+                elements[2] = prim_index * num_verts + 2;
+            }
+            /* copies, since a cache slot may be reused for the next vertex */
+            sg_soft_vs_output v[3];
+            for (int i = 0; i < num_verts; i++) {
+                const int element = base_element + elements[i];
+                int vertex_index;
+                if (SG_INDEXTYPE_UINT16 == index_type) {
+                    uint16_t index;
+                    memcpy(&index, _sg.soft.cur_ib + element * 2, sizeof(index));
+                    vertex_index = (int)index + base_vertex;
+                }
+                else if (SG_INDEXTYPE_UINT32 == index_type) {
+                    uint32_t index;
+                    memcpy(&index, _sg.soft.cur_ib + element * 4, sizeof(index));
+                    vertex_index = (int)index + base_vertex;
+                }
+                else {
+                    vertex_index = element + base_vertex;
+                }
+                v[i] = *_sg_soft_process_vertex(vertex_index, instance_index);
+            }
+            switch (num_verts) {
+                case 1:     _sg_soft_point(&v[0]); break;
+                case 2:     _sg_soft_line(&v[0], &v[1]); break;
+                default:    _sg_soft_triangle(&v[0], &v[1], &v[2]); break;
+            }
+        }
     }
 }
 
-_SOKOL_PRIVATE void _sg_wgpu_update_buffer(_sg_buffer_t* buf, const void* data, uint32_t num_bytes) {
-    SOKOL_ASSERT(buf && data && (num_bytes > 0));
-    uint32_t copied_num_bytes = _sg_wgpu_staging_copy_to_buffer(buf->wgpu.buf, 0, data, (uint32_t)num_bytes);
-    SOKOL_ASSERT(copied_num_bytes > 0); _SOKOL_UNUSED(copied_num_bytes);
+_SOKOL_PRIVATE void _sg_soft_update_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size) {
+    SOKOL_ASSERT(buf && data && (data_size > 0));
+    memcpy(buf->soft.ptr, data, data_size);
 }
 
-_SOKOL_PRIVATE uint32_t _sg_wgpu_append_buffer(_sg_buffer_t* buf, const void* data, uint32_t num_bytes, bool new_frame) {
-    SOKOL_ASSERT(buf && data && (num_bytes > 0));
+_SOKOL_PRIVATE uint32_t _sg_soft_append_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size, bool new_frame) {
+    SOKOL_ASSERT(buf && data && (data_size > 0));
     _SOKOL_UNUSED(new_frame);
-    uint32_t copied_num_bytes = _sg_wgpu_staging_copy_to_buffer(buf->wgpu.buf, buf->cmn.append_pos, data, num_bytes);
-    SOKOL_ASSERT(copied_num_bytes > 0); _SOKOL_UNUSED(copied_num_bytes);
-    return copied_num_bytes;
+    memcpy(buf->soft.ptr + buf->cmn.append_pos, data, data_size);
+    /* NOTE: this is a requirement from WebGPU, but we want identical behaviour across all backend */
+    return _sg_roundup(data_size, 4);
 }
 
-_SOKOL_PRIVATE void _sg_wgpu_update_image(_sg_image_t* img, const sg_image_content* data) {
+_SOKOL_PRIVATE void* _sg_soft_map_buffer(_sg_buffer_t* buf) {
+    SOKOL_ASSERT(buf);
+    return buf->soft.ptr;
+}
+
+_SOKOL_PRIVATE void _sg_soft_unmap_buffer(_sg_buffer_t* buf, const void* data, uint32_t data_size) {
+    SOKOL_ASSERT(buf);
+    /* the buffer memory was written directly, unless a shadow copy was used */
+    if (data) {
+        memcpy(buf->soft.ptr, data, data_size);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_soft_update_image(_sg_image_t* img, const sg_image_content* data) {
     SOKOL_ASSERT(img && data);
-    bool success = _sg_wgpu_staging_copy_to_texture(img, data);
-    SOKOL_ASSERT(success);
-    _SOKOL_UNUSED(success);
+    /* queued draws may sample the old content */
+    _sg_soft_flush();
+    const sg_subimage_content* sub = &data->subimage[0][0];
+    if (sub->ptr && (sub->size > 0)) {
+        _sg_soft_copy_rows(img, 0, 0, img->cmn.width, img->cmn.height, sub->ptr, sub->size);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_soft_update_image_region(_sg_image_t* img, const sg_image_region* region, const void* data, int data_size) {
+    SOKOL_ASSERT(img && region && data && (data_size > 0));
+    /* only the top mipmap exists */
+    if (region->mip_level != 0) {
+        return;
+    }
+    _sg_soft_flush();
+    _sg_soft_copy_rows(img, region->x, region->y, region->width, region->height, data, data_size);
+}
+
+/* completes immediately */
+_SOKOL_PRIVATE bool _sg_soft_read_pixels(_sg_image_t* img, const sg_read_pixels_desc* desc) {
+    SOKOL_ASSERT(desc && desc->callback && (desc->width > 0) && (desc->height > 0));
+    const uint8_t* src_pixels = img ? (const uint8_t*) img->soft.pixels : _sg.soft.def_fb.color;
+    const int src_width = img ? img->cmn.width : _sg.soft.def_fb.width;
+    const int src_height = img ? img->cmn.height : _sg.soft.def_fb.height;
+    if ((0 == src_pixels) || ((desc->x + desc->width) > src_width) || ((desc->y + desc->height) > src_height)) {
+        return false;
+    }
+    const int row_size = desc->width * 4;
+    const int num_bytes = row_size * desc->height;
+    uint8_t* pixels = (uint8_t*) SOKOL_MALLOC((size_t)num_bytes);
+    SOKOL_ASSERT(pixels);
+    for (int y = 0; y < desc->height; y++) {
+        memcpy(pixels + y * row_size, src_pixels + ((desc->y + y) * src_width + desc->x) * 4, (size_t)row_size);
+    }
+    _sg_read_pixels_callback(desc, pixels, num_bytes);
+    SOKOL_FREE(pixels);
+    return true;
 }
 #endif
 
@@ -11436,6 +16627,8 @@ static inline void _sg_setup_backend(const sg_desc* desc) {
     _sg_d3d11_setup_backend(desc);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_setup_backend(desc);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_setup_backend(desc);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_setup_backend(desc);
     #else
@@ -11452,6 +16645,8 @@ static inline void _sg_discard_backend(void) {
     _sg_d3d11_discard_backend();
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_discard_backend();
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_discard_backend();
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_discard_backend();
     #else
@@ -11468,6 +16663,8 @@ static inline void _sg_reset_state_cache(void) {
     _sg_d3d11_reset_state_cache();
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_reset_state_cache();
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_reset_state_cache();
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_reset_state_cache();
     #else
@@ -11484,6 +16681,8 @@ static inline void _sg_activate_context(_sg_context_t* ctx) {
     _sg_d3d11_activate_context(ctx);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_activate_context(ctx);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_activate_context(ctx);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_activate_context(ctx);
     #else
@@ -11500,6 +16699,8 @@ static inline sg_resource_state _sg_create_context(_sg_context_t* ctx) {
     return _sg_d3d11_create_context(ctx);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_create_context(ctx);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_create_context(ctx);
     #elif defined(SOKOL_DUMMY_BACKEND)
     return _sg_dummy_create_context(ctx);
     #else
@@ -11516,6 +16717,8 @@ static inline void _sg_destroy_context(_sg_context_t* ctx) {
     _sg_d3d11_destroy_context(ctx);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_destroy_context(ctx);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_destroy_context(ctx);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_destroy_context(ctx);
     #else
@@ -11532,6 +16735,8 @@ static inline sg_resource_state _sg_create_buffer(_sg_buffer_t* buf, const sg_bu
     return _sg_d3d11_create_buffer(buf, desc);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_create_buffer(buf, desc);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_create_buffer(buf, desc);
     #elif defined(SOKOL_DUMMY_BACKEND)
     return _sg_dummy_create_buffer(buf, desc);
     #else
@@ -11548,6 +16753,8 @@ static inline void _sg_destroy_buffer(_sg_buffer_t* buf) {
     _sg_d3d11_destroy_buffer(buf);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_destroy_buffer(buf);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_destroy_buffer(buf);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_destroy_buffer(buf);
     #else
@@ -11564,6 +16771,8 @@ static inline sg_resource_state _sg_create_image(_sg_image_t* img, const sg_imag
     return _sg_d3d11_create_image(img, desc);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_create_image(img, desc);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_create_image(img, desc);
     #elif defined(SOKOL_DUMMY_BACKEND)
     return _sg_dummy_create_image(img, desc);
     #else
@@ -11580,6 +16789,8 @@ static inline void _sg_destroy_image(_sg_image_t* img) {
     _sg_d3d11_destroy_image(img);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_destroy_image(img);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_destroy_image(img);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_destroy_image(img);
     #else
@@ -11596,6 +16807,8 @@ static inline sg_resource_state _sg_create_shader(_sg_shader_t* shd, const sg_sh
     return _sg_d3d11_create_shader(shd, desc);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_create_shader(shd, desc);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_create_shader(shd, desc);
     #elif defined(SOKOL_DUMMY_BACKEND)
     return _sg_dummy_create_shader(shd, desc);
     #else
@@ -11612,6 +16825,8 @@ static inline void _sg_destroy_shader(_sg_shader_t* shd) {
     _sg_d3d11_destroy_shader(shd);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_destroy_shader(shd);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_destroy_shader(shd);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_destroy_shader(shd);
     #else
@@ -11628,6 +16843,8 @@ static inline sg_resource_state _sg_create_pipeline(_sg_pipeline_t* pip, _sg_sha
     return _sg_d3d11_create_pipeline(pip, shd, desc);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_create_pipeline(pip, shd, desc);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_create_pipeline(pip, shd, desc);
     #elif defined(SOKOL_DUMMY_BACKEND)
     return _sg_dummy_create_pipeline(pip, shd, desc);
     #else
@@ -11644,6 +16861,8 @@ static inline void _sg_destroy_pipeline(_sg_pipeline_t* pip) {
     _sg_d3d11_destroy_pipeline(pip);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_destroy_pipeline(pip);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_destroy_pipeline(pip);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_destroy_pipeline(pip);
     #else
@@ -11660,6 +16879,8 @@ static inline sg_resource_state _sg_create_pass(_sg_pass_t* pass, _sg_image_t**
     return _sg_d3d11_create_pass(pass, att_images, desc);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_create_pass(pass, att_images, desc);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_create_pass(pass, att_images, desc);
     #elif defined(SOKOL_DUMMY_BACKEND)
     return _sg_dummy_create_pass(pass, att_images, desc);
     #else
@@ -11676,6 +16897,8 @@ static inline void _sg_destroy_pass(_sg_pass_t* pass) {
     _sg_d3d11_destroy_pass(pass);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_destroy_pass(pass);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_destroy_pass(pass);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_destroy_pass(pass);
     #else
@@ -11692,6 +16915,8 @@ static inline _sg_image_t* _sg_pass_color_image(const _sg_pass_t* pass, int inde
     return _sg_d3d11_pass_color_image(pass, index);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_pass_color_image(pass, index);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_pass_color_image(pass, index);
     #elif defined(SOKOL_DUMMY_BACKEND)
     return _sg_dummy_pass_color_image(pass, index);
     #else
@@ -11708,6 +16933,8 @@ static inline _sg_image_t* _sg_pass_ds_image(const _sg_pass_t* pass) {
     return _sg_d3d11_pass_ds_image(pass);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_pass_ds_image(pass);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_pass_ds_image(pass);
     #elif defined(SOKOL_DUMMY_BACKEND)
     return _sg_dummy_pass_ds_image(pass);
     #else
@@ -11724,6 +16951,8 @@ static inline void _sg_begin_pass(_sg_pass_t* pass, const sg_pass_action* action
     _sg_d3d11_begin_pass(pass, action, w, h);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_begin_pass(pass, action, w, h);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_begin_pass(pass, action, w, h);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_begin_pass(pass, action, w, h);
     #else
@@ -11740,6 +16969,8 @@ static inline void _sg_end_pass(void) {
     _sg_d3d11_end_pass();
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_end_pass();
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_end_pass();
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_end_pass();
     #else
@@ -11747,6 +16978,27 @@ static inline void _sg_end_pass(void) {
     #endif
 }
 
+/* sg_features.gpu_timings is only true on desktop GL */
+static inline void _sg_begin_gpu_timing(const char* name, bool is_pass, sg_pass pass) {
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    if (_sg.desc.gpu_timings_enabled) {
+        _sg_gl_begin_gpu_timing(name, is_pass, pass);
+    }
+    #else
+    _SOKOL_UNUSED(name);
+    _SOKOL_UNUSED(is_pass);
+    _SOKOL_UNUSED(pass);
+    #endif
+}
+
+static inline void _sg_end_gpu_timing(void) {
+    #if defined(_SOKOL_GL_TIMER_QUERY)
+    if (_sg.desc.gpu_timings_enabled) {
+        _sg_gl_end_gpu_timing();
+    }
+    #endif
+}
+
 static inline void _sg_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_apply_viewport(x, y, w, h, origin_top_left);
@@ -11756,6 +17008,8 @@ static inline void _sg_apply_viewport(int x, int y, int w, int h, bool origin_to
     _sg_d3d11_apply_viewport(x, y, w, h, origin_top_left);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_apply_viewport(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_apply_viewport(x, y, w, h, origin_top_left);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_apply_viewport(x, y, w, h, origin_top_left);
     #else
@@ -11772,6 +17026,8 @@ static inline void _sg_apply_scissor_rect(int x, int y, int w, int h, bool origi
     _sg_d3d11_apply_scissor_rect(x, y, w, h, origin_top_left);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_apply_scissor_rect(x, y, w, h, origin_top_left);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_apply_scissor_rect(x, y, w, h, origin_top_left);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_apply_scissor_rect(x, y, w, h, origin_top_left);
     #else
@@ -11788,6 +17044,8 @@ static inline void _sg_apply_pipeline(_sg_pipeline_t* pip) {
     _sg_d3d11_apply_pipeline(pip);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_apply_pipeline(pip);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_apply_pipeline(pip);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_apply_pipeline(pip);
     #else
@@ -11797,10 +17055,10 @@ static inline void _sg_apply_pipeline(_sg_pipeline_t* pip) {
 
 static inline void _sg_apply_bindings(
     _sg_pipeline_t* pip,
-    _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs,
-    _sg_buffer_t* ib, int ib_offset,
-    _sg_image_t** vs_imgs, int num_vs_imgs,
-    _sg_image_t** fs_imgs, int num_fs_imgs)
+    const _sg_buffer_hot_t** vbs, const int* vb_offsets, int num_vbs,
+    const _sg_buffer_hot_t* ib, int ib_offset,
+    const _sg_image_hot_t** vs_imgs, int num_vs_imgs,
+    const _sg_image_hot_t** fs_imgs, int num_fs_imgs)
 {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
@@ -11810,6 +17068,8 @@ static inline void _sg_apply_bindings(
     _sg_d3d11_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
     #else
@@ -11826,6 +17086,8 @@ static inline void _sg_apply_uniforms(sg_shader_stage stage_index, int ub_index,
     _sg_d3d11_apply_uniforms(stage_index, ub_index, data, num_bytes);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_apply_uniforms(stage_index, ub_index, data, num_bytes);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_apply_uniforms(stage_index, ub_index, data, num_bytes);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_apply_uniforms(stage_index, ub_index, data, num_bytes);
     #else
@@ -11833,22 +17095,46 @@ static inline void _sg_apply_uniforms(sg_shader_stage stage_index, int ub_index,
     #endif
 }
 
-static inline void _sg_draw(int base_element, int num_elements, int num_instances) {
+static inline void _sg_draw(int base_element, int num_elements, int num_instances, int base_vertex) {
     #if defined(_SOKOL_ANY_GL)
-    _sg_gl_draw(base_element, num_elements, num_instances);
+    _sg_gl_draw(base_element, num_elements, num_instances, base_vertex);
     #elif defined(SOKOL_METAL)
-    _sg_mtl_draw(base_element, num_elements, num_instances);
+    _sg_mtl_draw(base_element, num_elements, num_instances, base_vertex);
     #elif defined(SOKOL_D3D11)
-    _sg_d3d11_draw(base_element, num_elements, num_instances);
+    _sg_d3d11_draw(base_element, num_elements, num_instances, base_vertex);
     #elif defined(SOKOL_WGPU)
-    _sg_wgpu_draw(base_element, num_elements, num_instances);
+    _sg_wgpu_draw(base_element, num_elements, num_instances, base_vertex);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_draw(base_element, num_elements, num_instances, base_vertex);
     #elif defined(SOKOL_DUMMY_BACKEND)
-    _sg_dummy_draw(base_element, num_elements, num_instances);
+    _sg_dummy_draw(base_element, num_elements, num_instances, base_vertex);
     #else
     #error("INVALID BACKEND");
     #endif
 }
 
+static inline void _sg_multi_draw(const sg_draw_args* draws, int num_draws) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_multi_draw(draws, num_draws);
+    #else
+    for (int i = 0; i < num_draws; i++) {
+        _sg_draw(draws[i].base_element, draws[i].num_elements, draws[i].num_instances, 0);
+    }
+    #endif
+}
+
+static inline void _sg_draw_indirect(_sg_buffer_t* buf, int offset, int num_draws) {
+    #if defined(_SOKOL_GL_DRAW_INDIRECT)
+    _sg_gl_draw_indirect(buf, offset, num_draws);
+    #else
+    /* sg_features.draw_indirect is only set by the GL backend */
+    _SOKOL_UNUSED(buf);
+    _SOKOL_UNUSED(offset);
+    _SOKOL_UNUSED(num_draws);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
 static inline void _sg_commit(void) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_commit();
@@ -11858,6 +17144,8 @@ static inline void _sg_commit(void) {
     _sg_d3d11_commit();
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_commit();
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_commit();
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_commit();
     #else
@@ -11874,6 +17162,8 @@ static inline void _sg_update_buffer(_sg_buffer_t* buf, const void* data_ptr, ui
     _sg_d3d11_update_buffer(buf, data_ptr, data_size);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_update_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_update_buffer(buf, data_ptr, data_size);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_update_buffer(buf, data_ptr, data_size);
     #else
@@ -11890,6 +17180,8 @@ static inline uint32_t _sg_append_buffer(_sg_buffer_t* buf, const void* data_ptr
     return _sg_d3d11_append_buffer(buf, data_ptr, data_size, new_frame);
     #elif defined(SOKOL_WGPU)
     return _sg_wgpu_append_buffer(buf, data_ptr, data_size, new_frame);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_append_buffer(buf, data_ptr, data_size, new_frame);
     #elif defined(SOKOL_DUMMY_BACKEND)
     return _sg_dummy_append_buffer(buf, data_ptr, data_size, new_frame);
     #else
@@ -11897,6 +17189,42 @@ static inline uint32_t _sg_append_buffer(_sg_buffer_t* buf, const void* data_ptr
     #endif
 }
 
+static inline void* _sg_map_buffer(_sg_buffer_t* buf) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_map_buffer(buf);
+    #elif defined(SOKOL_METAL)
+    return _sg_mtl_map_buffer(buf);
+    #elif defined(SOKOL_D3D11)
+    return _sg_d3d11_map_buffer(buf);
+    #elif defined(SOKOL_WGPU)
+    return _sg_wgpu_map_buffer(buf);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_map_buffer(buf);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_map_buffer(buf);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
+static inline void _sg_unmap_buffer(_sg_buffer_t* buf, const void* data_ptr, uint32_t data_size) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_unmap_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_unmap_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_D3D11)
+    _sg_d3d11_unmap_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_WGPU)
+    _sg_wgpu_unmap_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_unmap_buffer(buf, data_ptr, data_size);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_unmap_buffer(buf, data_ptr, data_size);
+    #else
+    #error("INVALID BACKEND");
+    #endif
+}
+
 static inline void _sg_update_image(_sg_image_t* img, const sg_image_content* data) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_update_image(img, data);
@@ -11906,6 +17234,8 @@ static inline void _sg_update_image(_sg_image_t* img, const sg_image_content* da
     _sg_d3d11_update_image(img, data);
     #elif defined(SOKOL_WGPU)
     _sg_wgpu_update_image(img, data);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_update_image(img, data);
     #elif defined(SOKOL_DUMMY_BACKEND)
     _sg_dummy_update_image(img, data);
     #else
@@ -11913,18 +17243,199 @@ static inline void _sg_update_image(_sg_image_t* img, const sg_image_content* da
     #endif
 }
 
+static inline void _sg_update_image_region(_sg_image_t* img, const sg_image_region* region, const void* data_ptr, int data_size) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_update_image_region(img, region, data_ptr, data_size);
+    #elif defined(SOKOL_METAL)
+    _sg_mtl_update_image_region(img, region, data_ptr, data_size);
+    #elif defined(SOKOL_SOFT)
+    _sg_soft_update_image_region(img, region, data_ptr, data_size);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_update_image_region(img, region, data_ptr, data_size);
+    #else
+    /* sg_features.image_region_update is false on D3D11 (dynamic textures
+       can only be updated with D3D11_MAP_WRITE_DISCARD) and WebGPU
+    */
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(region);
+    _SOKOL_UNUSED(data_ptr);
+    _SOKOL_UNUSED(data_size);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+static inline bool _sg_read_pixels(_sg_image_t* img, const sg_read_pixels_desc* desc) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_read_pixels(img, desc);
+    #elif defined(SOKOL_SOFT)
+    return _sg_soft_read_pixels(img, desc);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_read_pixels(img, desc);
+    #else
+    /* sg_features.read_pixels is false on D3D11, Metal and WebGPU */
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(desc);
+    SOKOL_UNREACHABLE;
+    return false;
+    #endif
+}
+
 /*== RESOURCE POOLS ==========================================================*/
 
-_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num) {
-    SOKOL_ASSERT(pool && (num >= 1));
-    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
-    pool->size = num + 1;
-    pool->queue_top = 0;
+/* move an array into a bigger allocation, the new tail is zero-initialized */
+_SOKOL_PRIVATE void* _sg_pool_realloc(void* old_ptr, size_t old_size, size_t new_size) {
+    SOKOL_ASSERT(new_size > old_size);
+    void* new_ptr = SOKOL_MALLOC(new_size);
+    SOKOL_ASSERT(new_ptr);
+    if (old_ptr) {
+        memcpy(new_ptr, old_ptr, old_size);
+        SOKOL_FREE(old_ptr);
+    }
+    memset((uint8_t*)new_ptr + old_size, 0, new_size - old_size);
+    return new_ptr;
+}
+
+/* add a chunk of zero-initialized items for the new pool slots [size, new_size),
+   existing items stay where they are, only the item pointer array,
+   hot array and generation counters are moved, items start at a
+   cache line boundary
+*/
+_SOKOL_PRIVATE void _sg_pool_add_chunk(_sg_pool_t* pool, int new_size) {
+    SOKOL_ASSERT(pool && (pool->item_size > 0));
+    SOKOL_ASSERT((new_size > pool->size) && (new_size <= _SG_MAX_POOL_SIZE));
+    SOKOL_ASSERT(pool->num_chunks < _SG_MAX_POOL_CHUNKS);
+    const int num_items = new_size - pool->size;
+    const size_t chunk_byte_size = (size_t)pool->item_size * (size_t)num_items + _SG_CACHE_LINE_SIZE;
+    void* chunk_ptr = SOKOL_MALLOC(chunk_byte_size);
+    SOKOL_ASSERT(chunk_ptr);
+    memset(chunk_ptr, 0, chunk_byte_size);
+    pool->chunks[pool->num_chunks++] = chunk_ptr;
+    uint8_t* chunk = (uint8_t*) _sg_roundup((uintptr_t)chunk_ptr, _SG_CACHE_LINE_SIZE);
+    pool->items = (void**) _sg_pool_realloc(pool->items, sizeof(void*) * pool->size, sizeof(void*) * new_size);
+    for (int i = 0; i < num_items; i++) {
+        pool->items[pool->size + i] = chunk + (size_t)i * (size_t)pool->item_size;
+    }
+    if (pool->hot_item_size > 0) {
+        pool->hot = _sg_pool_realloc(pool->hot, (size_t)pool->hot_item_size * (size_t)pool->size, (size_t)pool->hot_item_size * (size_t)new_size);
+    }
     /* generation counters indexable by pool slot index, slot 0 is reserved */
-    size_t gen_ctrs_size = sizeof(uint32_t) * pool->size;
-    pool->gen_ctrs = (uint32_t*) SOKOL_MALLOC(gen_ctrs_size);
+    pool->gen_ctrs = (uint32_t*) _sg_pool_realloc(pool->gen_ctrs, sizeof(uint32_t) * pool->size, sizeof(uint32_t) * new_size);
+    pool->size = new_size;
+}
+
+_SOKOL_PRIVATE void _sg_pool_discard_chunks(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool);
+    for (int i = 0; i < pool->num_chunks; i++) {
+        SOKOL_FREE(pool->chunks[i]);
+        pool->chunks[i] = 0;
+    }
+    pool->num_chunks = 0;
+    SOKOL_ASSERT(pool->items);
+    SOKOL_FREE(pool->items);
+    pool->items = 0;
+    if (pool->hot) {
+        SOKOL_FREE(pool->hot);
+        pool->hot = 0;
+    }
     SOKOL_ASSERT(pool->gen_ctrs);
-    memset(pool->gen_ctrs, 0, gen_ctrs_size);
+    SOKOL_FREE(pool->gen_ctrs);
+    pool->gen_ctrs = 0;
+    pool->size = 0;
+}
+
+#if defined(SOKOL_THREADSAFE_ALLOC)
+_SOKOL_PRIVATE uint64_t _sg_atomic_load_u64(volatile uint64_t* ptr) {
+    #if defined(_MSC_VER)
+    return (uint64_t) _InterlockedCompareExchange64((volatile __int64*)ptr, 0, 0);
+    #else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_atomic_cas_u64(volatile uint64_t* ptr, uint64_t expected, uint64_t desired) {
+    #if defined(_MSC_VER)
+    return expected == (uint64_t) _InterlockedCompareExchange64((volatile __int64*)ptr, (__int64)desired, (__int64)expected);
+    #else
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    #endif
+}
+
+_SOKOL_PRIVATE uint64_t _sg_pool_head(uint64_t old_head, int slot_index) {
+    return (((old_head >> 32) + 1) << 32) | (uint64_t)(uint32_t)slot_index;
+}
+
+/* NOTE: pools don't grow with SOKOL_THREADSAFE_ALLOC, because the item
+   pointer array can't be moved while other threads access the pool
+*/
+_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num, int item_size, int hot_item_size) {
+    SOKOL_ASSERT(pool && (num >= 1) && (item_size > 0) && (hot_item_size >= 0));
+    pool->item_size = _sg_roundup(item_size, _SG_CACHE_LINE_SIZE);
+    pool->hot_item_size = hot_item_size;
+    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
+    _sg_pool_add_chunk(pool, num + 1);
+    pool->free_next = (volatile int*) SOKOL_MALLOC(sizeof(int) * pool->size);
+    SOKOL_ASSERT(pool->free_next);
+    /* never allocate the zero-th pool item since the invalid id is 0,
+       slot 0 doubles as the end-of-list marker
+    */
+    pool->free_next[0] = _SG_INVALID_SLOT_INDEX;
+    for (int i = 1; i < pool->size; i++) {
+        pool->free_next[i] = (i + 1 < pool->size) ? (i + 1) : _SG_INVALID_SLOT_INDEX;
+    }
+    pool->free_head = 1;
+}
+
+_SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool);
+    SOKOL_ASSERT(pool->free_next);
+    SOKOL_FREE((void*)pool->free_next);
+    pool->free_next = 0;
+    pool->free_head = 0;
+    _sg_pool_discard_chunks(pool);
+}
+
+/* may be called from any thread */
+_SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool);
+    SOKOL_ASSERT(pool->free_next);
+    uint64_t old_head, new_head;
+    int slot_index;
+    do {
+        old_head = _sg_atomic_load_u64(&pool->free_head);
+        slot_index = (int)(uint32_t)old_head;
+        if (_SG_INVALID_SLOT_INDEX == slot_index) {
+            /* pool exhausted */
+            return _SG_INVALID_SLOT_INDEX;
+        }
+        /* free_next[slot_index] may be stale if another thread won the
+           race, but then the tag has changed and the CAS below fails
+        */
+        new_head = _sg_pool_head(old_head, pool->free_next[slot_index]);
+    } while (!_sg_atomic_cas_u64(&pool->free_head, old_head, new_head));
+    SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
+    return slot_index;
+}
+
+_SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
+    SOKOL_ASSERT(pool);
+    SOKOL_ASSERT(pool->free_next);
+    uint64_t old_head, new_head;
+    do {
+        old_head = _sg_atomic_load_u64(&pool->free_head);
+        SOKOL_ASSERT((int)(uint32_t)old_head != slot_index);
+        pool->free_next[slot_index] = (int)(uint32_t)old_head;
+        new_head = _sg_pool_head(old_head, slot_index);
+    } while (!_sg_atomic_cas_u64(&pool->free_head, old_head, new_head));
+}
+#else
+_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num, int item_size, int hot_item_size) {
+    SOKOL_ASSERT(pool && (num >= 1) && (item_size > 0) && (hot_item_size >= 0));
+    pool->item_size = _sg_roundup(item_size, _SG_CACHE_LINE_SIZE);
+    pool->hot_item_size = hot_item_size;
+    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
+    _sg_pool_add_chunk(pool, num + 1);
+    pool->queue_top = 0;
     /* it's not a bug to only reserve 'num' here */
     pool->free_queue = (int*) SOKOL_MALLOC(sizeof(int)*num);
     SOKOL_ASSERT(pool->free_queue);
@@ -11939,17 +17450,32 @@ _SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool->free_queue);
     SOKOL_FREE(pool->free_queue);
     pool->free_queue = 0;
-    SOKOL_ASSERT(pool->gen_ctrs);
-    SOKOL_FREE(pool->gen_ctrs);
-    pool->gen_ctrs = 0;
-    pool->size = 0;
     pool->queue_top = 0;
+    _sg_pool_discard_chunks(pool);
+}
+
+/* double the pool size (up to _SG_MAX_POOL_SIZE) by adding a new chunk,
+   existing slot indices and generation counters remain valid
+*/
+_SOKOL_PRIVATE bool _sg_grow_pool(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool && (pool->queue_top == 0));
+    if (pool->size >= _SG_MAX_POOL_SIZE) {
+        return false;
+    }
+    const int old_size = pool->size;
+    const int new_size = _sg_min(old_size * 2, _SG_MAX_POOL_SIZE);
+    _sg_pool_add_chunk(pool, new_size);
+    pool->free_queue = (int*) _sg_pool_realloc(pool->free_queue, sizeof(int) * (old_size-1), sizeof(int) * (new_size-1));
+    for (int i = new_size-1; i >= old_size; i--) {
+        pool->free_queue[pool->queue_top++] = i;
+    }
+    return true;
 }
 
 _SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool);
     SOKOL_ASSERT(pool->free_queue);
-    if (pool->queue_top > 0) {
+    if ((pool->queue_top > 0) || _sg_grow_pool(pool)) {
         int slot_index = pool->free_queue[--pool->queue_top];
         SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
         return slot_index;
@@ -11974,6 +17500,7 @@ _SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
     pool->free_queue[pool->queue_top++] = slot_index;
     SOKOL_ASSERT(pool->queue_top <= (pool->size-1));
 }
+#endif
 
 _SOKOL_PRIVATE void _sg_reset_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf);
@@ -12010,56 +17537,21 @@ _SOKOL_PRIVATE void _sg_setup_pools(_sg_pools_t* p, const sg_desc* desc) {
     SOKOL_ASSERT(desc);
     /* note: the pools here will have an additional item, since slot 0 is reserved */
     SOKOL_ASSERT((desc->buffer_pool_size > 0) && (desc->buffer_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size);
-    size_t buffer_pool_byte_size = sizeof(_sg_buffer_t) * p->buffer_pool.size;
-    p->buffers = (_sg_buffer_t*) SOKOL_MALLOC(buffer_pool_byte_size);
-    SOKOL_ASSERT(p->buffers);
-    memset(p->buffers, 0, buffer_pool_byte_size);
-
+    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size, (int)sizeof(_sg_buffer_t), (int)sizeof(_sg_buffer_hot_t));
     SOKOL_ASSERT((desc->image_pool_size > 0) && (desc->image_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->image_pool, desc->image_pool_size);
-    size_t image_pool_byte_size = sizeof(_sg_image_t) * p->image_pool.size;
-    p->images = (_sg_image_t*) SOKOL_MALLOC(image_pool_byte_size);
-    SOKOL_ASSERT(p->images);
-    memset(p->images, 0, image_pool_byte_size);
-
+    _sg_init_pool(&p->image_pool, desc->image_pool_size, (int)sizeof(_sg_image_t), (int)sizeof(_sg_image_hot_t));
     SOKOL_ASSERT((desc->shader_pool_size > 0) && (desc->shader_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->shader_pool, desc->shader_pool_size);
-    size_t shader_pool_byte_size = sizeof(_sg_shader_t) * p->shader_pool.size;
-    p->shaders = (_sg_shader_t*) SOKOL_MALLOC(shader_pool_byte_size);
-    SOKOL_ASSERT(p->shaders);
-    memset(p->shaders, 0, shader_pool_byte_size);
-
+    _sg_init_pool(&p->shader_pool, desc->shader_pool_size, (int)sizeof(_sg_shader_t), 0);
     SOKOL_ASSERT((desc->pipeline_pool_size > 0) && (desc->pipeline_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size);
-    size_t pipeline_pool_byte_size = sizeof(_sg_pipeline_t) * p->pipeline_pool.size;
-    p->pipelines = (_sg_pipeline_t*) SOKOL_MALLOC(pipeline_pool_byte_size);
-    SOKOL_ASSERT(p->pipelines);
-    memset(p->pipelines, 0, pipeline_pool_byte_size);
-
+    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size, (int)sizeof(_sg_pipeline_t), 0);
     SOKOL_ASSERT((desc->pass_pool_size > 0) && (desc->pass_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pass_pool, desc->pass_pool_size);
-    size_t pass_pool_byte_size = sizeof(_sg_pass_t) * p->pass_pool.size;
-    p->passes = (_sg_pass_t*) SOKOL_MALLOC(pass_pool_byte_size);
-    SOKOL_ASSERT(p->passes);
-    memset(p->passes, 0, pass_pool_byte_size);
-
+    _sg_init_pool(&p->pass_pool, desc->pass_pool_size, (int)sizeof(_sg_pass_t), 0);
     SOKOL_ASSERT((desc->context_pool_size > 0) && (desc->context_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->context_pool, desc->context_pool_size);
-    size_t context_pool_byte_size = sizeof(_sg_context_t) * p->context_pool.size;
-    p->contexts = (_sg_context_t*) SOKOL_MALLOC(context_pool_byte_size);
-    SOKOL_ASSERT(p->contexts);
-    memset(p->contexts, 0, context_pool_byte_size);
+    _sg_init_pool(&p->context_pool, desc->context_pool_size, (int)sizeof(_sg_context_t), 0);
 }
 
 _SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
     SOKOL_ASSERT(p);
-    SOKOL_FREE(p->contexts);    p->contexts = 0;
-    SOKOL_FREE(p->passes);      p->passes = 0;
-    SOKOL_FREE(p->pipelines);   p->pipelines = 0;
-    SOKOL_FREE(p->shaders);     p->shaders = 0;
-    SOKOL_FREE(p->images);      p->images = 0;
-    SOKOL_FREE(p->buffers);     p->buffers = 0;
     _sg_discard_pool(&p->context_pool);
     _sg_discard_pool(&p->pass_pool);
     _sg_discard_pool(&p->pipeline_pool);
@@ -12101,42 +17593,42 @@ _SOKOL_PRIVATE _sg_buffer_t* _sg_buffer_at(const _sg_pools_t* p, uint32_t buf_id
     SOKOL_ASSERT(p && (SG_INVALID_ID != buf_id));
     int slot_index = _sg_slot_index(buf_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
-    return &p->buffers[slot_index];
+    return (_sg_buffer_t*) p->buffer_pool.items[slot_index];
 }
 
 _SOKOL_PRIVATE _sg_image_t* _sg_image_at(const _sg_pools_t* p, uint32_t img_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != img_id));
     int slot_index = _sg_slot_index(img_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
-    return &p->images[slot_index];
+    return (_sg_image_t*) p->image_pool.items[slot_index];
 }
 
 _SOKOL_PRIVATE _sg_shader_t* _sg_shader_at(const _sg_pools_t* p, uint32_t shd_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != shd_id));
     int slot_index = _sg_slot_index(shd_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->shader_pool.size));
-    return &p->shaders[slot_index];
+    return (_sg_shader_t*) p->shader_pool.items[slot_index];
 }
 
 _SOKOL_PRIVATE _sg_pipeline_t* _sg_pipeline_at(const _sg_pools_t* p, uint32_t pip_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pip_id));
     int slot_index = _sg_slot_index(pip_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pipeline_pool.size));
-    return &p->pipelines[slot_index];
+    return (_sg_pipeline_t*) p->pipeline_pool.items[slot_index];
 }
 
 _SOKOL_PRIVATE _sg_pass_t* _sg_pass_at(const _sg_pools_t* p, uint32_t pass_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pass_id));
     int slot_index = _sg_slot_index(pass_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pass_pool.size));
-    return &p->passes[slot_index];
+    return (_sg_pass_t*) p->pass_pool.items[slot_index];
 }
 
 _SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t context_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != context_id));
     int slot_index = _sg_slot_index(context_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->context_pool.size));
-    return &p->contexts[slot_index];
+    return (_sg_context_t*) p->context_pool.items[slot_index];
 }
 
 /* returns pointer to resource with matching id check, may return 0 */
@@ -12160,6 +17652,87 @@ _SOKOL_PRIVATE _sg_image_t* _sg_lookup_image(const _sg_pools_t* p, uint32_t img_
     return 0;
 }
 
+/* returns pointer to the per-draw data of a resource with matching id check, may return 0 */
+_SOKOL_PRIVATE const _sg_buffer_hot_t* _sg_lookup_buffer_hot(const _sg_pools_t* p, uint32_t buf_id) {
+    if (SG_INVALID_ID != buf_id) {
+        int slot_index = _sg_slot_index(buf_id);
+        SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
+        const _sg_buffer_hot_t* hot = &((const _sg_buffer_hot_t*)p->buffer_pool.hot)[slot_index];
+        if (hot->id == buf_id) {
+            return hot;
+        }
+    }
+    return 0;
+}
+
+_SOKOL_PRIVATE const _sg_image_hot_t* _sg_lookup_image_hot(const _sg_pools_t* p, uint32_t img_id) {
+    if (SG_INVALID_ID != img_id) {
+        int slot_index = _sg_slot_index(img_id);
+        SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
+        const _sg_image_hot_t* hot = &((const _sg_image_hot_t*)p->image_pool.hot)[slot_index];
+        if (hot->id == img_id) {
+            return hot;
+        }
+    }
+    return 0;
+}
+
+/* copy the per-draw data of the buffer at slot_index into the hot array,
+   called after the slot state, the active slot, the append overflow
+   flag or the backend buffers have changed
+*/
+_SOKOL_PRIVATE void _sg_sync_buffer_hot(_sg_pools_t* p, int slot_index) {
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
+    _sg_buffer_t* buf = (_sg_buffer_t*) p->buffer_pool.items[slot_index];
+    _sg_buffer_hot_t* hot = &((_sg_buffer_hot_t*)p->buffer_pool.hot)[slot_index];
+    SOKOL_ASSERT((buf->cmn.active_slot >= 0) && (buf->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES));
+    hot->id = buf->slot.id;
+    hot->state = (uint8_t) buf->slot.state;
+    hot->active_slot = (uint8_t) buf->cmn.active_slot;
+    hot->append_overflow = buf->cmn.append_overflow;
+    hot->buf = buf;
+    #if defined(_SOKOL_ANY_GL)
+    hot->gl.buf = buf->gl.buf[buf->cmn.active_slot];
+    #if defined(_SOKOL_GL_BUFFER_STORAGE)
+    hot->gl.mapped = (0 != buf->gl.mapped[0]);
+    #else
+    hot->gl.mapped = false;
+    #endif
+    #elif defined(SOKOL_METAL)
+    hot->mtl.buf = buf->mtl.buf[buf->cmn.active_slot];
+    #elif defined(SOKOL_D3D11)
+    hot->d3d11.buf = buf->d3d11.buf;
+    #elif defined(SOKOL_WGPU)
+    hot->wgpu.buf = buf->wgpu.buf;
+    #elif defined(SOKOL_SOFT)
+    hot->soft.ptr = buf->soft.ptr;
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_sync_image_hot(_sg_pools_t* p, int slot_index) {
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
+    _sg_image_t* img = (_sg_image_t*) p->image_pool.items[slot_index];
+    _sg_image_hot_t* hot = &((_sg_image_hot_t*)p->image_pool.hot)[slot_index];
+    SOKOL_ASSERT((img->cmn.active_slot >= 0) && (img->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES));
+    hot->id = img->slot.id;
+    hot->state = (uint8_t) img->slot.state;
+    hot->active_slot = (uint8_t) img->cmn.active_slot;
+    hot->img = img;
+    #if defined(_SOKOL_ANY_GL)
+    hot->gl.target = img->gl.target;
+    hot->gl.tex = img->gl.tex[img->cmn.active_slot];
+    #elif defined(SOKOL_METAL)
+    hot->mtl.tex = img->mtl.tex[img->cmn.active_slot];
+    hot->mtl.sampler_state = img->mtl.sampler_state;
+    #elif defined(SOKOL_D3D11)
+    hot->d3d11.srv = img->d3d11.srv;
+    hot->d3d11.smp = img->d3d11.smp;
+    #elif defined(SOKOL_WGPU)
+    hot->wgpu.tex_view = img->wgpu.tex_view;
+    hot->wgpu.sampler = img->wgpu.sampler;
+    #endif
+}
+
 _SOKOL_PRIVATE _sg_shader_t* _sg_lookup_shader(const _sg_pools_t* p, uint32_t shd_id) {
     SOKOL_ASSERT(p);
     if (SG_INVALID_ID != shd_id) {
@@ -12213,42 +17786,48 @@ _SOKOL_PRIVATE void _sg_destroy_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
               and the resource slots not be cleared!
     */
     for (int i = 1; i < p->buffer_pool.size; i++) {
-        if (p->buffers[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->buffers[i].slot.state;
+        _sg_buffer_t* buf = (_sg_buffer_t*) p->buffer_pool.items[i];
+        if (buf->slot.ctx_id == ctx_id) {
+            sg_resource_state state = buf->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_buffer(&p->buffers[i]);
+                _sg_buffer_common_discard(&buf->cmn);
+                _sg_destroy_buffer(buf);
             }
         }
     }
     for (int i = 1; i < p->image_pool.size; i++) {
-        if (p->images[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->images[i].slot.state;
+        _sg_image_t* img = (_sg_image_t*) p->image_pool.items[i];
+        if (img->slot.ctx_id == ctx_id) {
+            sg_resource_state state = img->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_image(&p->images[i]);
+                _sg_destroy_image(img);
             }
         }
     }
     for (int i = 1; i < p->shader_pool.size; i++) {
-        if (p->shaders[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->shaders[i].slot.state;
+        _sg_shader_t* shd = (_sg_shader_t*) p->shader_pool.items[i];
+        if (shd->slot.ctx_id == ctx_id) {
+            sg_resource_state state = shd->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_shader(&p->shaders[i]);
+                _sg_destroy_shader(shd);
             }
         }
     }
     for (int i = 1; i < p->pipeline_pool.size; i++) {
-        if (p->pipelines[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->pipelines[i].slot.state;
+        _sg_pipeline_t* pip = (_sg_pipeline_t*) p->pipeline_pool.items[i];
+        if (pip->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pip->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_pipeline(&p->pipelines[i]);
+                _sg_destroy_pipeline(pip);
             }
         }
     }
     for (int i = 1; i < p->pass_pool.size; i++) {
-        if (p->passes[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->passes[i].slot.state;
+        _sg_pass_t* pass = (_sg_pass_t*) p->pass_pool.items[i];
+        if (pass->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pass->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_pass(&p->passes[i]);
+                _sg_destroy_pass(pass);
             }
         }
     }
@@ -12284,6 +17863,8 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_SHADERDESC_BYTECODE:              return "shader byte code required";
         case _SG_VALIDATE_SHADERDESC_SOURCE_OR_BYTECODE:    return "shader source or byte code required";
         case _SG_VALIDATE_SHADERDESC_NO_BYTECODE_SIZE:      return "shader byte code length (in bytes) required";
+        case _SG_VALIDATE_SHADERDESC_SOFT_FUNCS:            return "software backend requires shader functions (soft_vs, soft_fs)";
+        case _SG_VALIDATE_SHADERDESC_SOFT_NUM_VARYINGS:     return "sg_shader_desc.soft_num_varyings must be 0..SG_SOFT_MAX_VARYINGS";
         case _SG_VALIDATE_SHADERDESC_NO_CONT_UBS:           return "shader uniform blocks must occupy continuous slots";
         case _SG_VALIDATE_SHADERDESC_NO_CONT_UB_MEMBERS:    return "uniform block members must occupy continuous slots";
         case _SG_VALIDATE_SHADERDESC_NO_UB_MEMBERS:         return "GL backend requires uniform block member declarations";
@@ -12342,11 +17923,13 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_ABND_VB_EXISTS:           return "sg_apply_bindings: vertex buffer no longer alive";
         case _SG_VALIDATE_ABND_VB_TYPE:             return "sg_apply_bindings: buffer in vertex buffer slot is not a SG_BUFFERTYPE_VERTEXBUFFER";
         case _SG_VALIDATE_ABND_VB_OVERFLOW:         return "sg_apply_bindings: buffer in vertex buffer slot is overflown";
+        case _SG_VALIDATE_ABND_VB_MAPPED:           return "sg_apply_bindings: buffer in vertex buffer slot is still mapped";
         case _SG_VALIDATE_ABND_NO_IB:               return "sg_apply_bindings: pipeline object defines indexed rendering, but no index buffer provided";
         case _SG_VALIDATE_ABND_IB:                  return "sg_apply_bindings: pipeline object defines non-indexed rendering, but index buffer provided";
         case _SG_VALIDATE_ABND_IB_EXISTS:           return "sg_apply_bindings: index buffer no longer alive";
         case _SG_VALIDATE_ABND_IB_TYPE:             return "sg_apply_bindings: buffer in index buffer slot is not a SG_BUFFERTYPE_INDEXBUFFER";
         case _SG_VALIDATE_ABND_IB_OVERFLOW:         return "sg_apply_bindings: buffer in index buffer slot is overflown";
+        case _SG_VALIDATE_ABND_IB_MAPPED:           return "sg_apply_bindings: buffer in index buffer slot is still mapped";
         case _SG_VALIDATE_ABND_VS_IMGS:             return "sg_apply_bindings: vertex shader image count doesn't match sg_shader_desc";
         case _SG_VALIDATE_ABND_VS_IMG_EXISTS:       return "sg_apply_bindings: vertex shader image no longer alive";
         case _SG_VALIDATE_ABND_VS_IMG_TYPES:        return "sg_apply_bindings: one or more vertex shader image types don't match sg_shader_desc";
@@ -12370,6 +17953,23 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_APPENDBUF_SIZE:       return "sg_append_buffer: overall appended size is bigger than buffer size";
         case _SG_VALIDATE_APPENDBUF_UPDATE:     return "sg_append_buffer: cannot call sg_append_buffer and sg_update_buffer in same frame";
 
+        /* sg_draw_indirect */
+        case _SG_VALIDATE_DRAWINDIRECT_BUF:     return "sg_draw_indirect: buffer doesn't exist or isn't valid";
+        case _SG_VALIDATE_DRAWINDIRECT_TYPE:    return "sg_draw_indirect: buffer is not a SG_BUFFERTYPE_INDIRECTBUFFER";
+        case _SG_VALIDATE_DRAWINDIRECT_OFFSET:  return "sg_draw_indirect: offset must be a multiple of 4";
+        case _SG_VALIDATE_DRAWINDIRECT_SIZE:    return "sg_draw_indirect: draw arguments are out of buffer bounds";
+        case _SG_VALIDATE_DRAWINDIRECT_MAPPED:  return "sg_draw_indirect: buffer is still mapped";
+        case _SG_VALIDATE_DRAWINDIRECT_IBOFFSET: return "sg_draw_indirect: indexed indirect draws require sg_bindings.index_buffer_offset == 0";
+
+        /* sg_map_buffer */
+        case _SG_VALIDATE_MAPBUF_USAGE:         return "sg_map_buffer: cannot map immutable buffer";
+        case _SG_VALIDATE_MAPBUF_SIZE:          return "sg_map_buffer: map size is bigger than buffer size";
+        case _SG_VALIDATE_MAPBUF_ONCE:          return "sg_map_buffer: only one map or update allowed per buffer and frame";
+        case _SG_VALIDATE_MAPBUF_APPEND:        return "sg_map_buffer: cannot call sg_map_buffer and sg_append_buffer in same frame";
+
+        /* sg_unmap_buffer */
+        case _SG_VALIDATE_UNMAPBUF_NOTMAPPED:   return "sg_unmap_buffer: buffer is not mapped";
+
         /* sg_update_image */
         case _SG_VALIDATE_UPDIMG_USAGE:         return "sg_update_image: cannot update immutable image";
         case _SG_VALIDATE_UPDIMG_NOTENOUGHDATA: return "sg_update_image: not enough subimage data provided";
@@ -12377,6 +17977,26 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         case _SG_VALIDATE_UPDIMG_COMPRESSED:    return "sg_update_image: cannot update images with compressed format";
         case _SG_VALIDATE_UPDIMG_ONCE:          return "sg_update_image: only one update allowed per image and frame";
 
+        /* sg_update_image_region */
+        case _SG_VALIDATE_UPDIMGREG_FEATURE:    return "sg_update_image_region: not supported by backend (sg_features.image_region_update)";
+        case _SG_VALIDATE_UPDIMGREG_USAGE:      return "sg_update_image_region: image must be SG_USAGE_DYNAMIC";
+        case _SG_VALIDATE_UPDIMGREG_COMPRESSED: return "sg_update_image_region: cannot update images with compressed format";
+        case _SG_VALIDATE_UPDIMGREG_MIPLEVEL:   return "sg_update_image_region: mip_level out of range";
+        case _SG_VALIDATE_UPDIMGREG_SLICE:      return "sg_update_image_region: slice out of range";
+        case _SG_VALIDATE_UPDIMGREG_RECT:       return "sg_update_image_region: region rectangle outside of mipmap level";
+        case _SG_VALIDATE_UPDIMGREG_DATA:       return "sg_update_image_region: data size doesn't match region size";
+
+        /* sg_read_pixels_async */
+        case _SG_VALIDATE_READPIX_FEATURE:      return "sg_read_pixels_async: not supported by backend (sg_features.read_pixels)";
+        case _SG_VALIDATE_READPIX_PASS:         return "sg_read_pixels_async: cannot be called inside a render pass";
+        case _SG_VALIDATE_READPIX_CALLBACK:     return "sg_read_pixels_async: callback must be set";
+        case _SG_VALIDATE_READPIX_IMAGE:        return "sg_read_pixels_async: image is not valid";
+        case _SG_VALIDATE_READPIX_RENDERTARGET: return "sg_read_pixels_async: image must be a render target";
+        case _SG_VALIDATE_READPIX_IMAGETYPE:    return "sg_read_pixels_async: image must be SG_IMAGETYPE_2D";
+        case _SG_VALIDATE_READPIX_FORMAT:       return "sg_read_pixels_async: image pixel format must be SG_PIXELFORMAT_RGBA8";
+        case _SG_VALIDATE_READPIX_DEFAULTPASS:  return "sg_read_pixels_async: reading the default framebuffer requires a preceding sg_begin_default_pass()";
+        case _SG_VALIDATE_READPIX_RECT:         return "sg_read_pixels_async: rectangle outside of framebuffer";
+
         default: return "unknown validation error";
     }
 }
@@ -12522,6 +18142,10 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
             /* on WGPU byte code must be provided */
             SOKOL_VALIDATE((0 != desc->vs.byte_code), _SG_VALIDATE_SHADERDESC_BYTECODE);
             SOKOL_VALIDATE((0 != desc->fs.byte_code), _SG_VALIDATE_SHADERDESC_BYTECODE);
+        #elif defined(SOKOL_SOFT)
+            /* on the software backend, shaders are C functions */
+            SOKOL_VALIDATE((0 != desc->soft_vs) && (0 != desc->soft_fs), _SG_VALIDATE_SHADERDESC_SOFT_FUNCS);
+            SOKOL_VALIDATE((desc->soft_num_varyings >= 0) && (desc->soft_num_varyings <= SG_SOFT_MAX_VARYINGS), _SG_VALIDATE_SHADERDESC_SOFT_NUM_VARYINGS);
         #else
             /* Dummy Backend, don't require source or bytecode */
         #endif
@@ -12554,8 +18178,10 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
                         const sg_shader_uniform_desc* u_desc = &ub_desc->uniforms[u_index];
                         if (u_desc->type != SG_UNIFORMTYPE_INVALID) {
                             SOKOL_VALIDATE(uniforms_continuous, _SG_VALIDATE_SHADERDESC_NO_CONT_UB_MEMBERS);
-                            #if defined(SOKOL_GLES2) || defined(SOKOL_GLES3)
+                            #if defined(SOKOL_GLES2)
                             SOKOL_VALIDATE(u_desc->name, _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME);
+                            #elif defined(SOKOL_GLES3)
+                            SOKOL_VALIDATE(u_desc->name || ub_desc->name, _SG_VALIDATE_SHADERDESC_UB_MEMBER_NAME);
                             #endif
                             const int array_count = u_desc->array_count;
                             uniform_offset += _sg_uniform_size(u_desc->type, array_count);
@@ -12802,6 +18428,7 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
                 if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
                     SOKOL_VALIDATE(SG_BUFFERTYPE_VERTEXBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_VB_TYPE);
                     SOKOL_VALIDATE(!buf->cmn.append_overflow, _SG_VALIDATE_ABND_VB_OVERFLOW);
+                    SOKOL_VALIDATE(0 == buf->cmn.map_ptr, _SG_VALIDATE_ABND_VB_MAPPED);
                 }
             }
             else {
@@ -12826,6 +18453,7 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
             if (buf && buf->slot.state == SG_RESOURCESTATE_VALID) {
                 SOKOL_VALIDATE(SG_BUFFERTYPE_INDEXBUFFER == buf->cmn.type, _SG_VALIDATE_ABND_IB_TYPE);
                 SOKOL_VALIDATE(!buf->cmn.append_overflow, _SG_VALIDATE_ABND_IB_OVERFLOW);
+                SOKOL_VALIDATE(0 == buf->cmn.map_ptr, _SG_VALIDATE_ABND_IB_MAPPED);
             }
         }
 
@@ -12924,6 +18552,56 @@ _SOKOL_PRIVATE bool _sg_validate_append_buffer(const _sg_buffer_t* buf, const vo
     #endif
 }
 
+_SOKOL_PRIVATE bool _sg_validate_draw_indirect(const _sg_buffer_t* buf, int offset, int num_bytes, bool indexed) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(buf);
+        _SOKOL_UNUSED(offset);
+        _SOKOL_UNUSED(num_bytes);
+        _SOKOL_UNUSED(indexed);
+        return true;
+    #else
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(buf && (buf->slot.state == SG_RESOURCESTATE_VALID), _SG_VALIDATE_DRAWINDIRECT_BUF);
+        if (buf) {
+            SOKOL_VALIDATE(SG_BUFFERTYPE_INDIRECTBUFFER == buf->cmn.type, _SG_VALIDATE_DRAWINDIRECT_TYPE);
+            SOKOL_VALIDATE((offset >= 0) && ((offset & 3) == 0), _SG_VALIDATE_DRAWINDIRECT_OFFSET);
+            SOKOL_VALIDATE((offset + num_bytes) <= buf->cmn.size, _SG_VALIDATE_DRAWINDIRECT_SIZE);
+            SOKOL_VALIDATE(0 == buf->cmn.map_ptr, _SG_VALIDATE_DRAWINDIRECT_MAPPED);
+        }
+        /* the GPU path has no way to apply the index buffer offset */
+        SOKOL_VALIDATE(!indexed || (0 == _sg.cur_ib_offset), _SG_VALIDATE_DRAWINDIRECT_IBOFFSET);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_map_buffer(const _sg_buffer_t* buf, int size) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(buf);
+        _SOKOL_UNUSED(size);
+        return true;
+    #else
+        SOKOL_ASSERT(buf);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(buf->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_MAPBUF_USAGE);
+        SOKOL_VALIDATE(buf->cmn.size >= size, _SG_VALIDATE_MAPBUF_SIZE);
+        SOKOL_VALIDATE(buf->cmn.update_frame_index != _sg.frame_index, _SG_VALIDATE_MAPBUF_ONCE);
+        SOKOL_VALIDATE(buf->cmn.append_frame_index != _sg.frame_index, _SG_VALIDATE_MAPBUF_APPEND);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_unmap_buffer(const _sg_buffer_t* buf) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(buf);
+        return true;
+    #else
+        SOKOL_ASSERT(buf);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(0 != buf->cmn.map_ptr, _SG_VALIDATE_UNMAPBUF_NOTMAPPED);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
 _SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_image_content* data) {
     #if !defined(SOKOL_DEBUG)
         _SOKOL_UNUSED(img);
@@ -12951,6 +18629,74 @@ _SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_i
     #endif
 }
 
+_SOKOL_PRIVATE bool _sg_validate_update_image_region(const _sg_image_t* img, const sg_image_region* region, const void* data, int size) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        _SOKOL_UNUSED(region);
+        _SOKOL_UNUSED(data);
+        _SOKOL_UNUSED(size);
+        return true;
+    #else
+        SOKOL_ASSERT(img && region);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(_sg.features.image_region_update, _SG_VALIDATE_UPDIMGREG_FEATURE);
+        SOKOL_VALIDATE(img->cmn.usage == SG_USAGE_DYNAMIC, _SG_VALIDATE_UPDIMGREG_USAGE);
+        SOKOL_VALIDATE(!_sg_is_compressed_pixel_format(img->cmn.pixel_format), _SG_VALIDATE_UPDIMGREG_COMPRESSED);
+        const int mip_index = region->mip_level;
+        SOKOL_VALIDATE((mip_index >= 0) && (mip_index < img->cmn.num_mipmaps), _SG_VALIDATE_UPDIMGREG_MIPLEVEL);
+        int num_slices = 1;
+        switch (img->cmn.type) {
+            case SG_IMAGETYPE_CUBE:     num_slices = SG_CUBEFACE_NUM; break;
+            case SG_IMAGETYPE_ARRAY:    num_slices = img->cmn.depth; break;
+            case SG_IMAGETYPE_3D:       num_slices = _sg_max(img->cmn.depth >> mip_index, 1); break;
+            default: break;
+        }
+        SOKOL_VALIDATE((region->slice >= 0) && (region->slice < num_slices), _SG_VALIDATE_UPDIMGREG_SLICE);
+        const int mip_width = _sg_max(img->cmn.width >> mip_index, 1);
+        const int mip_height = _sg_max(img->cmn.height >> mip_index, 1);
+        SOKOL_VALIDATE((region->x >= 0) && (region->y >= 0) && (region->width > 0) && (region->height > 0) &&
+                       ((region->x + region->width) <= mip_width) &&
+                       ((region->y + region->height) <= mip_height), _SG_VALIDATE_UPDIMGREG_RECT);
+        const int expected_size = (region->width > 0) && (region->height > 0) ?
+            (int)_sg_surface_pitch(img->cmn.pixel_format, (uint32_t)region->width, (uint32_t)region->height, 1) : 0;
+        SOKOL_VALIDATE(data && (size == expected_size), _SG_VALIDATE_UPDIMGREG_DATA);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_read_pixels(const _sg_image_t* img, const sg_read_pixels_desc* desc) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        _SOKOL_UNUSED(desc);
+        return true;
+    #else
+        SOKOL_ASSERT(desc);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(_sg.features.read_pixels, _SG_VALIDATE_READPIX_FEATURE);
+        SOKOL_VALIDATE(!_sg.pass_valid, _SG_VALIDATE_READPIX_PASS);
+        SOKOL_VALIDATE(0 != desc->callback, _SG_VALIDATE_READPIX_CALLBACK);
+        int fb_width = _sg.default_pass_width;
+        int fb_height = _sg.default_pass_height;
+        if (desc->image.id != SG_INVALID_ID) {
+            SOKOL_VALIDATE(0 != img, _SG_VALIDATE_READPIX_IMAGE);
+            if (img) {
+                SOKOL_VALIDATE(img->cmn.render_target, _SG_VALIDATE_READPIX_RENDERTARGET);
+                SOKOL_VALIDATE(img->cmn.type == SG_IMAGETYPE_2D, _SG_VALIDATE_READPIX_IMAGETYPE);
+                SOKOL_VALIDATE(img->cmn.pixel_format == SG_PIXELFORMAT_RGBA8, _SG_VALIDATE_READPIX_FORMAT);
+                fb_width = img->cmn.width;
+                fb_height = img->cmn.height;
+            }
+        }
+        else {
+            SOKOL_VALIDATE((fb_width > 0) && (fb_height > 0), _SG_VALIDATE_READPIX_DEFAULTPASS);
+        }
+        SOKOL_VALIDATE((desc->x >= 0) && (desc->y >= 0) && (desc->width > 0) && (desc->height > 0) &&
+                       ((desc->x + desc->width) <= fb_width) &&
+                       ((desc->y + desc->height) <= fb_height), _SG_VALIDATE_READPIX_RECT);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
 /*== fill in desc default values =============================================*/
 _SOKOL_PRIVATE sg_buffer_desc _sg_buffer_desc_defaults(const sg_buffer_desc* desc) {
     sg_buffer_desc def = *desc;
@@ -13109,7 +18855,9 @@ _SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
     sg_buffer res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.buffer_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &_sg.pools.buffers[slot_index].slot, slot_index);
+        _sg_buffer_t* buf = (_sg_buffer_t*) _sg.pools.buffer_pool.items[slot_index];
+        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &buf->slot, slot_index);
+        _sg_sync_buffer_hot(&_sg.pools, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -13122,7 +18870,9 @@ _SOKOL_PRIVATE sg_image _sg_alloc_image(void) {
     sg_image res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.image_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &_sg.pools.images[slot_index].slot, slot_index);
+        _sg_image_t* img = (_sg_image_t*) _sg.pools.image_pool.items[slot_index];
+        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &img->slot, slot_index);
+        _sg_sync_image_hot(&_sg.pools, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -13135,7 +18885,8 @@ _SOKOL_PRIVATE sg_shader _sg_alloc_shader(void) {
     sg_shader res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.shader_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &_sg.pools.shaders[slot_index].slot, slot_index);
+        _sg_shader_t* shd = (_sg_shader_t*) _sg.pools.shader_pool.items[slot_index];
+        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &shd->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -13148,7 +18899,8 @@ _SOKOL_PRIVATE sg_pipeline _sg_alloc_pipeline(void) {
     sg_pipeline res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.pipeline_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id =_sg_slot_alloc(&_sg.pools.pipeline_pool, &_sg.pools.pipelines[slot_index].slot, slot_index);
+        _sg_pipeline_t* pip = (_sg_pipeline_t*) _sg.pools.pipeline_pool.items[slot_index];
+        res.id = _sg_slot_alloc(&_sg.pools.pipeline_pool, &pip->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -13161,7 +18913,8 @@ _SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
     sg_pass res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.pass_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &_sg.pools.passes[slot_index].slot, slot_index);
+        _sg_pass_t* pass = (_sg_pass_t*) _sg.pools.pass_pool.items[slot_index];
+        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &pass->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -13170,6 +18923,13 @@ _SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
     return res;
 }
 
+/* without backend support for indirect draws, the content of indirect
+   buffers lives in the CPU-side shadow buffer, see sg_draw_indirect()
+*/
+_SOKOL_PRIVATE bool _sg_buffer_common_cpu_indirect(const _sg_buffer_common_t* cmn) {
+    return (SG_BUFFERTYPE_INDIRECTBUFFER == cmn->type) && !_sg.features.draw_indirect;
+}
+
 _SOKOL_PRIVATE void _sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
     SOKOL_ASSERT(buf_id.id != SG_INVALID_ID && desc);
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
@@ -13177,11 +18937,20 @@ _SOKOL_PRIVATE void _sg_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc
     buf->slot.ctx_id = _sg.active_context.id;
     if (_sg_validate_buffer_desc(desc)) {
         buf->slot.state = _sg_create_buffer(buf, desc);
+        if ((buf->slot.state == SG_RESOURCESTATE_VALID) && _sg_buffer_common_cpu_indirect(&buf->cmn)) {
+            buf->cmn.shadow_ptr = SOKOL_MALLOC((size_t)buf->cmn.size);
+            SOKOL_ASSERT(buf->cmn.shadow_ptr);
+            memset(buf->cmn.shadow_ptr, 0, (size_t)buf->cmn.size);
+            if (desc->content) {
+                memcpy(buf->cmn.shadow_ptr, desc->content, (size_t)buf->cmn.size);
+            }
+        }
     }
     else {
         buf->slot.state = SG_RESOURCESTATE_FAILED;
     }
     SOKOL_ASSERT((buf->slot.state == SG_RESOURCESTATE_VALID)||(buf->slot.state == SG_RESOURCESTATE_FAILED));
+    _sg_sync_buffer_hot(&_sg.pools, _sg_slot_index(buf_id.id));
 }
 
 _SOKOL_PRIVATE void _sg_init_image(sg_image img_id, const sg_image_desc* desc) {
@@ -13196,6 +18965,7 @@ _SOKOL_PRIVATE void _sg_init_image(sg_image img_id, const sg_image_desc* desc) {
         img->slot.state = SG_RESOURCESTATE_FAILED;
     }
     SOKOL_ASSERT((img->slot.state == SG_RESOURCESTATE_VALID)||(img->slot.state == SG_RESOURCESTATE_FAILED));
+    _sg_sync_image_hot(&_sg.pools, _sg_slot_index(img_id.id));
 }
 
 _SOKOL_PRIVATE void _sg_init_shader(sg_shader shd_id, const sg_shader_desc* desc) {
@@ -13253,12 +19023,319 @@ _SOKOL_PRIVATE void _sg_init_pass(sg_pass pass_id, const sg_pass_desc* desc) {
         else {
             att_imgs[ds_att_index] = 0;
         }
-        pass->slot.state = _sg_create_pass(pass, att_imgs, desc);
+        pass->slot.state = _sg_create_pass(pass, att_imgs, desc);
+    }
+    else {
+        pass->slot.state = SG_RESOURCESTATE_FAILED;
+    }
+    SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID)||(pass->slot.state == SG_RESOURCESTATE_FAILED));
+}
+
+/*== command list recording private functions ================================*/
+_SOKOL_PRIVATE void* _sg_cmd_alloc(sg_commands* cmds, _sg_cmd_type_t type, int num_bytes) {
+    SOKOL_ASSERT(cmds && cmds->recording);
+    const int size = _sg_roundup(num_bytes, 4);
+    if (cmds->overflow || ((cmds->pos + size) > cmds->size)) {
+        cmds->overflow = true;
+        return 0;
+    }
+    _sg_cmd_header_t* hdr = (_sg_cmd_header_t*) (cmds->ptr + cmds->pos);
+    hdr->type = (uint32_t) type;
+    hdr->size = (uint32_t) size;
+    cmds->pos += size;
+    cmds->num_cmds++;
+    return hdr;
+}
+
+_SOKOL_PRIVATE void _sg_cmd_rect(sg_commands* cmds, _sg_cmd_type_t type, int x, int y, int w, int h, bool origin_top_left) {
+    _sg_cmd_rect_t* cmd = (_sg_cmd_rect_t*) _sg_cmd_alloc(cmds, type, sizeof(_sg_cmd_rect_t));
+    if (cmd) {
+        cmd->x = x;
+        cmd->y = y;
+        cmd->w = w;
+        cmd->h = h;
+        cmd->origin_top_left = origin_top_left ? 1 : 0;
+    }
+}
+
+/* number of slots up to and including the last valid one */
+_SOKOL_PRIVATE int _sg_cmd_num_buffers(const sg_buffer* bufs, int max_bufs) {
+    int num = 0;
+    for (int i = 0; i < max_bufs; i++) {
+        if (bufs[i].id != SG_INVALID_ID) {
+            num = i + 1;
+        }
+    }
+    return num;
+}
+
+_SOKOL_PRIVATE int _sg_cmd_num_images(const sg_image* imgs, int max_imgs) {
+    int num = 0;
+    for (int i = 0; i < max_imgs; i++) {
+        if (imgs[i].id != SG_INVALID_ID) {
+            num = i + 1;
+        }
+    }
+    return num;
+}
+
+_SOKOL_PRIVATE void _sg_cmd_submit_bindings(const _sg_cmd_apply_bindings_t* cmd) {
+    sg_bindings bindings;
+    memset(&bindings, 0, sizeof(bindings));
+    const uint32_t* src = (const uint32_t*) (cmd + 1);
+    for (int i = 0; i < cmd->num_vbs; i++) {
+        bindings.vertex_buffers[i].id = *src++;
+    }
+    for (int i = 0; i < cmd->num_vbs; i++) {
+        bindings.vertex_buffer_offsets[i] = (int) *src++;
+    }
+    if (cmd->has_ib) {
+        bindings.index_buffer.id = *src++;
+        bindings.index_buffer_offset = (int) *src++;
+    }
+    for (int i = 0; i < cmd->num_vs_imgs; i++) {
+        bindings.vs_images[i].id = *src++;
+    }
+    for (int i = 0; i < cmd->num_fs_imgs; i++) {
+        bindings.fs_images[i].id = *src++;
+    }
+    sg_apply_bindings(&bindings);
+}
+
+/*== pipeline deduplication private functions ================================*/
+
+/* flatten a defaulted pipeline desc into an array of 32-bit values, the label is ignored */
+_SOKOL_PRIVATE void _sg_pipdedup_key(const sg_pipeline_desc* desc, uint32_t* key) {
+    int i = 0;
+    for (int b = 0; b < SG_MAX_SHADERSTAGE_BUFFERS; b++) {
+        const sg_buffer_layout_desc* l = &desc->layout.buffers[b];
+        key[i++] = (uint32_t) l->stride;
+        key[i++] = (uint32_t) l->step_func;
+        key[i++] = (uint32_t) l->step_rate;
+    }
+    for (int a = 0; a < SG_MAX_VERTEX_ATTRIBUTES; a++) {
+        const sg_vertex_attr_desc* va = &desc->layout.attrs[a];
+        key[i++] = (uint32_t) va->buffer_index;
+        key[i++] = (uint32_t) va->offset;
+        key[i++] = (uint32_t) va->format;
+    }
+    key[i++] = desc->shader.id;
+    key[i++] = (uint32_t) desc->primitive_type;
+    key[i++] = (uint32_t) desc->index_type;
+    const sg_depth_stencil_state* ds = &desc->depth_stencil;
+    const sg_stencil_state* ss[2] = { &ds->stencil_front, &ds->stencil_back };
+    for (int s = 0; s < 2; s++) {
+        key[i++] = (uint32_t) ss[s]->fail_op;
+        key[i++] = (uint32_t) ss[s]->depth_fail_op;
+        key[i++] = (uint32_t) ss[s]->pass_op;
+        key[i++] = (uint32_t) ss[s]->compare_func;
+    }
+    key[i++] = (uint32_t) ds->depth_compare_func;
+    key[i++] = ds->depth_write_enabled ? 1 : 0;
+    key[i++] = ds->stencil_enabled ? 1 : 0;
+    key[i++] = ds->stencil_read_mask;
+    key[i++] = ds->stencil_write_mask;
+    key[i++] = ds->stencil_ref;
+    const sg_blend_state* bs = &desc->blend;
+    key[i++] = bs->enabled ? 1 : 0;
+    key[i++] = (uint32_t) bs->src_factor_rgb;
+    key[i++] = (uint32_t) bs->dst_factor_rgb;
+    key[i++] = (uint32_t) bs->op_rgb;
+    key[i++] = (uint32_t) bs->src_factor_alpha;
+    key[i++] = (uint32_t) bs->dst_factor_alpha;
+    key[i++] = (uint32_t) bs->op_alpha;
+    key[i++] = bs->color_write_mask;
+    key[i++] = (uint32_t) bs->color_attachment_count;
+    key[i++] = (uint32_t) bs->color_format;
+    key[i++] = (uint32_t) bs->depth_format;
+    memcpy(&key[i], bs->blend_color, 4 * sizeof(uint32_t)); i += 4;
+    const sg_rasterizer_state* rs = &desc->rasterizer;
+    key[i++] = rs->alpha_to_coverage_enabled ? 1 : 0;
+    key[i++] = (uint32_t) rs->cull_mode;
+    key[i++] = (uint32_t) rs->face_winding;
+    key[i++] = (uint32_t) rs->sample_count;
+    memcpy(&key[i++], &rs->depth_bias, sizeof(uint32_t));
+    memcpy(&key[i++], &rs->depth_bias_slope_scale, sizeof(uint32_t));
+    memcpy(&key[i++], &rs->depth_bias_clamp, sizeof(uint32_t));
+    SOKOL_ASSERT(i == _SG_PIPDEDUP_KEY_SIZE);
+}
+
+_SOKOL_PRIVATE uint32_t _sg_pipdedup_hash(const uint32_t* key) {
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < _SG_PIPDEDUP_KEY_SIZE; i++) {
+        hash = (hash ^ key[i]) * 16777619u;
+    }
+    return hash;
+}
+
+_SOKOL_PRIVATE void _sg_pipdedup_alloc_table(_sg_pipdedup_t* dd) {
+    /* keep the hash table at most half full */
+    dd->table_size = 1;
+    while (dd->table_size < (2 * dd->num_slots)) {
+        dd->table_size <<= 1;
+    }
+    const size_t table_size = (size_t)dd->table_size * sizeof(int);
+    dd->table = (int*) SOKOL_MALLOC(table_size);
+    SOKOL_ASSERT(dd->table);
+    memset(dd->table, 0xFF, table_size);
+}
+
+_SOKOL_PRIVATE void _sg_setup_pipdedup(_sg_pipdedup_t* dd, const sg_desc* desc) {
+    SOKOL_ASSERT(dd && desc);
+    dd->enabled = desc->pipeline_dedup_enabled;
+    if (!dd->enabled) {
+        return;
+    }
+    /* one entry per pipeline pool slot, slot 0 is reserved */
+    dd->num_slots = desc->pipeline_pool_size + 1;
+    const size_t entries_size = dd->num_slots * sizeof(_sg_pipdedup_entry_t);
+    dd->entries = (_sg_pipdedup_entry_t*) SOKOL_MALLOC(entries_size);
+    SOKOL_ASSERT(dd->entries);
+    memset(dd->entries, 0, entries_size);
+    _sg_pipdedup_alloc_table(dd);
+}
+
+_SOKOL_PRIVATE void _sg_discard_pipdedup(_sg_pipdedup_t* dd) {
+    SOKOL_ASSERT(dd);
+    if (dd->entries) {
+        SOKOL_FREE(dd->entries);
+        dd->entries = 0;
+    }
+    if (dd->table) {
+        SOKOL_FREE(dd->table);
+        dd->table = 0;
+    }
+    dd->num_slots = 0;
+    dd->table_size = 0;
+    dd->enabled = false;
+}
+
+_SOKOL_PRIVATE void _sg_pipdedup_table_insert(_sg_pipdedup_t* dd, int slot_index) {
+    const int mask = dd->table_size - 1;
+    int bucket = (int)(dd->entries[slot_index].hash & (uint32_t)mask);
+    while (dd->table[bucket] != -1) {
+        bucket = (bucket + 1) & mask;
+    }
+    dd->table[bucket] = slot_index;
+}
+
+_SOKOL_PRIVATE void _sg_pipdedup_table_remove(_sg_pipdedup_t* dd, int slot_index) {
+    const int mask = dd->table_size - 1;
+    int bucket = (int)(dd->entries[slot_index].hash & (uint32_t)mask);
+    while (dd->table[bucket] != slot_index) {
+        SOKOL_ASSERT(dd->table[bucket] != -1);
+        bucket = (bucket + 1) & mask;
+    }
+    /* backward-shift following entries so that lookups need no tombstones */
+    int next = bucket;
+    for (;;) {
+        next = (next + 1) & mask;
+        if (dd->table[next] == -1) {
+            break;
+        }
+        const int home = (int)(dd->entries[dd->table[next]].hash & (uint32_t)mask);
+        const bool move = (bucket <= next) ?
+            ((home <= bucket) || (home > next)) :
+            ((home <= bucket) && (home > next));
+        if (move) {
+            dd->table[bucket] = dd->table[next];
+            bucket = next;
+        }
+    }
+    dd->table[bucket] = -1;
+}
+
+/* find a shared valid pipeline matching the key, or return SG_INVALID_ID */
+_SOKOL_PRIVATE uint32_t _sg_pipdedup_find(const _sg_pipdedup_t* dd, const uint32_t* key, uint32_t hash) {
+    const int mask = dd->table_size - 1;
+    int bucket = (int)(hash & (uint32_t)mask);
+    while (dd->table[bucket] != -1) {
+        const _sg_pipdedup_entry_t* entry = &dd->entries[dd->table[bucket]];
+        if ((entry->hash == hash) && (0 == memcmp(entry->key, key, sizeof(entry->key)))) {
+            const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, entry->pip_id);
+            if (pip && (pip->slot.state == SG_RESOURCESTATE_VALID) && (pip->slot.ctx_id == _sg.active_context.id)) {
+                return entry->pip_id;
+            }
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    return SG_INVALID_ID;
+}
+
+_SOKOL_PRIVATE void _sg_pipdedup_add(_sg_pipdedup_t* dd, uint32_t pip_id, const uint32_t* key, uint32_t hash) {
+    const int slot_index = _sg_slot_index(pip_id);
+    if (slot_index >= dd->num_slots) {
+        /* the pipeline pool has grown since the entries were allocated */
+        const int num_slots = _sg.pools.pipeline_pool.size;
+        SOKOL_ASSERT(slot_index < num_slots);
+        dd->entries = (_sg_pipdedup_entry_t*) _sg_pool_realloc(dd->entries,
+            dd->num_slots * sizeof(_sg_pipdedup_entry_t),
+            num_slots * sizeof(_sg_pipdedup_entry_t));
+        dd->num_slots = num_slots;
+        SOKOL_FREE(dd->table);
+        _sg_pipdedup_alloc_table(dd);
+        for (int i = 1; i < dd->num_slots; i++) {
+            if (dd->entries[i].ref_count > 0) {
+                _sg_pipdedup_table_insert(dd, i);
+            }
+        }
+    }
+    _sg_pipdedup_entry_t* entry = &dd->entries[slot_index];
+    if (entry->ref_count > 0) {
+        /* stale entry of a pipeline which went away without sg_destroy_pipeline() */
+        _sg_pipdedup_table_remove(dd, slot_index);
+    }
+    entry->pip_id = pip_id;
+    entry->hash = hash;
+    entry->ref_count = 1;
+    memcpy(entry->key, key, sizeof(entry->key));
+    _sg_pipdedup_table_insert(dd, slot_index);
+}
+
+/* drop a pipeline's entry from the hash table once the last reference is gone */
+_SOKOL_PRIVATE void _sg_pipdedup_remove(_sg_pipdedup_t* dd, _sg_pipdedup_entry_t* entry) {
+    SOKOL_ASSERT(entry && (entry->ref_count == 0));
+    _sg_pipdedup_table_remove(dd, (int)(entry - dd->entries));
+}
+
+/* returns the pipeline's dedup entry, or a null pointer if the pipeline isn't shared */
+_SOKOL_PRIVATE _sg_pipdedup_entry_t* _sg_pipdedup_entry(_sg_pipdedup_t* dd, uint32_t pip_id) {
+    const int slot_index = _sg_slot_index(pip_id);
+    if (dd->enabled && (slot_index < dd->num_slots)) {
+        _sg_pipdedup_entry_t* entry = &dd->entries[slot_index];
+        if ((entry->pip_id == pip_id) && (entry->ref_count > 0)) {
+            return entry;
+        }
     }
-    else {
-        pass->slot.state = SG_RESOURCESTATE_FAILED;
+    return 0;
+}
+
+/*== redundant call filter private functions =================================*/
+_SOKOL_PRIVATE void _sg_filter_reset(void) {
+    _sg.filter.pip_id = SG_INVALID_ID;
+    _sg.filter.bindings_valid = false;
+    _sg.filter.viewport.valid = false;
+    _sg.filter.scissor_rect.valid = false;
+}
+
+/* returns true if the rect is identical with the last applied rect,
+   otherwise records the new rect and returns false
+*/
+_SOKOL_PRIVATE bool _sg_filter_rect(_sg_filter_rect_t* rect, int x, int y, int w, int h, bool origin_top_left) {
+    if (rect->valid &&
+        (rect->x == x) && (rect->y == y) && (rect->w == w) && (rect->h == h) &&
+        (rect->origin_top_left == origin_top_left))
+    {
+        return true;
     }
-    SOKOL_ASSERT((pass->slot.state == SG_RESOURCESTATE_VALID)||(pass->slot.state == SG_RESOURCESTATE_FAILED));
+    rect->valid = true;
+    rect->x = x;
+    rect->y = y;
+    rect->w = w;
+    rect->h = h;
+    rect->origin_top_left = origin_top_left;
+    return false;
 }
 
 /*== PUBLIC API FUNCTIONS ====================================================*/
@@ -13290,8 +19367,10 @@ SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
     _sg.desc.uniform_buffer_size = _sg_def(_sg.desc.uniform_buffer_size, _SG_DEFAULT_UB_SIZE);
     _sg.desc.staging_buffer_size = _sg_def(_sg.desc.staging_buffer_size, _SG_DEFAULT_STAGING_SIZE);
     _sg.desc.sampler_cache_size = _sg_def(_sg.desc.sampler_cache_size, _SG_DEFAULT_SAMPLER_CACHE_CAPACITY);
+    _sg.desc.soft_num_threads = _sg_def(_sg.desc.soft_num_threads, _SG_DEFAULT_SOFT_NUM_THREADS);
 
     _sg_setup_pools(&_sg.pools, &_sg.desc);
+    _sg_setup_pipdedup(&_sg.pipdedup, &_sg.desc);
     _sg.frame_index = 1;
     _sg_setup_backend(&_sg.desc);
     _sg.valid = true;
@@ -13311,6 +19390,7 @@ SOKOL_API_IMPL void sg_shutdown(void) {
         }
     }
     _sg_discard_backend();
+    _sg_discard_pipdedup(&_sg.pipdedup);
     _sg_discard_pools(&_sg.pools);
     _sg.valid = false;
 }
@@ -13346,13 +19426,56 @@ SOKOL_API_IMPL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt) {
     return _sg.formats[fmt_index];
 }
 
+SOKOL_API_IMPL sg_filter_stats sg_query_filter_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.filter.stats;
+}
+
+SOKOL_API_IMPL sg_frame_stats sg_query_frame_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.prev_frame_stats;
+}
+
+SOKOL_API_IMPL sg_gpu_timings sg_query_gpu_timings(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.gpu_timings;
+}
+
+SOKOL_API_IMPL sg_dummy_stats sg_query_dummy_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    #if defined(SOKOL_DUMMY_BACKEND)
+    return _sg.dmy.stats;
+    #else
+    sg_dummy_stats stats;
+    memset(&stats, 0, sizeof(stats));
+    return stats;
+    #endif
+}
+
+SOKOL_API_IMPL const char* sg_query_dummy_log(void) {
+    SOKOL_ASSERT(_sg.valid);
+    #if defined(SOKOL_DUMMY_BACKEND)
+    if (_sg.dmy.log) {
+        return _sg.dmy.log;
+    }
+    #endif
+    return "";
+}
+
+SOKOL_API_IMPL void sg_reset_dummy_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    #if defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_reset_stats();
+    #endif
+}
+
 SOKOL_API_IMPL sg_context sg_setup_context(void) {
     SOKOL_ASSERT(_sg.valid);
     sg_context res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.context_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.context_pool, &_sg.pools.contexts[slot_index].slot, slot_index);
-        _sg_context_t* ctx = _sg_context_at(&_sg.pools, res.id);
+        _sg_context_t* ctx = (_sg_context_t*) _sg.pools.context_pool.items[slot_index];
+        res.id = _sg_slot_alloc(&_sg.pools.context_pool, &ctx->slot, slot_index);
         ctx->slot.state = _sg_create_context(ctx);
         SOKOL_ASSERT(ctx->slot.state == SG_RESOURCESTATE_VALID);
         _sg_activate_context(ctx);
@@ -13362,6 +19485,7 @@ SOKOL_API_IMPL sg_context sg_setup_context(void) {
         res.id = SG_INVALID_ID;
     }
     _sg.active_context = res;
+    _sg_filter_reset();
     return res;
 }
 
@@ -13375,6 +19499,7 @@ SOKOL_API_IMPL void sg_discard_context(sg_context ctx_id) {
         _sg_pool_free_index(&_sg.pools.context_pool, _sg_slot_index(ctx_id.id));
     }
     _sg.active_context.id = SG_INVALID_ID;
+    _sg_filter_reset();
     _sg_activate_context(0);
 }
 
@@ -13384,6 +19509,7 @@ SOKOL_API_IMPL void sg_activate_context(sg_context ctx_id) {
     _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
     /* NOTE: ctx can be 0 here if the context is no longer valid */
     _sg_activate_context(ctx);
+    _sg_filter_reset();
 }
 
 SOKOL_API_IMPL sg_trace_hooks sg_install_trace_hooks(const sg_trace_hooks* trace_hooks) {
@@ -13477,6 +19603,7 @@ SOKOL_API_IMPL void sg_fail_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(buf && buf->slot.state == SG_RESOURCESTATE_ALLOC);
     buf->slot.ctx_id = _sg.active_context.id;
     buf->slot.state = SG_RESOURCESTATE_FAILED;
+    _sg_sync_buffer_hot(&_sg.pools, _sg_slot_index(buf_id.id));
     _SG_TRACE_ARGS(fail_buffer, buf_id);
 }
 
@@ -13487,6 +19614,7 @@ SOKOL_API_IMPL void sg_fail_image(sg_image img_id) {
     SOKOL_ASSERT(img && img->slot.state == SG_RESOURCESTATE_ALLOC);
     img->slot.ctx_id = _sg.active_context.id;
     img->slot.state = SG_RESOURCESTATE_FAILED;
+    _sg_sync_image_hot(&_sg.pools, _sg_slot_index(img_id.id));
     _SG_TRACE_ARGS(fail_image, img_id);
 }
 
@@ -13609,9 +19737,24 @@ SOKOL_API_IMPL sg_pipeline sg_make_pipeline(const sg_pipeline_desc* desc) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(desc);
     sg_pipeline_desc desc_def = _sg_pipeline_desc_defaults(desc);
+    uint32_t key[_SG_PIPDEDUP_KEY_SIZE];
+    uint32_t hash = 0;
+    if (_sg.pipdedup.enabled) {
+        _sg_pipdedup_key(&desc_def, key);
+        hash = _sg_pipdedup_hash(key);
+        sg_pipeline shared_pip_id = { _sg_pipdedup_find(&_sg.pipdedup, key, hash) };
+        if (shared_pip_id.id != SG_INVALID_ID) {
+            /* no trace hook call, no new pipeline object is created */
+            _sg_pipdedup_entry(&_sg.pipdedup, shared_pip_id.id)->ref_count++;
+            return shared_pip_id;
+        }
+    }
     sg_pipeline pip_id = _sg_alloc_pipeline();
     if (pip_id.id != SG_INVALID_ID) {
         _sg_init_pipeline(pip_id, &desc_def);
+        if (_sg.pipdedup.enabled && (_sg_pipeline_at(&_sg.pools, pip_id.id)->slot.state == SG_RESOURCESTATE_VALID)) {
+            _sg_pipdedup_add(&_sg.pipdedup, pip_id.id, key, hash);
+        }
     }
     else {
         SOKOL_LOG("pipeline pool exhausted!");
@@ -13644,8 +19787,11 @@ SOKOL_API_IMPL void sg_destroy_buffer(sg_buffer buf_id) {
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
     if (buf) {
         if (buf->slot.ctx_id == _sg.active_context.id) {
+            _sg_buffer_common_discard(&buf->cmn);
             _sg_destroy_buffer(buf);
             _sg_reset_buffer(buf);
+            _sg_sync_buffer_hot(&_sg.pools, _sg_slot_index(buf_id.id));
+            _sg_filter_reset();
             _sg_pool_free_index(&_sg.pools.buffer_pool, _sg_slot_index(buf_id.id));
         }
         else {
@@ -13663,6 +19809,8 @@ SOKOL_API_IMPL void sg_destroy_image(sg_image img_id) {
         if (img->slot.ctx_id == _sg.active_context.id) {
             _sg_destroy_image(img);
             _sg_reset_image(img);
+            _sg_sync_image_hot(&_sg.pools, _sg_slot_index(img_id.id));
+            _sg_filter_reset();
             _sg_pool_free_index(&_sg.pools.image_pool, _sg_slot_index(img_id.id));
         }
         else {
@@ -13691,12 +19839,25 @@ SOKOL_API_IMPL void sg_destroy_shader(sg_shader shd_id) {
 
 SOKOL_API_IMPL void sg_destroy_pipeline(sg_pipeline pip_id) {
     SOKOL_ASSERT(_sg.valid);
-    _SG_TRACE_ARGS(destroy_pipeline, pip_id);
+    /* shared pipelines are only destroyed when the last reference is released,
+       the trace hook is only called for the actual destruction
+    */
     _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (pip && (pip->slot.ctx_id == _sg.active_context.id)) {
+        _sg_pipdedup_entry_t* dd_entry = _sg_pipdedup_entry(&_sg.pipdedup, pip_id.id);
+        if (dd_entry) {
+            if (--dd_entry->ref_count > 0) {
+                return;
+            }
+            _sg_pipdedup_remove(&_sg.pipdedup, dd_entry);
+        }
+    }
+    _SG_TRACE_ARGS(destroy_pipeline, pip_id);
     if (pip) {
         if (pip->slot.ctx_id == _sg.active_context.id) {
             _sg_destroy_pipeline(pip);
             _sg_reset_pipeline(pip);
+            _sg_filter_reset();
             _sg_pool_free_index(&_sg.pools.pipeline_pool, _sg_slot_index(pip_id.id));
         }
         else {
@@ -13730,8 +19891,13 @@ SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int
     sg_pass_action pa;
     _sg_resolve_default_pass_action(pass_action, &pa);
     _sg.cur_pass.id = SG_INVALID_ID;
+    _sg.default_pass_width = width;
+    _sg.default_pass_height = height;
     _sg.pass_valid = true;
+    _sg_filter_reset();
+    _sg_begin_gpu_timing("default pass", true, _sg.cur_pass);
     _sg_begin_pass(0, &pa, width, height);
+    _sg.frame_stats.num_passes++;
     _SG_TRACE_ARGS(begin_default_pass, pass_action, width, height);
 }
 
@@ -13740,6 +19906,7 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
     SOKOL_ASSERT(pass_action);
     SOKOL_ASSERT((pass_action->_start_canary == 0) && (pass_action->_end_canary == 0));
     _sg.cur_pass = pass_id;
+    _sg_filter_reset();
     _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, pass_id.id);
     if (pass && _sg_validate_begin_pass(pass)) {
         _sg.pass_valid = true;
@@ -13749,11 +19916,14 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
         SOKOL_ASSERT(img);
         const int w = img->cmn.width;
         const int h = img->cmn.height;
+        _sg_begin_gpu_timing("pass", true, pass_id);
         _sg_begin_pass(pass, &pa, w, h);
+        _sg.frame_stats.num_passes++;
         _SG_TRACE_ARGS(begin_pass, pass_id, pass_action);
     }
     else {
         _sg.pass_valid = false;
+        _sg.frame_stats.num_rejected_pass_invalid++;
         _SG_TRACE_NOARGS(err_pass_invalid);
     }
 }
@@ -13761,32 +19931,53 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
 SOKOL_API_IMPL void sg_apply_viewport(int x, int y, int width, int height, bool origin_top_left) {
     SOKOL_ASSERT(_sg.valid);
     if (!_sg.pass_valid) {
+        _sg.frame_stats.num_rejected_pass_invalid++;
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
-    _sg_apply_viewport(x, y, width, height, origin_top_left);
+    if (_sg_filter_rect(&_sg.filter.viewport, x, y, width, height, origin_top_left)) {
+        _sg.filter.stats.num_apply_viewport++;
+    }
+    else {
+        _sg_apply_viewport(x, y, width, height, origin_top_left);
+    }
     _SG_TRACE_ARGS(apply_viewport, x, y, width, height, origin_top_left);
 }
 
 SOKOL_API_IMPL void sg_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left) {
     SOKOL_ASSERT(_sg.valid);
     if (!_sg.pass_valid) {
+        _sg.frame_stats.num_rejected_pass_invalid++;
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
-    _sg_apply_scissor_rect(x, y, width, height, origin_top_left);
+    if (_sg_filter_rect(&_sg.filter.scissor_rect, x, y, width, height, origin_top_left)) {
+        _sg.filter.stats.num_apply_scissor_rect++;
+    }
+    else {
+        _sg_apply_scissor_rect(x, y, width, height, origin_top_left);
+    }
     _SG_TRACE_ARGS(apply_scissor_rect, x, y, width, height, origin_top_left);
 }
 
 SOKOL_API_IMPL void sg_apply_pipeline(sg_pipeline pip_id) {
     SOKOL_ASSERT(_sg.valid);
     _sg.bindings_valid = false;
+    if ((SG_INVALID_ID != pip_id.id) && (_sg.filter.pip_id == pip_id.id)) {
+        _sg.filter.stats.num_apply_pipeline++;
+        _SG_TRACE_ARGS(apply_pipeline, pip_id);
+        return;
+    }
+    _sg.filter.pip_id = SG_INVALID_ID;
+    _sg.filter.bindings_valid = false;
     if (!_sg_validate_apply_pipeline(pip_id)) {
         _sg.next_draw_valid = false;
+        _sg.frame_stats.num_rejected_draw_invalid++;
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
     }
     if (!_sg.pass_valid) {
+        _sg.frame_stats.num_rejected_pass_invalid++;
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
@@ -13796,6 +19987,10 @@ SOKOL_API_IMPL void sg_apply_pipeline(sg_pipeline pip_id) {
     _sg.next_draw_valid = (SG_RESOURCESTATE_VALID == pip->slot.state);
     SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
     _sg_apply_pipeline(pip);
+    _sg.frame_stats.num_apply_pipeline++;
+    if (_sg.next_draw_valid) {
+        _sg.filter.pip_id = pip_id.id;
+    }
     _SG_TRACE_ARGS(apply_pipeline, pip_id);
 }
 
@@ -13803,8 +19998,20 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(bindings);
     SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
+    if (_sg.filter.bindings_valid &&
+        (_sg.filter.pip_id == _sg.cur_pipeline.id) &&
+        (0 == memcmp(&_sg.filter.bindings, bindings, sizeof(sg_bindings))))
+    {
+        _sg.bindings_valid = true;
+        _sg.filter.stats.num_apply_bindings++;
+        _SG_TRACE_ARGS(apply_bindings, bindings);
+        return;
+    }
+    _sg.filter.bindings_valid = false;
     if (!_sg_validate_apply_bindings(bindings)) {
         _sg.next_draw_valid = false;
+        _sg.filter.pip_id = SG_INVALID_ID;
+        _sg.frame_stats.num_rejected_draw_invalid++;
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
     }
@@ -13813,48 +20020,49 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
     SOKOL_ASSERT(pip);
 
-    _sg_buffer_t* vbs[SG_MAX_SHADERSTAGE_BUFFERS] = { 0 };
+    /* only the compact per-draw copies of the resources are touched here */
+    const _sg_buffer_hot_t* vbs[SG_MAX_SHADERSTAGE_BUFFERS] = { 0 };
     int num_vbs = 0;
     for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++, num_vbs++) {
         if (bindings->vertex_buffers[i].id) {
-            vbs[i] = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
+            vbs[i] = _sg_lookup_buffer_hot(&_sg.pools, bindings->vertex_buffers[i].id);
             SOKOL_ASSERT(vbs[i]);
-            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vbs[i]->slot.state);
-            _sg.next_draw_valid &= !vbs[i]->cmn.append_overflow;
+            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vbs[i]->state);
+            _sg.next_draw_valid &= !vbs[i]->append_overflow;
         }
         else {
             break;
         }
     }
 
-    _sg_buffer_t* ib = 0;
+    const _sg_buffer_hot_t* ib = 0;
     if (bindings->index_buffer.id) {
-        ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
+        ib = _sg_lookup_buffer_hot(&_sg.pools, bindings->index_buffer.id);
         SOKOL_ASSERT(ib);
-        _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == ib->slot.state);
-        _sg.next_draw_valid &= !ib->cmn.append_overflow;
+        _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == ib->state);
+        _sg.next_draw_valid &= !ib->append_overflow;
     }
 
-    _sg_image_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    const _sg_image_hot_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
     int num_vs_imgs = 0;
     for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, num_vs_imgs++) {
         if (bindings->vs_images[i].id) {
-            vs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->vs_images[i].id);
+            vs_imgs[i] = _sg_lookup_image_hot(&_sg.pools, bindings->vs_images[i].id);
             SOKOL_ASSERT(vs_imgs[i]);
-            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vs_imgs[i]->slot.state);
+            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == vs_imgs[i]->state);
         }
         else {
             break;
         }
     }
 
-    _sg_image_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
+    const _sg_image_hot_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES] = { 0 };
     int num_fs_imgs = 0;
     for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++, num_fs_imgs++) {
         if (bindings->fs_images[i].id) {
-            fs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->fs_images[i].id);
+            fs_imgs[i] = _sg_lookup_image_hot(&_sg.pools, bindings->fs_images[i].id);
             SOKOL_ASSERT(fs_imgs[i]);
-            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == fs_imgs[i]->slot.state);
+            _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == fs_imgs[i]->state);
         }
         else {
             break;
@@ -13864,9 +20072,19 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
         const int* vb_offsets = bindings->vertex_buffer_offsets;
         int ib_offset = bindings->index_buffer_offset;
         _sg_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+        #if defined(SOKOL_DEBUG)
+        _sg.cur_ib_offset = ib_offset;
+        #endif
+        _sg.frame_stats.num_apply_bindings++;
+        if (SG_INVALID_ID != _sg.filter.pip_id) {
+            _sg.filter.bindings = *bindings;
+            _sg.filter.bindings_valid = true;
+        }
         _SG_TRACE_ARGS(apply_bindings, bindings);
     }
     else {
+        _sg.filter.pip_id = SG_INVALID_ID;
+        _sg.frame_stats.num_rejected_draw_invalid++;
         _SG_TRACE_NOARGS(err_draw_invalid);
     }
 }
@@ -13878,10 +20096,13 @@ SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const
     SOKOL_ASSERT(data && (num_bytes > 0));
     if (!_sg_validate_apply_uniforms(stage, ub_index, data, num_bytes)) {
         _sg.next_draw_valid = false;
+        _sg.filter.pip_id = SG_INVALID_ID;
+        _sg.frame_stats.num_rejected_draw_invalid++;
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
     }
     if (!_sg.pass_valid) {
+        _sg.frame_stats.num_rejected_pass_invalid++;
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
@@ -13889,6 +20110,8 @@ SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const
         _SG_TRACE_NOARGS(err_draw_invalid);
     }
     _sg_apply_uniforms(stage, ub_index, data, num_bytes);
+    _sg.frame_stats.num_apply_uniforms++;
+    _sg.frame_stats.size_apply_uniforms += (uint32_t)num_bytes;
     _SG_TRACE_ARGS(apply_uniforms, stage, ub_index, data, num_bytes);
 }
 
@@ -13900,31 +20123,161 @@ SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instance
         }
     #endif
     if (!_sg.pass_valid) {
+        _sg.frame_stats.num_rejected_pass_invalid++;
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
     if (!_sg.next_draw_valid) {
+        _sg.frame_stats.num_rejected_draw_invalid++;
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
     }
     if (!_sg.bindings_valid) {
+        _sg.frame_stats.num_rejected_draw_invalid++;
         _SG_TRACE_NOARGS(err_bindings_invalid);
         return;
     }
-    _sg_draw(base_element, num_elements, num_instances);
+    _sg_draw(base_element, num_elements, num_instances, 0);
+    _sg.frame_stats.num_draw++;
+    _sg.frame_stats.num_elements += (uint32_t)num_elements;
+    _sg.frame_stats.num_instances += (uint32_t)num_instances;
     _SG_TRACE_ARGS(draw, base_element, num_elements, num_instances);
 }
 
+SOKOL_API_IMPL void sg_draw_ex(int base_element, int num_elements, int num_instances, int base_vertex) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(base_vertex >= 0);
+    #if defined(SOKOL_DEBUG)
+        if (!_sg.bindings_valid) {
+            SOKOL_LOG("attempting to draw without resource bindings");
+        }
+    #endif
+    if (!_sg.pass_valid) {
+        _sg.frame_stats.num_rejected_pass_invalid++;
+        _SG_TRACE_NOARGS(err_pass_invalid);
+        return;
+    }
+    if (!_sg.next_draw_valid) {
+        _sg.frame_stats.num_rejected_draw_invalid++;
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    if (!_sg.bindings_valid) {
+        _sg.frame_stats.num_rejected_draw_invalid++;
+        _SG_TRACE_NOARGS(err_bindings_invalid);
+        return;
+    }
+    _sg_draw(base_element, num_elements, num_instances, base_vertex);
+    _sg.frame_stats.num_draw++;
+    _sg.frame_stats.num_elements += (uint32_t)num_elements;
+    _sg.frame_stats.num_instances += (uint32_t)num_instances;
+    _SG_TRACE_ARGS(draw_ex, base_element, num_elements, num_instances, base_vertex);
+}
+
+SOKOL_API_IMPL void sg_multi_draw(const sg_draw_args* draws, int num_draws) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(draws && (num_draws >= 0));
+    #if defined(SOKOL_DEBUG)
+        if (!_sg.bindings_valid) {
+            SOKOL_LOG("attempting to draw without resource bindings");
+        }
+    #endif
+    if (!_sg.pass_valid) {
+        _sg.frame_stats.num_rejected_pass_invalid++;
+        _SG_TRACE_NOARGS(err_pass_invalid);
+        return;
+    }
+    if (!_sg.next_draw_valid) {
+        _sg.frame_stats.num_rejected_draw_invalid++;
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    if (!_sg.bindings_valid) {
+        _sg.frame_stats.num_rejected_draw_invalid++;
+        _SG_TRACE_NOARGS(err_bindings_invalid);
+        return;
+    }
+    if (num_draws > 0) {
+        _sg_multi_draw(draws, num_draws);
+        _sg.frame_stats.num_draw += (uint32_t)num_draws;
+        for (int i = 0; i < num_draws; i++) {
+            _sg.frame_stats.num_elements += (uint32_t)draws[i].num_elements;
+            _sg.frame_stats.num_instances += (uint32_t)draws[i].num_instances;
+        }
+    }
+    _SG_TRACE_ARGS(multi_draw, draws, num_draws);
+}
+
+SOKOL_API_IMPL void sg_draw_indirect(sg_buffer buf_id, int offset, int num_draws) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(num_draws >= 0);
+    #if defined(SOKOL_DEBUG)
+        if (!_sg.bindings_valid) {
+            SOKOL_LOG("attempting to draw without resource bindings");
+        }
+    #endif
+    if (!_sg.pass_valid) {
+        _sg.frame_stats.num_rejected_pass_invalid++;
+        _SG_TRACE_NOARGS(err_pass_invalid);
+        return;
+    }
+    if (!_sg.next_draw_valid) {
+        _sg.frame_stats.num_rejected_draw_invalid++;
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    if (!_sg.bindings_valid) {
+        _sg.frame_stats.num_rejected_draw_invalid++;
+        _SG_TRACE_NOARGS(err_bindings_invalid);
+        return;
+    }
+    const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+    SOKOL_ASSERT(pip);
+    const bool indexed = (pip->cmn.index_type != SG_INDEXTYPE_NONE);
+    const int args_size = indexed ? (int)sizeof(sg_draw_indexed_indirect_args) : (int)sizeof(sg_draw_indirect_args);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (_sg_validate_draw_indirect(buf, offset, num_draws * args_size, indexed)) {
+        if (buf && (buf->slot.state == SG_RESOURCESTATE_VALID) && (num_draws > 0) &&
+            (SG_BUFFERTYPE_INDIRECTBUFFER == buf->cmn.type) &&
+            ((offset + num_draws * args_size) <= buf->cmn.size))
+        {
+            if (_sg.features.draw_indirect) {
+                _sg_draw_indirect(buf, offset, num_draws);
+            }
+            else {
+                /* emulate with regular draw calls from the CPU-side copy */
+                SOKOL_ASSERT(buf->cmn.shadow_ptr);
+                const uint8_t* ptr = (const uint8_t*)buf->cmn.shadow_ptr + offset;
+                for (int i = 0; i < num_draws; i++, ptr += args_size) {
+                    /* the first 3 items are identical in both layouts */
+                    const sg_draw_indirect_args* args = (const sg_draw_indirect_args*) ptr;
+                    const int base_vertex = indexed ? (int)((const sg_draw_indexed_indirect_args*)ptr)->base_vertex : 0;
+                    if ((args->num_elements > 0) && (args->num_instances > 0)) {
+                        _sg_draw((int)args->base_element, (int)args->num_elements, (int)args->num_instances, base_vertex);
+                        _sg.frame_stats.num_elements += args->num_elements;
+                        _sg.frame_stats.num_instances += args->num_instances;
+                    }
+                }
+            }
+            _sg.frame_stats.num_draw += (uint32_t)num_draws;
+        }
+    }
+    _SG_TRACE_ARGS(draw_indirect, buf_id, offset, num_draws);
+}
+
 SOKOL_API_IMPL void sg_end_pass(void) {
     SOKOL_ASSERT(_sg.valid);
     if (!_sg.pass_valid) {
+        _sg.frame_stats.num_rejected_pass_invalid++;
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
     _sg_end_pass();
+    _sg_end_gpu_timing();
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.cur_pipeline.id = SG_INVALID_ID;
     _sg.pass_valid = false;
+    _sg_filter_reset();
     _SG_TRACE_NOARGS(end_pass);
 }
 
@@ -13932,12 +20285,163 @@ SOKOL_API_IMPL void sg_commit(void) {
     SOKOL_ASSERT(_sg.valid);
     _sg_commit();
     _SG_TRACE_NOARGS(commit);
+    _sg.frame_stats.frame_index = _sg.frame_index;
+    _sg.prev_frame_stats = _sg.frame_stats;
+    memset(&_sg.frame_stats, 0, sizeof(_sg.frame_stats));
     _sg.frame_index++;
 }
 
+SOKOL_API_IMPL void sg_begin_commands(sg_commands* cmds, void* ptr, int size) {
+    SOKOL_ASSERT(cmds && ptr && (size > 0));
+    /* all recorded commands are 4-byte aligned */
+    SOKOL_ASSERT(((uintptr_t)ptr & 3) == 0);
+    memset(cmds, 0, sizeof(sg_commands));
+    cmds->ptr = (uint8_t*) ptr;
+    cmds->size = size;
+    cmds->recording = true;
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_viewport(sg_commands* cmds, int x, int y, int width, int height, bool origin_top_left) {
+    _sg_cmd_rect(cmds, _SG_CMD_APPLY_VIEWPORT, x, y, width, height, origin_top_left);
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_scissor_rect(sg_commands* cmds, int x, int y, int width, int height, bool origin_top_left) {
+    _sg_cmd_rect(cmds, _SG_CMD_APPLY_SCISSOR_RECT, x, y, width, height, origin_top_left);
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_pipeline(sg_commands* cmds, sg_pipeline pip) {
+    _sg_cmd_apply_pipeline_t* cmd = (_sg_cmd_apply_pipeline_t*) _sg_cmd_alloc(cmds, _SG_CMD_APPLY_PIPELINE, sizeof(_sg_cmd_apply_pipeline_t));
+    if (cmd) {
+        cmd->pip_id = pip.id;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_bindings(sg_commands* cmds, const sg_bindings* bindings) {
+    SOKOL_ASSERT(bindings);
+    SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
+    const int num_vbs = _sg_cmd_num_buffers(bindings->vertex_buffers, SG_MAX_SHADERSTAGE_BUFFERS);
+    const int has_ib = (bindings->index_buffer.id != SG_INVALID_ID) ? 1 : 0;
+    const int num_vs_imgs = _sg_cmd_num_images(bindings->vs_images, SG_MAX_SHADERSTAGE_IMAGES);
+    const int num_fs_imgs = _sg_cmd_num_images(bindings->fs_images, SG_MAX_SHADERSTAGE_IMAGES);
+    const int num_items = 2 * num_vbs + 2 * has_ib + num_vs_imgs + num_fs_imgs;
+    const int num_bytes = (int)sizeof(_sg_cmd_apply_bindings_t) + num_items * (int)sizeof(uint32_t);
+    _sg_cmd_apply_bindings_t* cmd = (_sg_cmd_apply_bindings_t*) _sg_cmd_alloc(cmds, _SG_CMD_APPLY_BINDINGS, num_bytes);
+    if (cmd) {
+        cmd->num_vbs = (uint8_t) num_vbs;
+        cmd->has_ib = (uint8_t) has_ib;
+        cmd->num_vs_imgs = (uint8_t) num_vs_imgs;
+        cmd->num_fs_imgs = (uint8_t) num_fs_imgs;
+        uint32_t* dst = (uint32_t*) (cmd + 1);
+        for (int i = 0; i < num_vbs; i++) {
+            *dst++ = bindings->vertex_buffers[i].id;
+        }
+        for (int i = 0; i < num_vbs; i++) {
+            *dst++ = (uint32_t) bindings->vertex_buffer_offsets[i];
+        }
+        if (has_ib) {
+            *dst++ = bindings->index_buffer.id;
+            *dst++ = (uint32_t) bindings->index_buffer_offset;
+        }
+        for (int i = 0; i < num_vs_imgs; i++) {
+            *dst++ = bindings->vs_images[i].id;
+        }
+        for (int i = 0; i < num_fs_imgs; i++) {
+            *dst++ = bindings->fs_images[i].id;
+        }
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_uniforms(sg_commands* cmds, sg_shader_stage stage, int ub_index, const void* data, int num_bytes) {
+    SOKOL_ASSERT((stage == SG_SHADERSTAGE_VS) || (stage == SG_SHADERSTAGE_FS));
+    SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
+    SOKOL_ASSERT(data && (num_bytes > 0));
+    const int cmd_size = (int)sizeof(_sg_cmd_apply_uniforms_t) + num_bytes;
+    _sg_cmd_apply_uniforms_t* cmd = (_sg_cmd_apply_uniforms_t*) _sg_cmd_alloc(cmds, _SG_CMD_APPLY_UNIFORMS, cmd_size);
+    if (cmd) {
+        cmd->stage = (uint32_t) stage;
+        cmd->ub_index = ub_index;
+        cmd->num_bytes = num_bytes;
+        memcpy(cmd + 1, data, (size_t)num_bytes);
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_draw(sg_commands* cmds, int base_element, int num_elements, int num_instances) {
+    _sg_cmd_draw_t* cmd = (_sg_cmd_draw_t*) _sg_cmd_alloc(cmds, _SG_CMD_DRAW, sizeof(_sg_cmd_draw_t));
+    if (cmd) {
+        cmd->base_element = base_element;
+        cmd->num_elements = num_elements;
+        cmd->num_instances = num_instances;
+    }
+}
+
+SOKOL_API_IMPL bool sg_end_commands(sg_commands* cmds) {
+    SOKOL_ASSERT(cmds && cmds->recording);
+    cmds->recording = false;
+    return !cmds->overflow;
+}
+
+SOKOL_API_IMPL void sg_submit_commands(const sg_commands* cmds) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(cmds);
+    if (cmds->recording) {
+        SOKOL_LOG("sg_submit_commands: command list is still recording (missing sg_end_commands()?)");
+        return;
+    }
+    if (cmds->overflow) {
+        SOKOL_LOG("sg_submit_commands: command list has overflown, skipping");
+        return;
+    }
+    int pos = 0;
+    while (pos < cmds->pos) {
+        const _sg_cmd_header_t* hdr = (const _sg_cmd_header_t*) (cmds->ptr + pos);
+        SOKOL_ASSERT((hdr->size >= sizeof(_sg_cmd_header_t)) && ((pos + (int)hdr->size) <= cmds->pos));
+        switch (hdr->type) {
+            case _SG_CMD_APPLY_VIEWPORT:
+                {
+                    const _sg_cmd_rect_t* cmd = (const _sg_cmd_rect_t*) hdr;
+                    sg_apply_viewport(cmd->x, cmd->y, cmd->w, cmd->h, 0 != cmd->origin_top_left);
+                }
+                break;
+            case _SG_CMD_APPLY_SCISSOR_RECT:
+                {
+                    const _sg_cmd_rect_t* cmd = (const _sg_cmd_rect_t*) hdr;
+                    sg_apply_scissor_rect(cmd->x, cmd->y, cmd->w, cmd->h, 0 != cmd->origin_top_left);
+                }
+                break;
+            case _SG_CMD_APPLY_PIPELINE:
+                {
+                    const _sg_cmd_apply_pipeline_t* cmd = (const _sg_cmd_apply_pipeline_t*) hdr;
+                    sg_pipeline pip = { cmd->pip_id };
+                    sg_apply_pipeline(pip);
+                }
+                break;
+            case _SG_CMD_APPLY_BINDINGS:
+                _sg_cmd_submit_bindings((const _sg_cmd_apply_bindings_t*) hdr);
+                break;
+            case _SG_CMD_APPLY_UNIFORMS:
+                {
+                    const _sg_cmd_apply_uniforms_t* cmd = (const _sg_cmd_apply_uniforms_t*) hdr;
+                    sg_apply_uniforms((sg_shader_stage)cmd->stage, cmd->ub_index, cmd + 1, cmd->num_bytes);
+                }
+                break;
+            case _SG_CMD_DRAW:
+                {
+                    const _sg_cmd_draw_t* cmd = (const _sg_cmd_draw_t*) hdr;
+                    sg_draw(cmd->base_element, cmd->num_elements, cmd->num_instances);
+                }
+                break;
+            default:
+                SOKOL_UNREACHABLE;
+                break;
+        }
+        pos += (int)hdr->size;
+    }
+}
+
 SOKOL_API_IMPL void sg_reset_state_cache(void) {
     SOKOL_ASSERT(_sg.valid);
     _sg_reset_state_cache();
+    _sg_filter_reset();
     _SG_TRACE_NOARGS(reset_state_cache);
 }
 
@@ -13951,8 +20455,17 @@ SOKOL_API_IMPL void sg_update_buffer(sg_buffer buf_id, const void* data, int num
             SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
             /* update and append on same buffer in same frame not allowed */
             SOKOL_ASSERT(buf->cmn.append_frame_index != _sg.frame_index);
-            _sg_update_buffer(buf, data, (uint32_t)num_bytes);
+            if (_sg_buffer_common_cpu_indirect(&buf->cmn)) {
+                memcpy(buf->cmn.shadow_ptr, data, (size_t)num_bytes);
+            }
+            else {
+                _sg_update_buffer(buf, data, (uint32_t)num_bytes);
+            }
             buf->cmn.update_frame_index = _sg.frame_index;
+            _sg_sync_buffer_hot(&_sg.pools, _sg_slot_index(buf_id.id));
+            _sg.filter.bindings_valid = false;
+            _sg.frame_stats.num_update_buffer++;
+            _sg.frame_stats.size_update_buffer += (uint32_t)num_bytes;
         }
     }
     _SG_TRACE_ARGS(update_buffer, buf_id, data, num_bytes);
@@ -13963,6 +20476,8 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const void* data, int num_
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
     int result;
     if (buf) {
+        /* appending may switch the active buffer slot or set the overflow flag */
+        _sg.filter.bindings_valid = false;
         /* rewind append cursor in a new frame */
         if (buf->cmn.append_frame_index != _sg.frame_index) {
             buf->cmn.append_pos = 0;
@@ -13977,12 +20492,22 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const void* data, int num_
                 if (!buf->cmn.append_overflow && (num_bytes > 0)) {
                     /* update and append on same buffer in same frame not allowed */
                     SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
-                    uint32_t copied_num_bytes = _sg_append_buffer(buf, data, (uint32_t)num_bytes, buf->cmn.append_frame_index != _sg.frame_index);
+                    uint32_t copied_num_bytes;
+                    if (_sg_buffer_common_cpu_indirect(&buf->cmn)) {
+                        memcpy((uint8_t*)buf->cmn.shadow_ptr + buf->cmn.append_pos, data, (size_t)num_bytes);
+                        copied_num_bytes = (uint32_t)_sg_roundup(num_bytes, 4);
+                    }
+                    else {
+                        copied_num_bytes = _sg_append_buffer(buf, data, (uint32_t)num_bytes, buf->cmn.append_frame_index != _sg.frame_index);
+                    }
                     buf->cmn.append_pos += copied_num_bytes;
                     buf->cmn.append_frame_index = _sg.frame_index;
+                    _sg.frame_stats.num_append_buffer++;
+                    _sg.frame_stats.size_append_buffer += copied_num_bytes;
                 }
             }
         }
+        _sg_sync_buffer_hot(&_sg.pools, _sg_slot_index(buf_id.id));
         result = start_pos;
     }
     else {
@@ -13993,6 +20518,58 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const void* data, int num_
     return result;
 }
 
+SOKOL_API_IMPL void* sg_map_buffer(sg_buffer buf_id, int num_bytes) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    void* result = 0;
+    if ((num_bytes > 0) && buf && (buf->slot.state == SG_RESOURCESTATE_VALID)) {
+        if (_sg_validate_map_buffer(buf, num_bytes) && (0 == buf->cmn.map_ptr)) {
+            SOKOL_ASSERT(num_bytes <= buf->cmn.size);
+            /* mapping counts as the one update allowed per buffer and frame */
+            SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
+            SOKOL_ASSERT(buf->cmn.append_frame_index != _sg.frame_index);
+            if (!_sg_buffer_common_cpu_indirect(&buf->cmn)) {
+                result = _sg_map_buffer(buf);
+            }
+            if (0 == result) {
+                /* backend can't map the buffer, write into a shadow copy instead */
+                if (0 == buf->cmn.shadow_ptr) {
+                    buf->cmn.shadow_ptr = SOKOL_MALLOC((size_t)buf->cmn.size);
+                    SOKOL_ASSERT(buf->cmn.shadow_ptr);
+                }
+                result = buf->cmn.shadow_ptr;
+            }
+            buf->cmn.map_ptr = result;
+            buf->cmn.map_size = num_bytes;
+            buf->cmn.update_frame_index = _sg.frame_index;
+            _sg_sync_buffer_hot(&_sg.pools, _sg_slot_index(buf_id.id));
+            _sg.filter.bindings_valid = false;
+            _sg.frame_stats.num_update_buffer++;
+            _sg.frame_stats.size_update_buffer += (uint32_t)num_bytes;
+        }
+    }
+    _SG_TRACE_ARGS(map_buffer, buf_id, num_bytes, result);
+    return result;
+}
+
+SOKOL_API_IMPL void sg_unmap_buffer(sg_buffer buf_id) {
+    SOKOL_ASSERT(_sg.valid);
+    /* trace hooks are called before unmapping so that they can still read the mapped data */
+    _SG_TRACE_ARGS(unmap_buffer, buf_id);
+    _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
+    if (buf && (buf->slot.state == SG_RESOURCESTATE_VALID)) {
+        if (_sg_validate_unmap_buffer(buf) && buf->cmn.map_ptr) {
+            if (!_sg_buffer_common_cpu_indirect(&buf->cmn)) {
+                const void* shadow_ptr = (buf->cmn.map_ptr == buf->cmn.shadow_ptr) ? buf->cmn.shadow_ptr : 0;
+                _sg_unmap_buffer(buf, shadow_ptr, (uint32_t)buf->cmn.map_size);
+            }
+            buf->cmn.map_ptr = 0;
+            buf->cmn.map_size = 0;
+            _sg_sync_buffer_hot(&_sg.pools, _sg_slot_index(buf_id.id));
+        }
+    }
+}
+
 SOKOL_API_IMPL bool sg_query_buffer_overflow(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
     _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, buf_id.id);
@@ -14008,19 +20585,67 @@ SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_content* dat
             SOKOL_ASSERT(img->cmn.upd_frame_index != _sg.frame_index);
             _sg_update_image(img, data);
             img->cmn.upd_frame_index = _sg.frame_index;
+            _sg_sync_image_hot(&_sg.pools, _sg_slot_index(img_id.id));
+            _sg.filter.bindings_valid = false;
+            _sg.frame_stats.num_update_image++;
+            for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+                for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+                    _sg.frame_stats.size_update_image += (uint32_t)data->subimage[face_index][mip_index].size;
+                }
+            }
         }
     }
     _SG_TRACE_ARGS(update_image, img_id, data);
 }
 
+SOKOL_API_IMPL void sg_update_image_region(sg_image img_id, const sg_image_region* region, const void* data_ptr, int data_size) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(region);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
+        if (_sg_validate_update_image_region(img, region, data_ptr, data_size)) {
+            if (_sg.features.image_region_update && data_ptr && (data_size > 0)) {
+                _sg_update_image_region(img, region, data_ptr, data_size);
+                _sg.frame_stats.num_update_image++;
+                _sg.frame_stats.size_update_image += (uint32_t)data_size;
+            }
+        }
+    }
+    _SG_TRACE_ARGS(update_image_region, img_id, region, data_ptr, data_size);
+}
+
+SOKOL_API_IMPL bool sg_read_pixels_async(const sg_read_pixels_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(desc);
+    bool result = false;
+    _sg_image_t* img = 0;
+    if (desc->image.id != SG_INVALID_ID) {
+        img = _sg_lookup_image(&_sg.pools, desc->image.id);
+        if (img && (img->slot.state != SG_RESOURCESTATE_VALID)) {
+            img = 0;
+        }
+    }
+    if (_sg_validate_read_pixels(img, desc)) {
+        const bool src_valid = img || (desc->image.id == SG_INVALID_ID);
+        if (_sg.features.read_pixels && !_sg.pass_valid && src_valid && desc->callback && (desc->width > 0) && (desc->height > 0)) {
+            result = _sg_read_pixels(img, desc);
+        }
+    }
+    _SG_TRACE_ARGS(read_pixels_async, desc, result);
+    return result;
+}
+
 SOKOL_API_IMPL void sg_push_debug_group(const char* name) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(name);
+    sg_pass inv_pass = { SG_INVALID_ID };
+    _sg_begin_gpu_timing(name, false, inv_pass);
     _SG_TRACE_ARGS(push_debug_group, name);
 }
 
 SOKOL_API_IMPL void sg_pop_debug_group(void) {
     SOKOL_ASSERT(_sg.valid);
+    _sg_end_gpu_timing();
     _SG_TRACE_NOARGS(pop_debug_group);
 }
 
@@ -14132,6 +20757,78 @@ SOKOL_API_IMPL sg_pass_desc sg_query_pass_defaults(const sg_pass_desc* desc) {
     return _sg_pass_desc_defaults(desc);
 }
 
+/* floor of a texel coordinate, clamped to a range where wrapping is still exact */
+_SOKOL_PRIVATE int _sg_soft_texel_floor(float v) {
+    v = (v < -16777216.0f) ? -16777216.0f : ((v > 16777216.0f) ? 16777216.0f : v);
+    const int i = (int)v;
+    return (v < (float)i) ? (i - 1) : i;
+}
+
+/* returns the wrapped texel coordinate, or -1 for the border color */
+_SOKOL_PRIVATE int _sg_soft_texel_wrap(int i, int size, sg_wrap wrap) {
+    switch (wrap) {
+        case SG_WRAP_CLAMP_TO_EDGE:
+            return (i < 0) ? 0 : ((i >= size) ? (size - 1) : i);
+        case SG_WRAP_CLAMP_TO_BORDER:
+            return ((i < 0) || (i >= size)) ? -1 : i;
+        case SG_WRAP_MIRRORED_REPEAT:
+            {
+                int m = i % (2 * size);
+                m = (m < 0) ? (m + 2 * size) : m;
+                return (m < size) ? m : (2 * size - 1 - m);
+            }
+        default:
+            {
+                const int m = i % size;
+                return (m < 0) ? (m + size) : m;
+            }
+    }
+}
+
+_SOKOL_PRIVATE void _sg_soft_texel(const sg_soft_texture* tex, int x, int y, float* out_rgba) {
+    x = _sg_soft_texel_wrap(x, tex->width, tex->wrap_u);
+    y = _sg_soft_texel_wrap(y, tex->height, tex->wrap_v);
+    if ((x < 0) || (y < 0)) {
+        memcpy(out_rgba, tex->border_color, 4 * sizeof(float));
+    }
+    else {
+        const uint8_t* p = tex->pixels + (y * tex->width + x) * 4;
+        for (int i = 0; i < 4; i++) {
+            out_rgba[i] = (float)p[i] / 255.0f;
+        }
+    }
+}
+
+SOKOL_API_IMPL void sg_soft_sample(const sg_soft_texture* tex, float u, float v, float* out_rgba) {
+    SOKOL_ASSERT(out_rgba);
+    if ((0 == tex) || (0 == tex->pixels)) {
+        out_rgba[0] = out_rgba[1] = out_rgba[2] = 0.0f;
+        out_rgba[3] = 1.0f;
+        return;
+    }
+    /* texel centers are at +0.5, v=0 is the top row */
+    const float fx = u * (float)tex->width;
+    const float fy = v * (float)tex->height;
+    if (SG_FILTER_LINEAR != tex->filter) {
+        _sg_soft_texel(tex, _sg_soft_texel_floor(fx), _sg_soft_texel_floor(fy), out_rgba);
+        return;
+    }
+    const int x0 = _sg_soft_texel_floor(fx - 0.5f);
+    const int y0 = _sg_soft_texel_floor(fy - 0.5f);
+    const float tx = (fx - 0.5f) - (float)x0;
+    const float ty = (fy - 0.5f) - (float)y0;
+    float t00[4], t10[4], t01[4], t11[4];
+    _sg_soft_texel(tex, x0, y0, t00);
+    _sg_soft_texel(tex, x0 + 1, y0, t10);
+    _sg_soft_texel(tex, x0, y0 + 1, t01);
+    _sg_soft_texel(tex, x0 + 1, y0 + 1, t11);
+    for (int i = 0; i < 4; i++) {
+        const float top = t00[i] + tx * (t10[i] - t00[i]);
+        const float bottom = t01[i] + tx * (t11[i] - t01[i]);
+        out_rgba[i] = top + ty * (bottom - top);
+    }
+}
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
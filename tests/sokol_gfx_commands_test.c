@@ -0,0 +1,251 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_commands_test.c
+//
+//  Records the same frame once through the regular sokol_gfx functions,
+//  and once into a command list which is replayed with sg_submit_commands(),
+//  and checks that both produce the same stream of trace hook calls.
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#define SOKOL_TRACE_HOOKS
+#include "sokol_gfx.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+static int num_failed;
+#define T(expr) if (!(expr)) { printf("%s(%d): FAILED: %s\n", __FILE__, __LINE__, #expr); num_failed++; }
+
+/* the trace hook calls of one frame, written as text lines */
+static struct {
+    char buf[4096];
+    int pos;
+} trace_log;
+
+static void log_printf(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    const int space = (int)sizeof(trace_log.buf) - trace_log.pos;
+    const int n = vsnprintf(trace_log.buf + trace_log.pos, (size_t)space, fmt, args);
+    va_end(args);
+    T((n >= 0) && (n < space));
+    if ((n >= 0) && (n < space)) {
+        trace_log.pos += n;
+    }
+}
+
+static void reset_log(void) {
+    trace_log.pos = 0;
+    trace_log.buf[0] = 0;
+}
+
+static void trace_apply_viewport(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    (void)user_data;
+    log_printf("apply_viewport %d %d %d %d %d\n", x, y, width, height, origin_top_left);
+}
+
+static void trace_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    (void)user_data;
+    log_printf("apply_scissor_rect %d %d %d %d %d\n", x, y, width, height, origin_top_left);
+}
+
+static void trace_apply_pipeline(sg_pipeline pip, void* user_data) {
+    (void)user_data;
+    log_printf("apply_pipeline %x\n", pip.id);
+}
+
+static void trace_apply_bindings(const sg_bindings* bnd, void* user_data) {
+    (void)user_data;
+    log_printf("apply_bindings");
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        log_printf(" vb%d=%x/%d", i, bnd->vertex_buffers[i].id, bnd->vertex_buffer_offsets[i]);
+    }
+    log_printf(" ib=%x/%d", bnd->index_buffer.id, bnd->index_buffer_offset);
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        log_printf(" vs_img%d=%x fs_img%d=%x", i, bnd->vs_images[i].id, i, bnd->fs_images[i].id);
+    }
+    log_printf("\n");
+}
+
+static void trace_apply_uniforms(sg_shader_stage stage, int ub_index, const void* data, int num_bytes, void* user_data) {
+    (void)user_data;
+    log_printf("apply_uniforms %d %d %d", stage, ub_index, num_bytes);
+    for (int i = 0; i < num_bytes; i++) {
+        log_printf(" %02x", ((const uint8_t*)data)[i]);
+    }
+    log_printf("\n");
+}
+
+static void trace_draw(int base_element, int num_elements, int num_instances, void* user_data) {
+    (void)user_data;
+    log_printf("draw %d %d %d\n", base_element, num_elements, num_instances);
+}
+
+static void trace_err_draw_invalid(void* user_data) {
+    (void)user_data;
+    log_printf("err_draw_invalid\n");
+}
+
+static void trace_err_bindings_invalid(void* user_data) {
+    (void)user_data;
+    log_printf("err_bindings_invalid\n");
+}
+
+typedef struct {
+    sg_pipeline pip[2];
+    sg_buffer vbuf;
+    sg_buffer ibuf;
+    sg_image img;
+} scene_t;
+
+static scene_t make_scene(void) {
+    scene_t scn;
+    float vertices[24] = { 0.0f };
+    sg_buffer_desc vbuf_desc = { .size = sizeof(vertices), .content = vertices };
+    scn.vbuf = sg_make_buffer(&vbuf_desc);
+    uint16_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+    sg_buffer_desc ibuf_desc = { .type = SG_BUFFERTYPE_INDEXBUFFER, .size = sizeof(indices), .content = indices };
+    scn.ibuf = sg_make_buffer(&ibuf_desc);
+    sg_image_desc img_desc = { .width = 4, .height = 4, .usage = SG_USAGE_DYNAMIC };
+    scn.img = sg_make_image(&img_desc);
+    sg_shader_desc shd_desc = {
+        .vs = { .source = "vs", .uniform_blocks[0].size = 16 },
+        .fs = { .source = "fs", .images[0].type = SG_IMAGETYPE_2D },
+    };
+    sg_shader shd = sg_make_shader(&shd_desc);
+    sg_pipeline_desc pip_desc = {
+        .shader = shd,
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+    };
+    scn.pip[0] = sg_make_pipeline(&pip_desc);
+    pip_desc.index_type = SG_INDEXTYPE_UINT16;
+    scn.pip[1] = sg_make_pipeline(&pip_desc);
+    return scn;
+}
+
+/* the reference frame, called directly */
+static void draw_direct(const scene_t* scn) {
+    sg_apply_viewport(1, 2, 300, 200, true);
+    sg_apply_scissor_rect(10, 20, 30, 40, false);
+    for (int i = 0; i < 4; i++) {
+        const bool indexed = (i & 1) != 0;
+        sg_apply_pipeline(scn->pip[indexed ? 1 : 0]);
+        sg_bindings bind = {
+            .vertex_buffers[0] = scn->vbuf,
+            .vertex_buffer_offsets[0] = 12 * i,
+            .index_buffer = indexed ? scn->ibuf : (sg_buffer){0},
+            .fs_images[0] = scn->img,
+        };
+        sg_apply_bindings(&bind);
+        const float params[4] = { (float)i, 1.0f, 2.0f, 3.5f };
+        sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, params, sizeof(params));
+        sg_draw(i, indexed ? 6 : 3, i + 1);
+    }
+}
+
+/* the same frame, recorded into a command list */
+static bool record_commands(sg_commands* cmds, const scene_t* scn) {
+    sg_cmd_apply_viewport(cmds, 1, 2, 300, 200, true);
+    sg_cmd_apply_scissor_rect(cmds, 10, 20, 30, 40, false);
+    for (int i = 0; i < 4; i++) {
+        const bool indexed = (i & 1) != 0;
+        sg_cmd_apply_pipeline(cmds, scn->pip[indexed ? 1 : 0]);
+        sg_bindings bind = {
+            .vertex_buffers[0] = scn->vbuf,
+            .vertex_buffer_offsets[0] = 12 * i,
+            .index_buffer = indexed ? scn->ibuf : (sg_buffer){0},
+            .fs_images[0] = scn->img,
+        };
+        sg_cmd_apply_bindings(cmds, &bind);
+        const float params[4] = { (float)i, 1.0f, 2.0f, 3.5f };
+        sg_cmd_apply_uniforms(cmds, SG_SHADERSTAGE_VS, 0, params, sizeof(params));
+        sg_cmd_draw(cmds, i, indexed ? 6 : 3, i + 1);
+    }
+    return sg_end_commands(cmds);
+}
+
+static void test_replay_matches_direct(void) {
+    sg_setup(&(sg_desc){0});
+    const scene_t scn = make_scene();
+    sg_install_trace_hooks(&(sg_trace_hooks){
+        .apply_viewport = trace_apply_viewport,
+        .apply_scissor_rect = trace_apply_scissor_rect,
+        .apply_pipeline = trace_apply_pipeline,
+        .apply_bindings = trace_apply_bindings,
+        .apply_uniforms = trace_apply_uniforms,
+        .draw = trace_draw,
+        .err_draw_invalid = trace_err_draw_invalid,
+        .err_bindings_invalid = trace_err_bindings_invalid,
+    });
+    const sg_pass_action pass_action = { 0 };
+
+    /* direct submission */
+    static char direct_log[sizeof(trace_log.buf)];
+    reset_log();
+    sg_begin_default_pass(&pass_action, 640, 480);
+    draw_direct(&scn);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats direct_stats = sg_query_frame_stats();
+    memcpy(direct_log, trace_log.buf, sizeof(direct_log));
+
+    /* recording must not call into sokol_gfx */
+    static uint32_t mem[512];
+    sg_commands cmds;
+    reset_log();
+    sg_begin_commands(&cmds, mem, sizeof(mem));
+    T(record_commands(&cmds, &scn));
+    T(trace_log.pos == 0);
+
+    /* replayed submission */
+    sg_begin_default_pass(&pass_action, 640, 480);
+    sg_submit_commands(&cmds);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats replay_stats = sg_query_frame_stats();
+
+    T(direct_log[0] != 0);
+    T(0 == strcmp(direct_log, trace_log.buf));
+    T(direct_stats.num_draw == 4);
+    T(replay_stats.num_draw == direct_stats.num_draw);
+    T(replay_stats.num_elements == direct_stats.num_elements);
+    T(replay_stats.num_rejected_draw_invalid == 0);
+
+    /* a command list can be submitted more than once */
+    reset_log();
+    sg_begin_default_pass(&pass_action, 640, 480);
+    sg_submit_commands(&cmds);
+    sg_end_pass();
+    sg_commit();
+    T(0 == strcmp(direct_log, trace_log.buf));
+    sg_shutdown();
+}
+
+static void test_overflow(void) {
+    sg_setup(&(sg_desc){0});
+    const scene_t scn = make_scene();
+    sg_install_trace_hooks(&(sg_trace_hooks){ .draw = trace_draw });
+    static uint32_t mem[16];
+    sg_commands cmds;
+    sg_begin_commands(&cmds, mem, sizeof(mem));
+    T(!record_commands(&cmds, &scn));
+
+    /* an overflown command list is skipped as a whole */
+    reset_log();
+    sg_begin_default_pass(&(sg_pass_action){0}, 640, 480);
+    sg_submit_commands(&cmds);
+    sg_end_pass();
+    sg_commit();
+    T(trace_log.pos == 0);
+    sg_shutdown();
+}
+
+int main(void) {
+    test_replay_matches_direct();
+    test_overflow();
+    if (num_failed > 0) {
+        printf("%d checks failed\n", num_failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_dummy_test.c
+//
+//  Checks the state transition counters and the command log of the dummy
+//  backend (sg_query_dummy_stats() and sg_query_dummy_log()) for a fixed
+//  scene: resource creation, one frame and resource destruction.
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#include "sokol_gfx.h"
+#include <stdio.h>
+#include <string.h>
+
+static int num_failed;
+#define T(expr) if (!(expr)) { printf("%s(%d): FAILED: %s\n", __FILE__, __LINE__, #expr); num_failed++; }
+
+typedef struct {
+    sg_buffer vbuf;
+    sg_buffer ibuf;
+    sg_image tex;
+    sg_image dyn_img;
+    sg_shader shd;
+    sg_pipeline pip;
+} scene_t;
+
+static scene_t make_scene(void) {
+    scene_t scn;
+    const float vertices[12] = { 0.0f };
+    scn.vbuf = sg_make_buffer(&(sg_buffer_desc){ .size = sizeof(vertices), .content = vertices });
+    const uint16_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+    scn.ibuf = sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_INDEXBUFFER, .size = sizeof(indices), .content = indices });
+    const uint32_t pixels[16] = { 0 };
+    scn.tex = sg_make_image(&(sg_image_desc){
+        .width = 4,
+        .height = 4,
+        .content.subimage[0][0] = { .ptr = pixels, .size = sizeof(pixels) },
+    });
+    scn.dyn_img = sg_make_image(&(sg_image_desc){ .width = 4, .height = 4, .usage = SG_USAGE_DYNAMIC });
+    scn.shd = sg_make_shader(&(sg_shader_desc){
+        .vs = { .source = "vs", .uniform_blocks[0].size = 16 },
+        .fs = { .source = "fs", .images[0].type = SG_IMAGETYPE_2D, .images[1].type = SG_IMAGETYPE_2D },
+    });
+    scn.pip = sg_make_pipeline(&(sg_pipeline_desc){
+        .shader = scn.shd,
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .index_type = SG_INDEXTYPE_UINT16,
+    });
+    return scn;
+}
+
+static void test_create(void) {
+    sg_setup(&(sg_desc){ .dummy_log_size = 4096 });
+    make_scene();
+
+    /* the content of immutable resources is uploaded on creation */
+    const sg_dummy_stats stats = sg_query_dummy_stats();
+    T(stats.num_buffer_uploads == 2);
+    T(stats.size_buffer_uploads == 48 + 12);
+    T(stats.num_image_uploads == 1);
+    T(stats.size_image_uploads == 64);
+    T(0 == strcmp(sg_query_dummy_log(),
+        "make_buffer buf=1 size=48\n"
+        "make_buffer buf=2 size=12\n"
+        "make_image img=1 size=64\n"
+        "make_image img=2 size=0\n"
+        "make_shader shd=1\n"
+        "make_pipeline pip=1\n"));
+    sg_shutdown();
+}
+
+static void test_frame(void) {
+    sg_setup(&(sg_desc){ .dummy_log_size = 4096 });
+    const scene_t scn = make_scene();
+    sg_reset_dummy_stats();
+
+    const uint32_t pixels[16] = { 0 };
+    sg_image_content content = { 0 };
+    content.subimage[0][0] = (sg_subimage_content){ .ptr = pixels, .size = sizeof(pixels) };
+    sg_update_image(scn.dyn_img, &content);
+    sg_begin_default_pass(&(sg_pass_action){0}, 64, 32);
+    sg_apply_pipeline(scn.pip);
+    const sg_bindings bnd = {
+        .vertex_buffers[0] = scn.vbuf,
+        .index_buffer = scn.ibuf,
+        .fs_images = { scn.tex, scn.dyn_img },
+    };
+    const float params[4] = { 0.0f };
+    for (int i = 0; i < 2; i++) {
+        /* only the first iteration changes the bindings */
+        sg_apply_bindings(&bnd);
+        sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, params, sizeof(params));
+        sg_draw(0, 6, i + 1);
+    }
+    sg_end_pass();
+    sg_commit();
+
+    const sg_dummy_stats stats = sg_query_dummy_stats();
+    T(stats.num_passes == 1);
+    T(stats.num_render_target_switches == 1);
+    T(stats.num_pipeline_switches == 1);
+    T(stats.num_shader_switches == 1);
+    T(stats.num_render_state_changes == 1);
+    T(stats.num_vertex_buffer_binds == 1);
+    T(stats.num_index_buffer_binds == 1);
+    T(stats.num_texture_binds == 2);
+    T(stats.num_uniform_updates == 2);
+    T(stats.size_uniform_updates == 32);
+    T(stats.num_draws == 2);
+    T(stats.num_elements == 12);
+    T(stats.num_instances == 3);
+    T(stats.num_buffer_uploads == 0);
+    T(stats.num_image_uploads == 1);
+    T(stats.size_image_uploads == 64);
+    T(!stats.log_overflow);
+    T(0 == strcmp(sg_query_dummy_log(),
+        "update_image img=2 size=64\n"
+        "begin_pass pass=0 w=64 h=32 clears=2\n"
+        "pipeline pip=1\n"
+        "shader shd=1\n"
+        "render_state pip=1\n"
+        "vertex_buffer slot=0 buf=1 offset=0\n"
+        "index_buffer buf=2 offset=0\n"
+        "texture stage=fs slot=0 img=1\n"
+        "texture stage=fs slot=1 img=2\n"
+        "uniforms stage=vs ub=0 size=16\n"
+        "draw base=0 num=6 instances=1 base_vertex=0\n"
+        "uniforms stage=vs ub=0 size=16\n"
+        "draw base=0 num=6 instances=2 base_vertex=0\n"
+        "end_pass\n"
+        "commit\n"));
+    sg_shutdown();
+}
+
+static void test_destroy(void) {
+    sg_setup(&(sg_desc){ .dummy_log_size = 4096 });
+    const scene_t scn = make_scene();
+    sg_reset_dummy_stats();
+    sg_destroy_pipeline(scn.pip);
+    sg_destroy_shader(scn.shd);
+    sg_destroy_image(scn.dyn_img);
+    sg_destroy_image(scn.tex);
+    sg_destroy_buffer(scn.ibuf);
+    sg_destroy_buffer(scn.vbuf);
+    T(0 == strcmp(sg_query_dummy_log(),
+        "destroy_pipeline pip=1\n"
+        "destroy_shader shd=1\n"
+        "destroy_image img=2\n"
+        "destroy_image img=1\n"
+        "destroy_buffer buf=2\n"
+        "destroy_buffer buf=1\n"));
+
+    /* destroying an already destroyed resource is a no-op */
+    sg_reset_dummy_stats();
+    sg_destroy_buffer(scn.vbuf);
+    T(0 == strcmp(sg_query_dummy_log(), ""));
+    sg_shutdown();
+}
+
+int main(void) {
+    test_create();
+    test_frame();
+    test_destroy();
+    if (num_failed > 0) {
+        printf("%d checks failed\n", num_failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_map_test.c
+//
+//  Checks sg_map_buffer() / sg_unmap_buffer() on the dummy backend, with
+//  non-fatal validation so that rejected calls can be tested.
+//------------------------------------------------------------------------------
+#if !defined(SOKOL_DEBUG)
+#define SOKOL_DEBUG (1)
+#endif
+#define SOKOL_VALIDATE_NON_FATAL
+#define SOKOL_TRACE_HOOKS
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#include "sokol_gfx.h"
+#include <stdio.h>
+#include <string.h>
+
+static int num_failed;
+#define T(expr) if (!(expr)) { printf("%s(%d): FAILED: %s\n", __FILE__, __LINE__, #expr); num_failed++; }
+
+static void setup(void) {
+    sg_setup(&(sg_desc){ .dummy_log_size = 4096 });
+}
+
+static sg_buffer make_buffer(sg_buffer_type type) {
+    return sg_make_buffer(&(sg_buffer_desc){
+        .type = type,
+        .size = 64,
+        .usage = SG_USAGE_STREAM,
+    });
+}
+
+static sg_pipeline make_pipeline(void) {
+    sg_pipeline_desc desc = {
+        .shader = sg_make_shader(&(sg_shader_desc){ .vs.source = "vs", .fs.source = "fs" }),
+        .index_type = SG_INDEXTYPE_UINT16,
+    };
+    desc.layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT4;
+    return sg_make_pipeline(&desc);
+}
+
+static void test_map_unmap(void) {
+    setup();
+    sg_buffer buf = make_buffer(SG_BUFFERTYPE_VERTEXBUFFER);
+    sg_reset_dummy_stats();
+
+    /* map, write, unmap is one buffer update */
+    uint8_t* ptr = (uint8_t*) sg_map_buffer(buf, 32);
+    T(ptr != 0);
+    if (ptr) {
+        for (int i = 0; i < 32; i++) {
+            ptr[i] = (uint8_t)i;
+        }
+    }
+    sg_unmap_buffer(buf);
+    sg_dummy_stats stats = sg_query_dummy_stats();
+    T(stats.num_buffer_uploads == 1);
+    T(stats.size_buffer_uploads == 32);
+    T(0 == strcmp(sg_query_dummy_log(), "unmap_buffer buf=1 size=32\n"));
+
+    /* a second map in the same frame is rejected, mapped or not */
+    T(sg_map_buffer(buf, 16) == 0);
+    sg_commit();
+    sg_frame_stats frame_stats = sg_query_frame_stats();
+    T(frame_stats.num_update_buffer == 1);
+    T(frame_stats.size_update_buffer == 32);
+
+    /* mapping again in the next frame works, but only once */
+    T(sg_map_buffer(buf, 16) != 0);
+    T(sg_map_buffer(buf, 16) == 0);
+    sg_unmap_buffer(buf);
+    stats = sg_query_dummy_stats();
+    T(stats.num_buffer_uploads == 2);
+    T(stats.size_buffer_uploads == 48);
+
+    /* immutable buffers can't be mapped */
+    const float data[4] = { 0 };
+    sg_buffer imm_buf = sg_make_buffer(&(sg_buffer_desc){ .size = sizeof(data), .content = data });
+    T(sg_map_buffer(imm_buf, 16) == 0);
+    sg_shutdown();
+}
+
+static void test_bind_mapped(void) {
+    setup();
+    sg_buffer vbuf = make_buffer(SG_BUFFERTYPE_VERTEXBUFFER);
+    sg_buffer ibuf = make_buffer(SG_BUFFERTYPE_INDEXBUFFER);
+    sg_pipeline pip = make_pipeline();
+    sg_reset_dummy_stats();
+
+    /* a mapped vertex or index buffer can't be bound */
+    const sg_bindings bnd = { .vertex_buffers[0] = vbuf, .index_buffer = ibuf };
+    T(sg_map_buffer(vbuf, 64) != 0);
+    sg_begin_default_pass(&(sg_pass_action){0}, 64, 64);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&bnd);
+    T(_sg.validate_error == _SG_VALIDATE_ABND_VB_MAPPED);
+    sg_draw(0, 3, 1);
+    sg_unmap_buffer(vbuf);
+    T(sg_map_buffer(ibuf, 64) != 0);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&bnd);
+    T(_sg.validate_error == _SG_VALIDATE_ABND_IB_MAPPED);
+    sg_draw(0, 3, 1);
+    sg_dummy_stats stats = sg_query_dummy_stats();
+    T(stats.num_vertex_buffer_binds == 0);
+    T(stats.num_index_buffer_binds == 0);
+    T(stats.num_draws == 0);
+
+    /* once unmapped, they can be bound in the same frame */
+    sg_unmap_buffer(ibuf);
+    sg_apply_pipeline(pip);
+    sg_apply_bindings(&bnd);
+    T(_sg.validate_error == _SG_VALIDATE_SUCCESS);
+    sg_draw(0, 3, 1);
+    stats = sg_query_dummy_stats();
+    T(stats.num_vertex_buffer_binds == 1);
+    T(stats.num_index_buffer_binds == 1);
+    T(stats.num_draws == 1);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_stats frame_stats = sg_query_frame_stats();
+    T(frame_stats.num_draw == 1);
+    T(frame_stats.num_rejected_draw_invalid > 0);
+    sg_shutdown();
+}
+
+static struct {
+    void* map_ptr;
+    int map_size;
+    int num_unmaps;
+    bool unmap_while_mapped;
+    uint8_t data[64];
+} trace;
+
+static void trace_map_buffer(sg_buffer buf, int data_size, void* result, void* user_data) {
+    (void)buf; (void)user_data;
+    trace.map_ptr = result;
+    trace.map_size = data_size;
+}
+
+static void trace_unmap_buffer(sg_buffer buf, void* user_data) {
+    (void)user_data;
+    trace.num_unmaps++;
+    const _sg_buffer_t* b = _sg_lookup_buffer(&_sg.pools, buf.id);
+    trace.unmap_while_mapped = b && (b->cmn.map_ptr != 0) && (b->cmn.map_ptr == trace.map_ptr);
+    if (trace.map_ptr && (trace.map_size <= (int)sizeof(trace.data))) {
+        memcpy(trace.data, trace.map_ptr, (size_t)trace.map_size);
+    }
+}
+
+static void test_unmap_trace_hook(void) {
+    setup();
+    sg_install_trace_hooks(&(sg_trace_hooks){
+        .map_buffer = trace_map_buffer,
+        .unmap_buffer = trace_unmap_buffer,
+    });
+    sg_buffer buf = make_buffer(SG_BUFFERTYPE_VERTEXBUFFER);
+    uint8_t* ptr = (uint8_t*) sg_map_buffer(buf, 48);
+    T(ptr != 0);
+    T(trace.map_ptr == ptr);
+    T(trace.map_size == 48);
+    if (ptr) {
+        for (int i = 0; i < 48; i++) {
+            ptr[i] = (uint8_t)(0xA0 + i);
+        }
+    }
+    sg_unmap_buffer(buf);
+
+    /* the unmap hook is called while the written data is still mapped */
+    T(trace.num_unmaps == 1);
+    T(trace.unmap_while_mapped);
+    bool data_ok = true;
+    for (int i = 0; i < 48; i++) {
+        data_ok &= (trace.data[i] == (uint8_t)(0xA0 + i));
+    }
+    T(data_ok);
+    sg_shutdown();
+}
+
+int main(void) {
+    test_map_unmap();
+    test_bind_mapped();
+    test_unmap_trace_hook();
+    if (num_failed > 0) {
+        printf("%d checks failed\n", num_failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
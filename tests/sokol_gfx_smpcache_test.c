@@ -0,0 +1,282 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_smpcache_test.c
+//
+//  Drives the generic sampler cache (_sg_smpcache_*) directly, with
+//  made-up sampler handles and a destroy callback which records the
+//  destroyed handles.
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#include "sokol_gfx.h"
+#include <stdio.h>
+
+static int num_failed;
+#define T(expr) if (!(expr)) { printf("%s(%d): FAILED: %s\n", __FILE__, __LINE__, #expr); num_failed++; }
+
+static struct {
+    uintptr_t handles[64];
+    int num;
+} destroyed;
+
+static void destroy_sampler(uintptr_t sampler_handle) {
+    if (destroyed.num < 64) {
+        destroyed.handles[destroyed.num] = sampler_handle;
+    }
+    destroyed.num++;
+}
+
+static void reset_destroyed(void) {
+    destroyed.num = 0;
+}
+
+/* a distinct sampler key per k */
+static sg_image_desc key_desc(int k) {
+    return (sg_image_desc){
+        .min_filter = SG_FILTER_LINEAR,
+        .mag_filter = SG_FILTER_LINEAR,
+        .max_anisotropy = (uint32_t)(k + 1),
+    };
+}
+
+static uintptr_t key_handle(int k) {
+    return (uintptr_t)(1000 + k);
+}
+
+static int home_bucket(const _sg_sampler_cache_t* cache, int k) {
+    _sg_sampler_cache_item_t key;
+    const sg_image_desc desc = key_desc(k);
+    _sg_smpcache_init_key(&key, &desc);
+    return (int)(key.hash & (uint32_t)(cache->table_size - 1));
+}
+
+/* find the first key after 'start' which lands in hash table bucket 'bucket' */
+static int find_key_in_bucket(const _sg_sampler_cache_t* cache, int bucket, int start) {
+    for (int k = start; k < 100000; k++) {
+        if (home_bucket(cache, k) == bucket) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+static int add_key(_sg_sampler_cache_t* cache, int k) {
+    const sg_image_desc desc = key_desc(k);
+    return _sg_smpcache_add_item(cache, &desc, key_handle(k));
+}
+
+static int find_key(const _sg_sampler_cache_t* cache, int k) {
+    const sg_image_desc desc = key_desc(k);
+    return _sg_smpcache_find_item(cache, &desc);
+}
+
+/* every item is reachable through the hash table, and nothing else is in it */
+static bool table_consistent(const _sg_sampler_cache_t* cache) {
+    int num_used = 0;
+    for (int i = 0; i < cache->table_size; i++) {
+        if (cache->table[i] != -1) {
+            num_used++;
+        }
+    }
+    if (num_used != cache->num_items) {
+        return false;
+    }
+    for (int i = 0; i < cache->num_items; i++) {
+        const int mask = cache->table_size - 1;
+        int bucket = (int)(cache->items[i].hash & (uint32_t)mask);
+        while ((cache->table[bucket] != -1) && (cache->table[bucket] != i)) {
+            bucket = (bucket + 1) & mask;
+        }
+        if (cache->table[bucket] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_hit_miss(void) {
+    reset_destroyed();
+    _sg_sampler_cache_t cache;
+    _sg_smpcache_init(&cache, 4, destroy_sampler);
+    T(find_key(&cache, 0) == -1);
+    const int i0 = add_key(&cache, 0);
+    const int i1 = add_key(&cache, 1);
+    T(i0 != i1);
+    T(find_key(&cache, 0) == i0);
+    T(find_key(&cache, 1) == i1);
+    T(find_key(&cache, 2) == -1);
+    T(_sg_smpcache_sampler(&cache, i0) == key_handle(0));
+    T(_sg_smpcache_use_item(&cache, i1) == key_handle(1));
+
+    /* min_lod/max_lod are part of the key */
+    sg_image_desc desc = key_desc(0);
+    desc.max_lod = 4.0f;
+    T(_sg_smpcache_find_item(&cache, &desc) == -1);
+    T(table_consistent(&cache));
+
+    _sg_smpcache_discard(&cache);
+    T(destroyed.num == 2);
+}
+
+static void test_ref_count(void) {
+    reset_destroyed();
+    _sg_sampler_cache_t cache;
+    _sg_smpcache_init(&cache, 2, destroy_sampler);
+    const int i0 = add_key(&cache, 0);
+    _sg_smpcache_use_item(&cache, i0);
+    _sg_smpcache_use_item(&cache, i0);
+    T(cache.items[i0].ref_count == 2);
+    _sg_smpcache_release_item(&cache, i0);
+    T(cache.items[i0].ref_count == 1);
+    T(cache.lru_head == -1);
+    _sg_smpcache_release_item(&cache, i0);
+    T(cache.items[i0].ref_count == 0);
+    T((cache.lru_head == i0) && (cache.lru_tail == i0));
+
+    /* using an unreferenced item takes it off the LRU list again */
+    _sg_smpcache_use_item(&cache, i0);
+    T((cache.lru_head == -1) && (cache.lru_tail == -1));
+
+    /* a referenced item is never evicted */
+    const int i1 = add_key(&cache, 1);
+    _sg_smpcache_use_item(&cache, i1);
+    _sg_smpcache_release_item(&cache, i1);
+    const int i2 = add_key(&cache, 2);
+    T(i2 == i1);
+    T((destroyed.num == 1) && (destroyed.handles[0] == key_handle(1)));
+    T(find_key(&cache, 0) == i0);
+    T(find_key(&cache, 1) == -1);
+    T(table_consistent(&cache));
+    _sg_smpcache_discard(&cache);
+}
+
+static void test_lru_order(void) {
+    reset_destroyed();
+    _sg_sampler_cache_t cache;
+    _sg_smpcache_init(&cache, 4, destroy_sampler);
+    int idx[4];
+    for (int k = 0; k < 4; k++) {
+        idx[k] = add_key(&cache, k);
+        _sg_smpcache_use_item(&cache, idx[k]);
+    }
+    /* release in order 0, 1, 2, 3, then touch 1 again: LRU order is 0, 2, 3, 1 */
+    for (int k = 0; k < 4; k++) {
+        _sg_smpcache_release_item(&cache, idx[k]);
+    }
+    _sg_smpcache_use_item(&cache, idx[1]);
+    _sg_smpcache_release_item(&cache, idx[1]);
+
+    const int expected[4] = { 0, 2, 3, 1 };
+    for (int i = 0; i < 4; i++) {
+        const int k = 4 + i;
+        const int index = add_key(&cache, k);
+        _sg_smpcache_use_item(&cache, index);
+        T(index == idx[expected[i]]);
+        T(destroyed.num == (i + 1));
+        T(destroyed.handles[i] == key_handle(expected[i]));
+        T(find_key(&cache, expected[i]) == -1);
+        T(find_key(&cache, k) == index);
+    }
+    T(cache.capacity == 4);
+    T(table_consistent(&cache));
+    _sg_smpcache_discard(&cache);
+    T(destroyed.num == 8);
+}
+
+static void test_grow(void) {
+    reset_destroyed();
+    _sg_sampler_cache_t cache;
+    _sg_smpcache_init(&cache, 2, destroy_sampler);
+    int idx[5];
+    for (int k = 0; k < 5; k++) {
+        idx[k] = add_key(&cache, k);
+        _sg_smpcache_use_item(&cache, idx[k]);
+    }
+    T(cache.capacity == 8);
+    T(cache.num_items == 5);
+    T(destroyed.num == 0);
+    for (int k = 0; k < 5; k++) {
+        T(find_key(&cache, k) == idx[k]);
+        T(_sg_smpcache_sampler(&cache, idx[k]) == key_handle(k));
+        T(cache.items[idx[k]].ref_count == 1);
+    }
+    T(table_consistent(&cache));
+    _sg_smpcache_discard(&cache);
+    T(destroyed.num == 5);
+}
+
+static void test_backward_shift(void) {
+    reset_destroyed();
+    _sg_sampler_cache_t cache;
+    _sg_smpcache_init(&cache, 4, destroy_sampler);
+    T(cache.table_size == 8);
+
+    /* three keys colliding in the last bucket, so the probe sequence wraps
+       around, and one key whose home is the first bucket */
+    const int last = cache.table_size - 1;
+    const int ka = find_key_in_bucket(&cache, last, 0);
+    const int kb = find_key_in_bucket(&cache, last, ka + 1);
+    const int kc = find_key_in_bucket(&cache, last, kb + 1);
+    const int kd = find_key_in_bucket(&cache, 0, 0);
+    T((ka >= 0) && (kb >= 0) && (kc >= 0) && (kd >= 0));
+    const int ia = add_key(&cache, ka);
+    const int ib = add_key(&cache, kb);
+    const int ic = add_key(&cache, kc);
+    const int id = add_key(&cache, kd);
+    T(cache.table[last] == ia);
+    T(cache.table[0] == ib);
+    T(cache.table[1] == ic);
+    T(cache.table[2] == id);
+
+    /* make a, then b the eviction candidates, keep c and d referenced */
+    _sg_smpcache_use_item(&cache, ia);
+    _sg_smpcache_use_item(&cache, ib);
+    _sg_smpcache_use_item(&cache, ic);
+    _sg_smpcache_use_item(&cache, id);
+    _sg_smpcache_release_item(&cache, ia);
+    _sg_smpcache_release_item(&cache, ib);
+
+    /* evicting a shifts b, c and d back by one bucket */
+    const int ke = find_key_in_bucket(&cache, 4, 0);
+    T(ke >= 0);
+    T(add_key(&cache, ke) == ia);
+    T((destroyed.num == 1) && (destroyed.handles[0] == key_handle(ka)));
+    T(cache.table[last] == ib);
+    T(cache.table[0] == ic);
+    T(cache.table[1] == id);
+    T(cache.table[2] == -1);
+    T(find_key(&cache, ka) == -1);
+    T(find_key(&cache, kb) == ib);
+    T(find_key(&cache, kc) == ic);
+    T(find_key(&cache, kd) == id);
+    T(table_consistent(&cache));
+
+    /* evicting b moves c into its home bucket, d follows */
+    const int kf = find_key_in_bucket(&cache, 5, 0);
+    T(kf >= 0);
+    T(add_key(&cache, kf) == ib);
+    T((destroyed.num == 2) && (destroyed.handles[1] == key_handle(kb)));
+    T(cache.table[last] == ic);
+    T(cache.table[0] == id);
+    T(cache.table[1] == -1);
+    T(find_key(&cache, kc) == ic);
+    T(find_key(&cache, kd) == id);
+    T(find_key(&cache, ke) == ia);
+    T(find_key(&cache, kf) == ib);
+    T(table_consistent(&cache));
+    _sg_smpcache_discard(&cache);
+    T(destroyed.num == 6);
+}
+
+int main(void) {
+    test_hit_miss();
+    test_ref_count();
+    test_lru_order();
+    test_grow();
+    test_backward_shift();
+    if (num_failed > 0) {
+        printf("%d checks failed\n", num_failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_soft_test.c
+//
+//  Renders a small sokol_gl scene (triangles, lines, line strips and points)
+//  on the software backend with 1 and with 4 rasterizer threads, checks
+//  some of the line and point pixels, and that both results are identical.
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_GL_IMPL
+#define SOKOL_SOFT
+#include "sokol_gfx.h"
+#include "util/sokol_gl.h"
+#include <stdio.h>
+#include <string.h>
+
+static int num_failed;
+#define T(expr) if (!(expr)) { printf("%s(%d): FAILED: %s\n", __FILE__, __LINE__, #expr); num_failed++; }
+
+/* several 64x64 tiles in each direction */
+#define WIDTH (256)
+#define HEIGHT (256)
+
+static uint8_t pixels[2][WIDTH * HEIGHT * 4];
+static int cur_pixels;
+
+static uint32_t rand_state;
+static uint32_t xorshift32(void) {
+    uint32_t x = rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return rand_state = x;
+}
+
+static float rnd(float max) {
+    return (float)(xorshift32() & 0xFFFF) * max / 65536.0f;
+}
+
+static uint8_t rnd_color(void) {
+    return (uint8_t)(64 + (xorshift32() & 0x7F));
+}
+
+static void read_pixels_cb(const sg_read_pixels_result* res) {
+    if (res->size == sizeof(pixels[0])) {
+        memcpy(pixels[cur_pixels], res->ptr, sizeof(pixels[0]));
+    }
+}
+
+static bool all_pipelines_valid(sgl_pipeline pip) {
+    const _sgl_pipeline_t* p = _sgl_lookup_pipeline(pip.id);
+    bool valid = (0 != p);
+    for (int i = 0; valid && (i < SGL_NUM_PRIMITIVE_TYPES); i++) {
+        valid = (SG_RESOURCESTATE_VALID == sg_query_pipeline_state(p->pip[i]));
+    }
+    return valid;
+}
+
+static void render(int num_threads) {
+    sg_setup(&(sg_desc){ .soft_num_threads = num_threads });
+    sgl_setup(&(sgl_desc_t){0});
+    sg_image color_img = sg_make_image(&(sg_image_desc){
+        .render_target = true,
+        .width = WIDTH,
+        .height = HEIGHT,
+        .pixel_format = SG_PIXELFORMAT_RGBA8,
+    });
+    /* sokol_gl pipelines expect a depth-stencil buffer by default */
+    sg_image depth_img = sg_make_image(&(sg_image_desc){
+        .render_target = true,
+        .width = WIDTH,
+        .height = HEIGHT,
+        .pixel_format = SG_PIXELFORMAT_DEPTH_STENCIL,
+    });
+    sg_pass pass = sg_make_pass(&(sg_pass_desc){
+        .color_attachments[0].image = color_img,
+        .depth_stencil_attachment.image = depth_img,
+    });
+
+    /* points and lines are never culled, whatever the pipeline says */
+    sgl_pipeline cull_front_pip = sgl_make_pipeline(&(sg_pipeline_desc){ .rasterizer.cull_mode = SG_CULLMODE_FRONT });
+    sgl_pipeline cull_back_pip = sgl_make_pipeline(&(sg_pipeline_desc){ .rasterizer.cull_mode = SG_CULLMODE_BACK });
+    T(all_pipelines_valid(cull_front_pip));
+    T(all_pipelines_valid(cull_back_pip));
+
+    sgl_defaults();
+    sgl_ortho(0.0f, (float)WIDTH, (float)HEIGHT, 0.0f, -1.0f, 1.0f);
+
+    /* random overlapping primitives in the top half, where draw order matters */
+    rand_state = 0x12345678;
+    sgl_begin_triangles();
+    for (int i = 0; i < 3 * 64; i++) {
+        sgl_v2f_c3b(rnd(WIDTH), rnd(HEIGHT / 2), rnd_color(), rnd_color(), rnd_color());
+    }
+    sgl_end();
+    sgl_begin_lines();
+    for (int i = 0; i < 2 * 64; i++) {
+        sgl_v2f_c3b(rnd(WIDTH), rnd(HEIGHT / 2), rnd_color(), rnd_color(), rnd_color());
+    }
+    sgl_end();
+    sgl_begin_line_strip();
+    for (int i = 0; i < 32; i++) {
+        sgl_v2f_c3b(rnd(WIDTH), rnd(HEIGHT / 2), rnd_color(), rnd_color(), rnd_color());
+    }
+    sgl_end();
+    sgl_begin_points();
+    for (int i = 0; i < 256; i++) {
+        sgl_v2f_c3b(rnd(WIDTH), rnd(HEIGHT / 2), 255, 255, 255);
+    }
+    sgl_end();
+
+    /* checked primitives in the bottom half, crossing tile borders */
+    sgl_begin_lines();
+    sgl_v2f_c3b(8.0f, 160.5f, 0, 255, 0);
+    sgl_v2f_c3b(248.0f, 160.5f, 0, 255, 0);
+    sgl_v2f_c3b(200.5f, 140.0f, 0, 0, 255);
+    sgl_v2f_c3b(200.5f, 250.0f, 0, 0, 255);
+    sgl_end();
+    sgl_begin_line_strip();
+    sgl_v2f_c3b(16.0f, 240.0f, 255, 0, 0);
+    sgl_v2f_c3b(112.0f, 176.0f, 255, 0, 0);
+    sgl_v2f_c3b(176.0f, 240.0f, 255, 0, 0);
+    sgl_end();
+    sgl_load_pipeline(cull_front_pip);
+    sgl_begin_points();
+    sgl_v2f_c3b(20.5f, 200.5f, 255, 255, 255);
+    sgl_end();
+    sgl_load_pipeline(cull_back_pip);
+    sgl_begin_points();
+    sgl_v2f_c3b(70.5f, 130.5f, 255, 255, 255);
+    sgl_end();
+    T(sgl_error() == SGL_NO_ERROR);
+
+    sg_begin_pass(pass, &(sg_pass_action){
+        .colors[0] = { .action = SG_ACTION_CLEAR, .val = { 0.0f, 0.0f, 0.0f, 1.0f } }
+    });
+    sgl_draw();
+    sg_end_pass();
+    memset(pixels[cur_pixels], 0, sizeof(pixels[0]));
+    T(sg_read_pixels_async(&(sg_read_pixels_desc){
+        .image = color_img,
+        .width = WIDTH,
+        .height = HEIGHT,
+        .callback = read_pixels_cb,
+    }));
+    sg_commit();
+    sgl_shutdown();
+    sg_shutdown();
+}
+
+static uint32_t pixel(int x, int y) {
+    const uint8_t* p = &pixels[cur_pixels][(y * WIDTH + x) * 4];
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#define BLACK (0xFF000000)
+#define WHITE (0xFFFFFFFF)
+#define RED   (0xFF0000FF)
+#define GREEN (0xFF00FF00)
+#define BLUE  (0xFFFF0000)
+
+static void check_pixels(void) {
+    /* the horizontal line covers the pixel centers from x=8 to x=248, one row high */
+    bool hline_ok = (pixel(7, 160) == BLACK) && (pixel(248, 160) == BLACK);
+    for (int x = 8; x < 248; x++) {
+        /* the vertical line crosses at x=200 */
+        const uint32_t off_color = (x == 200) ? BLUE : BLACK;
+        hline_ok &= (pixel(x, 159) == off_color) && (pixel(x, 161) == off_color);
+        hline_ok &= (pixel(x, 160) == ((x == 200) ? BLUE : GREEN));
+    }
+    T(hline_ok);
+
+    /* same for the vertical line, which is drawn after the horizontal one */
+    bool vline_ok = (pixel(200, 139) == BLACK) && (pixel(200, 250) == BLACK);
+    for (int y = 140; y < 250; y++) {
+        vline_ok &= (pixel(200, y) == BLUE) && (pixel(201, y) == ((y == 160) ? GREEN : BLACK));
+    }
+    T(vline_ok);
+
+    /* the line strip covers one or two pixels per column (depending on the slope) */
+    bool strip_ok = true;
+    for (int x = 16; x < 176; x++) {
+        int num_red = 0;
+        for (int y = 170; y < 246; y++) {
+            num_red += (pixel(x, y) == RED) ? 1 : 0;
+        }
+        strip_ok &= (num_red >= 1) && (num_red <= 2);
+    }
+    T(strip_ok);
+
+    /* points are 1x1 pixel quads, with culling enabled in the pipelines */
+    T(pixel(20, 200) == WHITE);
+    T(pixel(70, 130) == WHITE);
+    int num_white = 0;
+    for (int y = 129; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            num_white += (pixel(x, y) == WHITE) ? 1 : 0;
+        }
+    }
+    T(num_white == 2);
+}
+
+int main(void) {
+    cur_pixels = 0;
+    render(1);
+    check_pixels();
+    cur_pixels = 1;
+    render(4);
+    check_pixels();
+    T(0 == memcmp(pixels[0], pixels[1], sizeof(pixels[0])));
+    if (num_failed > 0) {
+        printf("%d checks failed\n", num_failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_trace_replay.c
+//
+//  Replays a trace captured with util/sokol_gfx_trace.h on the dummy
+//  backend and measures the CPU time of the replay.
+//
+//  Usage: sokol_gfx_trace_replay trace_file [num_loops]
+//
+//  The trace must have been captured by an executable compiled with the
+//  same sokol_gfx.h and SOKOL_POOL_SLOT_BITS, and with pool sizes which
+//  are not bigger than the defaults used here.
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#include "sokol_gfx.h"
+#include "sokol_time.h"
+#define SOKOL_GFX_TRACE_IMPL
+#include "util/sokol_gfx_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char* argv[]) {
+    const int num_loops = (argc > 2) ? atoi(argv[2]) : 1;
+    if ((argc < 2) || (num_loops < 1)) {
+        printf("usage: %s trace_file [num_loops]\n", argv[0]);
+        return 1;
+    }
+    FILE* fp = fopen(argv[1], "rb");
+    if (!fp) {
+        printf("failed to open '%s'\n", argv[1]);
+        return 1;
+    }
+    fseek(fp, 0, SEEK_END);
+    const int size = (int)ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    /* malloc'ed memory satisfies the 4-byte alignment of trace data */
+    void* ptr = malloc((size_t)size);
+    const bool read_ok = (size > 0) && ptr && (fread(ptr, 1, (size_t)size, fp) == (size_t)size);
+    fclose(fp);
+    if (!read_ok) {
+        printf("failed to read '%s'\n", argv[1]);
+        free(ptr);
+        return 1;
+    }
+
+    sg_setup(&(sg_desc){0});
+    stm_setup();
+    const uint64_t start = stm_now();
+    const bool ok = sgtrace_replay(&(sgtrace_replay_desc_t){
+        .ptr = ptr,
+        .size = size,
+        .num_loops = num_loops,
+    });
+    const uint64_t ticks = stm_since(start);
+    printf("%s, %d loops: %.3f ms\n", ok ? "ok" : "replay failed", num_loops, stm_ms(ticks));
+    sg_shutdown();
+    free(ptr);
+    return ok ? 0 : 1;
+}
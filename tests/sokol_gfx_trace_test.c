@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+//  sokol_gfx_trace_test.c
+//
+//  Captures a few frames with util/sokol_gfx_trace.h on the dummy backend,
+//  replays the trace and checks that the dummy backend's command log of
+//  the replay is identical to the log of the captured frames.
+//
+//  The trace is also written to sokol_gfx_trace_test.trace, which is
+//  replayed by the sokol_gfx_trace_replay tool in a separate test.
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#define SOKOL_TRACE_HOOKS
+#include "sokol_gfx.h"
+#define SOKOL_GFX_TRACE_IMPL
+#include "util/sokol_gfx_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int num_failed;
+#define T(expr) if (!(expr)) { printf("%s(%d): FAILED: %s\n", __FILE__, __LINE__, #expr); num_failed++; }
+
+#define LOG_SIZE (64 * 1024)
+#define NUM_FRAMES (3)
+
+typedef struct {
+    sg_buffer vbuf;
+    sg_buffer ibuf;
+    sg_buffer stream_buf;
+    sg_image img;
+    sg_image color_img;
+    sg_image depth_img;
+    sg_shader shd;
+    sg_pipeline pip[2];
+    sg_pipeline offscreen_pip;
+    sg_pass pass;
+} scene_t;
+
+static const sg_desc setup_desc = { .dummy_log_size = LOG_SIZE };
+
+static scene_t make_scene(void) {
+    scene_t scn;
+    float vertices[24] = { 0.0f };
+    scn.vbuf = sg_make_buffer(&(sg_buffer_desc){ .size = sizeof(vertices), .content = vertices });
+    uint16_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+    scn.ibuf = sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_INDEXBUFFER, .size = sizeof(indices), .content = indices });
+    scn.stream_buf = sg_make_buffer(&(sg_buffer_desc){ .size = 1024, .usage = SG_USAGE_STREAM });
+    scn.img = sg_make_image(&(sg_image_desc){ .width = 4, .height = 4, .usage = SG_USAGE_DYNAMIC });
+    scn.color_img = sg_make_image(&(sg_image_desc){ .render_target = true, .width = 32, .height = 32 });
+    scn.depth_img = sg_make_image(&(sg_image_desc){
+        .render_target = true,
+        .width = 32,
+        .height = 32,
+        .pixel_format = SG_PIXELFORMAT_DEPTH,
+    });
+    scn.shd = sg_make_shader(&(sg_shader_desc){
+        .vs = { .source = "vs", .uniform_blocks[0].size = 16 },
+        .fs = { .source = "fs", .images[0].type = SG_IMAGETYPE_2D },
+    });
+    sg_pipeline_desc pip_desc = {
+        .shader = scn.shd,
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+    };
+    scn.pip[0] = sg_make_pipeline(&pip_desc);
+    pip_desc.index_type = SG_INDEXTYPE_UINT16;
+    scn.pip[1] = sg_make_pipeline(&pip_desc);
+    pip_desc.blend.depth_format = SG_PIXELFORMAT_DEPTH;
+    pip_desc.depth_stencil.depth_write_enabled = true;
+    scn.offscreen_pip = sg_make_pipeline(&pip_desc);
+    scn.pass = sg_make_pass(&(sg_pass_desc){
+        .color_attachments[0].image = scn.color_img,
+        .depth_stencil_attachment.image = scn.depth_img,
+    });
+    return scn;
+}
+
+/* in the same order as the trace replay destroys its resources, so that the logs match */
+static void destroy_scene(const scene_t* scn) {
+    sg_destroy_pass(scn->pass);
+    sg_destroy_pipeline(scn->pip[0]);
+    sg_destroy_pipeline(scn->pip[1]);
+    sg_destroy_pipeline(scn->offscreen_pip);
+    sg_destroy_shader(scn->shd);
+    sg_destroy_image(scn->img);
+    sg_destroy_image(scn->color_img);
+    sg_destroy_image(scn->depth_img);
+    sg_destroy_buffer(scn->vbuf);
+    sg_destroy_buffer(scn->ibuf);
+    sg_destroy_buffer(scn->stream_buf);
+}
+
+static void draw_frame(const scene_t* scn, int frame_index) {
+    /* dynamic and stream resource updates */
+    uint32_t pixels[16];
+    for (int i = 0; i < 16; i++) {
+        pixels[i] = (uint32_t)(frame_index * 16 + i);
+    }
+    sg_image_content img_content = { 0 };
+    img_content.subimage[0][0] = (sg_subimage_content){ .ptr = pixels, .size = sizeof(pixels) };
+    sg_update_image(scn->img, &img_content);
+    float vertices[9 * 4] = { 0.0f };
+    vertices[0] = (float)frame_index;
+    const int vb_offset = sg_append_buffer(scn->stream_buf, vertices, (int)sizeof(vertices));
+
+    /* offscreen pass */
+    sg_pass_action pass_action = { .colors[0] = { .action = SG_ACTION_CLEAR } };
+    sg_begin_pass(scn->pass, &pass_action);
+    sg_apply_pipeline(scn->offscreen_pip);
+    sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = scn->vbuf, .index_buffer = scn->ibuf, .fs_images[0] = scn->img });
+    const float params[4] = { 1.0f, 2.0f, 3.0f, (float)frame_index };
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, params, sizeof(params));
+    sg_draw(0, 6, 1);
+    sg_end_pass();
+
+    /* default pass, sampling the offscreen render target */
+    sg_begin_default_pass(&pass_action, 640, 480);
+    sg_apply_viewport(0, 0, 320 + frame_index, 240, true);
+    sg_apply_scissor_rect(8, 8, 100, 100, true);
+    for (int i = 0; i < 4; i++) {
+        const bool indexed = (i & 1) != 0;
+        sg_apply_pipeline(scn->pip[indexed ? 1 : 0]);
+        sg_apply_bindings(&(sg_bindings){
+            .vertex_buffers[0] = indexed ? scn->vbuf : scn->stream_buf,
+            .vertex_buffer_offsets[0] = indexed ? 0 : vb_offset,
+            .index_buffer = indexed ? scn->ibuf : (sg_buffer){0},
+            .fs_images[0] = (i < 2) ? scn->color_img : scn->img,
+        });
+        const float ub[4] = { (float)i, (float)frame_index, 0.5f, 1.0f };
+        sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, ub, sizeof(ub));
+        sg_draw(0, indexed ? 6 : 3, i + 1);
+    }
+    sg_end_pass();
+    sg_commit();
+}
+
+static struct {
+    uint32_t* ptr;  /* 4-byte aligned */
+    int size;
+} trace;
+
+static char capture_log[LOG_SIZE];
+static sg_dummy_stats capture_stats;
+
+static void capture(void) {
+    sg_setup(&setup_desc);
+    sgtrace_setup(&(sgtrace_desc_t){0});
+    const scene_t scn = make_scene();
+    sgtrace_begin_capture();
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        draw_frame(&scn, i);
+    }
+    const sgtrace_data_t data = sgtrace_end_capture();
+    T(data.ptr && (data.size > 0));
+    trace.size = data.size;
+    trace.ptr = (uint32_t*) malloc((size_t)data.size);
+    memcpy(trace.ptr, data.ptr, (size_t)data.size);
+    destroy_scene(&scn);
+    capture_stats = sg_query_dummy_stats();
+    strcpy(capture_log, sg_query_dummy_log());
+    sgtrace_shutdown();
+    sg_shutdown();
+}
+
+static void test_replay_log(void) {
+    sg_setup(&setup_desc);
+    T(sgtrace_replay(&(sgtrace_replay_desc_t){ .ptr = trace.ptr, .size = trace.size }));
+    const sg_dummy_stats stats = sg_query_dummy_stats();
+    T(!capture_stats.log_overflow);
+    T(!stats.log_overflow);
+    T(capture_stats.num_draws == NUM_FRAMES * 5);
+    T(stats.num_draws == capture_stats.num_draws);
+    T(0 == strcmp(sg_query_dummy_log(), capture_log));
+    sg_shutdown();
+}
+
+static void test_replay_loops(void) {
+    sg_setup(&setup_desc);
+    T(sgtrace_replay(&(sgtrace_replay_desc_t){ .ptr = trace.ptr, .size = trace.size, .num_loops = 4 }));
+    const sg_dummy_stats stats = sg_query_dummy_stats();
+    T(stats.num_draws == 4 * capture_stats.num_draws);
+    T(stats.num_passes == 4 * capture_stats.num_passes);
+    sg_shutdown();
+}
+
+static void write_trace(void) {
+    FILE* fp = fopen("sokol_gfx_trace_test.trace", "wb");
+    T(fp);
+    if (fp) {
+        T(fwrite(trace.ptr, 1, (size_t)trace.size, fp) == (size_t)trace.size);
+        fclose(fp);
+    }
+}
+
+int main(void) {
+    capture();
+    test_replay_log();
+    test_replay_loops();
+    write_trace();
+    free(trace.ptr);
+    if (num_failed > 0) {
+        printf("%d checks failed\n", num_failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -21,6 +21,7 @@
     SOKOL_D3D11
     SOKOL_METAL
     SOKOL_WGPU
+    SOKOL_SOFT
 
     Define at least one of the following fonts to use:
 
@@ -1112,11 +1113,31 @@ static const char* _sdtx_fs_src = "FIXME!";
 #elif defined(SOKOL_WGPU)
 static const char* _sdtx_vs_src = "FIXME!";
 static const char* _sdtx_fs_src = "FIXME!";
+#elif defined(SOKOL_SOFT)
+static void _sdtx_soft_vs(const sg_soft_vs_input* in, sg_soft_vs_output* out) {
+    const float* glyph_size = (const float*) in->uniforms[0];
+    out->pos[0] = (in->attrs[0][0] * glyph_size[0]) * 2.0f - 1.0f;
+    out->pos[1] = (in->attrs[0][1] * glyph_size[1]) * 2.0f - 1.0f;
+    out->pos[2] = 0.0f;
+    out->pos[3] = 1.0f;
+    out->varyings[0] = in->attrs[1][0];
+    out->varyings[1] = in->attrs[1][1];
+    for (int i = 0; i < 4; i++) {
+        out->varyings[2+i] = in->attrs[2][i];
+    }
+}
+static void _sdtx_soft_fs(const sg_soft_fs_input* in, sg_soft_fs_output* out) {
+    float texel[4];
+    sg_soft_sample(in->images[0], in->varyings[0], in->varyings[1], texel);
+    for (int i = 0; i < 4; i++) {
+        out->color[i] = texel[i] * in->varyings[2+i];
+    }
+}
 #elif defined(SOKOL_DUMMY_BACKEND)
 static const char* _sdtx_vs_src = "";
 static const char* _sdtx_fs_src = "";
 #else
-#error "Please define one of SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU or SOKOL_DUMMY_BACKEND!"
+#error "Please define one of SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU, SOKOL_SOFT or SOKOL_DUMMY_BACKEND!"
 #endif
 
 typedef struct {
@@ -1426,8 +1447,14 @@ static void _sdtx_setup_common(void) {
     shd_desc.vs.uniform_blocks[0].uniforms[0].type = SG_UNIFORMTYPE_FLOAT2;
     shd_desc.fs.images[0].name = "tex";
     shd_desc.fs.images[0].type = SG_IMAGETYPE_2D;
+    #if defined(SOKOL_SOFT)
+    shd_desc.soft_vs = _sdtx_soft_vs;
+    shd_desc.soft_fs = _sdtx_soft_fs;
+    shd_desc.soft_num_varyings = 6;
+    #else
     shd_desc.vs.source = _sdtx_vs_src;
     shd_desc.fs.source = _sdtx_fs_src;
+    #endif
     _sdtx.shader = sg_make_shader(&shd_desc);
     SOKOL_ASSERT(SG_INVALID_ID != _sdtx.shader.id);
 
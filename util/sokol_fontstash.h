@@ -121,7 +121,9 @@
     sfons_flush():
         - this will call sg_update_image() on the font atlas texture
           if fontstash.h has added any rasterized glyphs since the last
-          frame
+          frame, if the backend supports partial image updates
+          (sg_features.image_region_update), only the range of atlas rows
+          touched by new glyphs is uploaded via sg_update_image_region()
 
     sfons_shutdown():
         - destroy the font atlas texture, sgl_pipeline and sg_shader objects
@@ -843,11 +845,38 @@ static const uint8_t _sfons_fs_bin[980] = {
     0x3e,0x00,0x03,0x00,0x0a,0x00,0x00,0x00,0x1d,0x00,0x00,0x00,0xfd,0x00,0x01,0x00,
     0x38,0x00,0x01,0x00,
 };
+#elif defined(SOKOL_SOFT)
+/* software shaders, the uniform block is two column-major mat4 (mvp, tm) */
+static void _sfons_soft_mul_mat4(const float* m, const float* v, float* out) {
+    for (int r = 0; r < 4; r++) {
+        out[r] = m[r]*v[0] + m[4+r]*v[1] + m[8+r]*v[2] + m[12+r]*v[3];
+    }
+}
+static void _sfons_soft_vs(const sg_soft_vs_input* in, sg_soft_vs_output* out) {
+    const float* mvp = (const float*) in->uniforms[0];
+    const float* tm = mvp + 16;
+    float uv[4];
+    _sfons_soft_mul_mat4(mvp, in->attrs[0], out->pos);
+    _sfons_soft_mul_mat4(tm, in->attrs[1], uv);
+    out->varyings[0] = uv[0];
+    out->varyings[1] = uv[1];
+    for (int i = 0; i < 4; i++) {
+        out->varyings[2+i] = in->attrs[2][i];
+    }
+}
+static void _sfons_soft_fs(const sg_soft_fs_input* in, sg_soft_fs_output* out) {
+    float texel[4];
+    sg_soft_sample(in->images[0], in->varyings[0], in->varyings[1], texel);
+    out->color[0] = in->varyings[2];
+    out->color[1] = in->varyings[3];
+    out->color[2] = in->varyings[4];
+    out->color[3] = texel[0] * in->varyings[5];
+}
 #elif defined(SOKOL_DUMMY_BACKEND)
 static const char* _sfons_vs_src = "";
 static const char* _sfons_fs_src = "";
 #else
-#error "Please define one of SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU or SOKOL_DUMMY_BACKEND!"
+#error "Please define one of SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU, SOKOL_SOFT or SOKOL_DUMMY_BACKEND!"
 #endif
 
 typedef struct _sfons_t {
@@ -856,6 +885,8 @@ typedef struct _sfons_t {
     sg_image img;
     int width, height;
     bool img_dirty;
+    bool img_valid;         /* true once the atlas texture has been fully uploaded */
+    int dirty_y0, dirty_y1; /* range of atlas rows touched since the last flush */
 } _sfons_t;
 
 static int _sfons_render_create(void* user_ptr, int width, int height) {
@@ -885,6 +916,10 @@ static int _sfons_render_create(void* user_ptr, int width, int height) {
             shd_desc.vs.byte_code_size = sizeof(_sfons_vs_bin);
             shd_desc.fs.byte_code = _sfons_fs_bin;
             shd_desc.fs.byte_code_size = sizeof(_sfons_fs_bin);
+        #elif defined(SOKOL_SOFT)
+            shd_desc.soft_vs = _sfons_soft_vs;
+            shd_desc.soft_fs = _sfons_soft_fs;
+            shd_desc.soft_num_varyings = 6;
         #else
             shd_desc.vs.source = _sfons_vs_src;
             shd_desc.fs.source = _sfons_fs_src;
@@ -911,6 +946,10 @@ static int _sfons_render_create(void* user_ptr, int width, int height) {
     }
     sfons->width = width;
     sfons->height = height;
+    sfons->img_dirty = false;
+    sfons->img_valid = false;
+    sfons->dirty_y0 = 0;
+    sfons->dirty_y1 = 0;
 
     SOKOL_ASSERT(sfons->img.id == SG_INVALID_ID);
     sg_image_desc img_desc;
@@ -932,6 +971,15 @@ static int _sfons_render_resize(void* user_ptr, int width, int height) {
 static void _sfons_render_update(void* user_ptr, int* rect, const unsigned char* data) {
     SOKOL_ASSERT(user_ptr && rect && data);
     _sfons_t* sfons = (_sfons_t*) user_ptr;
+    /* rect is (x0, y0, x1, y1), keep track of the dirty row range */
+    if (sfons->img_dirty) {
+        sfons->dirty_y0 = (rect[1] < sfons->dirty_y0) ? rect[1] : sfons->dirty_y0;
+        sfons->dirty_y1 = (rect[3] > sfons->dirty_y1) ? rect[3] : sfons->dirty_y1;
+    }
+    else {
+        sfons->dirty_y0 = rect[1];
+        sfons->dirty_y1 = rect[3];
+    }
     sfons->img_dirty = true;
 }
 
@@ -997,11 +1045,32 @@ SOKOL_API_IMPL void sfons_flush(FONScontext* ctx) {
     _sfons_t* sfons = (_sfons_t*) ctx->params.userPtr;
     if (sfons->img_dirty) {
         sfons->img_dirty = false;
-        sg_image_content content;
-        memset(&content, 0, sizeof(content));
-        content.subimage[0][0].ptr = ctx->texData;
-        content.subimage[0][0].size = sfons->width * sfons->height;
-        sg_update_image(sfons->img, &content);
+        int y0 = (sfons->dirty_y0 < 0) ? 0 : sfons->dirty_y0;
+        int y1 = (sfons->dirty_y1 > sfons->height) ? sfons->height : sfons->dirty_y1;
+        if (sfons->img_valid && sg_query_features().image_region_update) {
+            /* only upload the rows touched by new glyphs, the image
+               region update happens in place, so this also requires that the
+               atlas texture has been fully uploaded once before
+            */
+            if (y1 > y0) {
+                sg_image_region region;
+                memset(&region, 0, sizeof(region));
+                region.y = y0;
+                region.width = sfons->width;
+                region.height = y1 - y0;
+                sg_update_image_region(sfons->img, &region,
+                    ctx->texData + y0 * sfons->width,
+                    sfons->width * region.height);
+            }
+        }
+        else {
+            sg_image_content content;
+            memset(&content, 0, sizeof(content));
+            content.subimage[0][0].ptr = ctx->texData;
+            content.subimage[0][0].size = sfons->width * sfons->height;
+            sg_update_image(sfons->img, &content);
+            sfons->img_valid = true;
+        }
     }
 }
 
@@ -276,7 +276,11 @@ typedef enum {
     SG_IMGUI_CMD_DESTROY_PASS,
     SG_IMGUI_CMD_UPDATE_BUFFER,
     SG_IMGUI_CMD_UPDATE_IMAGE,
+    SG_IMGUI_CMD_UPDATE_IMAGE_REGION,
     SG_IMGUI_CMD_APPEND_BUFFER,
+    SG_IMGUI_CMD_MAP_BUFFER,
+    SG_IMGUI_CMD_UNMAP_BUFFER,
+    SG_IMGUI_CMD_READ_PIXELS_ASYNC,
     SG_IMGUI_CMD_BEGIN_DEFAULT_PASS,
     SG_IMGUI_CMD_BEGIN_PASS,
     SG_IMGUI_CMD_APPLY_VIEWPORT,
@@ -285,6 +289,9 @@ typedef enum {
     SG_IMGUI_CMD_APPLY_BINDINGS,
     SG_IMGUI_CMD_APPLY_UNIFORMS,
     SG_IMGUI_CMD_DRAW,
+    SG_IMGUI_CMD_DRAW_EX,
+    SG_IMGUI_CMD_MULTI_DRAW,
+    SG_IMGUI_CMD_DRAW_INDIRECT,
     SG_IMGUI_CMD_END_PASS,
     SG_IMGUI_CMD_COMMIT,
     SG_IMGUI_CMD_ALLOC_BUFFER,
@@ -364,12 +371,34 @@ typedef struct {
     sg_image image;
 } sg_imgui_args_update_image_t;
 
+typedef struct {
+    sg_image image;
+    sg_image_region region;
+    int data_size;
+} sg_imgui_args_update_image_region_t;
+
 typedef struct {
     sg_buffer buffer;
     int data_size;
     int result;
 } sg_imgui_args_append_buffer_t;
 
+typedef struct {
+    sg_buffer buffer;
+    int data_size;
+    bool result;
+} sg_imgui_args_map_buffer_t;
+
+typedef struct {
+    sg_buffer buffer;
+} sg_imgui_args_unmap_buffer_t;
+
+typedef struct {
+    sg_image image;
+    int x, y, width, height;
+    bool result;
+} sg_imgui_args_read_pixels_async_t;
+
 typedef struct {
     sg_pass_action action;
     int width;
@@ -414,6 +443,23 @@ typedef struct {
     int num_instances;
 } sg_imgui_args_draw_t;
 
+typedef struct {
+    int base_element;
+    int num_elements;
+    int num_instances;
+    int base_vertex;
+} sg_imgui_args_draw_ex_t;
+
+typedef struct {
+    int num_draws;
+} sg_imgui_args_multi_draw_t;
+
+typedef struct {
+    sg_buffer buffer;
+    int offset;
+    int num_draws;
+} sg_imgui_args_draw_indirect_t;
+
 typedef struct {
     sg_buffer result;
 } sg_imgui_args_alloc_buffer_t;
@@ -491,7 +537,11 @@ typedef union {
     sg_imgui_args_destroy_pass_t destroy_pass;
     sg_imgui_args_update_buffer_t update_buffer;
     sg_imgui_args_update_image_t update_image;
+    sg_imgui_args_update_image_region_t update_image_region;
     sg_imgui_args_append_buffer_t append_buffer;
+    sg_imgui_args_map_buffer_t map_buffer;
+    sg_imgui_args_unmap_buffer_t unmap_buffer;
+    sg_imgui_args_read_pixels_async_t read_pixels_async;
     sg_imgui_args_begin_default_pass_t begin_default_pass;
     sg_imgui_args_begin_pass_t begin_pass;
     sg_imgui_args_apply_viewport_t apply_viewport;
@@ -500,6 +550,9 @@ typedef union {
     sg_imgui_args_apply_bindings_t apply_bindings;
     sg_imgui_args_apply_uniforms_t apply_uniforms;
     sg_imgui_args_draw_t draw;
+    sg_imgui_args_draw_ex_t draw_ex;
+    sg_imgui_args_multi_draw_t multi_draw;
+    sg_imgui_args_draw_indirect_t draw_indirect;
     sg_imgui_args_alloc_buffer_t alloc_buffer;
     sg_imgui_args_alloc_image_t alloc_image;
     sg_imgui_args_alloc_shader_t alloc_shader;
@@ -620,7 +673,8 @@ END_EXTERN_C
 #include <string.h>
 #include <stdio.h>      /* snprintf */
 
-#define _SG_IMGUI_SLOT_MASK (0xFFFF)
+#define _SG_IMGUI_SLOT_SHIFT (SOKOL_POOL_SLOT_BITS)    /* same as _SG_SLOT_SHIFT in sokol_gfx.h */
+#define _SG_IMGUI_SLOT_MASK ((1<<_SG_IMGUI_SLOT_SHIFT)-1)
 #define _SG_IMGUI_LIST_WIDTH (192)
 #define _SG_IMGUI_COLOR_OTHER 0xFFCCCCCC
 #define _SG_IMGUI_COLOR_RSRC 0xFF00FFFF
@@ -754,6 +808,24 @@ _SOKOL_PRIVATE void* _sg_imgui_realloc(void* old_ptr, int old_size, int new_size
     return new_ptr;
 }
 
+/* resource pools grow on demand in sokol_gfx.h, grow a socket array so
+   that slot_index is valid, new sockets are zero-initialized
+*/
+_SOKOL_PRIVATE void* _sg_imgui_grow_sockets(void* sockets, int* num_sockets, int slot_index, int socket_size) {
+    SOKOL_ASSERT(num_sockets && (slot_index > 0) && (slot_index <= _SG_IMGUI_SLOT_MASK));
+    if (slot_index < *num_sockets) {
+        return sockets;
+    }
+    int new_num = (*num_sockets > 0) ? *num_sockets : 1;
+    while (new_num <= slot_index) {
+        new_num *= 2;
+    }
+    uint8_t* new_sockets = (uint8_t*) _sg_imgui_realloc(sockets, *num_sockets * socket_size, new_num * socket_size);
+    memset(new_sockets + *num_sockets * socket_size, 0, (new_num - *num_sockets) * socket_size);
+    *num_sockets = new_num;
+    return new_sockets;
+}
+
 _SOKOL_PRIVATE void _sg_imgui_strcpy(sg_imgui_str_t* dst, const char* src) {
     SOKOL_ASSERT(dst);
     if (src) {
@@ -826,6 +898,7 @@ _SOKOL_PRIVATE const char* _sg_imgui_backend_string(sg_backend b) {
         case SG_BACKEND_METAL_MACOS:        return "SG_BACKEND_METAL_MACOS";
         case SG_BACKEND_METAL_SIMULATOR:    return "SG_BACKEND_METAL_SIMULATOR";
         case SG_BACKEND_DUMMY:              return "SG_BACKEND_DUMMY";
+        case SG_BACKEND_SOFT:               return "SG_BACKEND_SOFT";
         default: return "???";
     }
 }
@@ -834,6 +907,7 @@ _SOKOL_PRIVATE const char* _sg_imgui_buffertype_string(sg_buffer_type t) {
     switch (t) {
         case SG_BUFFERTYPE_VERTEXBUFFER:    return "SG_BUFFERTYPE_VERTEXBUFFER";
         case SG_BUFFERTYPE_INDEXBUFFER:     return "SG_BUFFERTYPE_INDEXBUFFER";
+        case SG_BUFFERTYPE_INDIRECTBUFFER:  return "SG_BUFFERTYPE_INDIRECTBUFFER";
         default:                            return "???";
     }
 }
@@ -1194,7 +1268,7 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_pass_id_string(sg_imgui_t* ctx, sg_pass
 
 /*--- RESOURCE HELPERS -------------------------------------------------------*/
 _SOKOL_PRIVATE void _sg_imgui_buffer_created(sg_imgui_t* ctx, sg_buffer res_id, int slot_index, const sg_buffer_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->buffers.num_sockets));
+    ctx->buffers.sockets = (sg_imgui_buffer_t*) _sg_imgui_grow_sockets(ctx->buffers.sockets, &ctx->buffers.num_sockets, slot_index, sizeof(sg_imgui_buffer_t));
     sg_imgui_buffer_t* buf = &ctx->buffers.sockets[slot_index];
     buf->res_id = res_id;
     buf->desc = *desc;
@@ -1202,13 +1276,17 @@ _SOKOL_PRIVATE void _sg_imgui_buffer_created(sg_imgui_t* ctx, sg_buffer res_id,
 }
 
 _SOKOL_PRIVATE void _sg_imgui_buffer_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->buffers.num_sockets));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->buffers.num_sockets) {
+        /* a resource created before sg_imgui_init() */
+        return;
+    }
     sg_imgui_buffer_t* buf = &ctx->buffers.sockets[slot_index];
     buf->res_id.id = SG_INVALID_ID;
 }
 
 _SOKOL_PRIVATE void _sg_imgui_image_created(sg_imgui_t* ctx, sg_image res_id, int slot_index, const sg_image_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->images.num_sockets));
+    ctx->images.sockets = (sg_imgui_image_t*) _sg_imgui_grow_sockets(ctx->images.sockets, &ctx->images.num_sockets, slot_index, sizeof(sg_imgui_image_t));
     sg_imgui_image_t* img = &ctx->images.sockets[slot_index];
     img->res_id = res_id;
     img->desc = *desc;
@@ -1217,13 +1295,63 @@ _SOKOL_PRIVATE void _sg_imgui_image_created(sg_imgui_t* ctx, sg_image res_id, in
 }
 
 _SOKOL_PRIVATE void _sg_imgui_image_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->images.num_sockets));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->images.num_sockets) {
+        /* a resource created before sg_imgui_init() */
+        return;
+    }
     sg_imgui_image_t* img = &ctx->images.sockets[slot_index];
     img->res_id.id = SG_INVALID_ID;
 }
 
+/* the shader desc's name strings point into the socket itself, re-point
+   them after the shader sockets have moved in memory
+*/
+_SOKOL_PRIVATE void _sg_imgui_shader_fixup_names(sg_imgui_shader_t* shd) {
+    if (shd->desc.vs.entry) {
+        shd->desc.vs.entry = shd->vs_entry.buf;
+    }
+    if (shd->desc.fs.entry) {
+        shd->desc.fs.entry = shd->fs_entry.buf;
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_UBS; i++) {
+        for (int j = 0; j < SG_MAX_UB_MEMBERS; j++) {
+            if (shd->desc.vs.uniform_blocks[i].uniforms[j].name) {
+                shd->desc.vs.uniform_blocks[i].uniforms[j].name = shd->vs_uniform_name[i][j].buf;
+            }
+            if (shd->desc.fs.uniform_blocks[i].uniforms[j].name) {
+                shd->desc.fs.uniform_blocks[i].uniforms[j].name = shd->fs_uniform_name[i][j].buf;
+            }
+        }
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        if (shd->desc.vs.images[i].name) {
+            shd->desc.vs.images[i].name = shd->vs_image_name[i].buf;
+        }
+        if (shd->desc.fs.images[i].name) {
+            shd->desc.fs.images[i].name = shd->fs_image_name[i].buf;
+        }
+    }
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        if (shd->desc.attrs[i].name) {
+            shd->desc.attrs[i].name = shd->attr_name[i].buf;
+        }
+        if (shd->desc.attrs[i].sem_name) {
+            shd->desc.attrs[i].sem_name = shd->attr_sem_name[i].buf;
+        }
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_shader_created(sg_imgui_t* ctx, sg_shader res_id, int slot_index, const sg_shader_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->shaders.num_sockets));
+    const sg_imgui_shader_t* old_sockets = ctx->shaders.sockets;
+    ctx->shaders.sockets = (sg_imgui_shader_t*) _sg_imgui_grow_sockets(ctx->shaders.sockets, &ctx->shaders.num_sockets, slot_index, sizeof(sg_imgui_shader_t));
+    if (old_sockets != ctx->shaders.sockets) {
+        for (int i = 0; i < ctx->shaders.num_sockets; i++) {
+            if (ctx->shaders.sockets[i].res_id.id != SG_INVALID_ID) {
+                _sg_imgui_shader_fixup_names(&ctx->shaders.sockets[i]);
+            }
+        }
+    }
     sg_imgui_shader_t* shd = &ctx->shaders.sockets[slot_index];
     shd->res_id = res_id;
     shd->desc = *desc;
@@ -1292,7 +1420,11 @@ _SOKOL_PRIVATE void _sg_imgui_shader_created(sg_imgui_t* ctx, sg_shader res_id,
 }
 
 _SOKOL_PRIVATE void _sg_imgui_shader_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->shaders.num_sockets));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->shaders.num_sockets) {
+        /* a resource created before sg_imgui_init() */
+        return;
+    }
     sg_imgui_shader_t* shd = &ctx->shaders.sockets[slot_index];
     shd->res_id.id = SG_INVALID_ID;
     if (shd->desc.vs.source) {
@@ -1314,7 +1446,7 @@ _SOKOL_PRIVATE void _sg_imgui_shader_destroyed(sg_imgui_t* ctx, int slot_index)
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pipeline_created(sg_imgui_t* ctx, sg_pipeline res_id, int slot_index, const sg_pipeline_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->pipelines.num_sockets));
+    ctx->pipelines.sockets = (sg_imgui_pipeline_t*) _sg_imgui_grow_sockets(ctx->pipelines.sockets, &ctx->pipelines.num_sockets, slot_index, sizeof(sg_imgui_pipeline_t));
     sg_imgui_pipeline_t* pip = &ctx->pipelines.sockets[slot_index];
     pip->res_id = res_id;
     pip->label = _sg_imgui_make_str(desc->label);
@@ -1323,13 +1455,17 @@ _SOKOL_PRIVATE void _sg_imgui_pipeline_created(sg_imgui_t* ctx, sg_pipeline res_
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pipeline_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->pipelines.num_sockets));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->pipelines.num_sockets) {
+        /* a resource created before sg_imgui_init() */
+        return;
+    }
     sg_imgui_pipeline_t* pip = &ctx->pipelines.sockets[slot_index];
     pip->res_id.id = SG_INVALID_ID;
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pass_created(sg_imgui_t* ctx, sg_pass res_id, int slot_index, const sg_pass_desc* desc) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->passes.num_sockets));
+    ctx->passes.sockets = (sg_imgui_pass_t*) _sg_imgui_grow_sockets(ctx->passes.sockets, &ctx->passes.num_sockets, slot_index, sizeof(sg_imgui_pass_t));
     sg_imgui_pass_t* pass = &ctx->passes.sockets[slot_index];
     pass->res_id = res_id;
     for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
@@ -1341,7 +1477,11 @@ _SOKOL_PRIVATE void _sg_imgui_pass_created(sg_imgui_t* ctx, sg_pass res_id, int
 }
 
 _SOKOL_PRIVATE void _sg_imgui_pass_destroyed(sg_imgui_t* ctx, int slot_index) {
-    SOKOL_ASSERT((slot_index > 0) && (slot_index < ctx->passes.num_sockets));
+    SOKOL_ASSERT(slot_index > 0);
+    if (slot_index >= ctx->passes.num_sockets) {
+        /* a resource created before sg_imgui_init() */
+        return;
+    }
     sg_imgui_pass_t* pass = &ctx->passes.sockets[slot_index];
     pass->res_id.id = SG_INVALID_ID;
 }
@@ -1496,6 +1636,19 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
             _sg_imgui_snprintf(&str, "%d: sg_update_image(img=%s, data=..)", index, res_id.buf);
             break;
 
+        case SG_IMGUI_CMD_UPDATE_IMAGE_REGION:
+            res_id = _sg_imgui_image_id_string(ctx, item->args.update_image_region.image);
+            _sg_imgui_snprintf(&str, "%d: sg_update_image_region(img=%s, mip=%d, slice=%d, x=%d, y=%d, w=%d, h=%d, data_size=%d)",
+                index, res_id.buf,
+                item->args.update_image_region.region.mip_level,
+                item->args.update_image_region.region.slice,
+                item->args.update_image_region.region.x,
+                item->args.update_image_region.region.y,
+                item->args.update_image_region.region.width,
+                item->args.update_image_region.region.height,
+                item->args.update_image_region.data_size);
+            break;
+
         case SG_IMGUI_CMD_APPEND_BUFFER:
             res_id = _sg_imgui_buffer_id_string(ctx, item->args.append_buffer.buffer);
             _sg_imgui_snprintf(&str, "%d: sg_append_buffer(buf=%s, data_ptr=.., data_size=%d) => %d",
@@ -1504,6 +1657,35 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
                 item->args.append_buffer.result);
             break;
 
+        case SG_IMGUI_CMD_MAP_BUFFER:
+            res_id = _sg_imgui_buffer_id_string(ctx, item->args.map_buffer.buffer);
+            _sg_imgui_snprintf(&str, "%d: sg_map_buffer(buf=%s, data_size=%d) => %s",
+                index, res_id.buf,
+                item->args.map_buffer.data_size,
+                _sg_imgui_bool_string(item->args.map_buffer.result));
+            break;
+
+        case SG_IMGUI_CMD_UNMAP_BUFFER:
+            res_id = _sg_imgui_buffer_id_string(ctx, item->args.unmap_buffer.buffer);
+            _sg_imgui_snprintf(&str, "%d: sg_unmap_buffer(buf=%s)", index, res_id.buf);
+            break;
+
+        case SG_IMGUI_CMD_READ_PIXELS_ASYNC:
+            if (item->args.read_pixels_async.image.id != SG_INVALID_ID) {
+                res_id = _sg_imgui_image_id_string(ctx, item->args.read_pixels_async.image);
+            }
+            else {
+                res_id = _sg_imgui_make_str("default framebuffer");
+            }
+            _sg_imgui_snprintf(&str, "%d: sg_read_pixels_async(img=%s, x=%d, y=%d, w=%d, h=%d) => %s",
+                index, res_id.buf,
+                item->args.read_pixels_async.x,
+                item->args.read_pixels_async.y,
+                item->args.read_pixels_async.width,
+                item->args.read_pixels_async.height,
+                _sg_imgui_bool_string(item->args.read_pixels_async.result));
+            break;
+
         case SG_IMGUI_CMD_BEGIN_DEFAULT_PASS:
             _sg_imgui_snprintf(&str, "%d: sg_begin_default_pass(pass_action=.., width=%d, height=%d)",
                 index,
@@ -1561,6 +1743,29 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
                 item->args.draw.num_instances);
             break;
 
+        case SG_IMGUI_CMD_DRAW_EX:
+            _sg_imgui_snprintf(&str, "%d: sg_draw_ex(base_element=%d, num_elements=%d, num_instances=%d, base_vertex=%d)",
+                index,
+                item->args.draw_ex.base_element,
+                item->args.draw_ex.num_elements,
+                item->args.draw_ex.num_instances,
+                item->args.draw_ex.base_vertex);
+            break;
+
+        case SG_IMGUI_CMD_MULTI_DRAW:
+            _sg_imgui_snprintf(&str, "%d: sg_multi_draw(draws=.., num_draws=%d)",
+                index,
+                item->args.multi_draw.num_draws);
+            break;
+
+        case SG_IMGUI_CMD_DRAW_INDIRECT:
+            res_id = _sg_imgui_buffer_id_string(ctx, item->args.draw_indirect.buffer);
+            _sg_imgui_snprintf(&str, "%d: sg_draw_indirect(buf=%s, offset=%d, num_draws=%d)",
+                index, res_id.buf,
+                item->args.draw_indirect.offset,
+                item->args.draw_indirect.num_draws);
+            break;
+
         case SG_IMGUI_CMD_END_PASS:
             _sg_imgui_snprintf(&str, "%d: sg_end_pass()", index);
             break;
@@ -1909,6 +2114,22 @@ _SOKOL_PRIVATE void _sg_imgui_update_image(sg_image img, const sg_image_content*
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_update_image_region(sg_image img, const sg_image_region* region, const void* data_ptr, int data_size, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_UPDATE_IMAGE_REGION;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.update_image_region.image = img;
+        item->args.update_image_region.region = *region;
+        item->args.update_image_region.data_size = data_size;
+    }
+    if (ctx->hooks.update_image_region) {
+        ctx->hooks.update_image_region(img, region, data_ptr, data_size, ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_append_buffer(sg_buffer buf, const void* data_ptr, int data_size, int result, void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -1925,6 +2146,55 @@ _SOKOL_PRIVATE void _sg_imgui_append_buffer(sg_buffer buf, const void* data_ptr,
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_map_buffer(sg_buffer buf, int data_size, void* result, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_MAP_BUFFER;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.map_buffer.buffer = buf;
+        item->args.map_buffer.data_size = data_size;
+        item->args.map_buffer.result = (0 != result);
+    }
+    if (ctx->hooks.map_buffer) {
+        ctx->hooks.map_buffer(buf, data_size, result, ctx->hooks.user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_imgui_unmap_buffer(sg_buffer buf, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_UNMAP_BUFFER;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.unmap_buffer.buffer = buf;
+    }
+    if (ctx->hooks.unmap_buffer) {
+        ctx->hooks.unmap_buffer(buf, ctx->hooks.user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_imgui_read_pixels_async(const sg_read_pixels_desc* desc, bool result, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_READ_PIXELS_ASYNC;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.read_pixels_async.image = desc->image;
+        item->args.read_pixels_async.x = desc->x;
+        item->args.read_pixels_async.y = desc->y;
+        item->args.read_pixels_async.width = desc->width;
+        item->args.read_pixels_async.height = desc->height;
+        item->args.read_pixels_async.result = result;
+    }
+    if (ctx->hooks.read_pixels_async) {
+        ctx->hooks.read_pixels_async(desc, result, ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_begin_default_pass(const sg_pass_action* pass_action, int width, int height, void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -2060,6 +2330,53 @@ _SOKOL_PRIVATE void _sg_imgui_draw(int base_element, int num_elements, int num_i
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_draw_ex(int base_element, int num_elements, int num_instances, int base_vertex, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_DRAW_EX;
+        item->color = _SG_IMGUI_COLOR_DRAW;
+        item->args.draw_ex.base_element = base_element;
+        item->args.draw_ex.num_elements = num_elements;
+        item->args.draw_ex.num_instances = num_instances;
+        item->args.draw_ex.base_vertex = base_vertex;
+    }
+    if (ctx->hooks.draw_ex) {
+        ctx->hooks.draw_ex(base_element, num_elements, num_instances, base_vertex, ctx->hooks.user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_imgui_multi_draw(const sg_draw_args* draws, int num_draws, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_MULTI_DRAW;
+        item->color = _SG_IMGUI_COLOR_DRAW;
+        item->args.multi_draw.num_draws = num_draws;
+    }
+    if (ctx->hooks.multi_draw) {
+        ctx->hooks.multi_draw(draws, num_draws, ctx->hooks.user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_imgui_draw_indirect(sg_buffer buf, int offset, int num_draws, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_DRAW_INDIRECT;
+        item->color = _SG_IMGUI_COLOR_DRAW;
+        item->args.draw_indirect.buffer = buf;
+        item->args.draw_indirect.offset = offset;
+        item->args.draw_indirect.num_draws = num_draws;
+    }
+    if (ctx->hooks.draw_indirect) {
+        ctx->hooks.draw_indirect(buf, offset, num_draws, ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_end_pass(void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -3246,9 +3563,21 @@ _SOKOL_PRIVATE void _sg_imgui_draw_capture_panel(sg_imgui_t* ctx) {
         case SG_IMGUI_CMD_UPDATE_IMAGE:
             _sg_imgui_draw_image_panel(ctx, item->args.update_image.image);
             break;
+        case SG_IMGUI_CMD_UPDATE_IMAGE_REGION:
+            _sg_imgui_draw_image_panel(ctx, item->args.update_image_region.image);
+            break;
         case SG_IMGUI_CMD_APPEND_BUFFER:
             _sg_imgui_draw_buffer_panel(ctx, item->args.update_buffer.buffer);
             break;
+        case SG_IMGUI_CMD_MAP_BUFFER:
+            _sg_imgui_draw_buffer_panel(ctx, item->args.map_buffer.buffer);
+            break;
+        case SG_IMGUI_CMD_UNMAP_BUFFER:
+            _sg_imgui_draw_buffer_panel(ctx, item->args.unmap_buffer.buffer);
+            break;
+        case SG_IMGUI_CMD_READ_PIXELS_ASYNC:
+            _sg_imgui_draw_image_panel(ctx, item->args.read_pixels_async.image);
+            break;
         case SG_IMGUI_CMD_BEGIN_DEFAULT_PASS:
             {
                 sg_pass inv_pass = { SG_INVALID_ID };
@@ -3272,7 +3601,12 @@ _SOKOL_PRIVATE void _sg_imgui_draw_capture_panel(sg_imgui_t* ctx) {
         case SG_IMGUI_CMD_APPLY_UNIFORMS:
             _sg_imgui_draw_uniforms_panel(ctx, &item->args.apply_uniforms);
             break;
+        case SG_IMGUI_CMD_DRAW_INDIRECT:
+            _sg_imgui_draw_buffer_panel(ctx, item->args.draw_indirect.buffer);
+            break;
         case SG_IMGUI_CMD_DRAW:
+        case SG_IMGUI_CMD_DRAW_EX:
+        case SG_IMGUI_CMD_MULTI_DRAW:
         case SG_IMGUI_CMD_END_PASS:
         case SG_IMGUI_CMD_COMMIT:
             break;
@@ -3338,6 +3672,11 @@ _SOKOL_PRIVATE void _sg_imgui_draw_caps_panel(sg_imgui_t* ctx) {
     igText("    imagetype_3d: %s", _sg_imgui_bool_string(f.imagetype_3d));
     igText("    imagetype_array: %s", _sg_imgui_bool_string(f.imagetype_array));
     igText("    image_clamp_to_border: %s", _sg_imgui_bool_string(f.image_clamp_to_border));
+    igText("    draw_indirect: %s", _sg_imgui_bool_string(f.draw_indirect));
+    igText("    base_vertex: %s", _sg_imgui_bool_string(f.base_vertex));
+    igText("    image_region_update: %s", _sg_imgui_bool_string(f.image_region_update));
+    igText("    read_pixels: %s", _sg_imgui_bool_string(f.read_pixels));
+    igText("    gpu_timings: %s", _sg_imgui_bool_string(f.gpu_timings));
     sg_limits l = sg_query_limits();
     igText("\nLimits:\n");
     igText("    max_image_size_2d: %d", l.max_image_size_2d);
@@ -3387,7 +3726,11 @@ SOKOL_API_IMPL void sg_imgui_init(sg_imgui_t* ctx) {
     hooks.destroy_pass = _sg_imgui_destroy_pass;
     hooks.update_buffer = _sg_imgui_update_buffer;
     hooks.update_image = _sg_imgui_update_image;
+    hooks.update_image_region = _sg_imgui_update_image_region;
     hooks.append_buffer = _sg_imgui_append_buffer;
+    hooks.map_buffer = _sg_imgui_map_buffer;
+    hooks.unmap_buffer = _sg_imgui_unmap_buffer;
+    hooks.read_pixels_async = _sg_imgui_read_pixels_async;
     hooks.begin_default_pass = _sg_imgui_begin_default_pass;
     hooks.begin_pass = _sg_imgui_begin_pass;
     hooks.apply_viewport = _sg_imgui_apply_viewport;
@@ -3396,6 +3739,9 @@ SOKOL_API_IMPL void sg_imgui_init(sg_imgui_t* ctx) {
     hooks.apply_bindings = _sg_imgui_apply_bindings;
     hooks.apply_uniforms = _sg_imgui_apply_uniforms;
     hooks.draw = _sg_imgui_draw;
+    hooks.draw_ex = _sg_imgui_draw_ex;
+    hooks.multi_draw = _sg_imgui_multi_draw;
+    hooks.draw_indirect = _sg_imgui_draw_indirect;
     hooks.end_pass = _sg_imgui_end_pass;
     hooks.commit = _sg_imgui_commit;
     hooks.alloc_buffer = _sg_imgui_alloc_buffer;
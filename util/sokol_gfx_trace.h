@@ -0,0 +1,1916 @@
+#ifndef SOKOL_GFX_TRACE_INCLUDED
+/*
+    sokol_gfx_trace.h -- binary trace capture and replay for sokol_gfx.h
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_GFX_TRACE_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following file(s) before including sokol_gfx_trace.h:
+
+        sokol_gfx.h
+
+    The sokol_gfx.h implementation must be compiled with debug trace hooks
+    enabled by defining:
+
+        SOKOL_TRACE_HOOKS
+
+    ...before including the sokol_gfx.h implementation (this is only
+    needed for capturing, replaying works without trace hooks).
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)     - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)       - your own free function (default: free(p))
+    SOKOL_API_DECL      - public function declaration prefix (default: extern)
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+    SOKOL_LOG(msg)      - your own logging function (default: puts(msg))
+    SOKOL_UNREACHABLE() - a guard macro for unreachable code (default: assert(false))
+
+    If sokol_gfx_trace.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_gfx_trace.h records sokol-gfx API calls with all their arguments
+    (including resource content, uniform data and dynamic resource updates)
+    into a compact binary trace, and replays such a trace against any
+    sokol-gfx backend. The main use case is capturing a few frames in a
+    real application and replaying them offline in a loop to measure
+    the CPU-side cost of sokol-gfx and the backend, for instance under
+    a profiler on the dummy backend or on a software GL driver.
+
+    A trace consists of two sections:
+
+    - a preamble which recreates all resources which were alive when
+      the capture was started
+    - the captured frames, all API calls between sgtrace_begin_capture()
+      and sgtrace_end_capture()
+
+    When replaying, the preamble is executed once, and the captured frames
+    are executed as many times as requested.
+
+    STEP BY STEP
+    ============
+    --- call sgtrace_setup() right after sg_setup(), this installs trace
+        hooks into sokol-gfx which keep track of all resources, this
+        must happen before any resources are created:
+
+            sg_setup(&(sg_desc){ ... });
+            sgtrace_setup(&(sgtrace_desc_t){0});
+
+        Other trace hooks (for instance from sokol_gfx_imgui.h) will
+        keep working, as long as they are installed before sgtrace_setup()
+        and removed after sgtrace_shutdown().
+
+    --- to capture frames, call sgtrace_begin_capture() at the start of a
+        frame (before any sokol-gfx calls in that frame), and after the
+        last captured frame's sg_commit() call sgtrace_end_capture(), this
+        returns a pointer and size to the trace data:
+
+            sgtrace_data_t trace = sgtrace_end_capture();
+            FILE* fp = fopen("frames.trace", "wb");
+            fwrite(trace.ptr, 1, (size_t)trace.size, fp);
+            fclose(fp);
+
+        The trace data remains valid until the next call to
+        sgtrace_begin_capture() or sgtrace_shutdown().
+
+    --- before sg_shutdown(), call:
+
+            sgtrace_shutdown();
+
+    --- to replay a trace, call sgtrace_replay() between sg_setup()
+        and sg_shutdown() (sgtrace_setup() is not required for this):
+
+            bool ok = sgtrace_replay(&(sgtrace_replay_desc_t){
+                .ptr = trace_data,
+                .size = trace_size,
+                .num_loops = 100
+            });
+
+        All resources created by the replay are destroyed before
+        sgtrace_replay() returns.
+
+    A complete replay tool for benchmarking on the dummy backend is in
+    tests/sokol_gfx_trace_replay.c:
+
+        sokol_gfx_trace_replay frames.trace 100
+
+    The pool sizes in sg_desc must be at least as big as in the captured
+    application. To replay on a 3D backend, create a window or an offscreen
+    context with sokol_app.h (or your own window system glue) and call
+    sgtrace_replay() from the frame callback, default-pass rendering uses
+    the framebuffer size recorded in the trace.
+
+    TRACE FORMAT
+    ============
+    The trace starts with a header (magic number, version, the number of
+    resource id slot bits, the sizes of the sokol-gfx structs used in the
+    trace, the resource pool sizes and the offset of the captured frames), followed by a sequence of records.
+    Each record starts with a 32-bit command code and the size of the
+    record payload in bytes. Structs are stored as raw memory copies with
+    pointers cleared, the pointed-to data follows the struct as size-prefixed
+    blobs. Everything is padded to 4-byte boundaries.
+
+    Since structs are stored as memory copies, a trace can only be replayed
+    by an executable compiled for the same CPU architecture and with the
+    same sokol_gfx.h version and SOKOL_POOL_SLOT_BITS value as the one it
+    was recorded with. sgtrace_replay()
+    checks this and returns false for incompatible traces.
+
+    LIMITATIONS
+    ===========
+    - resources created before sgtrace_setup() are not known to the trace
+    - the content of dynamic and stream resources is only captured when it
+      is updated during the captured frames, data from earlier updates is
+      lost
+    - native 3D-API resource handles (sg_buffer_desc.gl_buffers etc.) are
+      not captured, instead the replay creates new 3D-API resources
+    - shader functions of the software backend (sg_shader_desc.soft_vs and
+      soft_fs) are function pointers and cannot be captured
+    - the callbacks of sg_read_pixels_async() are not captured, the replay
+      performs the readback with an empty callback
+    - the captured frames should be 'balanced': resources destroyed during
+      the captured frames will be missing in the following loops,
+      resources created during the captured frames are destroyed before
+      the next loop starts
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2020 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_GFX_TRACE_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_gfx_trace.h"
+#endif
+
+#ifndef SOKOL_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_IMPL)
+#define SOKOL_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    sgtrace_desc_t
+
+    Setup parameters for sgtrace_setup(), zero-initialize for defaults.
+*/
+typedef struct sgtrace_desc_t {
+    int initial_capacity;   /* initial size of the capture buffer in bytes (default: 1 MByte), grows as needed */
+} sgtrace_desc_t;
+
+/* a pointer to captured trace data */
+typedef struct sgtrace_data_t {
+    const void* ptr;
+    int size;
+} sgtrace_data_t;
+
+/*
+    sgtrace_replay_desc_t
+
+    Parameters for sgtrace_replay(), the trace data must be 4-byte aligned
+    and stay valid until sgtrace_replay() returns.
+*/
+typedef struct sgtrace_replay_desc_t {
+    const void* ptr;        /* pointer to trace data */
+    int size;               /* size of trace data in bytes */
+    int num_loops;          /* how often the captured frames are replayed (default: 1) */
+} sgtrace_replay_desc_t;
+
+/* capturing */
+SOKOL_API_DECL void sgtrace_setup(const sgtrace_desc_t* desc);
+SOKOL_API_DECL void sgtrace_shutdown(void);
+SOKOL_API_DECL void sgtrace_begin_capture(void);
+SOKOL_API_DECL sgtrace_data_t sgtrace_end_capture(void);
+SOKOL_API_DECL bool sgtrace_is_capturing(void);
+
+/* replaying */
+SOKOL_API_DECL bool sgtrace_replay(const sgtrace_replay_desc_t* desc);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif /* SOKOL_GFX_TRACE_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_GFX_TRACE_IMPL
+#define SOKOL_GFX_TRACE_IMPL_INCLUDED (1)
+
+#include <stddef.h> /* offsetof */
+#include <string.h> /* memset, memcpy */
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef SOKOL_LOG
+    #ifdef SOKOL_DEBUG
+        #include <stdio.h>
+        #define SOKOL_LOG(s) { SOKOL_ASSERT(s); puts(s); }
+    #else
+        #define SOKOL_LOG(s)
+    #endif
+#endif
+#ifndef SOKOL_UNREACHABLE
+    #define SOKOL_UNREACHABLE SOKOL_ASSERT(false)
+#endif
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+#ifndef _SOKOL_UNUSED
+    #define _SOKOL_UNUSED(x) (void)(x)
+#endif
+
+#define _sgtrace_def(val, def) (((val) == 0) ? (def) : (val))
+#define _SGTRACE_INIT_COOKIE (0xABCDABCD)
+#define _SGTRACE_MAGIC (0x52544753)         /* 'SGTR' */
+#define _SGTRACE_VERSION (2)
+#define _SGTRACE_DEFAULT_CAPACITY (1024 * 1024)
+#define _SGTRACE_SLOT_SHIFT (SOKOL_POOL_SLOT_BITS) /* same as _SG_SLOT_SHIFT in sokol_gfx.h */
+#define _SGTRACE_SLOT_MASK ((1<<_SGTRACE_SLOT_SHIFT)-1)
+
+/* call the trace hooks which were installed before sgtrace_setup() */
+#define _SGTRACE_FORWARD_ARGS(fn, ...) if (_sgtrace.hooks.fn) { _sgtrace.hooks.fn(__VA_ARGS__, _sgtrace.hooks.user_data); }
+#define _SGTRACE_FORWARD_NOARGS(fn) if (_sgtrace.hooks.fn) { _sgtrace.hooks.fn(_sgtrace.hooks.user_data); }
+
+typedef enum {
+    _SGTRACE_RES_BUFFER,
+    _SGTRACE_RES_IMAGE,
+    _SGTRACE_RES_SHADER,
+    _SGTRACE_RES_PIPELINE,
+    _SGTRACE_RES_PASS,
+    _SGTRACE_NUM_RES
+} _sgtrace_res_t;
+
+/* resource commands are grouped by resource type, in _sgtrace_res_t order */
+typedef enum {
+    _SGTRACE_CMD_INVALID,
+    _SGTRACE_CMD_MAKE_BUFFER,
+    _SGTRACE_CMD_MAKE_IMAGE,
+    _SGTRACE_CMD_MAKE_SHADER,
+    _SGTRACE_CMD_MAKE_PIPELINE,
+    _SGTRACE_CMD_MAKE_PASS,
+    _SGTRACE_CMD_ALLOC_BUFFER,
+    _SGTRACE_CMD_ALLOC_IMAGE,
+    _SGTRACE_CMD_ALLOC_SHADER,
+    _SGTRACE_CMD_ALLOC_PIPELINE,
+    _SGTRACE_CMD_ALLOC_PASS,
+    _SGTRACE_CMD_INIT_BUFFER,
+    _SGTRACE_CMD_INIT_IMAGE,
+    _SGTRACE_CMD_INIT_SHADER,
+    _SGTRACE_CMD_INIT_PIPELINE,
+    _SGTRACE_CMD_INIT_PASS,
+    _SGTRACE_CMD_FAIL_BUFFER,
+    _SGTRACE_CMD_FAIL_IMAGE,
+    _SGTRACE_CMD_FAIL_SHADER,
+    _SGTRACE_CMD_FAIL_PIPELINE,
+    _SGTRACE_CMD_FAIL_PASS,
+    _SGTRACE_CMD_DESTROY_BUFFER,
+    _SGTRACE_CMD_DESTROY_IMAGE,
+    _SGTRACE_CMD_DESTROY_SHADER,
+    _SGTRACE_CMD_DESTROY_PIPELINE,
+    _SGTRACE_CMD_DESTROY_PASS,
+    _SGTRACE_CMD_RESET_STATE_CACHE,
+    _SGTRACE_CMD_UPDATE_BUFFER,
+    _SGTRACE_CMD_APPEND_BUFFER,
+    _SGTRACE_CMD_MAP_BUFFER,
+    _SGTRACE_CMD_UPDATE_IMAGE,
+    _SGTRACE_CMD_UPDATE_IMAGE_REGION,
+    _SGTRACE_CMD_READ_PIXELS_ASYNC,
+    _SGTRACE_CMD_BEGIN_DEFAULT_PASS,
+    _SGTRACE_CMD_BEGIN_PASS,
+    _SGTRACE_CMD_APPLY_VIEWPORT,
+    _SGTRACE_CMD_APPLY_SCISSOR_RECT,
+    _SGTRACE_CMD_APPLY_PIPELINE,
+    _SGTRACE_CMD_APPLY_BINDINGS,
+    _SGTRACE_CMD_APPLY_UNIFORMS,
+    _SGTRACE_CMD_DRAW,
+    _SGTRACE_CMD_DRAW_EX,
+    _SGTRACE_CMD_MULTI_DRAW,
+    _SGTRACE_CMD_DRAW_INDIRECT,
+    _SGTRACE_CMD_END_PASS,
+    _SGTRACE_CMD_COMMIT,
+    _SGTRACE_CMD_PUSH_DEBUG_GROUP,
+    _SGTRACE_CMD_POP_DEBUG_GROUP,
+    _SGTRACE_NUM_CMDS
+} _sgtrace_cmd_t;
+
+/* the sokol-gfx structs which are stored as memory copies */
+typedef enum {
+    _SGTRACE_STRUCT_BUFFER_DESC,
+    _SGTRACE_STRUCT_IMAGE_DESC,
+    _SGTRACE_STRUCT_SHADER_DESC,
+    _SGTRACE_STRUCT_PIPELINE_DESC,
+    _SGTRACE_STRUCT_PASS_DESC,
+    _SGTRACE_STRUCT_PASS_ACTION,
+    _SGTRACE_STRUCT_BINDINGS,
+    _SGTRACE_STRUCT_IMAGE_REGION,
+    _SGTRACE_STRUCT_DRAW_ARGS,
+    _SGTRACE_NUM_STRUCTS
+} _sgtrace_struct_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_bits;         /* SOKOL_POOL_SLOT_BITS, resource ids are mapped by slot index */
+    uint32_t struct_sizes[_SGTRACE_NUM_STRUCTS];
+    uint32_t pool_sizes[_SGTRACE_NUM_RES];
+    uint32_t frames_offset;     /* byte offset of the first record of the captured frames */
+    uint32_t num_frames;
+} _sgtrace_header_t;
+
+/* a growable byte buffer */
+typedef struct {
+    uint8_t* ptr;
+    int size;
+    int capacity;
+} _sgtrace_buf_t;
+
+/* tracks a live resource and the records which recreate it */
+typedef struct {
+    uint32_t id;
+    _sgtrace_buf_t rec;
+    const void* map_ptr;        /* buffers only: currently mapped memory */
+    int map_size;
+} _sgtrace_slot_t;
+
+typedef struct {
+    uint32_t init_cookie;
+    sgtrace_desc_t desc;
+    sg_trace_hooks hooks;       /* the previously installed trace hooks */
+    int num_slots[_SGTRACE_NUM_RES];
+    _sgtrace_slot_t* slots[_SGTRACE_NUM_RES];
+    _sgtrace_buf_t trace;
+    bool capturing;
+    uint32_t num_frames;
+} _sgtrace_t;
+static _sgtrace_t _sgtrace;
+
+/*== HELPERS =================================================================*/
+_SOKOL_PRIVATE void _sgtrace_header_init(_sgtrace_header_t* hdr) {
+    memset(hdr, 0, sizeof(_sgtrace_header_t));
+    hdr->magic = _SGTRACE_MAGIC;
+    hdr->version = _SGTRACE_VERSION;
+    hdr->slot_bits = _SGTRACE_SLOT_SHIFT;
+    hdr->struct_sizes[_SGTRACE_STRUCT_BUFFER_DESC] = sizeof(sg_buffer_desc);
+    hdr->struct_sizes[_SGTRACE_STRUCT_IMAGE_DESC] = sizeof(sg_image_desc);
+    hdr->struct_sizes[_SGTRACE_STRUCT_SHADER_DESC] = sizeof(sg_shader_desc);
+    hdr->struct_sizes[_SGTRACE_STRUCT_PIPELINE_DESC] = sizeof(sg_pipeline_desc);
+    hdr->struct_sizes[_SGTRACE_STRUCT_PASS_DESC] = sizeof(sg_pass_desc);
+    hdr->struct_sizes[_SGTRACE_STRUCT_PASS_ACTION] = sizeof(sg_pass_action);
+    hdr->struct_sizes[_SGTRACE_STRUCT_BINDINGS] = sizeof(sg_bindings);
+    hdr->struct_sizes[_SGTRACE_STRUCT_IMAGE_REGION] = sizeof(sg_image_region);
+    hdr->struct_sizes[_SGTRACE_STRUCT_DRAW_ARGS] = sizeof(sg_draw_args);
+}
+
+_SOKOL_PRIVATE int _sgtrace_slot_index(uint32_t id) {
+    return (int)(id & _SGTRACE_SLOT_MASK);
+}
+
+/* sokol-gfx resource pools grow on demand, grow a per-slot array so that
+   slot_index is valid, new items are zero-initialized
+*/
+_SOKOL_PRIVATE void* _sgtrace_grow_slots(void* items, int* num_items, int slot_index, int item_size) {
+    SOKOL_ASSERT((slot_index >= *num_items) && (slot_index <= _SGTRACE_SLOT_MASK));
+    int new_num_items = _sgtrace_def(*num_items, 1);
+    while (new_num_items <= slot_index) {
+        new_num_items *= 2;
+    }
+    uint8_t* new_items = (uint8_t*) SOKOL_MALLOC((size_t)new_num_items * (size_t)item_size);
+    SOKOL_ASSERT(new_items);
+    if (items) {
+        memcpy(new_items, items, (size_t)*num_items * (size_t)item_size);
+        SOKOL_FREE(items);
+    }
+    memset(new_items + *num_items * item_size, 0, (size_t)(new_num_items - *num_items) * (size_t)item_size);
+    *num_items = new_num_items;
+    return new_items;
+}
+
+/*== WRITING =================================================================*/
+_SOKOL_PRIVATE void _sgtrace_buf_reserve(_sgtrace_buf_t* buf, int num_bytes) {
+    const int required = buf->size + num_bytes;
+    if (required > buf->capacity) {
+        int new_capacity = _sgtrace_def(buf->capacity, 256);
+        while (new_capacity < required) {
+            new_capacity *= 2;
+        }
+        uint8_t* new_ptr = (uint8_t*) SOKOL_MALLOC((size_t)new_capacity);
+        SOKOL_ASSERT(new_ptr);
+        if (buf->ptr) {
+            memcpy(new_ptr, buf->ptr, (size_t)buf->size);
+            SOKOL_FREE(buf->ptr);
+        }
+        buf->ptr = new_ptr;
+        buf->capacity = new_capacity;
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_buf_discard(_sgtrace_buf_t* buf) {
+    if (buf->ptr) {
+        SOKOL_FREE(buf->ptr);
+    }
+    memset(buf, 0, sizeof(_sgtrace_buf_t));
+}
+
+/* append data, padded to 4 bytes */
+_SOKOL_PRIVATE void _sgtrace_put(_sgtrace_buf_t* buf, const void* data, int num_bytes) {
+    SOKOL_ASSERT(num_bytes >= 0);
+    const int padded_num_bytes = (num_bytes + 3) & ~3;
+    _sgtrace_buf_reserve(buf, padded_num_bytes);
+    if (num_bytes > 0) {
+        memcpy(buf->ptr + buf->size, data, (size_t)num_bytes);
+    }
+    memset(buf->ptr + buf->size + num_bytes, 0, (size_t)(padded_num_bytes - num_bytes));
+    buf->size += padded_num_bytes;
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_u32(_sgtrace_buf_t* buf, uint32_t val) {
+    _sgtrace_put(buf, &val, sizeof(val));
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_int(_sgtrace_buf_t* buf, int val) {
+    _sgtrace_put(buf, &val, sizeof(val));
+}
+
+/* a size-prefixed blob, a null pointer is stored as an empty blob */
+_SOKOL_PRIVATE void _sgtrace_put_blob(_sgtrace_buf_t* buf, const void* data, int num_bytes) {
+    if ((0 == data) || (num_bytes < 0)) {
+        num_bytes = 0;
+    }
+    _sgtrace_put_int(buf, num_bytes);
+    _sgtrace_put(buf, data, num_bytes);
+}
+
+/* strings are stored with their terminating zero */
+_SOKOL_PRIVATE void _sgtrace_put_str(_sgtrace_buf_t* buf, const char* str) {
+    _sgtrace_put_blob(buf, str, str ? ((int)strlen(str) + 1) : 0);
+}
+
+_SOKOL_PRIVATE int _sgtrace_begin_cmd(_sgtrace_buf_t* buf, _sgtrace_cmd_t cmd) {
+    _sgtrace_put_u32(buf, (uint32_t)cmd);
+    const int pos = buf->size;
+    _sgtrace_put_u32(buf, 0);
+    return pos;
+}
+
+/* patch the payload size of the current command */
+_SOKOL_PRIVATE void _sgtrace_end_cmd(_sgtrace_buf_t* buf, int pos) {
+    const uint32_t payload_size = (uint32_t)(buf->size - (pos + 4));
+    memcpy(buf->ptr + pos, &payload_size, sizeof(payload_size));
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_buffer_desc(_sgtrace_buf_t* buf, const sg_buffer_desc* desc) {
+    sg_buffer_desc d = *desc;
+    d.content = 0;
+    d.label = 0;
+    memset(d.gl_buffers, 0, sizeof(d.gl_buffers));
+    memset((void*)d.mtl_buffers, 0, sizeof(d.mtl_buffers));
+    d.d3d11_buffer = 0;
+    d.wgpu_buffer = 0;
+    _sgtrace_put(buf, &d, sizeof(d));
+    _sgtrace_put_blob(buf, desc->content, desc->size);
+    _sgtrace_put_str(buf, desc->label);
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_image_content(_sgtrace_buf_t* buf, const sg_image_content* content) {
+    for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+        for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+            const sg_subimage_content* sub = &content->subimage[face_index][mip_index];
+            _sgtrace_put_blob(buf, sub->ptr, sub->size);
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_image_desc(_sgtrace_buf_t* buf, const sg_image_desc* desc) {
+    sg_image_desc d = *desc;
+    memset(&d.content, 0, sizeof(d.content));
+    d.label = 0;
+    memset(d.gl_textures, 0, sizeof(d.gl_textures));
+    memset((void*)d.mtl_textures, 0, sizeof(d.mtl_textures));
+    d.d3d11_texture = 0;
+    d.wgpu_texture = 0;
+    _sgtrace_put(buf, &d, sizeof(d));
+    _sgtrace_put_image_content(buf, &desc->content);
+    _sgtrace_put_str(buf, desc->label);
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_shader_stage_desc(_sgtrace_buf_t* buf, const sg_shader_stage_desc* stage) {
+    _sgtrace_put_str(buf, stage->source);
+    _sgtrace_put_blob(buf, stage->byte_code, stage->byte_code_size);
+    _sgtrace_put_str(buf, stage->entry);
+    for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+        const sg_shader_uniform_block_desc* ub = &stage->uniform_blocks[ub_index];
+        for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+            _sgtrace_put_str(buf, ub->uniforms[u_index].name);
+        }
+        _sgtrace_put_str(buf, ub->name);
+    }
+    for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+        _sgtrace_put_str(buf, stage->images[img_index].name);
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_clear_shader_stage_ptrs(sg_shader_stage_desc* stage) {
+    stage->source = 0;
+    stage->byte_code = 0;
+    stage->entry = 0;
+    for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+        sg_shader_uniform_block_desc* ub = &stage->uniform_blocks[ub_index];
+        for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+            ub->uniforms[u_index].name = 0;
+        }
+        ub->name = 0;
+    }
+    for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+        stage->images[img_index].name = 0;
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_shader_desc(_sgtrace_buf_t* buf, const sg_shader_desc* desc) {
+    sg_shader_desc d = *desc;
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        d.attrs[attr_index].name = 0;
+        d.attrs[attr_index].sem_name = 0;
+    }
+    _sgtrace_clear_shader_stage_ptrs(&d.vs);
+    _sgtrace_clear_shader_stage_ptrs(&d.fs);
+    d.label = 0;
+    d.soft_vs = 0;
+    d.soft_fs = 0;
+    _sgtrace_put(buf, &d, sizeof(d));
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        _sgtrace_put_str(buf, desc->attrs[attr_index].name);
+        _sgtrace_put_str(buf, desc->attrs[attr_index].sem_name);
+    }
+    _sgtrace_put_shader_stage_desc(buf, &desc->vs);
+    _sgtrace_put_shader_stage_desc(buf, &desc->fs);
+    _sgtrace_put_str(buf, desc->label);
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_pipeline_desc(_sgtrace_buf_t* buf, const sg_pipeline_desc* desc) {
+    sg_pipeline_desc d = *desc;
+    d.label = 0;
+    _sgtrace_put(buf, &d, sizeof(d));
+    _sgtrace_put_str(buf, desc->label);
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_pass_desc(_sgtrace_buf_t* buf, const sg_pass_desc* desc) {
+    sg_pass_desc d = *desc;
+    d.label = 0;
+    _sgtrace_put(buf, &d, sizeof(d));
+    _sgtrace_put_str(buf, desc->label);
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_desc(_sgtrace_buf_t* buf, _sgtrace_res_t res, const void* desc) {
+    switch (res) {
+        case _SGTRACE_RES_BUFFER:   _sgtrace_put_buffer_desc(buf, (const sg_buffer_desc*)desc); break;
+        case _SGTRACE_RES_IMAGE:    _sgtrace_put_image_desc(buf, (const sg_image_desc*)desc); break;
+        case _SGTRACE_RES_SHADER:   _sgtrace_put_shader_desc(buf, (const sg_shader_desc*)desc); break;
+        case _SGTRACE_RES_PIPELINE: _sgtrace_put_pipeline_desc(buf, (const sg_pipeline_desc*)desc); break;
+        case _SGTRACE_RES_PASS:     _sgtrace_put_pass_desc(buf, (const sg_pass_desc*)desc); break;
+        default: SOKOL_UNREACHABLE; break;
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_write_id_cmd(_sgtrace_buf_t* buf, _sgtrace_cmd_t cmd, uint32_t id) {
+    const int pos = _sgtrace_begin_cmd(buf, cmd);
+    _sgtrace_put_u32(buf, id);
+    _sgtrace_end_cmd(buf, pos);
+}
+
+_SOKOL_PRIVATE void _sgtrace_write_desc_cmd(_sgtrace_buf_t* buf, _sgtrace_cmd_t cmd, _sgtrace_res_t res, uint32_t id, const void* desc) {
+    const int pos = _sgtrace_begin_cmd(buf, cmd);
+    _sgtrace_put_u32(buf, id);
+    _sgtrace_put_desc(buf, res, desc);
+    _sgtrace_end_cmd(buf, pos);
+}
+
+/*== RESOURCE TRACKING =======================================================*/
+_SOKOL_PRIVATE _sgtrace_slot_t* _sgtrace_lookup_slot(_sgtrace_res_t res, uint32_t id) {
+    if (SG_INVALID_ID == id) {
+        return 0;
+    }
+    const int slot_index = _sgtrace_slot_index(id);
+    if (slot_index >= _sgtrace.num_slots[res]) {
+        /* not a live resource, slots are created in _sgtrace_create_slot() */
+        return 0;
+    }
+    return &_sgtrace.slots[res][slot_index];
+}
+
+/* like _sgtrace_lookup_slot(), but grows the slots if the resource pool has grown */
+_SOKOL_PRIVATE _sgtrace_slot_t* _sgtrace_create_slot(_sgtrace_res_t res, uint32_t id) {
+    if (SG_INVALID_ID == id) {
+        return 0;
+    }
+    const int slot_index = _sgtrace_slot_index(id);
+    if (slot_index >= _sgtrace.num_slots[res]) {
+        _sgtrace.slots[res] = (_sgtrace_slot_t*) _sgtrace_grow_slots(_sgtrace.slots[res], &_sgtrace.num_slots[res], slot_index, (int)sizeof(_sgtrace_slot_t));
+    }
+    return &_sgtrace.slots[res][slot_index];
+}
+
+/* a resource was created with sg_make_*() or sg_init_*() */
+_SOKOL_PRIVATE void _sgtrace_resource_desc(_sgtrace_cmd_t cmd, _sgtrace_res_t res, uint32_t id, const void* desc) {
+    _sgtrace_slot_t* slot = _sgtrace_create_slot(res, id);
+    if (!slot) {
+        return;
+    }
+    /* both cases are recreated with sg_make_*() */
+    slot->id = id;
+    slot->rec.size = 0;
+    _sgtrace_write_desc_cmd(&slot->rec, (_sgtrace_cmd_t)(_SGTRACE_CMD_MAKE_BUFFER + res), res, id, desc);
+    if (_sgtrace.capturing) {
+        _sgtrace_write_desc_cmd(&_sgtrace.trace, cmd, res, id, desc);
+    }
+}
+
+/* sg_alloc_*(), sg_fail_*() or sg_destroy_*() */
+_SOKOL_PRIVATE void _sgtrace_resource_id(_sgtrace_cmd_t cmd, _sgtrace_res_t res, uint32_t id) {
+    const bool alloc = (cmd == (_sgtrace_cmd_t)(_SGTRACE_CMD_ALLOC_BUFFER + res));
+    _sgtrace_slot_t* slot = alloc ? _sgtrace_create_slot(res, id) : _sgtrace_lookup_slot(res, id);
+    if (!slot) {
+        return;
+    }
+    if (alloc) {
+        slot->id = id;
+        slot->rec.size = 0;
+        _sgtrace_write_id_cmd(&slot->rec, cmd, id);
+    }
+    else if (slot->id != id) {
+        /* not a live resource */
+        return;
+    }
+    else if (cmd == (_sgtrace_cmd_t)(_SGTRACE_CMD_FAIL_BUFFER + res)) {
+        _sgtrace_write_id_cmd(&slot->rec, cmd, id);
+    }
+    else {
+        SOKOL_ASSERT(cmd == (_sgtrace_cmd_t)(_SGTRACE_CMD_DESTROY_BUFFER + res));
+        _sgtrace_buf_discard(&slot->rec);
+        memset(slot, 0, sizeof(_sgtrace_slot_t));
+    }
+    if (_sgtrace.capturing) {
+        _sgtrace_write_id_cmd(&_sgtrace.trace, cmd, id);
+    }
+}
+
+/*== TRACE HOOKS =============================================================*/
+_SOKOL_PRIVATE void _sgtrace_reset_state_cache(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_end_cmd(&_sgtrace.trace, _sgtrace_begin_cmd(&_sgtrace.trace, _SGTRACE_CMD_RESET_STATE_CACHE));
+    }
+    _SGTRACE_FORWARD_NOARGS(reset_state_cache);
+}
+
+_SOKOL_PRIVATE void _sgtrace_make_buffer(const sg_buffer_desc* desc, sg_buffer result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_MAKE_BUFFER, _SGTRACE_RES_BUFFER, result.id, desc);
+    _SGTRACE_FORWARD_ARGS(make_buffer, desc, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_make_image(const sg_image_desc* desc, sg_image result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_MAKE_IMAGE, _SGTRACE_RES_IMAGE, result.id, desc);
+    _SGTRACE_FORWARD_ARGS(make_image, desc, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_make_shader(const sg_shader_desc* desc, sg_shader result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_MAKE_SHADER, _SGTRACE_RES_SHADER, result.id, desc);
+    _SGTRACE_FORWARD_ARGS(make_shader, desc, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_make_pipeline(const sg_pipeline_desc* desc, sg_pipeline result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_MAKE_PIPELINE, _SGTRACE_RES_PIPELINE, result.id, desc);
+    _SGTRACE_FORWARD_ARGS(make_pipeline, desc, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_make_pass(const sg_pass_desc* desc, sg_pass result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_MAKE_PASS, _SGTRACE_RES_PASS, result.id, desc);
+    _SGTRACE_FORWARD_ARGS(make_pass, desc, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_destroy_buffer(sg_buffer buf, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_DESTROY_BUFFER, _SGTRACE_RES_BUFFER, buf.id);
+    _SGTRACE_FORWARD_ARGS(destroy_buffer, buf);
+}
+
+_SOKOL_PRIVATE void _sgtrace_destroy_image(sg_image img, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_DESTROY_IMAGE, _SGTRACE_RES_IMAGE, img.id);
+    _SGTRACE_FORWARD_ARGS(destroy_image, img);
+}
+
+_SOKOL_PRIVATE void _sgtrace_destroy_shader(sg_shader shd, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_DESTROY_SHADER, _SGTRACE_RES_SHADER, shd.id);
+    _SGTRACE_FORWARD_ARGS(destroy_shader, shd);
+}
+
+_SOKOL_PRIVATE void _sgtrace_destroy_pipeline(sg_pipeline pip, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_DESTROY_PIPELINE, _SGTRACE_RES_PIPELINE, pip.id);
+    _SGTRACE_FORWARD_ARGS(destroy_pipeline, pip);
+}
+
+_SOKOL_PRIVATE void _sgtrace_destroy_pass(sg_pass pass, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_DESTROY_PASS, _SGTRACE_RES_PASS, pass.id);
+    _SGTRACE_FORWARD_ARGS(destroy_pass, pass);
+}
+
+_SOKOL_PRIVATE void _sgtrace_update_buffer(sg_buffer buf, const void* data_ptr, int data_size, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_UPDATE_BUFFER);
+        _sgtrace_put_u32(tb, buf.id);
+        _sgtrace_put_blob(tb, data_ptr, data_size);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(update_buffer, buf, data_ptr, data_size);
+}
+
+_SOKOL_PRIVATE void _sgtrace_update_image(sg_image img, const sg_image_content* data, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_UPDATE_IMAGE);
+        _sgtrace_put_u32(tb, img.id);
+        _sgtrace_put_image_content(tb, data);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(update_image, img, data);
+}
+
+_SOKOL_PRIVATE void _sgtrace_update_image_region(sg_image img, const sg_image_region* region, const void* data_ptr, int data_size, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_UPDATE_IMAGE_REGION);
+        _sgtrace_put_u32(tb, img.id);
+        _sgtrace_put(tb, region, sizeof(sg_image_region));
+        _sgtrace_put_blob(tb, data_ptr, data_size);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(update_image_region, img, region, data_ptr, data_size);
+}
+
+_SOKOL_PRIVATE void _sgtrace_append_buffer(sg_buffer buf, const void* data_ptr, int data_size, int result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_APPEND_BUFFER);
+        _sgtrace_put_u32(tb, buf.id);
+        _sgtrace_put_blob(tb, data_ptr, data_size);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(append_buffer, buf, data_ptr, data_size, result);
+}
+
+/* mapped buffers are captured when they are unmapped, together with the written data */
+_SOKOL_PRIVATE void _sgtrace_map_buffer(sg_buffer buf, int data_size, void* result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_slot_t* slot = _sgtrace_lookup_slot(_SGTRACE_RES_BUFFER, buf.id);
+    if (slot && result) {
+        slot->map_ptr = result;
+        slot->map_size = data_size;
+    }
+    _SGTRACE_FORWARD_ARGS(map_buffer, buf, data_size, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_unmap_buffer(sg_buffer buf, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_slot_t* slot = _sgtrace_lookup_slot(_SGTRACE_RES_BUFFER, buf.id);
+    if (slot && slot->map_ptr) {
+        if (_sgtrace.capturing) {
+            _sgtrace_buf_t* tb = &_sgtrace.trace;
+            const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_MAP_BUFFER);
+            _sgtrace_put_u32(tb, buf.id);
+            _sgtrace_put_blob(tb, slot->map_ptr, slot->map_size);
+            _sgtrace_end_cmd(tb, pos);
+        }
+        slot->map_ptr = 0;
+        slot->map_size = 0;
+    }
+    _SGTRACE_FORWARD_ARGS(unmap_buffer, buf);
+}
+
+_SOKOL_PRIVATE void _sgtrace_read_pixels_async(const sg_read_pixels_desc* desc, bool result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_READ_PIXELS_ASYNC);
+        _sgtrace_put_u32(tb, desc->image.id);
+        _sgtrace_put_int(tb, desc->x);
+        _sgtrace_put_int(tb, desc->y);
+        _sgtrace_put_int(tb, desc->width);
+        _sgtrace_put_int(tb, desc->height);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(read_pixels_async, desc, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_begin_default_pass(const sg_pass_action* pass_action, int width, int height, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_BEGIN_DEFAULT_PASS);
+        _sgtrace_put(tb, pass_action, sizeof(sg_pass_action));
+        _sgtrace_put_int(tb, width);
+        _sgtrace_put_int(tb, height);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(begin_default_pass, pass_action, width, height);
+}
+
+_SOKOL_PRIVATE void _sgtrace_begin_pass(sg_pass pass, const sg_pass_action* pass_action, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_BEGIN_PASS);
+        _sgtrace_put_u32(tb, pass.id);
+        _sgtrace_put(tb, pass_action, sizeof(sg_pass_action));
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(begin_pass, pass, pass_action);
+}
+
+_SOKOL_PRIVATE void _sgtrace_put_rect(_sgtrace_cmd_t cmd, int x, int y, int width, int height, bool origin_top_left) {
+    _sgtrace_buf_t* tb = &_sgtrace.trace;
+    const int pos = _sgtrace_begin_cmd(tb, cmd);
+    _sgtrace_put_int(tb, x);
+    _sgtrace_put_int(tb, y);
+    _sgtrace_put_int(tb, width);
+    _sgtrace_put_int(tb, height);
+    _sgtrace_put_u32(tb, origin_top_left ? 1 : 0);
+    _sgtrace_end_cmd(tb, pos);
+}
+
+_SOKOL_PRIVATE void _sgtrace_apply_viewport(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_put_rect(_SGTRACE_CMD_APPLY_VIEWPORT, x, y, width, height, origin_top_left);
+    }
+    _SGTRACE_FORWARD_ARGS(apply_viewport, x, y, width, height, origin_top_left);
+}
+
+_SOKOL_PRIVATE void _sgtrace_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_put_rect(_SGTRACE_CMD_APPLY_SCISSOR_RECT, x, y, width, height, origin_top_left);
+    }
+    _SGTRACE_FORWARD_ARGS(apply_scissor_rect, x, y, width, height, origin_top_left);
+}
+
+_SOKOL_PRIVATE void _sgtrace_apply_pipeline(sg_pipeline pip, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_write_id_cmd(&_sgtrace.trace, _SGTRACE_CMD_APPLY_PIPELINE, pip.id);
+    }
+    _SGTRACE_FORWARD_ARGS(apply_pipeline, pip);
+}
+
+_SOKOL_PRIVATE void _sgtrace_apply_bindings(const sg_bindings* bindings, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_APPLY_BINDINGS);
+        _sgtrace_put(tb, bindings, sizeof(sg_bindings));
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(apply_bindings, bindings);
+}
+
+_SOKOL_PRIVATE void _sgtrace_apply_uniforms(sg_shader_stage stage, int ub_index, const void* data, int num_bytes, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_APPLY_UNIFORMS);
+        _sgtrace_put_int(tb, (int)stage);
+        _sgtrace_put_int(tb, ub_index);
+        _sgtrace_put_blob(tb, data, num_bytes);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(apply_uniforms, stage, ub_index, data, num_bytes);
+}
+
+_SOKOL_PRIVATE void _sgtrace_draw(int base_element, int num_elements, int num_instances, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_DRAW);
+        _sgtrace_put_int(tb, base_element);
+        _sgtrace_put_int(tb, num_elements);
+        _sgtrace_put_int(tb, num_instances);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(draw, base_element, num_elements, num_instances);
+}
+
+_SOKOL_PRIVATE void _sgtrace_draw_ex(int base_element, int num_elements, int num_instances, int base_vertex, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_DRAW_EX);
+        _sgtrace_put_int(tb, base_element);
+        _sgtrace_put_int(tb, num_elements);
+        _sgtrace_put_int(tb, num_instances);
+        _sgtrace_put_int(tb, base_vertex);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(draw_ex, base_element, num_elements, num_instances, base_vertex);
+}
+
+_SOKOL_PRIVATE void _sgtrace_multi_draw(const sg_draw_args* draws, int num_draws, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_MULTI_DRAW);
+        _sgtrace_put_blob(tb, draws, num_draws * (int)sizeof(sg_draw_args));
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(multi_draw, draws, num_draws);
+}
+
+_SOKOL_PRIVATE void _sgtrace_draw_indirect(sg_buffer buf, int offset, int num_draws, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_DRAW_INDIRECT);
+        _sgtrace_put_u32(tb, buf.id);
+        _sgtrace_put_int(tb, offset);
+        _sgtrace_put_int(tb, num_draws);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(draw_indirect, buf, offset, num_draws);
+}
+
+_SOKOL_PRIVATE void _sgtrace_end_pass(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_end_cmd(&_sgtrace.trace, _sgtrace_begin_cmd(&_sgtrace.trace, _SGTRACE_CMD_END_PASS));
+    }
+    _SGTRACE_FORWARD_NOARGS(end_pass);
+}
+
+_SOKOL_PRIVATE void _sgtrace_commit(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_end_cmd(&_sgtrace.trace, _sgtrace_begin_cmd(&_sgtrace.trace, _SGTRACE_CMD_COMMIT));
+        _sgtrace.num_frames++;
+    }
+    _SGTRACE_FORWARD_NOARGS(commit);
+}
+
+_SOKOL_PRIVATE void _sgtrace_alloc_buffer(sg_buffer result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_ALLOC_BUFFER, _SGTRACE_RES_BUFFER, result.id);
+    _SGTRACE_FORWARD_ARGS(alloc_buffer, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_alloc_image(sg_image result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_ALLOC_IMAGE, _SGTRACE_RES_IMAGE, result.id);
+    _SGTRACE_FORWARD_ARGS(alloc_image, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_alloc_shader(sg_shader result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_ALLOC_SHADER, _SGTRACE_RES_SHADER, result.id);
+    _SGTRACE_FORWARD_ARGS(alloc_shader, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_alloc_pipeline(sg_pipeline result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_ALLOC_PIPELINE, _SGTRACE_RES_PIPELINE, result.id);
+    _SGTRACE_FORWARD_ARGS(alloc_pipeline, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_alloc_pass(sg_pass result, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_ALLOC_PASS, _SGTRACE_RES_PASS, result.id);
+    _SGTRACE_FORWARD_ARGS(alloc_pass, result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_INIT_BUFFER, _SGTRACE_RES_BUFFER, buf_id.id, desc);
+    _SGTRACE_FORWARD_ARGS(init_buffer, buf_id, desc);
+}
+
+_SOKOL_PRIVATE void _sgtrace_init_image(sg_image img_id, const sg_image_desc* desc, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_INIT_IMAGE, _SGTRACE_RES_IMAGE, img_id.id, desc);
+    _SGTRACE_FORWARD_ARGS(init_image, img_id, desc);
+}
+
+_SOKOL_PRIVATE void _sgtrace_init_shader(sg_shader shd_id, const sg_shader_desc* desc, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_INIT_SHADER, _SGTRACE_RES_SHADER, shd_id.id, desc);
+    _SGTRACE_FORWARD_ARGS(init_shader, shd_id, desc);
+}
+
+_SOKOL_PRIVATE void _sgtrace_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc* desc, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_INIT_PIPELINE, _SGTRACE_RES_PIPELINE, pip_id.id, desc);
+    _SGTRACE_FORWARD_ARGS(init_pipeline, pip_id, desc);
+}
+
+_SOKOL_PRIVATE void _sgtrace_init_pass(sg_pass pass_id, const sg_pass_desc* desc, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_desc(_SGTRACE_CMD_INIT_PASS, _SGTRACE_RES_PASS, pass_id.id, desc);
+    _SGTRACE_FORWARD_ARGS(init_pass, pass_id, desc);
+}
+
+_SOKOL_PRIVATE void _sgtrace_fail_buffer(sg_buffer buf_id, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_FAIL_BUFFER, _SGTRACE_RES_BUFFER, buf_id.id);
+    _SGTRACE_FORWARD_ARGS(fail_buffer, buf_id);
+}
+
+_SOKOL_PRIVATE void _sgtrace_fail_image(sg_image img_id, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_FAIL_IMAGE, _SGTRACE_RES_IMAGE, img_id.id);
+    _SGTRACE_FORWARD_ARGS(fail_image, img_id);
+}
+
+_SOKOL_PRIVATE void _sgtrace_fail_shader(sg_shader shd_id, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_FAIL_SHADER, _SGTRACE_RES_SHADER, shd_id.id);
+    _SGTRACE_FORWARD_ARGS(fail_shader, shd_id);
+}
+
+_SOKOL_PRIVATE void _sgtrace_fail_pipeline(sg_pipeline pip_id, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_FAIL_PIPELINE, _SGTRACE_RES_PIPELINE, pip_id.id);
+    _SGTRACE_FORWARD_ARGS(fail_pipeline, pip_id);
+}
+
+_SOKOL_PRIVATE void _sgtrace_fail_pass(sg_pass pass_id, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _sgtrace_resource_id(_SGTRACE_CMD_FAIL_PASS, _SGTRACE_RES_PASS, pass_id.id);
+    _SGTRACE_FORWARD_ARGS(fail_pass, pass_id);
+}
+
+_SOKOL_PRIVATE void _sgtrace_push_debug_group(const char* name, void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_buf_t* tb = &_sgtrace.trace;
+        const int pos = _sgtrace_begin_cmd(tb, _SGTRACE_CMD_PUSH_DEBUG_GROUP);
+        _sgtrace_put_str(tb, name);
+        _sgtrace_end_cmd(tb, pos);
+    }
+    _SGTRACE_FORWARD_ARGS(push_debug_group, name);
+}
+
+_SOKOL_PRIVATE void _sgtrace_pop_debug_group(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    if (_sgtrace.capturing) {
+        _sgtrace_end_cmd(&_sgtrace.trace, _sgtrace_begin_cmd(&_sgtrace.trace, _SGTRACE_CMD_POP_DEBUG_GROUP));
+    }
+    _SGTRACE_FORWARD_NOARGS(pop_debug_group);
+}
+
+/* error hooks are only forwarded */
+_SOKOL_PRIVATE void _sgtrace_err_buffer_pool_exhausted(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _SGTRACE_FORWARD_NOARGS(err_buffer_pool_exhausted);
+}
+
+_SOKOL_PRIVATE void _sgtrace_err_image_pool_exhausted(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _SGTRACE_FORWARD_NOARGS(err_image_pool_exhausted);
+}
+
+_SOKOL_PRIVATE void _sgtrace_err_shader_pool_exhausted(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _SGTRACE_FORWARD_NOARGS(err_shader_pool_exhausted);
+}
+
+_SOKOL_PRIVATE void _sgtrace_err_pipeline_pool_exhausted(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _SGTRACE_FORWARD_NOARGS(err_pipeline_pool_exhausted);
+}
+
+_SOKOL_PRIVATE void _sgtrace_err_pass_pool_exhausted(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _SGTRACE_FORWARD_NOARGS(err_pass_pool_exhausted);
+}
+
+_SOKOL_PRIVATE void _sgtrace_err_context_mismatch(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _SGTRACE_FORWARD_NOARGS(err_context_mismatch);
+}
+
+_SOKOL_PRIVATE void _sgtrace_err_pass_invalid(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _SGTRACE_FORWARD_NOARGS(err_pass_invalid);
+}
+
+_SOKOL_PRIVATE void _sgtrace_err_draw_invalid(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _SGTRACE_FORWARD_NOARGS(err_draw_invalid);
+}
+
+_SOKOL_PRIVATE void _sgtrace_err_bindings_invalid(void* user_data) {
+    _SOKOL_UNUSED(user_data);
+    _SGTRACE_FORWARD_NOARGS(err_bindings_invalid);
+}
+
+/*== REPLAY ==================================================================*/
+typedef struct {
+    const uint8_t* ptr;
+    int size;
+    int pos;
+    bool error;
+} _sgtrace_reader_t;
+
+/* maps a captured resource id to the resource id created by the replay */
+typedef struct {
+    uint32_t trace_id;
+    uint32_t replay_id;
+    bool in_frames;             /* true if created inside the captured frames */
+} _sgtrace_id_map_t;
+
+typedef struct {
+    int num_ids[_SGTRACE_NUM_RES];
+    _sgtrace_id_map_t* ids[_SGTRACE_NUM_RES];
+    bool in_frames;
+} _sgtrace_replay_t;
+
+_SOKOL_PRIVATE void _sgtrace_get(_sgtrace_reader_t* r, void* dst, int num_bytes) {
+    const int padded_num_bytes = (num_bytes + 3) & ~3;
+    if (r->error || (num_bytes < 0) || ((r->pos + padded_num_bytes) > r->size)) {
+        r->error = true;
+        if (num_bytes > 0) {
+            memset(dst, 0, (size_t)num_bytes);
+        }
+        return;
+    }
+    memcpy(dst, r->ptr + r->pos, (size_t)num_bytes);
+    r->pos += padded_num_bytes;
+}
+
+_SOKOL_PRIVATE uint32_t _sgtrace_get_u32(_sgtrace_reader_t* r) {
+    uint32_t val = 0;
+    _sgtrace_get(r, &val, sizeof(val));
+    return val;
+}
+
+_SOKOL_PRIVATE int _sgtrace_get_int(_sgtrace_reader_t* r) {
+    int val = 0;
+    _sgtrace_get(r, &val, sizeof(val));
+    return val;
+}
+
+/* returns a pointer into the trace data, or a null pointer for empty blobs */
+_SOKOL_PRIVATE const void* _sgtrace_get_blob(_sgtrace_reader_t* r, int* out_num_bytes) {
+    const int num_bytes = _sgtrace_get_int(r);
+    const int padded_num_bytes = (num_bytes + 3) & ~3;
+    const void* ptr = 0;
+    if ((num_bytes < 0) || ((r->pos + padded_num_bytes) > r->size)) {
+        r->error = true;
+    }
+    else if (!r->error && (num_bytes > 0)) {
+        ptr = r->ptr + r->pos;
+        r->pos += padded_num_bytes;
+    }
+    if (out_num_bytes) {
+        *out_num_bytes = ptr ? num_bytes : 0;
+    }
+    return ptr;
+}
+
+_SOKOL_PRIVATE const char* _sgtrace_get_str(_sgtrace_reader_t* r) {
+    int num_bytes = 0;
+    const char* str = (const char*) _sgtrace_get_blob(r, &num_bytes);
+    if (str && (str[num_bytes - 1] != 0)) {
+        r->error = true;
+        str = 0;
+    }
+    return str;
+}
+
+_SOKOL_PRIVATE void _sgtrace_get_buffer_desc(_sgtrace_reader_t* r, sg_buffer_desc* desc) {
+    _sgtrace_get(r, desc, sizeof(sg_buffer_desc));
+    desc->content = _sgtrace_get_blob(r, 0);
+    desc->label = _sgtrace_get_str(r);
+}
+
+_SOKOL_PRIVATE void _sgtrace_get_image_content(_sgtrace_reader_t* r, sg_image_content* content) {
+    for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+        for (int mip_index = 0; mip_index < SG_MAX_MIPMAPS; mip_index++) {
+            sg_subimage_content* sub = &content->subimage[face_index][mip_index];
+            sub->ptr = _sgtrace_get_blob(r, &sub->size);
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_get_image_desc(_sgtrace_reader_t* r, sg_image_desc* desc) {
+    _sgtrace_get(r, desc, sizeof(sg_image_desc));
+    _sgtrace_get_image_content(r, &desc->content);
+    desc->label = _sgtrace_get_str(r);
+}
+
+_SOKOL_PRIVATE void _sgtrace_get_shader_stage_desc(_sgtrace_reader_t* r, sg_shader_stage_desc* stage) {
+    stage->source = _sgtrace_get_str(r);
+    stage->byte_code = (const uint8_t*) _sgtrace_get_blob(r, &stage->byte_code_size);
+    stage->entry = _sgtrace_get_str(r);
+    for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+        sg_shader_uniform_block_desc* ub = &stage->uniform_blocks[ub_index];
+        for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+            ub->uniforms[u_index].name = _sgtrace_get_str(r);
+        }
+        ub->name = _sgtrace_get_str(r);
+    }
+    for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+        stage->images[img_index].name = _sgtrace_get_str(r);
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_get_shader_desc(_sgtrace_reader_t* r, sg_shader_desc* desc) {
+    _sgtrace_get(r, desc, sizeof(sg_shader_desc));
+    for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
+        desc->attrs[attr_index].name = _sgtrace_get_str(r);
+        desc->attrs[attr_index].sem_name = _sgtrace_get_str(r);
+    }
+    _sgtrace_get_shader_stage_desc(r, &desc->vs);
+    _sgtrace_get_shader_stage_desc(r, &desc->fs);
+    desc->label = _sgtrace_get_str(r);
+}
+
+_SOKOL_PRIVATE void _sgtrace_get_pipeline_desc(_sgtrace_reader_t* r, sg_pipeline_desc* desc) {
+    _sgtrace_get(r, desc, sizeof(sg_pipeline_desc));
+    desc->label = _sgtrace_get_str(r);
+}
+
+_SOKOL_PRIVATE void _sgtrace_get_pass_desc(_sgtrace_reader_t* r, sg_pass_desc* desc) {
+    _sgtrace_get(r, desc, sizeof(sg_pass_desc));
+    desc->label = _sgtrace_get_str(r);
+}
+
+_SOKOL_PRIVATE _sgtrace_id_map_t* _sgtrace_replay_id_entry(_sgtrace_replay_t* rp, _sgtrace_res_t res, uint32_t trace_id) {
+    if (SG_INVALID_ID == trace_id) {
+        return 0;
+    }
+    const int slot_index = _sgtrace_slot_index(trace_id);
+    if (slot_index >= rp->num_ids[res]) {
+        return 0;
+    }
+    return &rp->ids[res][slot_index];
+}
+
+_SOKOL_PRIVATE uint32_t _sgtrace_replay_id(_sgtrace_replay_t* rp, _sgtrace_res_t res, uint32_t trace_id) {
+    const _sgtrace_id_map_t* entry = _sgtrace_replay_id_entry(rp, res, trace_id);
+    if (entry && (entry->trace_id == trace_id)) {
+        return entry->replay_id;
+    }
+    return SG_INVALID_ID;
+}
+
+_SOKOL_PRIVATE void _sgtrace_replay_map_id(_sgtrace_replay_t* rp, _sgtrace_res_t res, uint32_t trace_id, uint32_t replay_id) {
+    if (SG_INVALID_ID == trace_id) {
+        return;
+    }
+    /* the captured resource pool may have grown past the pool size in the header */
+    const int slot_index = _sgtrace_slot_index(trace_id);
+    if (slot_index >= rp->num_ids[res]) {
+        rp->ids[res] = (_sgtrace_id_map_t*) _sgtrace_grow_slots(rp->ids[res], &rp->num_ids[res], slot_index, (int)sizeof(_sgtrace_id_map_t));
+    }
+    _sgtrace_id_map_t* entry = _sgtrace_replay_id_entry(rp, res, trace_id);
+    if (entry) {
+        entry->trace_id = trace_id;
+        entry->replay_id = replay_id;
+        entry->in_frames = rp->in_frames;
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_replay_destroy(_sgtrace_res_t res, uint32_t id) {
+    switch (res) {
+        case _SGTRACE_RES_BUFFER:   { sg_buffer buf = { id }; sg_destroy_buffer(buf); } break;
+        case _SGTRACE_RES_IMAGE:    { sg_image img = { id }; sg_destroy_image(img); } break;
+        case _SGTRACE_RES_SHADER:   { sg_shader shd = { id }; sg_destroy_shader(shd); } break;
+        case _SGTRACE_RES_PIPELINE: { sg_pipeline pip = { id }; sg_destroy_pipeline(pip); } break;
+        case _SGTRACE_RES_PASS:     { sg_pass pass = { id }; sg_destroy_pass(pass); } break;
+        default: SOKOL_UNREACHABLE; break;
+    }
+}
+
+/* destroy replayed resources, in dependency order */
+_SOKOL_PRIVATE void _sgtrace_replay_destroy_all(_sgtrace_replay_t* rp, bool frames_only) {
+    for (int res = _SGTRACE_NUM_RES - 1; res >= 0; res--) {
+        for (int i = 0; i < rp->num_ids[res]; i++) {
+            _sgtrace_id_map_t* entry = &rp->ids[res][i];
+            if ((entry->trace_id != SG_INVALID_ID) && (!frames_only || entry->in_frames)) {
+                _sgtrace_replay_destroy((_sgtrace_res_t)res, entry->replay_id);
+                memset(entry, 0, sizeof(_sgtrace_id_map_t));
+            }
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_replay_resource(_sgtrace_replay_t* rp, _sgtrace_reader_t* r, _sgtrace_cmd_t cmd) {
+    /* the resource command kind (make, alloc, ...) and resource type */
+    const int kind = (cmd - _SGTRACE_CMD_MAKE_BUFFER) / _SGTRACE_NUM_RES;
+    const _sgtrace_res_t res = (_sgtrace_res_t)((cmd - _SGTRACE_CMD_MAKE_BUFFER) % _SGTRACE_NUM_RES);
+    const uint32_t trace_id = _sgtrace_get_u32(r);
+    const uint32_t replay_id = _sgtrace_replay_id(rp, res, trace_id);
+    union {
+        sg_buffer_desc buf;
+        sg_image_desc img;
+        sg_shader_desc shd;
+        sg_pipeline_desc pip;
+        sg_pass_desc pass;
+    } desc;
+    memset(&desc, 0, sizeof(desc));
+    switch (kind) {
+        case 0: /* make */
+        case 2: /* init */
+            switch (res) {
+                case _SGTRACE_RES_BUFFER:   _sgtrace_get_buffer_desc(r, &desc.buf); break;
+                case _SGTRACE_RES_IMAGE:    _sgtrace_get_image_desc(r, &desc.img); break;
+                case _SGTRACE_RES_SHADER:   _sgtrace_get_shader_desc(r, &desc.shd); break;
+                case _SGTRACE_RES_PIPELINE:
+                    _sgtrace_get_pipeline_desc(r, &desc.pip);
+                    desc.pip.shader.id = _sgtrace_replay_id(rp, _SGTRACE_RES_SHADER, desc.pip.shader.id);
+                    break;
+                case _SGTRACE_RES_PASS:
+                    _sgtrace_get_pass_desc(r, &desc.pass);
+                    for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+                        desc.pass.color_attachments[i].image.id = _sgtrace_replay_id(rp, _SGTRACE_RES_IMAGE, desc.pass.color_attachments[i].image.id);
+                    }
+                    desc.pass.depth_stencil_attachment.image.id = _sgtrace_replay_id(rp, _SGTRACE_RES_IMAGE, desc.pass.depth_stencil_attachment.image.id);
+                    break;
+                default: SOKOL_UNREACHABLE; break;
+            }
+            if (r->error) {
+                return;
+            }
+            if (0 == kind) {
+                uint32_t id = SG_INVALID_ID;
+                switch (res) {
+                    case _SGTRACE_RES_BUFFER:   id = sg_make_buffer(&desc.buf).id; break;
+                    case _SGTRACE_RES_IMAGE:    id = sg_make_image(&desc.img).id; break;
+                    case _SGTRACE_RES_SHADER:   id = sg_make_shader(&desc.shd).id; break;
+                    case _SGTRACE_RES_PIPELINE: id = sg_make_pipeline(&desc.pip).id; break;
+                    case _SGTRACE_RES_PASS:     id = sg_make_pass(&desc.pass).id; break;
+                    default: SOKOL_UNREACHABLE; break;
+                }
+                _sgtrace_replay_map_id(rp, res, trace_id, id);
+            }
+            else if (SG_INVALID_ID != replay_id) {
+                switch (res) {
+                    case _SGTRACE_RES_BUFFER:   { sg_buffer buf = { replay_id }; sg_init_buffer(buf, &desc.buf); } break;
+                    case _SGTRACE_RES_IMAGE:    { sg_image img = { replay_id }; sg_init_image(img, &desc.img); } break;
+                    case _SGTRACE_RES_SHADER:   { sg_shader shd = { replay_id }; sg_init_shader(shd, &desc.shd); } break;
+                    case _SGTRACE_RES_PIPELINE: { sg_pipeline pip = { replay_id }; sg_init_pipeline(pip, &desc.pip); } break;
+                    case _SGTRACE_RES_PASS:     { sg_pass pass = { replay_id }; sg_init_pass(pass, &desc.pass); } break;
+                    default: SOKOL_UNREACHABLE; break;
+                }
+            }
+            break;
+        case 1: /* alloc */
+            {
+                uint32_t id = SG_INVALID_ID;
+                switch (res) {
+                    case _SGTRACE_RES_BUFFER:   id = sg_alloc_buffer().id; break;
+                    case _SGTRACE_RES_IMAGE:    id = sg_alloc_image().id; break;
+                    case _SGTRACE_RES_SHADER:   id = sg_alloc_shader().id; break;
+                    case _SGTRACE_RES_PIPELINE: id = sg_alloc_pipeline().id; break;
+                    case _SGTRACE_RES_PASS:     id = sg_alloc_pass().id; break;
+                    default: SOKOL_UNREACHABLE; break;
+                }
+                _sgtrace_replay_map_id(rp, res, trace_id, id);
+            }
+            break;
+        case 3: /* fail */
+            if (SG_INVALID_ID != replay_id) {
+                switch (res) {
+                    case _SGTRACE_RES_BUFFER:   { sg_buffer buf = { replay_id }; sg_fail_buffer(buf); } break;
+                    case _SGTRACE_RES_IMAGE:    { sg_image img = { replay_id }; sg_fail_image(img); } break;
+                    case _SGTRACE_RES_SHADER:   { sg_shader shd = { replay_id }; sg_fail_shader(shd); } break;
+                    case _SGTRACE_RES_PIPELINE: { sg_pipeline pip = { replay_id }; sg_fail_pipeline(pip); } break;
+                    case _SGTRACE_RES_PASS:     { sg_pass pass = { replay_id }; sg_fail_pass(pass); } break;
+                    default: SOKOL_UNREACHABLE; break;
+                }
+            }
+            break;
+        case 4: /* destroy */
+            if (SG_INVALID_ID != replay_id) {
+                _sgtrace_replay_destroy(res, replay_id);
+                memset(_sgtrace_replay_id_entry(rp, res, trace_id), 0, sizeof(_sgtrace_id_map_t));
+            }
+            break;
+        default:
+            SOKOL_UNREACHABLE;
+            break;
+    }
+}
+
+_SOKOL_PRIVATE void _sgtrace_replay_noop_read_pixels(const sg_read_pixels_result* result) {
+    _SOKOL_UNUSED(result);
+}
+
+_SOKOL_PRIVATE void _sgtrace_replay_cmd(_sgtrace_replay_t* rp, _sgtrace_reader_t* r, _sgtrace_cmd_t cmd) {
+    if ((cmd >= _SGTRACE_CMD_MAKE_BUFFER) && (cmd <= _SGTRACE_CMD_DESTROY_PASS)) {
+        _sgtrace_replay_resource(rp, r, cmd);
+        return;
+    }
+    switch (cmd) {
+        case _SGTRACE_CMD_RESET_STATE_CACHE:
+            sg_reset_state_cache();
+            break;
+        case _SGTRACE_CMD_UPDATE_BUFFER:
+        case _SGTRACE_CMD_APPEND_BUFFER:
+        case _SGTRACE_CMD_MAP_BUFFER:
+            {
+                sg_buffer buf = { _sgtrace_replay_id(rp, _SGTRACE_RES_BUFFER, _sgtrace_get_u32(r)) };
+                int num_bytes = 0;
+                const void* data = _sgtrace_get_blob(r, &num_bytes);
+                if (r->error || (0 == data)) {
+                    break;
+                }
+                if (_SGTRACE_CMD_UPDATE_BUFFER == cmd) {
+                    sg_update_buffer(buf, data, num_bytes);
+                }
+                else if (_SGTRACE_CMD_APPEND_BUFFER == cmd) {
+                    sg_append_buffer(buf, data, num_bytes);
+                }
+                else {
+                    void* ptr = sg_map_buffer(buf, num_bytes);
+                    if (ptr) {
+                        memcpy(ptr, data, (size_t)num_bytes);
+                        sg_unmap_buffer(buf);
+                    }
+                }
+            }
+            break;
+        case _SGTRACE_CMD_UPDATE_IMAGE:
+            {
+                sg_image img = { _sgtrace_replay_id(rp, _SGTRACE_RES_IMAGE, _sgtrace_get_u32(r)) };
+                sg_image_content content;
+                _sgtrace_get_image_content(r, &content);
+                if (!r->error) {
+                    sg_update_image(img, &content);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_UPDATE_IMAGE_REGION:
+            {
+                sg_image img = { _sgtrace_replay_id(rp, _SGTRACE_RES_IMAGE, _sgtrace_get_u32(r)) };
+                sg_image_region region;
+                _sgtrace_get(r, &region, sizeof(region));
+                int num_bytes = 0;
+                const void* data = _sgtrace_get_blob(r, &num_bytes);
+                if (!r->error && data) {
+                    sg_update_image_region(img, &region, data, num_bytes);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_READ_PIXELS_ASYNC:
+            {
+                sg_read_pixels_desc desc;
+                memset(&desc, 0, sizeof(desc));
+                desc.image.id = _sgtrace_replay_id(rp, _SGTRACE_RES_IMAGE, _sgtrace_get_u32(r));
+                desc.x = _sgtrace_get_int(r);
+                desc.y = _sgtrace_get_int(r);
+                desc.width = _sgtrace_get_int(r);
+                desc.height = _sgtrace_get_int(r);
+                desc.callback = _sgtrace_replay_noop_read_pixels;
+                if (!r->error) {
+                    sg_read_pixels_async(&desc);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_BEGIN_DEFAULT_PASS:
+            {
+                sg_pass_action pass_action;
+                _sgtrace_get(r, &pass_action, sizeof(pass_action));
+                const int width = _sgtrace_get_int(r);
+                const int height = _sgtrace_get_int(r);
+                if (!r->error) {
+                    sg_begin_default_pass(&pass_action, width, height);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_BEGIN_PASS:
+            {
+                sg_pass pass = { _sgtrace_replay_id(rp, _SGTRACE_RES_PASS, _sgtrace_get_u32(r)) };
+                sg_pass_action pass_action;
+                _sgtrace_get(r, &pass_action, sizeof(pass_action));
+                if (!r->error) {
+                    sg_begin_pass(pass, &pass_action);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_APPLY_VIEWPORT:
+        case _SGTRACE_CMD_APPLY_SCISSOR_RECT:
+            {
+                const int x = _sgtrace_get_int(r);
+                const int y = _sgtrace_get_int(r);
+                const int width = _sgtrace_get_int(r);
+                const int height = _sgtrace_get_int(r);
+                const bool origin_top_left = 0 != _sgtrace_get_u32(r);
+                if (r->error) {
+                    break;
+                }
+                if (_SGTRACE_CMD_APPLY_VIEWPORT == cmd) {
+                    sg_apply_viewport(x, y, width, height, origin_top_left);
+                }
+                else {
+                    sg_apply_scissor_rect(x, y, width, height, origin_top_left);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_APPLY_PIPELINE:
+            {
+                sg_pipeline pip = { _sgtrace_replay_id(rp, _SGTRACE_RES_PIPELINE, _sgtrace_get_u32(r)) };
+                if (!r->error) {
+                    sg_apply_pipeline(pip);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_APPLY_BINDINGS:
+            {
+                sg_bindings bindings;
+                _sgtrace_get(r, &bindings, sizeof(bindings));
+                if (r->error) {
+                    break;
+                }
+                for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+                    bindings.vertex_buffers[i].id = _sgtrace_replay_id(rp, _SGTRACE_RES_BUFFER, bindings.vertex_buffers[i].id);
+                }
+                bindings.index_buffer.id = _sgtrace_replay_id(rp, _SGTRACE_RES_BUFFER, bindings.index_buffer.id);
+                for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+                    bindings.vs_images[i].id = _sgtrace_replay_id(rp, _SGTRACE_RES_IMAGE, bindings.vs_images[i].id);
+                    bindings.fs_images[i].id = _sgtrace_replay_id(rp, _SGTRACE_RES_IMAGE, bindings.fs_images[i].id);
+                }
+                sg_apply_bindings(&bindings);
+            }
+            break;
+        case _SGTRACE_CMD_APPLY_UNIFORMS:
+            {
+                const sg_shader_stage stage = (sg_shader_stage) _sgtrace_get_int(r);
+                const int ub_index = _sgtrace_get_int(r);
+                int num_bytes = 0;
+                const void* data = _sgtrace_get_blob(r, &num_bytes);
+                if (!r->error && data) {
+                    sg_apply_uniforms(stage, ub_index, data, num_bytes);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_DRAW:
+        case _SGTRACE_CMD_DRAW_EX:
+            {
+                const int base_element = _sgtrace_get_int(r);
+                const int num_elements = _sgtrace_get_int(r);
+                const int num_instances = _sgtrace_get_int(r);
+                const int base_vertex = (_SGTRACE_CMD_DRAW_EX == cmd) ? _sgtrace_get_int(r) : 0;
+                if (r->error) {
+                    break;
+                }
+                if (_SGTRACE_CMD_DRAW == cmd) {
+                    sg_draw(base_element, num_elements, num_instances);
+                }
+                else {
+                    sg_draw_ex(base_element, num_elements, num_instances, base_vertex);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_MULTI_DRAW:
+            {
+                int num_bytes = 0;
+                const sg_draw_args* draws = (const sg_draw_args*) _sgtrace_get_blob(r, &num_bytes);
+                if (!r->error && draws) {
+                    sg_multi_draw(draws, num_bytes / (int)sizeof(sg_draw_args));
+                }
+            }
+            break;
+        case _SGTRACE_CMD_DRAW_INDIRECT:
+            {
+                sg_buffer buf = { _sgtrace_replay_id(rp, _SGTRACE_RES_BUFFER, _sgtrace_get_u32(r)) };
+                const int offset = _sgtrace_get_int(r);
+                const int num_draws = _sgtrace_get_int(r);
+                if (!r->error) {
+                    sg_draw_indirect(buf, offset, num_draws);
+                }
+            }
+            break;
+        case _SGTRACE_CMD_END_PASS:
+            sg_end_pass();
+            break;
+        case _SGTRACE_CMD_COMMIT:
+            sg_commit();
+            break;
+        case _SGTRACE_CMD_PUSH_DEBUG_GROUP:
+            {
+                const char* name = _sgtrace_get_str(r);
+                if (!r->error) {
+                    sg_push_debug_group(name ? name : "");
+                }
+            }
+            break;
+        case _SGTRACE_CMD_POP_DEBUG_GROUP:
+            sg_pop_debug_group();
+            break;
+        default:
+            /* unknown commands are skipped */
+            break;
+    }
+}
+
+/* replay all records in a range of the trace, returns false on corrupt data */
+_SOKOL_PRIVATE bool _sgtrace_replay_records(_sgtrace_replay_t* rp, const uint8_t* ptr, int start, int end) {
+    int pos = start;
+    while ((pos + 8) <= end) {
+        uint32_t cmd, payload_size;
+        memcpy(&cmd, ptr + pos, sizeof(cmd));
+        memcpy(&payload_size, ptr + pos + 4, sizeof(payload_size));
+        pos += 8;
+        if ((payload_size > (uint32_t)(end - pos)) || (payload_size & 3)) {
+            return false;
+        }
+        _sgtrace_reader_t r;
+        r.ptr = ptr + pos;
+        r.size = (int)payload_size;
+        r.pos = 0;
+        r.error = false;
+        _sgtrace_replay_cmd(rp, &r, (_sgtrace_cmd_t)cmd);
+        if (r.error) {
+            return false;
+        }
+        pos += (int)payload_size;
+    }
+    return pos == end;
+}
+
+/*== PUBLIC API FUNCTIONS ====================================================*/
+SOKOL_API_IMPL void sgtrace_setup(const sgtrace_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT(_sgtrace.init_cookie != _SGTRACE_INIT_COOKIE);
+    memset(&_sgtrace, 0, sizeof(_sgtrace));
+    _sgtrace.init_cookie = _SGTRACE_INIT_COOKIE;
+    _sgtrace.desc = *desc;
+    _sgtrace.desc.initial_capacity = _sgtrace_def(_sgtrace.desc.initial_capacity, _SGTRACE_DEFAULT_CAPACITY);
+
+    /* one resource tracking slot per pool slot (slot 0 is reserved in sokol-gfx),
+       this grows along with the resource pools
+    */
+    const sg_desc gfx_desc = sg_query_desc();
+    _sgtrace.num_slots[_SGTRACE_RES_BUFFER] = gfx_desc.buffer_pool_size + 1;
+    _sgtrace.num_slots[_SGTRACE_RES_IMAGE] = gfx_desc.image_pool_size + 1;
+    _sgtrace.num_slots[_SGTRACE_RES_SHADER] = gfx_desc.shader_pool_size + 1;
+    _sgtrace.num_slots[_SGTRACE_RES_PIPELINE] = gfx_desc.pipeline_pool_size + 1;
+    _sgtrace.num_slots[_SGTRACE_RES_PASS] = gfx_desc.pass_pool_size + 1;
+    for (int res = 0; res < _SGTRACE_NUM_RES; res++) {
+        const size_t num_bytes = (size_t)_sgtrace.num_slots[res] * sizeof(_sgtrace_slot_t);
+        _sgtrace.slots[res] = (_sgtrace_slot_t*) SOKOL_MALLOC(num_bytes);
+        SOKOL_ASSERT(_sgtrace.slots[res]);
+        memset(_sgtrace.slots[res], 0, num_bytes);
+    }
+
+    sg_trace_hooks hooks;
+    memset(&hooks, 0, sizeof(hooks));
+    hooks.reset_state_cache = _sgtrace_reset_state_cache;
+    hooks.make_buffer = _sgtrace_make_buffer;
+    hooks.make_image = _sgtrace_make_image;
+    hooks.make_shader = _sgtrace_make_shader;
+    hooks.make_pipeline = _sgtrace_make_pipeline;
+    hooks.make_pass = _sgtrace_make_pass;
+    hooks.destroy_buffer = _sgtrace_destroy_buffer;
+    hooks.destroy_image = _sgtrace_destroy_image;
+    hooks.destroy_shader = _sgtrace_destroy_shader;
+    hooks.destroy_pipeline = _sgtrace_destroy_pipeline;
+    hooks.destroy_pass = _sgtrace_destroy_pass;
+    hooks.update_buffer = _sgtrace_update_buffer;
+    hooks.update_image = _sgtrace_update_image;
+    hooks.update_image_region = _sgtrace_update_image_region;
+    hooks.append_buffer = _sgtrace_append_buffer;
+    hooks.map_buffer = _sgtrace_map_buffer;
+    hooks.unmap_buffer = _sgtrace_unmap_buffer;
+    hooks.read_pixels_async = _sgtrace_read_pixels_async;
+    hooks.begin_default_pass = _sgtrace_begin_default_pass;
+    hooks.begin_pass = _sgtrace_begin_pass;
+    hooks.apply_viewport = _sgtrace_apply_viewport;
+    hooks.apply_scissor_rect = _sgtrace_apply_scissor_rect;
+    hooks.apply_pipeline = _sgtrace_apply_pipeline;
+    hooks.apply_bindings = _sgtrace_apply_bindings;
+    hooks.apply_uniforms = _sgtrace_apply_uniforms;
+    hooks.draw = _sgtrace_draw;
+    hooks.draw_ex = _sgtrace_draw_ex;
+    hooks.multi_draw = _sgtrace_multi_draw;
+    hooks.draw_indirect = _sgtrace_draw_indirect;
+    hooks.end_pass = _sgtrace_end_pass;
+    hooks.commit = _sgtrace_commit;
+    hooks.alloc_buffer = _sgtrace_alloc_buffer;
+    hooks.alloc_image = _sgtrace_alloc_image;
+    hooks.alloc_shader = _sgtrace_alloc_shader;
+    hooks.alloc_pipeline = _sgtrace_alloc_pipeline;
+    hooks.alloc_pass = _sgtrace_alloc_pass;
+    hooks.init_buffer = _sgtrace_init_buffer;
+    hooks.init_image = _sgtrace_init_image;
+    hooks.init_shader = _sgtrace_init_shader;
+    hooks.init_pipeline = _sgtrace_init_pipeline;
+    hooks.init_pass = _sgtrace_init_pass;
+    hooks.fail_buffer = _sgtrace_fail_buffer;
+    hooks.fail_image = _sgtrace_fail_image;
+    hooks.fail_shader = _sgtrace_fail_shader;
+    hooks.fail_pipeline = _sgtrace_fail_pipeline;
+    hooks.fail_pass = _sgtrace_fail_pass;
+    hooks.push_debug_group = _sgtrace_push_debug_group;
+    hooks.pop_debug_group = _sgtrace_pop_debug_group;
+    hooks.err_buffer_pool_exhausted = _sgtrace_err_buffer_pool_exhausted;
+    hooks.err_image_pool_exhausted = _sgtrace_err_image_pool_exhausted;
+    hooks.err_shader_pool_exhausted = _sgtrace_err_shader_pool_exhausted;
+    hooks.err_pipeline_pool_exhausted = _sgtrace_err_pipeline_pool_exhausted;
+    hooks.err_pass_pool_exhausted = _sgtrace_err_pass_pool_exhausted;
+    hooks.err_context_mismatch = _sgtrace_err_context_mismatch;
+    hooks.err_pass_invalid = _sgtrace_err_pass_invalid;
+    hooks.err_draw_invalid = _sgtrace_err_draw_invalid;
+    hooks.err_bindings_invalid = _sgtrace_err_bindings_invalid;
+    _sgtrace.hooks = sg_install_trace_hooks(&hooks);
+}
+
+SOKOL_API_IMPL void sgtrace_shutdown(void) {
+    SOKOL_ASSERT(_sgtrace.init_cookie == _SGTRACE_INIT_COOKIE);
+    /* restore the original trace hooks */
+    sg_install_trace_hooks(&_sgtrace.hooks);
+    for (int res = 0; res < _SGTRACE_NUM_RES; res++) {
+        for (int i = 0; i < _sgtrace.num_slots[res]; i++) {
+            _sgtrace_buf_discard(&_sgtrace.slots[res][i].rec);
+        }
+        SOKOL_FREE(_sgtrace.slots[res]);
+    }
+    _sgtrace_buf_discard(&_sgtrace.trace);
+    memset(&_sgtrace, 0, sizeof(_sgtrace));
+}
+
+SOKOL_API_IMPL void sgtrace_begin_capture(void) {
+    SOKOL_ASSERT(_sgtrace.init_cookie == _SGTRACE_INIT_COOKIE);
+    SOKOL_ASSERT(!_sgtrace.capturing);
+    _sgtrace.trace.size = 0;
+    _sgtrace_buf_reserve(&_sgtrace.trace, _sgtrace.desc.initial_capacity);
+    _sgtrace.num_frames = 0;
+
+    /* header, the frame offset and frame count are patched in sgtrace_end_capture() */
+    _sgtrace_header_t hdr;
+    _sgtrace_header_init(&hdr);
+    for (int res = 0; res < _SGTRACE_NUM_RES; res++) {
+        hdr.pool_sizes[res] = (uint32_t)_sgtrace.num_slots[res];
+    }
+    _sgtrace_put(&_sgtrace.trace, &hdr, sizeof(hdr));
+
+    /* preamble: recreate the live resources, pipelines depend on shaders
+       and passes on images, so go in _sgtrace_res_t order
+    */
+    for (int res = 0; res < _SGTRACE_NUM_RES; res++) {
+        for (int i = 0; i < _sgtrace.num_slots[res]; i++) {
+            const _sgtrace_slot_t* slot = &_sgtrace.slots[res][i];
+            if (slot->id != SG_INVALID_ID) {
+                _sgtrace_put(&_sgtrace.trace, slot->rec.ptr, slot->rec.size);
+            }
+        }
+    }
+    const uint32_t frames_offset = (uint32_t)_sgtrace.trace.size;
+    memcpy(_sgtrace.trace.ptr + offsetof(_sgtrace_header_t, frames_offset), &frames_offset, sizeof(frames_offset));
+    _sgtrace.capturing = true;
+}
+
+SOKOL_API_IMPL sgtrace_data_t sgtrace_end_capture(void) {
+    SOKOL_ASSERT(_sgtrace.init_cookie == _SGTRACE_INIT_COOKIE);
+    SOKOL_ASSERT(_sgtrace.capturing);
+    _sgtrace.capturing = false;
+    memcpy(_sgtrace.trace.ptr + offsetof(_sgtrace_header_t, num_frames), &_sgtrace.num_frames, sizeof(_sgtrace.num_frames));
+    sgtrace_data_t data;
+    data.ptr = _sgtrace.trace.ptr;
+    data.size = _sgtrace.trace.size;
+    return data;
+}
+
+SOKOL_API_IMPL bool sgtrace_is_capturing(void) {
+    return _sgtrace.capturing;
+}
+
+SOKOL_API_IMPL bool sgtrace_replay(const sgtrace_replay_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    const uint8_t* ptr = (const uint8_t*) desc->ptr;
+    if ((0 == ptr) || (desc->size < (int)sizeof(_sgtrace_header_t))) {
+        SOKOL_LOG("sgtrace_replay: no trace data");
+        return false;
+    }
+    _sgtrace_header_t hdr, ref_hdr;
+    memcpy(&hdr, ptr, sizeof(hdr));
+    _sgtrace_header_init(&ref_hdr);
+    if ((hdr.magic != ref_hdr.magic) || (hdr.version != ref_hdr.version)) {
+        SOKOL_LOG("sgtrace_replay: not a sokol_gfx_trace.h trace");
+        return false;
+    }
+    if ((hdr.slot_bits != ref_hdr.slot_bits) ||
+        (0 != memcmp(hdr.struct_sizes, ref_hdr.struct_sizes, sizeof(hdr.struct_sizes))))
+    {
+        SOKOL_LOG("sgtrace_replay: trace was recorded with an incompatible sokol_gfx.h build");
+        return false;
+    }
+    if ((hdr.frames_offset < sizeof(hdr)) || (hdr.frames_offset > (uint32_t)desc->size)) {
+        SOKOL_LOG("sgtrace_replay: corrupt trace data");
+        return false;
+    }
+
+    _sgtrace_replay_t rp;
+    memset(&rp, 0, sizeof(rp));
+    for (int res = 0; res < _SGTRACE_NUM_RES; res++) {
+        /* initial size, grows with the ids found in the trace */
+        const uint32_t pool_size = hdr.pool_sizes[res];
+        rp.num_ids[res] = ((pool_size > 0) && (pool_size <= (_SGTRACE_SLOT_MASK + 1))) ? (int)pool_size : 1;
+        const size_t num_bytes = (size_t)rp.num_ids[res] * sizeof(_sgtrace_id_map_t);
+        rp.ids[res] = (_sgtrace_id_map_t*) SOKOL_MALLOC(num_bytes);
+        SOKOL_ASSERT(rp.ids[res]);
+        memset(rp.ids[res], 0, num_bytes);
+    }
+
+    bool ok = _sgtrace_replay_records(&rp, ptr, (int)sizeof(hdr), (int)hdr.frames_offset);
+    rp.in_frames = true;
+    const int num_loops = _sgtrace_def(desc->num_loops, 1);
+    for (int loop = 0; ok && (loop < num_loops); loop++) {
+        if (loop > 0) {
+            _sgtrace_replay_destroy_all(&rp, true);
+        }
+        ok = _sgtrace_replay_records(&rp, ptr, (int)hdr.frames_offset, desc->size);
+    }
+    if (!ok) {
+        SOKOL_LOG("sgtrace_replay: corrupt trace data");
+    }
+
+    _sgtrace_replay_destroy_all(&rp, false);
+    for (int res = 0; res < _SGTRACE_NUM_RES; res++) {
+        SOKOL_FREE(rp.ids[res]);
+    }
+    return ok;
+}
+
+#endif /* SOKOL_GFX_TRACE_IMPL */
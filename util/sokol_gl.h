@@ -19,6 +19,7 @@
     SOKOL_D3D11
     SOKOL_METAL
     SOKOL_WGPU
+    SOKOL_SOFT
 
     ...optionally provide the following macros to override defaults:
 
@@ -1271,11 +1272,37 @@ static const uint8_t _sgl_fs_bin[916] = {
     0x3e,0x00,0x03,0x00,0x0a,0x00,0x00,0x00,0x18,0x00,0x00,0x00,0xfd,0x00,0x01,0x00,
     0x38,0x00,0x01,0x00,
 };
+#elif defined(SOKOL_SOFT)
+/* software shaders, the uniform block is two column-major mat4 (mvp, tm) */
+static void _sgl_soft_mul_mat4(const float* m, const float* v, float* out) {
+    for (int r = 0; r < 4; r++) {
+        out[r] = m[r]*v[0] + m[4+r]*v[1] + m[8+r]*v[2] + m[12+r]*v[3];
+    }
+}
+static void _sgl_soft_vs(const sg_soft_vs_input* in, sg_soft_vs_output* out) {
+    const float* mvp = (const float*) in->uniforms[0];
+    const float* tm = mvp + 16;
+    float uv[4];
+    _sgl_soft_mul_mat4(mvp, in->attrs[0], out->pos);
+    _sgl_soft_mul_mat4(tm, in->attrs[1], uv);
+    out->varyings[0] = uv[0];
+    out->varyings[1] = uv[1];
+    for (int i = 0; i < 4; i++) {
+        out->varyings[2+i] = in->attrs[2][i];
+    }
+}
+static void _sgl_soft_fs(const sg_soft_fs_input* in, sg_soft_fs_output* out) {
+    float texel[4];
+    sg_soft_sample(in->images[0], in->varyings[0], in->varyings[1], texel);
+    for (int i = 0; i < 4; i++) {
+        out->color[i] = texel[i] * in->varyings[2+i];
+    }
+}
 #elif defined(SOKOL_DUMMY_BACKEND)
 static const char* _sgl_vs_src = "";
 static const char* _sgl_fs_src = "";
 #else
-#error "Please define one of SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU or SOKOL_DUMMY_BACKEND!"
+#error "Please define one of SOKOL_GLCORE33, SOKOL_GLES2, SOKOL_GLES3, SOKOL_D3D11, SOKOL_METAL, SOKOL_WGPU, SOKOL_SOFT or SOKOL_DUMMY_BACKEND!"
 #endif
 
 typedef enum {
@@ -2058,6 +2085,10 @@ SOKOL_API_IMPL void sgl_setup(const sgl_desc_t* desc) {
         shd_desc.vs.byte_code_size = sizeof(_sgl_vs_bin);
         shd_desc.fs.byte_code = _sgl_fs_bin;
         shd_desc.fs.byte_code_size = sizeof(_sgl_fs_bin);
+    #elif defined(SOKOL_SOFT)
+        shd_desc.soft_vs = _sgl_soft_vs;
+        shd_desc.soft_fs = _sgl_soft_fs;
+        shd_desc.soft_num_varyings = 6;
     #else
         shd_desc.vs.source = _sgl_vs_src;
         shd_desc.fs.source = _sgl_fs_src;
@@ -1271,7 +1271,6 @@ SOKOL_API_IMPL void simgui_render(void) {
         #else
             const int num_cmds = cl->CmdBuffer.Size;
         #endif
-        uint32_t vtx_offset = 0;
         for (int cmd_index = 0; cmd_index < num_cmds; cmd_index++) {
             ImDrawCmd* pcmd = &cl->CmdBuffer.Data[cmd_index];
             if (pcmd->UserCallback) {
@@ -1283,11 +1282,9 @@ SOKOL_API_IMPL void simgui_render(void) {
                 sg_apply_bindings(&bind);
             }
             else {
-                if ((tex_id != pcmd->TextureId) || (vtx_offset != pcmd->VtxOffset)) {
+                if (tex_id != pcmd->TextureId) {
                     tex_id = pcmd->TextureId;
-                    vtx_offset = pcmd->VtxOffset * sizeof(ImDrawVert);
                     bind.fs_images[0].id = (uint32_t)(uintptr_t)tex_id;
-                    bind.vertex_buffer_offsets[0] = vb_offset + vtx_offset;
                     sg_apply_bindings(&bind);
                 }
                 #if defined(QT_GUI_LIB)
@@ -1302,7 +1299,8 @@ SOKOL_API_IMPL void simgui_render(void) {
                     const int scissor_h = (int) ((pcmd->ClipRect.w - pcmd->ClipRect.y) * dpi_scale);
                 #endif
                 sg_apply_scissor_rect(scissor_x, scissor_y, scissor_w, scissor_h, true);
-                sg_draw(base_element, pcmd->ElemCount, 1);
+                // VtxOffset is non-zero for draw lists with more than 64k vertices
+                sg_draw_ex(base_element, pcmd->ElemCount, 1, (int)pcmd->VtxOffset);
             }
             base_element += pcmd->ElemCount;
         }
@@ -0,0 +1,692 @@
+#ifndef SOKOL_RENDERQUEUE_INCLUDED
+/*
+    sokol_renderqueue.h -- a draw-call sorting render queue for sokol_gfx.h
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_RENDERQUEUE_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following file(s) before including sokol_renderqueue.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)     - your own assert macro (default: assert(c))
+    SOKOL_MALLOC(s)     - your own malloc function (default: malloc(s))
+    SOKOL_FREE(p)       - your own free function (default: free(p))
+    SOKOL_API_DECL      - public function declaration prefix (default: extern)
+    SOKOL_API_IMPL      - public function implementation prefix (default: -)
+
+    If sokol_renderqueue.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_renderqueue.h collects draw items (a pipeline, resource bindings,
+    uniform data and draw call parameters) in any order, sorts them by a
+    64-bit sort key, and renders them with the minimal sequence of
+    sg_apply_pipeline(), sg_apply_bindings(), sg_apply_uniforms() and
+    sg_draw() calls:
+
+    - the items are sorted with a stable radix sort (items with identical
+      keys are rendered in submission order)
+    - sg_apply_pipeline() is only called when the pipeline changes
+    - sg_apply_bindings() is only called when the pipeline or the bindings
+      change
+    - sg_apply_uniforms() is only called when the pipeline or the content
+      of a uniform block changes
+    - adjacent items with identical state and contiguous element ranges are
+      merged into one draw call
+    - adjacent instanced items with identical state and contiguous
+      per-instance data are merged into one instanced draw call
+
+    The draw items are kept until srq_reset(), uniform data is copied into
+    the queue when an item is submitted.
+
+    STEP BY STEP
+    ============
+    --- call srq_setup() after sg_setup():
+
+            srq_setup(&(srq_desc_t){0});
+
+        The following srq_desc_t members are optional (default values are
+        used for zero-initialized members):
+
+            .max_items              the maximum number of draw items between
+                                    two calls to srq_reset() (default: 4096)
+            .uniform_buffer_size    the size of the internal buffer for
+                                    uniform data in bytes (default: 256 KBytes)
+
+    --- build a sort key for each draw item with srq_make_key():
+
+            uint64_t key = srq_make_key(&(srq_key_desc_t){
+                .pass = 0,
+                .layer = LAYER_OPAQUE,
+                .pipeline = pip,
+                .bindings = &bind,
+                .depth = view_depth / far_plane
+            });
+
+        ...or build your own key as long as the top 8 bits are the pass
+        index (see SORT KEY LAYOUT below).
+
+    --- submit draw items in any order:
+
+            srq_submit(&(srq_item_t){
+                .key = key,
+                .pipeline = pip,
+                .bindings = bind,
+                .vs_uniforms[0] = { .ptr = &vs_params, .size = sizeof(vs_params) },
+                .base_element = 0,
+                .num_elements = 36,
+                .num_instances = 1
+            });
+
+        If .num_instances is zero, it defaults to 1.
+
+    --- inside a sokol-gfx pass, render all items of one pass index:
+
+            sg_begin_default_pass(&pass_action, width, height);
+            srq_draw(0);
+            sg_end_pass();
+
+        All items are sorted in the first call to srq_draw() after items
+        have been submitted. srq_draw() doesn't remove any items, calling
+        it twice with the same pass index renders the same items twice.
+
+    --- at the end of the frame, throw away all draw items and uniform data:
+
+            srq_reset();
+
+    --- the queue tracks a single error code which is sticky until the next
+        call to srq_reset():
+
+            srq_error_t srq_error(void)
+
+        SRQ_NO_ERROR                - all OK
+        SRQ_ERROR_ITEMS_FULL        - srq_desc_t.max_items was too small
+        SRQ_ERROR_UNIFORMS_FULL     - srq_desc_t.uniform_buffer_size was too small
+
+        Items which don't fit into the queue are dropped, all other items
+        are still rendered.
+
+    --- the number of submitted items and emitted sokol-gfx calls since
+        the last srq_reset() can be queried with:
+
+            srq_stats_t srq_query_stats(void)
+
+    --- before sg_shutdown(), call:
+
+            srq_shutdown()
+
+    SORT KEY LAYOUT
+    ===============
+    srq_make_key() builds the following key (most significant bits first):
+
+        bits 63..56:    pass index
+        bits 55..48:    layer
+        bit  47:        back-to-front flag
+        bits 46..0:     if back_to_front is false:
+                            12 bits pipeline, 12 bits textures, 23 bits depth
+                        if back_to_front is true:
+                            23 bits inverted depth, 12 bits pipeline, 12 bits textures
+
+    The pipeline bits are the lower bits of the pipeline's pool slot index,
+    the texture bits are a hash of all images in the bindings, and the depth
+    is clamped to the range 0.0 to 1.0. Within a layer, opaque geometry is
+    sorted by state first and front-to-back second, followed by blended
+    geometry (with .back_to_front = true) sorted back-to-front.
+
+    MERGING
+    =======
+    Two draw items which end up next to each other after sorting are
+    rendered with a single sg_draw() call if they have the same pipeline
+    and identical uniform data, and...
+
+    - ...if both have an .instance_stride of zero, identical bindings, the
+      same number of instances, and the second item's element range starts
+      where the first item's element range ends
+
+    - ...if both have the same .instance_stride (which is not zero) and
+      .instance_buffer_index, the same element range, and identical
+      bindings except for the offset of the instance vertex buffer, which
+      must point right behind the per-instance data of the first item
+
+    The second case allows to batch instanced draw items which have
+    written their per-instance data with sg_append_buffer() into the
+    same vertex buffer, for instance:
+
+        const int offset = sg_append_buffer(inst_buf, &inst, sizeof(inst));
+        srq_submit(&(srq_item_t){
+            ...
+            .bindings = {
+                .vertex_buffers = { mesh_buf, inst_buf },
+                .vertex_buffer_offsets = { 0, offset }
+            },
+            .num_elements = mesh_num_elements,
+            .num_instances = 1,
+            .instance_buffer_index = 1,
+            .instance_stride = sizeof(inst)
+        });
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2020 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_RENDERQUEUE_INCLUDED (1)
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_renderqueue.h"
+#endif
+
+#ifndef SOKOL_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_IMPL)
+#define SOKOL_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    srq_error_t
+
+    Errors are reset in srq_reset(), get the current error code
+    with srq_error()
+*/
+typedef enum srq_error_t {
+    SRQ_NO_ERROR = 0,
+    SRQ_ERROR_ITEMS_FULL,
+    SRQ_ERROR_UNIFORMS_FULL,
+} srq_error_t;
+
+typedef struct srq_desc_t {
+    int max_items;              /* max number of draw items between srq_reset() calls (default: 4096) */
+    int uniform_buffer_size;    /* size of the uniform data buffer in bytes (default: 256 KBytes) */
+} srq_desc_t;
+
+/* parameters for srq_make_key() */
+typedef struct srq_key_desc_t {
+    int pass;                   /* pass index (0..255) */
+    int layer;                  /* layer (0..255) */
+    sg_pipeline pipeline;
+    const sg_bindings* bindings;    /* optional, the images are hashed into the key */
+    float depth;                /* normalized depth, 0.0 is near, 1.0 is far */
+    bool back_to_front;         /* sort by descending depth before pipeline and textures */
+} srq_key_desc_t;
+
+/* a pointer to uniform block data */
+typedef struct srq_uniforms_t {
+    const void* ptr;
+    int size;
+} srq_uniforms_t;
+
+typedef struct srq_item_t {
+    uint64_t key;
+    sg_pipeline pipeline;
+    sg_bindings bindings;
+    srq_uniforms_t vs_uniforms[SG_MAX_SHADERSTAGE_UBS];
+    srq_uniforms_t fs_uniforms[SG_MAX_SHADERSTAGE_UBS];
+    int base_element;
+    int num_elements;
+    int num_instances;          /* default: 1 */
+    int instance_buffer_index;  /* vertex buffer slot of the per-instance data (only used with instance_stride) */
+    int instance_stride;        /* bytes per instance, if not zero, items with contiguous instance data are merged */
+} srq_item_t;
+
+/* statistics since the last srq_reset() */
+typedef struct srq_stats_t {
+    int num_items;              /* number of submitted items (including dropped items) */
+    int num_draws;              /* number of sg_draw() calls */
+    int num_apply_pipeline;
+    int num_apply_bindings;
+    int num_apply_uniforms;
+} srq_stats_t;
+
+/* setup/shutdown/misc */
+SOKOL_API_DECL void srq_setup(const srq_desc_t* desc);
+SOKOL_API_DECL void srq_shutdown(void);
+SOKOL_API_DECL srq_error_t srq_error(void);
+SOKOL_API_DECL srq_stats_t srq_query_stats(void);
+
+/* building sort keys and submitting draw items */
+SOKOL_API_DECL uint64_t srq_make_key(const srq_key_desc_t* desc);
+SOKOL_API_DECL void srq_submit(const srq_item_t* item);
+
+/* rendering and resetting the queue */
+SOKOL_API_DECL void srq_draw(int pass);
+SOKOL_API_DECL void srq_reset(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif /* SOKOL_RENDERQUEUE_INCLUDED */
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_RENDERQUEUE_IMPL
+#define SOKOL_RENDERQUEUE_IMPL_INCLUDED (1)
+
+#include <string.h> /* memset, memcpy, memcmp */
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG (1)
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+#ifndef SOKOL_MALLOC
+    #include <stdlib.h>
+    #define SOKOL_MALLOC(s) malloc(s)
+    #define SOKOL_FREE(p) free(p)
+#endif
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#define _srq_def(val, def) (((val) == 0) ? (def) : (val))
+#define _SRQ_INIT_COOKIE (0xABCDABCD)
+#define _SRQ_DEFAULT_MAX_ITEMS (4096)
+#define _SRQ_DEFAULT_UNIFORM_BUFFER_SIZE (256 * 1024)
+#define _SRQ_PASS_SHIFT (56)
+#define _SRQ_DEPTH_BITS (23)
+#define _SRQ_STATE_BITS (12)
+#define _SRQ_STATE_MASK ((1<<_SRQ_STATE_BITS)-1)
+
+/* a submitted draw item, the uniform data lives in the uniform buffer */
+typedef struct {
+    sg_pipeline pipeline;
+    sg_bindings bindings;
+    int ub_offset[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+    int ub_size[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+    int base_element;
+    int num_elements;
+    int num_instances;
+    int instance_buffer_index;
+    int instance_stride;
+} _srq_item_t;
+
+typedef struct {
+    uint64_t key;
+    int item_index;
+} _srq_sort_item_t;
+
+typedef struct {
+    uint32_t init_cookie;
+    srq_desc_t desc;
+    srq_error_t error;
+    srq_stats_t stats;
+    int num_items;
+    bool sorted;
+    _srq_item_t* items;
+    _srq_sort_item_t* sort_items;
+    _srq_sort_item_t* sort_tmp;     /* ping-pong buffer for the radix sort */
+    uint8_t* uniforms;
+    int uniforms_pos;
+    int counts[8][256];             /* radix sort histograms, one per key byte */
+} _srq_state_t;
+static _srq_state_t _srq;
+
+_SOKOL_PRIVATE uint32_t _srq_hash(uint32_t hash, uint32_t val) {
+    /* FNV-1a */
+    return (hash ^ val) * 16777619u;
+}
+
+/* stable LSD radix sort of the sort items by key, one pass per key byte,
+   passes where all items have the same byte value are skipped
+*/
+_SOKOL_PRIVATE void _srq_sort(void) {
+    const int num = _srq.num_items;
+    memset(_srq.counts, 0, sizeof(_srq.counts));
+    for (int i = 0; i < num; i++) {
+        const uint64_t key = _srq.sort_items[i].key;
+        for (int byte_index = 0; byte_index < 8; byte_index++) {
+            _srq.counts[byte_index][(key >> (byte_index * 8)) & 0xFF]++;
+        }
+    }
+    _srq_sort_item_t* src = _srq.sort_items;
+    _srq_sort_item_t* dst = _srq.sort_tmp;
+    for (int byte_index = 0; byte_index < 8; byte_index++) {
+        int* count = _srq.counts[byte_index];
+        const int shift = byte_index * 8;
+        if (count[(src[0].key >> shift) & 0xFF] == num) {
+            continue;
+        }
+        int offset = 0;
+        for (int i = 0; i < 256; i++) {
+            const int c = count[i];
+            count[i] = offset;
+            offset += c;
+        }
+        for (int i = 0; i < num; i++) {
+            dst[count[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        _srq_sort_item_t* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    /* the sorted items must end up in _srq.sort_items */
+    _srq.sort_items = src;
+    _srq.sort_tmp = dst;
+}
+
+/* copy uniform data into the uniform buffer, returns the offset or -1 if the buffer is full */
+_SOKOL_PRIVATE int _srq_push_uniforms(const srq_uniforms_t* ub) {
+    SOKOL_ASSERT(ub->ptr && (ub->size > 0));
+    const int offset = _srq.uniforms_pos;
+    const int aligned_size = (ub->size + 3) & ~3;
+    if ((offset + aligned_size) > _srq.desc.uniform_buffer_size) {
+        return -1;
+    }
+    memcpy(&_srq.uniforms[offset], ub->ptr, (size_t)ub->size);
+    _srq.uniforms_pos += aligned_size;
+    return offset;
+}
+
+_SOKOL_PRIVATE bool _srq_uniforms_equal(const _srq_item_t* a, const _srq_item_t* b) {
+    for (int stage = 0; stage < SG_NUM_SHADER_STAGES; stage++) {
+        for (int ub = 0; ub < SG_MAX_SHADERSTAGE_UBS; ub++) {
+            const int size = a->ub_size[stage][ub];
+            if (size != b->ub_size[stage][ub]) {
+                return false;
+            }
+            if ((size > 0) && (a->ub_offset[stage][ub] != b->ub_offset[stage][ub])) {
+                if (0 != memcmp(&_srq.uniforms[a->ub_offset[stage][ub]], &_srq.uniforms[b->ub_offset[stage][ub]], (size_t)size)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/* check whether 'next' can be merged into the draw call which has been
+   started with 'first' and covers 'num_elements' and 'num_instances'
+*/
+_SOKOL_PRIVATE bool _srq_can_merge(const _srq_item_t* first, const _srq_item_t* next, int num_elements, int num_instances) {
+    if ((first->pipeline.id != next->pipeline.id) || (first->instance_stride != next->instance_stride)) {
+        return false;
+    }
+    if (0 == first->instance_stride) {
+        /* contiguous element ranges */
+        if ((first->num_instances != next->num_instances) ||
+            (next->base_element != (first->base_element + num_elements)) ||
+            (0 != memcmp(&first->bindings, &next->bindings, sizeof(sg_bindings))))
+        {
+            return false;
+        }
+    }
+    else {
+        /* contiguous per-instance data */
+        const int vb_index = first->instance_buffer_index;
+        if ((vb_index != next->instance_buffer_index) ||
+            (first->base_element != next->base_element) ||
+            (first->num_elements != next->num_elements))
+        {
+            return false;
+        }
+        sg_bindings expected = first->bindings;
+        expected.vertex_buffer_offsets[vb_index] += num_instances * first->instance_stride;
+        if (0 != memcmp(&expected, &next->bindings, sizeof(sg_bindings))) {
+            return false;
+        }
+    }
+    return _srq_uniforms_equal(first, next);
+}
+
+/*-- public functions --------------------------------------------------------*/
+SOKOL_API_IMPL void srq_setup(const srq_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    memset(&_srq, 0, sizeof(_srq));
+    _srq.init_cookie = _SRQ_INIT_COOKIE;
+    _srq.desc = *desc;
+    _srq.desc.max_items = _srq_def(_srq.desc.max_items, _SRQ_DEFAULT_MAX_ITEMS);
+    _srq.desc.uniform_buffer_size = _srq_def(_srq.desc.uniform_buffer_size, _SRQ_DEFAULT_UNIFORM_BUFFER_SIZE);
+    const size_t num_items = (size_t)_srq.desc.max_items;
+    _srq.items = (_srq_item_t*) SOKOL_MALLOC(num_items * sizeof(_srq_item_t));
+    SOKOL_ASSERT(_srq.items);
+    _srq.sort_items = (_srq_sort_item_t*) SOKOL_MALLOC(num_items * sizeof(_srq_sort_item_t));
+    SOKOL_ASSERT(_srq.sort_items);
+    _srq.sort_tmp = (_srq_sort_item_t*) SOKOL_MALLOC(num_items * sizeof(_srq_sort_item_t));
+    SOKOL_ASSERT(_srq.sort_tmp);
+    _srq.uniforms = (uint8_t*) SOKOL_MALLOC((size_t)_srq.desc.uniform_buffer_size);
+    SOKOL_ASSERT(_srq.uniforms);
+}
+
+SOKOL_API_IMPL void srq_shutdown(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    SOKOL_FREE(_srq.items); _srq.items = 0;
+    SOKOL_FREE(_srq.sort_items); _srq.sort_items = 0;
+    SOKOL_FREE(_srq.sort_tmp); _srq.sort_tmp = 0;
+    SOKOL_FREE(_srq.uniforms); _srq.uniforms = 0;
+    _srq.init_cookie = 0;
+}
+
+SOKOL_API_IMPL srq_error_t srq_error(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    return _srq.error;
+}
+
+SOKOL_API_IMPL srq_stats_t srq_query_stats(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    return _srq.stats;
+}
+
+SOKOL_API_IMPL uint64_t srq_make_key(const srq_key_desc_t* desc) {
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT((desc->pass >= 0) && (desc->pass < 256));
+    SOKOL_ASSERT((desc->layer >= 0) && (desc->layer < 256));
+    /* the lower bits of a resource id are the pool slot index */
+    const uint64_t pip_bits = desc->pipeline.id & _SRQ_STATE_MASK;
+    uint64_t tex_bits = 0;
+    if (desc->bindings) {
+        uint32_t hash = 2166136261u;
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+            hash = _srq_hash(hash, desc->bindings->vs_images[i].id);
+            hash = _srq_hash(hash, desc->bindings->fs_images[i].id);
+        }
+        tex_bits = (hash ^ (hash >> _SRQ_STATE_BITS) ^ (hash >> (2 * _SRQ_STATE_BITS))) & _SRQ_STATE_MASK;
+    }
+    float depth = desc->depth;
+    if (!(depth > 0.0f)) {
+        /* also catches NaN */
+        depth = 0.0f;
+    }
+    else if (depth > 1.0f) {
+        depth = 1.0f;
+    }
+    const uint32_t max_depth = (1u<<_SRQ_DEPTH_BITS) - 1;
+    uint64_t depth_bits = (uint64_t)(depth * (float)max_depth);
+    uint64_t key = ((uint64_t)desc->pass << _SRQ_PASS_SHIFT) | ((uint64_t)desc->layer << 48);
+    if (desc->back_to_front) {
+        depth_bits = max_depth - depth_bits;
+        key |= (1ull << 47) | (depth_bits << (2 * _SRQ_STATE_BITS)) | (pip_bits << _SRQ_STATE_BITS) | tex_bits;
+    }
+    else {
+        key |= (pip_bits << (_SRQ_STATE_BITS + _SRQ_DEPTH_BITS)) | (tex_bits << _SRQ_DEPTH_BITS) | depth_bits;
+    }
+    return key;
+}
+
+SOKOL_API_IMPL void srq_submit(const srq_item_t* item) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    SOKOL_ASSERT(item);
+    SOKOL_ASSERT((item->instance_buffer_index >= 0) && (item->instance_buffer_index < SG_MAX_SHADERSTAGE_BUFFERS));
+    _srq.stats.num_items++;
+    if (_srq.num_items >= _srq.desc.max_items) {
+        _srq.error = SRQ_ERROR_ITEMS_FULL;
+        return;
+    }
+    _srq_item_t* dst = &_srq.items[_srq.num_items];
+    memset(dst, 0, sizeof(_srq_item_t));
+    const int uniforms_pos = _srq.uniforms_pos;
+    for (int stage = 0; stage < SG_NUM_SHADER_STAGES; stage++) {
+        const srq_uniforms_t* ubs = (stage == SG_SHADERSTAGE_VS) ? item->vs_uniforms : item->fs_uniforms;
+        for (int ub = 0; ub < SG_MAX_SHADERSTAGE_UBS; ub++) {
+            if (ubs[ub].size > 0) {
+                const int offset = _srq_push_uniforms(&ubs[ub]);
+                if (offset < 0) {
+                    /* drop the entire item */
+                    _srq.uniforms_pos = uniforms_pos;
+                    _srq.error = SRQ_ERROR_UNIFORMS_FULL;
+                    return;
+                }
+                dst->ub_offset[stage][ub] = offset;
+                dst->ub_size[stage][ub] = ubs[ub].size;
+            }
+        }
+    }
+    dst->pipeline = item->pipeline;
+    dst->bindings = item->bindings;
+    dst->base_element = item->base_element;
+    dst->num_elements = item->num_elements;
+    dst->num_instances = _srq_def(item->num_instances, 1);
+    dst->instance_buffer_index = item->instance_buffer_index;
+    dst->instance_stride = item->instance_stride;
+    _srq_sort_item_t* sort_item = &_srq.sort_items[_srq.num_items];
+    sort_item->key = item->key;
+    sort_item->item_index = _srq.num_items;
+    _srq.num_items++;
+    _srq.sorted = false;
+}
+
+SOKOL_API_IMPL void srq_draw(int pass) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    SOKOL_ASSERT((pass >= 0) && (pass < 256));
+    if (0 == _srq.num_items) {
+        return;
+    }
+    if (!_srq.sorted) {
+        _srq_sort();
+        _srq.sorted = true;
+    }
+    /* binary search for the first item of the pass */
+    const uint64_t pass_key = (uint64_t)pass << _SRQ_PASS_SHIFT;
+    int lo = 0;
+    int hi = _srq.num_items;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (_srq.sort_items[mid].key < pass_key) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    uint32_t cur_pip_id = SG_INVALID_ID;
+    const sg_bindings* cur_bindings = 0;
+    int cur_ub_offset[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+    int cur_ub_size[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+    int i = lo;
+    while ((i < _srq.num_items) && ((int)(_srq.sort_items[i].key >> _SRQ_PASS_SHIFT) == pass)) {
+        const _srq_item_t* item = &_srq.items[_srq.sort_items[i].item_index];
+        if (item->pipeline.id != cur_pip_id) {
+            sg_apply_pipeline(item->pipeline);
+            _srq.stats.num_apply_pipeline++;
+            cur_pip_id = item->pipeline.id;
+            /* when the pipeline changes, bindings and uniforms must be re-applied */
+            cur_bindings = 0;
+            memset(cur_ub_size, 0, sizeof(cur_ub_size));
+        }
+        if (!cur_bindings || (0 != memcmp(cur_bindings, &item->bindings, sizeof(sg_bindings)))) {
+            sg_apply_bindings(&item->bindings);
+            _srq.stats.num_apply_bindings++;
+            cur_bindings = &item->bindings;
+        }
+        for (int stage = 0; stage < SG_NUM_SHADER_STAGES; stage++) {
+            for (int ub = 0; ub < SG_MAX_SHADERSTAGE_UBS; ub++) {
+                const int size = item->ub_size[stage][ub];
+                if (0 == size) {
+                    continue;
+                }
+                const int offset = item->ub_offset[stage][ub];
+                if ((size == cur_ub_size[stage][ub]) &&
+                    ((offset == cur_ub_offset[stage][ub]) ||
+                     (0 == memcmp(&_srq.uniforms[offset], &_srq.uniforms[cur_ub_offset[stage][ub]], (size_t)size))))
+                {
+                    continue;
+                }
+                sg_apply_uniforms((sg_shader_stage)stage, ub, &_srq.uniforms[offset], size);
+                _srq.stats.num_apply_uniforms++;
+                cur_ub_offset[stage][ub] = offset;
+                cur_ub_size[stage][ub] = size;
+            }
+        }
+        /* merge following compatible items into the same draw call */
+        int num_elements = item->num_elements;
+        int num_instances = item->num_instances;
+        i++;
+        while ((i < _srq.num_items) && ((int)(_srq.sort_items[i].key >> _SRQ_PASS_SHIFT) == pass)) {
+            const _srq_item_t* next = &_srq.items[_srq.sort_items[i].item_index];
+            if (!_srq_can_merge(item, next, num_elements, num_instances)) {
+                break;
+            }
+            if (0 == item->instance_stride) {
+                num_elements += next->num_elements;
+            }
+            else {
+                num_instances += next->num_instances;
+            }
+            i++;
+        }
+        sg_draw(item->base_element, num_elements, num_instances);
+        _srq.stats.num_draws++;
+    }
+}
+
+SOKOL_API_IMPL void srq_reset(void) {
+    SOKOL_ASSERT(_SRQ_INIT_COOKIE == _srq.init_cookie);
+    _srq.num_items = 0;
+    _srq.uniforms_pos = 0;
+    _srq.sorted = false;
+    _srq.error = SRQ_NO_ERROR;
+    memset(&_srq.stats, 0, sizeof(_srq.stats));
+}
+
+#endif /* SOKOL_RENDERQUEUE_IMPL */